@@ -12,6 +12,8 @@
 #include "Fracture\Utils\Log.h"
 #include "Fracture\Utils\Instrumentation.h"
 #include "Fracture\Utils\Helpers.h"
+#include "Fracture\Utils\FrameStats.h"
+#include "Fracture\Utils\MemoryTracker.h"
 
 // For use by Fracture applications
 #include "Fracture\Core\Application.h"
@@ -20,6 +22,7 @@
 
 // --- Input ----------------------
 #include "Fracture\Input\Input.h"
+#include "Fracture\Input\InputRecording.h"
 #include "Fracture\Input\KeyCodes.h"
 #include "Fracture\Input\MouseButtonCodes.h"
 
@@ -28,6 +31,10 @@
 #include "Fracture\Events\ApplicationEvent.h"
 #include "Fracture\Events\KeyEvent.h"
 #include "Fracture\Events\MouseEvent.h"
+#include "Fracture\Events\EventQueue.h"
+#include "Fracture\Events\EventHandlers.h"
+#include "Fracture\Events\CustomEvent.h"
+#include "Fracture\Events\PostedEventQueue.h"
 
 // --- Renderer ----------------------]
 #include "Fracture\Renderer\Renderer.h"
@@ -38,7 +45,17 @@
 #include "Fracture\Renderer\OrthographicCamera.h"
 #include "Fracture\Renderer\OrthographicCameraController.h"
 #include "Fracture\Renderer\Texture.h"
+#include "Fracture\Renderer\Framebuffer.h"
+#include "Fracture\Renderer\Bounds.h"
+#include "Fracture\Renderer\Culling.h"
+#include "Fracture\Renderer\SpatialGrid.h"
+#include "Fracture\Renderer\StaticBatch.h"
+#include "Fracture\Renderer\GeometryPool.h"
+#include "Fracture\Renderer\IndirectDrawList.h"
 
 // --- Components ----------------------
 #include "Fracture\Components\Component.h"
+#include "Fracture\Components\Entity.h"
+#include "Fracture\Components\World.h"
+#include "Fracture\Components\TransformSystem.h"
 
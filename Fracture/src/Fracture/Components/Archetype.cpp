@@ -0,0 +1,171 @@
+#include "frpch.h"
+#include "Archetype.h"
+
+namespace Fracture {
+
+	namespace {
+
+		/// The registered component types. Registration is rare, so a mutex is enough.
+		struct RegistryData
+		{
+			ComponentInfo Infos[MaxComponents];
+			uint32_t Count = 0;
+			std::mutex Mutex;
+		};
+
+		RegistryData& GetRegistry()
+		{
+			static RegistryData data;
+			return data;
+		}
+
+		inline uint32_t AlignUp(uint32_t value, uint32_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		/// Columns start at least on a 16 byte boundary so systems can use aligned SSE loads on them.
+		constexpr uint32_t MinColumnAlignment = 16;
+
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ComponentRegistry //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ComponentID ComponentRegistry::Register(const ComponentInfo& info)
+	{
+		RegistryData& data = GetRegistry();
+		std::lock_guard<std::mutex> lock(data.Mutex);
+		FR_CORE_ASSERT(data.Count < MaxComponents, "Too many component types. Increase MaxComponents");
+
+		ComponentID id = data.Count++;
+		data.Infos[id] = info;
+		FR_CORE_TRACE("Registered component {0} (id {1}, {2} bytes)", info.Name, id, info.Size);
+		return id;
+	}
+
+	const ComponentInfo& ComponentRegistry::GetInfo(ComponentID id)
+	{
+		FR_CORE_ASSERT(id < GetRegistry().Count, "Invalid component id");
+		return GetRegistry().Infos[id];
+	}
+
+	uint32_t ComponentRegistry::GetCount()
+	{
+		RegistryData& data = GetRegistry();
+		std::lock_guard<std::mutex> lock(data.Mutex);
+		return data.Count;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Archetype //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Archetype::Archetype(const ComponentMask& mask)
+		: m_Mask(mask)
+	{
+		m_ColumnIndices.fill(InvalidColumn);
+
+		uint32_t rowSize = sizeof(Entity);
+		for (ComponentID id = 0; id < MaxComponents; id++)
+		{
+			if (!mask.test(id))
+				continue;
+			m_ColumnIndices[id] = (int16_t)m_Components.size();
+			m_Components.push_back(id);
+			m_ColumnSizes.push_back(ComponentRegistry::GetInfo(id).Size);
+			rowSize += ComponentRegistry::GetInfo(id).Size;
+		}
+		m_ColumnOffsets.resize(m_Components.size());
+
+		// Start from the capacity without padding and shrink until the aligned columns fit
+		auto layout = [this](uint32_t capacity) -> bool
+		{
+			uint32_t offset = capacity * (uint32_t)sizeof(Entity);
+			for (size_t column = 0; column < m_Components.size(); column++)
+			{
+				uint32_t alignment = std::max(ComponentRegistry::GetInfo(m_Components[column]).Alignment, MinColumnAlignment);
+				offset = AlignUp(offset, alignment);
+				m_ColumnOffsets[column] = offset;
+				offset += capacity * m_ColumnSizes[column];
+			}
+			return offset <= ChunkSize;
+		};
+
+		m_Capacity = ChunkSize / rowSize;
+		while (m_Capacity > 0 && !layout(m_Capacity))
+			m_Capacity--;
+		FR_CORE_ASSERT(m_Capacity > 0, "The components of an archetype do not fit in a chunk");
+	}
+
+	Archetype::~Archetype()
+	{
+		for (size_t column = 0; column < m_Components.size(); column++)
+		{
+			const ComponentInfo& info = ComponentRegistry::GetInfo(m_Components[column]);
+			for (uint32_t chunkIndex = 0; chunkIndex < m_Chunks.size(); chunkIndex++)
+			{
+				for (uint32_t row = 0; row < m_Chunks[chunkIndex].Count; row++)
+					info.Destruct(GetComponent(chunkIndex, (int16_t)column, row));
+			}
+		}
+	}
+
+	void Archetype::AllocateRow(Entity entity, uint32_t& chunkIndex, uint32_t& row)
+	{
+		if (m_Chunks.empty() || m_Chunks.back().Count == m_Capacity)
+		{
+			Chunk chunk;
+			chunk.Memory = std::unique_ptr<ChunkMemory>(new ChunkMemory); // Not make_unique, the memory does not need to be zeroed
+			m_Chunks.push_back(std::move(chunk));
+		}
+
+		chunkIndex = (uint32_t)m_Chunks.size() - 1;
+		row = m_Chunks.back().Count++;
+		GetEntities(chunkIndex)[row] = entity;
+	}
+
+	Entity Archetype::RemoveRow(uint32_t chunkIndex, uint32_t row, bool destruct)
+	{
+		FR_CORE_ASSERT(chunkIndex < m_Chunks.size() && row < m_Chunks[chunkIndex].Count, "Invalid row");
+
+		uint32_t lastChunk = (uint32_t)m_Chunks.size() - 1;
+		uint32_t lastRow = m_Chunks[lastChunk].Count - 1;
+		bool isLast = chunkIndex == lastChunk && row == lastRow;
+
+		for (size_t column = 0; column < m_Components.size(); column++)
+		{
+			const ComponentInfo& info = ComponentRegistry::GetInfo(m_Components[column]);
+			void* hole = GetComponent(chunkIndex, (int16_t)column, row);
+			if (destruct)
+				info.Destruct(hole);
+			if (!isLast)
+			{
+				void* last = GetComponent(lastChunk, (int16_t)column, lastRow);
+				info.MoveConstruct(hole, last);
+				info.Destruct(last);
+			}
+		}
+
+		Entity moved;
+		if (!isLast)
+		{
+			moved = GetEntities(lastChunk)[lastRow];
+			GetEntities(chunkIndex)[row] = moved;
+		}
+
+		if (--m_Chunks[lastChunk].Count == 0)
+			m_Chunks.pop_back();
+
+		return moved;
+	}
+
+	uint32_t Archetype::GetEntityCount() const
+	{
+		if (m_Chunks.empty())
+			return 0;
+		return (uint32_t)(m_Chunks.size() - 1) * m_Capacity + m_Chunks.back().Count;
+	}
+
+}
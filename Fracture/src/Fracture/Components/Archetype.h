@@ -0,0 +1,132 @@
+#pragma once
+/*!
+* @file Archetype.h
+* @brief Contains the Archetype class that stores every entity with the same set of components in fixed size SoA chunks.
+*
+* @see World
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Components\Entity.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Fracture {
+
+	/// The size of a chunk in bytes. Small enough to stay in L1/L2 while a system walks it.
+	constexpr uint32_t ChunkSize = 16 * 1024;
+
+	/// The memory of a chunk. Aligned to a cache line so every array can start on one.
+	struct alignas(64) ChunkMemory
+	{
+		uint8_t Bytes[ChunkSize];
+	};
+
+	/*!
+	* @brief A block of ChunkSize bytes that holds up to Archetype::GetCapacity() entities.
+	*
+	* @details The chunk is laid out as one array of Entity handles followed by one array per component type (structure of arrays), so a system that
+	* only reads a few components only touches their arrays.
+	*/
+	struct Chunk
+	{
+		std::unique_ptr<ChunkMemory> Memory; /// The storage of the chunk.
+		uint32_t Count = 0; /// The number of entities in the chunk. Rows [0, Count) are alive.
+	};
+
+	/*!
+	* @brief Stores all the entities that have exactly the same set of components.
+	*
+	* @details Chunks are kept dense: every chunk but the last is full. Removing a row moves the last row of the last chunk into the hole, so a
+	* system never has to skip dead rows. The archetype also caches the archetypes reached by adding or removing one component (the edges of the
+	* archetype graph) so moving an entity between archetypes does not need a lookup after the first time.
+	*/
+	class Archetype
+	{
+	public:
+		/// No column. Returned by GetColumnIndex for component types the archetype does not have.
+		static constexpr int16_t InvalidColumn = -1;
+
+		/*!
+		* @brief Constructor that computes the chunk layout of the set of components.
+		*
+		* @param[in] const ComponentMask& mask: The components of the archetype.
+		*/
+		Archetype(const ComponentMask& mask);
+		~Archetype();
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		/*!
+		* @brief Adds a row for an entity at the end of the last chunk. The components of the row are left uninitialised.
+		*
+		* @param[in] Entity entity: The entity that owns the row.
+		* @param[out] uint32_t& chunkIndex: The chunk of the row.
+		* @param[out] uint32_t& row: The row in the chunk.
+		*/
+		void AllocateRow(Entity entity, uint32_t& chunkIndex, uint32_t& row);
+
+		/*!
+		* @brief Removes a row by moving the last row of the archetype into it.
+		*
+		* @param[in] uint32_t chunkIndex: The chunk of the row.
+		* @param[in] uint32_t row: The row in the chunk.
+		* @param[in] bool destruct: Whether the components of the row are destroyed. False when they have already been moved out to another archetype.
+		*
+		* @return Entity: The entity that was moved into the row, or an invalid entity if the removed row was the last one.
+		*/
+		Entity RemoveRow(uint32_t chunkIndex, uint32_t row, bool destruct);
+
+		/*!
+		* @brief Returns the column of a component type, or InvalidColumn if the archetype does not have it.
+		*/
+		inline int16_t GetColumnIndex(ComponentID id) const { return m_ColumnIndices[id]; }
+
+		/*!
+		* @brief Returns the array of a column in a chunk.
+		*/
+		inline void* GetColumn(uint32_t chunkIndex, int16_t column) const { return m_Chunks[chunkIndex].Memory->Bytes + m_ColumnOffsets[column]; }
+
+		/*!
+		* @brief Returns the component of a column at a row.
+		*/
+		inline void* GetComponent(uint32_t chunkIndex, int16_t column, uint32_t row) const
+		{
+			return (uint8_t*)GetColumn(chunkIndex, column) + (size_t)row * m_ColumnSizes[column];
+		}
+
+		/*!
+		* @brief Returns the array of entity handles of a chunk.
+		*/
+		inline Entity* GetEntities(uint32_t chunkIndex) const { return reinterpret_cast<Entity*>(m_Chunks[chunkIndex].Memory->Bytes); }
+
+		inline const ComponentMask& GetMask() const { return m_Mask; }
+		inline const std::vector<ComponentID>& GetComponents() const { return m_Components; }
+		inline const std::vector<Chunk>& GetChunks() const { return m_Chunks; }
+		inline uint32_t GetChunkCount() const { return (uint32_t)m_Chunks.size(); }
+		inline uint32_t GetCapacity() const { return m_Capacity; }
+
+		/*!
+		* @brief Returns the number of entities in the archetype.
+		*/
+		uint32_t GetEntityCount() const;
+
+		/// The cached archetype reached by adding a component type. nullptr until it is first needed.
+		std::array<Archetype*, MaxComponents> AddEdges = {};
+		/// The cached archetype reached by removing a component type. nullptr until it is first needed.
+		std::array<Archetype*, MaxComponents> RemoveEdges = {};
+	private:
+		ComponentMask m_Mask; /// The components of the archetype.
+		std::vector<ComponentID> m_Components; /// The component ids in increasing order, one per column.
+		std::vector<uint32_t> m_ColumnOffsets; /// The byte offset of every column in a chunk.
+		std::vector<uint32_t> m_ColumnSizes; /// The size of the component of every column.
+		std::array<int16_t, MaxComponents> m_ColumnIndices; /// Maps a ComponentID to its column.
+		uint32_t m_Capacity = 0; /// The number of entities that fit in a chunk.
+		std::vector<Chunk> m_Chunks; /// The chunks. All but the last are full.
+	};
+
+}
@@ -3,7 +3,7 @@
 * @file Component.h
 * @brief Contians all the components that can be attached to an entity
 * 
-* @todo: The system currently does not support ECS style component system. This will be implemented in the future.
+* @see World
 * 
 * @author Aditya Rajagopal
 */
@@ -14,6 +14,9 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm\gtx\quaternion.hpp>
 
+#include "Fracture\Renderer\VertexArray.h"
+#include "Fracture\Renderer\Shader.h"
+
 namespace Fracture {
 
 	class TransformComponent
@@ -59,64 +62,66 @@ namespace Fracture {
 		const glm::vec3& GetScale() { return m_Scale; }
 
 		/*!
-		* @brief Setter for the position vector of the transform. This will set the isChanged flag to true so that the transform matrix can be recalculated.
+		* @brief Setter for the position vector of the transform. This will mark the transform and inverse transform matrices to be recalculated.
 		* 
 		* @param[in] const glm::vec3& position: The position vector of the transform.
 		*/
-		void SetPosition(const glm::vec3& position) { m_Position = position; isChanged = true; }
+		void SetPosition(const glm::vec3& position) { m_Position = position; MarkChanged(); }
 
 		/*!
-		* @brief Setter for the rotation vector of the transform. This will set the isChanged flag to true so that the transform matrix can be recalculated.
+		* @brief Setter for the rotation vector of the transform. This will mark the transform and inverse transform matrices to be recalculated.
 		* 
 		* @param[in] const glm::vec3& rotation: The rotation vector of the transform.
 		*/
-		void SetRotation(const glm::vec3& rotation) { m_Rotation = rotation; isChanged = true; }
+		void SetRotation(const glm::vec3& rotation) { m_Rotation = rotation; MarkChanged(); }
 
 		/*!
-		* @brief Setter for the scale vector of the transform. This will set the isChanged flag to true so that the transform matrix can be recalculated.
+		* @brief Setter for the scale vector of the transform. This will mark the transform and inverse transform matrices to be recalculated.
 		* 
 		* @param[in] const glm::vec3& scale: The scale vector of the transform.
 		*/
-		void SetScale(const glm::vec3& scale) { m_Scale = scale; isChanged = true; }
+		void SetScale(const glm::vec3& scale) { m_Scale = scale; MarkChanged(); }
 
 		/*!
-		* @brief Function that will translate the transform by the given translation vector. This will set the isChanged flag to true so that the transform matrix can be recalculated.
+		* @brief Function that will translate the transform by the given translation vector. This will mark the transform and inverse transform matrices to be recalculated.
 		* 
 		* @param[in] const glm::vec3& translation: The translation vector.
 		*/
-		void Translate(const glm::vec3& translation) { m_Position += translation; isChanged = true; }
+		void Translate(const glm::vec3& translation) { m_Position += translation; MarkChanged(); }
 
 		/*!
-		* @brief Function that will add the given rotation to the current rotation. This will set the isChanged flag to true so that the transform matrix can be recalculated.
+		* @brief Function that will add the given rotation to the current rotation. This will mark the transform and inverse transform matrices to be recalculated.
 		* 
 		* @param[in] const glm::vec3& rotation: The rotation vector.
 		*/
-		void Rotate(const glm::vec3& rotation) { m_Rotation += rotation; isChanged = true; }
+		void Rotate(const glm::vec3& rotation) { m_Rotation += rotation; MarkChanged(); }
 
 		/*!
-		* @brief Function that will scale the transform by the given scale vector. This will set the isChanged flag to true so that the transform matrix can be recalculated.
+		* @brief Function that will scale the transform by the given scale vector. This will mark the transform and inverse transform matrices to be recalculated.
 		* 
 		* @param[in] const glm::vec3& scale: The scale vector.
 		*/
-		void Scale(const glm::vec3& scale) { m_Scale += scale; isChanged = true; }
+		void Scale(const glm::vec3& scale) { m_Scale += scale; MarkChanged(); }
 
 
 		/*!
 		* @brief Function that will return the transform matrix of the transformComponent.
 		* 
-		* @details If the isChanged flag is true then the transform matrix will be recalculated and the isChanged flag will be set to false. If not it will return the cached transform matrix.
+		* @details If the transform changed since the last call the matrix is recalculated, otherwise the cached matrix is returned.
+		* The matrix is written directly from the rotation, scale and position instead of multiplying a translate, rotate and scale matrix.
 		* 
 		* @return glm::mat4 The transform matrix of the transformComponent.
 		*/
 		glm::mat4 GetTransform()
 		{
-			if (isChanged)
+			if (m_TransformDirty)
 			{
-				glm::mat4 rotation = glm::toMat4(glm::quat(m_Rotation));
-				glm::mat4 translation = glm::translate(glm::mat4(1.0f), m_Position);
-				glm::mat4 scale = glm::scale(glm::mat4(1.0f), m_Scale);
-				m_Transform = translation * rotation * scale;
-				isChanged = false;
+				glm::mat3 rotation = glm::mat3_cast(glm::quat(m_Rotation));
+				m_Transform[0] = glm::vec4(rotation[0] * m_Scale.x, 0.0f);
+				m_Transform[1] = glm::vec4(rotation[1] * m_Scale.y, 0.0f);
+				m_Transform[2] = glm::vec4(rotation[2] * m_Scale.z, 0.0f);
+				m_Transform[3] = glm::vec4(m_Position, 1.0f);
+				m_TransformDirty = false;
 			}
 			return m_Transform;
 		}
@@ -124,31 +129,66 @@ namespace Fracture {
 		/*!
 		* @brief Function that will return the inverse transform matrix of the transformComponent.
 		* 
-		* @details If the isChanged flag is true then the inverse transform matrix will be recalculated and the isChanged flag will be set to false. If not it will return the cached inverse transform matrix.
+		* @details If the transform changed since the last call the matrix is recalculated, otherwise the cached matrix is returned. It has its own flag so
+		* calling GetTransform first does not leave it stale. The inverse is computed analytically as S^-1 * R^T * T^-1 instead of with a generic 4x4 inverse.
 		* 
 		* @return glm::mat4 The inverse transform matrix of the transformComponent.
 		*/
 		glm::mat4 GetTransformInverse()
 		{
-			if (isChanged)
+			if (m_InverseDirty)
 			{
-				glm::mat4 rotation = glm::toMat4(glm::quat(m_Rotation));
-				glm::mat4 translation = glm::translate(glm::mat4(1.0f), m_Position);
-				glm::mat4 scale = glm::scale(glm::mat4(1.0f), m_Scale);
-				m_InverseTransform = glm::inverse(translation * rotation * scale);
-				isChanged = false;
+				glm::mat3 linear = glm::transpose(glm::mat3_cast(glm::quat(m_Rotation)));
+				glm::vec3 inverseScale = 1.0f / m_Scale;
+				for (int column = 0; column < 3; column++)
+					linear[column] *= inverseScale;
+				for (int column = 0; column < 3; column++)
+					m_InverseTransform[column] = glm::vec4(linear[column], 0.0f);
+				m_InverseTransform[3] = glm::vec4(-(linear * m_Position), 1.0f);
+				m_InverseDirty = false;
 			}
 			return m_InverseTransform;
 		}
+	private:
+		/*!
+		* @brief Marks both cached matrices to be recalculated.
+		*/
+		void MarkChanged() { m_TransformDirty = true; m_InverseDirty = true; }
 	private:
 		glm::vec3 m_Position = { 0.0f, 0.0f, 0.0f }; /// The position vector of the transform
 		glm::vec3 m_Rotation = { 0.0f, 0.0f, 0.0f }; /// The rotation vector of the transform
 		glm::vec3 m_Scale = { 1.0f, 1.0f, 1.0f }; /// The scale vector of the transform
-		bool isChanged = true; /// A boolean flag that will be set to true if the transform is changed and needs to be recalculated
+		bool m_TransformDirty = true; /// Set when the transform changed and m_Transform needs to be recalculated
+		bool m_InverseDirty = true; /// Set when the transform changed and m_InverseTransform needs to be recalculated
 
 		glm::mat4 m_Transform = glm::mat4(1.0f); /// The cached transform matrix of the transform
 		glm::mat4 m_InverseTransform = glm::mat4(1.0f); /// The cached inverse transform matrix of the transform
 	};
 
+	/*!
+	* @brief Component that gives an entity a name, for debugging and editor UI.
+	*/
+	struct TagComponent
+	{
+		std::string Name; /// The name of the entity
+
+		TagComponent() = default;
+		TagComponent(const std::string& name)
+			: Name(name) {}
+	};
+
+	/*!
+	* @brief Component that holds what is needed to submit an entity to the Renderer.
+	*/
+	struct RenderableComponent
+	{
+		Ref<VertexArray> Mesh; /// The vertex array that is drawn
+		Ref<Shader> Material; /// The shader the vertex array is drawn with
+
+		RenderableComponent() = default;
+		RenderableComponent(const Ref<VertexArray>& mesh, const Ref<Shader>& material)
+			: Mesh(mesh), Material(material) {}
+	};
+
 
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+/*!
+* @file Entity.h
+* @brief Contains the Entity handle and the ComponentRegistry that gives every component type an id.
+*
+* @see World
+*
+* @author Aditya Rajagopal
+*/
+
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace Fracture {
+
+	/*!
+	* @brief A handle to an entity of a World.
+	*
+	* @details The 32 bit id packs the index of the entity in the World (low 24 bits) and a generation (high 8 bits). The generation is incremented every time an
+	* index is recycled, so a handle to a destroyed entity is detected instead of silently pointing at the entity that reused its slot.
+	*/
+	struct Entity
+	{
+		static constexpr uint32_t IndexBits = 24; /// The number of bits used for the index.
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1; /// The mask of the index bits.
+		static constexpr uint32_t MaxIndex = IndexMask - 1; /// The largest index. IndexMask is reserved so InvalidID never names a live entity.
+		static constexpr uint32_t InvalidID = 0xFFFFFFFF; /// The id of a null handle.
+
+		uint32_t ID = InvalidID; /// The packed index and generation.
+
+		Entity() = default;
+		explicit Entity(uint32_t id) : ID(id) {}
+		Entity(uint32_t index, uint8_t generation) : ID(((uint32_t)generation << IndexBits) | (index & IndexMask)) {}
+
+		inline uint32_t GetIndex() const { return ID & IndexMask; }
+		inline uint8_t GetGeneration() const { return (uint8_t)(ID >> IndexBits); }
+		inline bool IsValid() const { return ID != InvalidID; }
+
+		inline bool operator==(const Entity& other) const { return ID == other.ID; }
+		inline bool operator!=(const Entity& other) const { return ID != other.ID; }
+	};
+
+	/// The id of a component type. Assigned by the ComponentRegistry on first use.
+	using ComponentID = uint32_t;
+
+	/// The maximum number of component types a program can use.
+	constexpr uint32_t MaxComponents = 64;
+
+	/// A set of component types. Every archetype and every query is identified by one.
+	using ComponentMask = std::bitset<MaxComponents>;
+
+	/// What the World needs to know to store a component type without knowing the type.
+	struct ComponentInfo
+	{
+		const char* Name = nullptr; /// The name of the type, for logging.
+		uint32_t Size = 0; /// sizeof the type.
+		uint32_t Alignment = 0; /// alignof the type.
+		void (*MoveConstruct)(void* destination, void* source) = nullptr; /// Move constructs a component into uninitialised memory.
+		void (*Destruct)(void* component) = nullptr; /// Destroys a component.
+	};
+
+	/*!
+	* @brief Static registry that assigns every component type a ComponentID and keeps its ComponentInfo.
+	*
+	* @details Any type that is move constructible can be used as a component. Ids are assigned in the order the types are first used.
+	*/
+	class ComponentRegistry
+	{
+	public:
+		/*!
+		* @brief Returns the id of the component type T, registering it on first use.
+		*/
+		template<typename T>
+		static ComponentID GetID()
+		{
+			// const T and T are the same component, so the id lives in the instantiation of the unqualified type
+			return GetTypeID<std::remove_cv_t<std::remove_reference_t<T>>>();
+		}
+
+		/*!
+		* @brief Returns the ComponentMask of a list of component types.
+		*/
+		template<typename... Ts>
+		static ComponentMask GetMask()
+		{
+			ComponentMask mask;
+			(mask.set(GetID<Ts>()), ...);
+			return mask;
+		}
+
+		/*!
+		* @brief Returns the ComponentInfo of a registered component type.
+		*/
+		static const ComponentInfo& GetInfo(ComponentID id);
+
+		/*!
+		* @brief Returns the number of registered component types.
+		*/
+		static uint32_t GetCount();
+	private:
+		static ComponentID Register(const ComponentInfo& info);
+
+		template<typename T>
+		static ComponentID GetTypeID()
+		{
+			static const ComponentID id = Register(MakeInfo<T>());
+			return id;
+		}
+
+		template<typename T>
+		static ComponentInfo MakeInfo()
+		{
+			static_assert(std::is_move_constructible_v<T>, "Components must be move constructible");
+			static_assert(alignof(T) <= 64, "Components can not be aligned to more than 64 bytes");
+
+			ComponentInfo info;
+			info.Name = typeid(T).name();
+			info.Size = (uint32_t)sizeof(T);
+			info.Alignment = (uint32_t)alignof(T);
+			info.MoveConstruct = [](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); };
+			info.Destruct = [](void* component) { static_cast<T*>(component)->~T(); };
+			return info;
+		}
+	};
+
+}
+
+namespace std {
+
+	template<>
+	struct hash<Fracture::Entity>
+	{
+		size_t operator()(const Fracture::Entity& entity) const
+		{
+			return hash<uint32_t>()(entity.ID);
+		}
+	};
+
+}
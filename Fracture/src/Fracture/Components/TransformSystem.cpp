@@ -0,0 +1,490 @@
+#include "frpch.h"
+#include "TransformSystem.h"
+
+#include "Fracture/Core/JobSystem.h"
+#include "Fracture/Core/Simd.h"
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm\gtx\quaternion.hpp>
+
+namespace Fracture {
+
+	namespace {
+
+		static_assert(64 % SimdLanes == 0, "A dirty word must cover a whole number of batches");
+
+		/// The bits of a dirty word that belong to the batch starting at bit.
+		constexpr uint64_t BatchMask = (1ull << SimdLanes) - 1;
+
+		/// Levels (and dirty ranges) with fewer transforms than this are updated on the calling thread.
+		constexpr uint32_t ParallelThreshold = 4096;
+		/// The number of transforms of a level handed to a thread at a time.
+		constexpr uint32_t TransformsPerJob = 1024;
+
+		/*!
+		* @brief Multiplies two affine matrices, skipping the bottom row that is always (0, 0, 0, 1).
+		*/
+		inline glm::mat4 AffineMultiply(const glm::mat4& a, const glm::mat4& b)
+		{
+			glm::mat4 result;
+			result[0] = a[0] * b[0].x + a[1] * b[0].y + a[2] * b[0].z;
+			result[1] = a[0] * b[1].x + a[1] * b[1].y + a[2] * b[1].z;
+			result[2] = a[0] * b[2].x + a[1] * b[2].y + a[2] * b[2].z;
+			result[3] = a[0] * b[3].x + a[1] * b[3].y + a[2] * b[3].z + a[3];
+			return result;
+		}
+
+	}
+
+	TransformHandle TransformSystem::Create(const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale)
+	{
+		TransformHandle handle;
+		if (!m_FreeHandles.empty())
+		{
+			handle.ID = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+		else
+		{
+			handle.ID = (uint32_t)m_HandleToIndex.size();
+			m_HandleToIndex.push_back(TransformHandle::InvalidID);
+		}
+
+		uint32_t index = m_Count++;
+		Reserve(m_Count);
+		m_HandleToIndex[handle.ID] = index;
+		m_IndexToHandle[index] = handle.ID;
+		m_ParentHandles[index] = TransformHandle::InvalidID;
+		m_ParentIndices[index] = TransformHandle::InvalidID;
+		m_ChildCounts[index] = 0;
+
+		// A new root only keeps the order sorted by depth while there are no children after it
+		if (GetDepth() <= 1 && !m_OrderDirty)
+			m_LevelStarts = { 0, m_Count };
+		else
+			m_OrderDirty = true;
+
+		SetPosition(handle, position);
+		SetRotation(handle, rotation);
+		SetScale(handle, scale);
+		return handle;
+	}
+
+	void TransformSystem::Destroy(TransformHandle handle)
+	{
+		uint32_t index = GetIndex(handle);
+
+		if (m_ChildCounts[index] > 0)
+		{
+			// The children become roots and keep their local transform
+			for (uint32_t i = 0; i < m_Count; i++)
+			{
+				if (m_ParentHandles[i] == handle.ID)
+				{
+					m_ParentHandles[i] = TransformHandle::InvalidID;
+					MarkDirty(i);
+				}
+			}
+			m_OrderDirty = true;
+		}
+		if (m_ParentHandles[index] != TransformHandle::InvalidID)
+			m_ChildCounts[m_HandleToIndex[m_ParentHandles[index]]]--;
+
+		uint32_t last = --m_Count;
+		if (index != last)
+		{
+			// Keep the arrays dense by moving the last transform into the hole
+			for (std::vector<float>* channel : { &m_PositionX, &m_PositionY, &m_PositionZ, &m_RotationX, &m_RotationY, &m_RotationZ, &m_RotationW, &m_ScaleX, &m_ScaleY, &m_ScaleZ })
+				(*channel)[index] = (*channel)[last];
+			for (std::vector<glm::mat4>* matrices : { &m_LocalTransforms, &m_LocalInverseTransforms, &m_Transforms, &m_InverseTransforms })
+				(*matrices)[index] = (*matrices)[last];
+			for (std::vector<uint32_t>* links : { &m_ParentHandles, &m_ParentIndices, &m_ChildCounts })
+				(*links)[index] = (*links)[last];
+			m_EulerAngles[index] = m_EulerAngles[last];
+
+			uint32_t movedHandle = m_IndexToHandle[last];
+			m_IndexToHandle[index] = movedHandle;
+			m_HandleToIndex[movedHandle] = index;
+			if (m_Dirty[last / 64] & (1ull << (last % 64)))
+				MarkDirty(index);
+		}
+
+		// Reset the freed slot to the identity so the padding lanes of its batch stay well defined
+		m_PositionX[last] = m_PositionY[last] = m_PositionZ[last] = 0.0f;
+		m_RotationX[last] = m_RotationY[last] = m_RotationZ[last] = 0.0f;
+		m_RotationW[last] = 1.0f;
+		m_ScaleX[last] = m_ScaleY[last] = m_ScaleZ[last] = 1.0f;
+		m_Dirty[last / 64] &= ~(1ull << (last % 64));
+
+		m_HandleToIndex[handle.ID] = TransformHandle::InvalidID;
+		m_FreeHandles.push_back(handle.ID);
+
+		// Moving the last transform into the hole only keeps the order sorted by depth when there is a single level
+		if (GetDepth() <= 1 && !m_OrderDirty)
+			m_LevelStarts = { 0, m_Count };
+		else
+			m_OrderDirty = true;
+	}
+
+	bool TransformSystem::IsValid(TransformHandle handle) const
+	{
+		return handle.IsValid() && handle.ID < m_HandleToIndex.size() && m_HandleToIndex[handle.ID] != TransformHandle::InvalidID;
+	}
+
+	void TransformSystem::SetParent(TransformHandle child, TransformHandle parent)
+	{
+		uint32_t index = GetIndex(child);
+		uint32_t previous = m_ParentHandles[index];
+		if (previous == parent.ID)
+			return;
+
+		if (parent.IsValid())
+		{
+			for (uint32_t ancestor = parent.ID; ancestor != TransformHandle::InvalidID; ancestor = m_ParentHandles[GetIndex({ ancestor })])
+				FR_CORE_ASSERT(ancestor != child.ID, "A transform can not be attached to its own descendant");
+			m_ChildCounts[GetIndex(parent)]++;
+		}
+		if (previous != TransformHandle::InvalidID)
+			m_ChildCounts[m_HandleToIndex[previous]]--;
+
+		m_ParentHandles[index] = parent.ID;
+		MarkDirty(index);
+		m_OrderDirty = true;
+	}
+
+	TransformHandle TransformSystem::GetParent(TransformHandle handle) const
+	{
+		return { m_ParentHandles[GetIndex(handle)] };
+	}
+
+	void TransformSystem::SetPosition(TransformHandle handle, const glm::vec3& position)
+	{
+		uint32_t index = GetIndex(handle);
+		m_PositionX[index] = position.x;
+		m_PositionY[index] = position.y;
+		m_PositionZ[index] = position.z;
+		MarkDirty(index);
+	}
+
+	void TransformSystem::SetRotation(TransformHandle handle, const glm::vec3& rotation)
+	{
+		uint32_t index = GetIndex(handle);
+		m_EulerAngles[index] = rotation;
+
+		// The trigonometry is done once here so Update only needs multiplies and adds
+		glm::quat quaternion(rotation);
+		m_RotationX[index] = quaternion.x;
+		m_RotationY[index] = quaternion.y;
+		m_RotationZ[index] = quaternion.z;
+		m_RotationW[index] = quaternion.w;
+		MarkDirty(index);
+	}
+
+	void TransformSystem::SetScale(TransformHandle handle, const glm::vec3& scale)
+	{
+		uint32_t index = GetIndex(handle);
+		m_ScaleX[index] = scale.x;
+		m_ScaleY[index] = scale.y;
+		m_ScaleZ[index] = scale.z;
+		MarkDirty(index);
+	}
+
+	void TransformSystem::Translate(TransformHandle handle, const glm::vec3& translation)
+	{
+		SetPosition(handle, GetPosition(handle) + translation);
+	}
+
+	void TransformSystem::Rotate(TransformHandle handle, const glm::vec3& rotation)
+	{
+		SetRotation(handle, GetRotation(handle) + rotation);
+	}
+
+	glm::vec3 TransformSystem::GetPosition(TransformHandle handle) const
+	{
+		uint32_t index = GetIndex(handle);
+		return { m_PositionX[index], m_PositionY[index], m_PositionZ[index] };
+	}
+
+	glm::vec3 TransformSystem::GetRotation(TransformHandle handle) const
+	{
+		return m_EulerAngles[GetIndex(handle)];
+	}
+
+	glm::vec3 TransformSystem::GetScale(TransformHandle handle) const
+	{
+		uint32_t index = GetIndex(handle);
+		return { m_ScaleX[index], m_ScaleY[index], m_ScaleZ[index] };
+	}
+
+	const glm::mat4& TransformSystem::GetTransform(TransformHandle handle) const
+	{
+		return m_Transforms[GetIndex(handle)];
+	}
+
+	const glm::mat4& TransformSystem::GetTransformInverse(TransformHandle handle) const
+	{
+		return m_InverseTransforms[GetIndex(handle)];
+	}
+
+	const glm::mat4& TransformSystem::GetLocalTransform(TransformHandle handle) const
+	{
+		return m_LocalTransforms[GetIndex(handle)];
+	}
+
+	void TransformSystem::Update()
+	{
+		FR_PROFILE_FUNCTION();
+		if (m_OrderDirty)
+			RebuildOrder();
+
+		// Local matrices of every batch with a dirty transform. The dirty bits are kept until the world pass has read them
+		std::atomic<uint32_t> composed = 0;
+		auto composeWords = [&](uint32_t begin, uint32_t end)
+		{
+			uint32_t count = 0;
+			for (uint32_t word = begin; word < end; word++)
+			{
+				uint64_t dirty = m_Dirty[word];
+				if (!dirty)
+					continue;
+
+				for (uint32_t bit = 0; bit < 64; bit += SimdLanes)
+				{
+					if ((dirty >> bit) & BatchMask)
+					{
+						ComposeBatch(word * 64 + bit);
+						count += SimdLanes;
+					}
+				}
+			}
+			composed += count;
+		};
+
+		uint32_t wordCount = (m_Count + 63) / 64;
+		if (m_Count >= ParallelThreshold)
+			JobSystem::ParallelFor(wordCount, TransformsPerJob / 64, composeWords);
+		else
+			composeWords(0, wordCount);
+
+		// World matrices one level at a time, so the parents of a level are always final before its children read them
+		std::atomic<uint32_t> worldUpdated = 0;
+		auto updateWorld = [&](uint32_t begin, uint32_t end)
+		{
+			uint32_t count = 0;
+			for (uint32_t i = begin; i < end; i++)
+			{
+				uint32_t parent = m_ParentIndices[i];
+				bool changed = IsDirty(i) || (parent != TransformHandle::InvalidID && m_WorldChanged[parent]);
+				m_WorldChanged[i] = changed;
+				if (!changed)
+					continue;
+
+				if (parent == TransformHandle::InvalidID)
+				{
+					m_Transforms[i] = m_LocalTransforms[i];
+					m_InverseTransforms[i] = m_LocalInverseTransforms[i];
+				}
+				else
+				{
+					m_Transforms[i] = AffineMultiply(m_Transforms[parent], m_LocalTransforms[i]);
+					m_InverseTransforms[i] = AffineMultiply(m_LocalInverseTransforms[i], m_InverseTransforms[parent]);
+				}
+				count++;
+			}
+			worldUpdated += count;
+		};
+
+		for (size_t level = 0; level + 1 < m_LevelStarts.size(); level++)
+		{
+			uint32_t begin = m_LevelStarts[level];
+			uint32_t end = m_LevelStarts[level + 1];
+			if (end - begin >= ParallelThreshold)
+				JobSystem::ParallelFor(end - begin, TransformsPerJob, [&](uint32_t first, uint32_t last) { updateWorld(begin + first, begin + last); });
+			else
+				updateWorld(begin, end);
+		}
+
+		std::fill(m_Dirty.begin(), m_Dirty.end(), 0);
+		m_LastUpdateCount = composed;
+		m_LastWorldUpdateCount = worldUpdated;
+	}
+
+	void TransformSystem::ComposeBatch(uint32_t first)
+	{
+		const SimdFloat one = SimdSet(1.0f);
+		const SimdFloat two = SimdSet(2.0f);
+
+		SimdFloat qx = SimdLoad(&m_RotationX[first]);
+		SimdFloat qy = SimdLoad(&m_RotationY[first]);
+		SimdFloat qz = SimdLoad(&m_RotationZ[first]);
+		SimdFloat qw = SimdLoad(&m_RotationW[first]);
+		SimdFloat sx = SimdLoad(&m_ScaleX[first]);
+		SimdFloat sy = SimdLoad(&m_ScaleY[first]);
+		SimdFloat sz = SimdLoad(&m_ScaleZ[first]);
+		SimdFloat tx = SimdLoad(&m_PositionX[first]);
+		SimdFloat ty = SimdLoad(&m_PositionY[first]);
+		SimdFloat tz = SimdLoad(&m_PositionZ[first]);
+
+		// Rotation matrix of a unit quaternion, r[column][row] like glm::mat3_cast
+		SimdFloat xx = SimdMul(qx, qx), yy = SimdMul(qy, qy), zz = SimdMul(qz, qz);
+		SimdFloat xy = SimdMul(qx, qy), xz = SimdMul(qx, qz), yz = SimdMul(qy, qz);
+		SimdFloat wx = SimdMul(qw, qx), wy = SimdMul(qw, qy), wz = SimdMul(qw, qz);
+
+		SimdFloat r[3][3];
+		r[0][0] = SimdSub(one, SimdMul(two, SimdAdd(yy, zz)));
+		r[0][1] = SimdMul(two, SimdAdd(xy, wz));
+		r[0][2] = SimdMul(two, SimdSub(xz, wy));
+		r[1][0] = SimdMul(two, SimdSub(xy, wz));
+		r[1][1] = SimdSub(one, SimdMul(two, SimdAdd(xx, zz)));
+		r[1][2] = SimdMul(two, SimdAdd(yz, wx));
+		r[2][0] = SimdMul(two, SimdAdd(xz, wy));
+		r[2][1] = SimdMul(two, SimdSub(yz, wx));
+		r[2][2] = SimdSub(one, SimdMul(two, SimdAdd(xx, yy)));
+
+		// T * R * S: column c of the rotation scaled by the scale of axis c
+		const SimdFloat scale[3] = { sx, sy, sz };
+		const SimdFloat position[3] = { tx, ty, tz };
+		alignas(32) float transform[4][3][SimdLanes];
+		for (uint32_t column = 0; column < 3; column++)
+		{
+			for (uint32_t row = 0; row < 3; row++)
+				SimdStore(transform[column][row], SimdMul(r[column][row], scale[column]));
+		}
+		for (uint32_t row = 0; row < 3; row++)
+			SimdStore(transform[3][row], position[row]);
+
+		// (T * R * S)^-1 = S^-1 * R^T * T^-1: row i of the linear part is column i of the rotation divided by the scale of axis i
+		const SimdFloat inverseScale[3] = { SimdDiv(one, sx), SimdDiv(one, sy), SimdDiv(one, sz) };
+		SimdFloat inverse[3][3];
+		for (uint32_t column = 0; column < 3; column++)
+		{
+			for (uint32_t row = 0; row < 3; row++)
+				inverse[column][row] = SimdMul(r[row][column], inverseScale[row]);
+		}
+
+		alignas(32) float inverseTransform[4][3][SimdLanes];
+		for (uint32_t row = 0; row < 3; row++)
+		{
+			for (uint32_t column = 0; column < 3; column++)
+				SimdStore(inverseTransform[column][row], inverse[column][row]);
+
+			SimdFloat translation = SimdAdd(SimdAdd(SimdMul(inverse[0][row], tx), SimdMul(inverse[1][row], ty)), SimdMul(inverse[2][row], tz));
+			SimdStore(inverseTransform[3][row], SimdSub(SimdSet(0.0f), translation));
+		}
+
+		for (uint32_t lane = 0; lane < SimdLanes; lane++)
+		{
+			glm::mat4& matrix = m_LocalTransforms[first + lane];
+			glm::mat4& inverseMatrix = m_LocalInverseTransforms[first + lane];
+			for (uint32_t column = 0; column < 4; column++)
+			{
+				matrix[column] = glm::vec4(transform[column][0][lane], transform[column][1][lane], transform[column][2][lane], column == 3 ? 1.0f : 0.0f);
+				inverseMatrix[column] = glm::vec4(inverseTransform[column][0][lane], inverseTransform[column][1][lane], inverseTransform[column][2][lane], column == 3 ? 1.0f : 0.0f);
+			}
+		}
+	}
+
+	void TransformSystem::Reserve(uint32_t count)
+	{
+		uint32_t size = (count + 63) / 64 * 64; // Whole dirty words, which are also whole batches
+		if (size <= m_PositionX.size())
+			return;
+
+		for (std::vector<float>* channel : { &m_PositionX, &m_PositionY, &m_PositionZ, &m_RotationX, &m_RotationY, &m_RotationZ })
+			channel->resize(size, 0.0f);
+		for (std::vector<float>* channel : { &m_RotationW, &m_ScaleX, &m_ScaleY, &m_ScaleZ })
+			channel->resize(size, 1.0f);
+
+		m_EulerAngles.resize(size, glm::vec3(0.0f));
+		for (std::vector<glm::mat4>* matrices : { &m_LocalTransforms, &m_LocalInverseTransforms, &m_Transforms, &m_InverseTransforms })
+			matrices->resize(size, glm::mat4(1.0f));
+		for (std::vector<uint32_t>* links : { &m_IndexToHandle, &m_ParentHandles, &m_ParentIndices })
+			links->resize(size, TransformHandle::InvalidID);
+		m_ChildCounts.resize(size, 0);
+		m_WorldChanged.resize(size, 0);
+		m_Dirty.resize(size / 64, 0);
+	}
+
+	void TransformSystem::RebuildOrder()
+	{
+		FR_PROFILE_FUNCTION();
+
+		// The depth of every transform. Parents can be anywhere in the current order, so chains are walked up and filled in on the way back down
+		std::vector<uint32_t> depths(m_Count, TransformHandle::InvalidID);
+		std::vector<uint32_t> chain;
+		uint32_t maxDepth = 0;
+		for (uint32_t i = 0; i < m_Count; i++)
+		{
+			uint32_t current = i;
+			while (depths[current] == TransformHandle::InvalidID && m_ParentHandles[current] != TransformHandle::InvalidID)
+			{
+				chain.push_back(current);
+				current = m_HandleToIndex[m_ParentHandles[current]];
+			}
+			if (depths[current] == TransformHandle::InvalidID)
+				depths[current] = 0;
+
+			uint32_t depth = depths[current];
+			while (!chain.empty())
+			{
+				depths[chain.back()] = ++depth;
+				chain.pop_back();
+			}
+			maxDepth = std::max(maxDepth, depths[i]);
+		}
+
+		// Counting sort by depth. It is stable, so siblings keep their relative order
+		m_LevelStarts.assign(maxDepth + 2, 0);
+		for (uint32_t i = 0; i < m_Count; i++)
+			m_LevelStarts[depths[i] + 1]++;
+		for (uint32_t level = 1; level < m_LevelStarts.size(); level++)
+			m_LevelStarts[level] += m_LevelStarts[level - 1];
+
+		std::vector<uint32_t> order(m_Count);
+		std::vector<uint32_t> next(m_LevelStarts.begin(), m_LevelStarts.end() - 1);
+		for (uint32_t i = 0; i < m_Count; i++)
+			order[next[depths[i]]++] = i;
+
+		auto permute = [&](auto& array)
+		{
+			auto previous = array;
+			for (uint32_t i = 0; i < m_Count; i++)
+				array[i] = previous[order[i]];
+		};
+		for (std::vector<float>* channel : { &m_PositionX, &m_PositionY, &m_PositionZ, &m_RotationX, &m_RotationY, &m_RotationZ, &m_RotationW, &m_ScaleX, &m_ScaleY, &m_ScaleZ })
+			permute(*channel);
+		for (std::vector<glm::mat4>* matrices : { &m_LocalTransforms, &m_LocalInverseTransforms, &m_Transforms, &m_InverseTransforms })
+			permute(*matrices);
+		for (std::vector<uint32_t>* links : { &m_IndexToHandle, &m_ParentHandles, &m_ChildCounts })
+			permute(*links);
+		permute(m_EulerAngles);
+
+		std::vector<uint64_t> dirty(m_Dirty.size(), 0);
+		for (uint32_t i = 0; i < m_Count; i++)
+		{
+			if (IsDirty(order[i]))
+				dirty[i / 64] |= 1ull << (i % 64);
+		}
+		m_Dirty.swap(dirty);
+
+		for (uint32_t i = 0; i < m_Count; i++)
+		{
+			m_HandleToIndex[m_IndexToHandle[i]] = i;
+			m_ParentIndices[i] = TransformHandle::InvalidID;
+		}
+		for (uint32_t i = 0; i < m_Count; i++)
+		{
+			if (m_ParentHandles[i] != TransformHandle::InvalidID)
+				m_ParentIndices[i] = m_HandleToIndex[m_ParentHandles[i]];
+		}
+
+		m_OrderDirty = false;
+	}
+
+	uint32_t TransformSystem::GetIndex(TransformHandle handle) const
+	{
+		FR_CORE_ASSERT(IsValid(handle), "Invalid transform handle");
+		return m_HandleToIndex[handle.ID];
+	}
+
+}
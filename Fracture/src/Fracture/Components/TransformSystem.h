@@ -0,0 +1,201 @@
+#pragma once
+/*!
+* @file TransformSystem.h
+* @brief Contains the TransformSystem class that stores transform hierarchies in structure of arrays form and composes their matrices in SIMD batches.
+*
+* @details Usage:
+*
+* Fracture::TransformSystem transforms;
+* Fracture::TransformHandle ship = transforms.Create(glm::vec3(1.0f, 0.0f, 0.0f));
+* Fracture::TransformHandle turret = transforms.Create(glm::vec3(0.0f, 0.2f, 0.0f));
+* transforms.SetParent(turret, ship); // The position of the turret is now relative to the ship
+* transforms.Rotate(ship, glm::vec3(0.0f, 0.0f, 0.1f));
+*
+* transforms.Update(); // Recomposes the ship and, because its parent moved, the turret
+* Fracture::Renderer::Submit(vertexArray, shader, transforms.GetTransform(turret));
+*
+* The handle is a plain struct so it can be stored as a component of an entity in a World.
+*
+* @see TransformComponent, World
+*
+* @author Aditya Rajagopal
+*/
+
+#include <glm\glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Fracture {
+
+	/// A handle to a transform of a TransformSystem. Stays valid while transforms are created and destroyed around it.
+	struct TransformHandle
+	{
+		static constexpr uint32_t InvalidID = 0xFFFFFFFF; /// The id of a null handle.
+
+		uint32_t ID = InvalidID; /// The slot of the transform in the TransformSystem.
+
+		inline bool IsValid() const { return ID != InvalidID; }
+		inline bool operator==(const TransformHandle& other) const { return ID == other.ID; }
+		inline bool operator!=(const TransformHandle& other) const { return ID != other.ID; }
+	};
+
+	/*!
+	* @brief Stores positions, rotations and scales in separate float arrays and composes their local and world matrices, and the inverses, in batches.
+	*
+	* @details Each local matrix is written directly from the quaternion, scale and position (no intermediate translate, rotate and scale matrices are multiplied)
+	* and the inverse is computed analytically as S^-1 * R^T * T^-1 instead of with a generic 4x4 inverse. The batches are 8 wide with AVX, which the
+	* premake project enables, and 4 wide (SSE) otherwise. See Simd.h.
+	*
+	* Transforms can have a parent. The arrays are kept sorted by depth (breadth first), so every parent comes before its children and the world
+	* matrices are computed in a single linear pass. Setters only mark the transform in a dirty bitset; Update recomposes the local matrices of the
+	* batches that contain a dirty transform (skipping the rest 64 transforms at a time) and then the world matrices of the dirty transforms and of
+	* everything below them. Clean subtrees are not touched. Levels with many transforms are split across the JobSystem.
+	*
+	* Transforms are kept densely packed. Destroying a transform moves the last one into its place and changing the hierarchy reorders the arrays
+	* on the next Update, so handles go through an indirection table. The matrices returned by the getters are the ones of the last Update.
+	*/
+	class TransformSystem
+	{
+	public:
+		TransformSystem() = default;
+
+		/*!
+		* @brief Creates a transform.
+		*
+		* @param[in] const glm::vec3& position: The position of the transform.
+		* @param[in] const glm::vec3& rotation: The rotation of the transform as euler angles in radians.
+		* @param[in] const glm::vec3& scale: The scale of the transform.
+		*
+		* @return TransformHandle: The handle of the new transform.
+		*/
+		TransformHandle Create(const glm::vec3& position = glm::vec3(0.0f), const glm::vec3& rotation = glm::vec3(0.0f), const glm::vec3& scale = glm::vec3(1.0f));
+
+		/*!
+		* @brief Destroys a transform. The handle must not be used afterwards.
+		*/
+		void Destroy(TransformHandle handle);
+
+		/*!
+		* @brief Returns whether the handle refers to a transform that has not been destroyed.
+		*/
+		bool IsValid(TransformHandle handle) const;
+
+		/*!
+		* @brief Attaches a transform to a parent. Its position, rotation and scale become relative to the parent.
+		*
+		* @details Destroying the parent detaches its children, which keep their local position, rotation and scale.
+		*
+		* @param[in] TransformHandle child: The transform to attach.
+		* @param[in] TransformHandle parent: The new parent, or an invalid handle to detach the transform.
+		*/
+		void SetParent(TransformHandle child, TransformHandle parent);
+
+		/*!
+		* @brief Returns the parent of a transform, or an invalid handle if it has none.
+		*/
+		TransformHandle GetParent(TransformHandle handle) const;
+
+		void SetPosition(TransformHandle handle, const glm::vec3& position);
+		void SetRotation(TransformHandle handle, const glm::vec3& rotation);
+		void SetScale(TransformHandle handle, const glm::vec3& scale);
+		void Translate(TransformHandle handle, const glm::vec3& translation);
+		void Rotate(TransformHandle handle, const glm::vec3& rotation);
+
+		glm::vec3 GetPosition(TransformHandle handle) const;
+		glm::vec3 GetRotation(TransformHandle handle) const;
+		glm::vec3 GetScale(TransformHandle handle) const;
+
+		/*!
+		* @brief Recomposes the local matrices of every batch that contains a transform changed since the last update and the world matrices of the changed subtrees.
+		*/
+		void Update();
+
+		/*!
+		* @brief Returns the world transform matrix computed by the last Update.
+		*/
+		const glm::mat4& GetTransform(TransformHandle handle) const;
+
+		/*!
+		* @brief Returns the inverse world transform matrix computed by the last Update.
+		*/
+		const glm::mat4& GetTransformInverse(TransformHandle handle) const;
+
+		/*!
+		* @brief Returns the transform matrix relative to the parent computed by the last Update.
+		*/
+		const glm::mat4& GetLocalTransform(TransformHandle handle) const;
+
+		/*!
+		* @brief Returns the number of transforms.
+		*/
+		inline uint32_t GetCount() const { return m_Count; }
+
+		/*!
+		* @brief Returns the number of local matrices the last Update composed, including the clean transforms that share a batch with a dirty one.
+		*/
+		inline uint32_t GetLastUpdateCount() const { return m_LastUpdateCount; }
+
+		/*!
+		* @brief Returns the number of world matrices the last Update recomputed.
+		*/
+		inline uint32_t GetLastWorldUpdateCount() const { return m_LastWorldUpdateCount; }
+
+		/*!
+		* @brief Returns the number of levels of the hierarchy. 1 when no transform has a parent.
+		*/
+		inline uint32_t GetDepth() const { return m_LevelStarts.empty() ? 0 : (uint32_t)m_LevelStarts.size() - 1; }
+	private:
+		/*!
+		* @brief Grows the arrays so they hold count transforms, rounded up to a whole batch. New slots hold the identity transform.
+		*/
+		void Reserve(uint32_t count);
+
+		/*!
+		* @brief Returns the dense index of a handle.
+		*/
+		uint32_t GetIndex(TransformHandle handle) const;
+
+		inline void MarkDirty(uint32_t index) { m_Dirty[index / 64] |= 1ull << (index % 64); }
+
+		inline bool IsDirty(uint32_t index) const { return (m_Dirty[index / 64] >> (index % 64)) & 1; }
+
+		/*!
+		* @brief Composes the local matrices of the batch starting at the dense index first.
+		*/
+		void ComposeBatch(uint32_t first);
+
+		/*!
+		* @brief Sorts the arrays by depth after the hierarchy changed and recomputes the parent indices and the level ranges.
+		*/
+		void RebuildOrder();
+	private:
+		// Structure of arrays: one float array per channel so a batch is loaded with one vector load per channel
+		std::vector<float> m_PositionX, m_PositionY, m_PositionZ;
+		std::vector<float> m_RotationX, m_RotationY, m_RotationZ, m_RotationW; /// The rotation as a quaternion
+		std::vector<float> m_ScaleX, m_ScaleY, m_ScaleZ;
+
+		std::vector<glm::vec3> m_EulerAngles; /// The rotation as set by the user, returned by GetRotation. Only touched by the setters.
+		std::vector<glm::mat4> m_LocalTransforms; /// The composed matrices relative to the parent.
+		std::vector<glm::mat4> m_LocalInverseTransforms; /// The inverses of the local matrices.
+		std::vector<glm::mat4> m_Transforms; /// The world matrices.
+		std::vector<glm::mat4> m_InverseTransforms; /// The inverses of the world matrices.
+		std::vector<uint64_t> m_Dirty; /// One bit per dense index, set when the transform changed since the last update.
+		std::vector<uint8_t> m_WorldChanged; /// Set during Update for every transform whose world matrix was recomputed. Bytes so a level can be split across threads.
+
+		std::vector<uint32_t> m_ParentHandles; /// The handle id of the parent of every dense index, InvalidID for roots.
+		std::vector<uint32_t> m_ParentIndices; /// The dense index of the parent of every dense index. Only valid while the order is clean.
+		std::vector<uint32_t> m_ChildCounts; /// The number of children of every dense index.
+		std::vector<uint32_t> m_LevelStarts; /// The first dense index of every depth, followed by the count.
+		bool m_OrderDirty = false; /// Set when the hierarchy changed and the arrays have to be sorted by depth again.
+
+		std::vector<uint32_t> m_HandleToIndex; /// Maps a handle id to its dense index. InvalidID for destroyed handles.
+		std::vector<uint32_t> m_IndexToHandle; /// Maps a dense index to its handle id.
+		std::vector<uint32_t> m_FreeHandles; /// The handle ids of destroyed transforms.
+
+		uint32_t m_Count = 0; /// The number of transforms.
+		uint32_t m_LastUpdateCount = 0; /// The number of local matrices composed by the last Update.
+		uint32_t m_LastWorldUpdateCount = 0; /// The number of world matrices recomputed by the last Update.
+	};
+
+}
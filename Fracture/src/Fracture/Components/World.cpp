@@ -0,0 +1,157 @@
+#include "frpch.h"
+#include "World.h"
+
+namespace Fracture {
+
+	World::World()
+	{
+		m_EmptyArchetype = GetOrCreateArchetype(ComponentMask());
+	}
+
+	World::~World()
+	{
+		// The archetypes destroy the components that are still alive
+		m_Queries.clear();
+		m_Archetypes.clear();
+		m_ArchetypeMap.clear();
+	}
+
+	Entity World::CreateEntity()
+	{
+		Entity entity = AllocateEntity();
+		EntityRecord& record = m_Records[entity.GetIndex()];
+		record.Owner = m_EmptyArchetype;
+		m_EmptyArchetype->AllocateRow(entity, record.Chunk, record.Row);
+		return entity;
+	}
+
+	void World::DestroyEntity(Entity entity)
+	{
+		FR_CORE_ASSERT(IsAlive(entity), "Entity is not alive");
+		EntityRecord& record = m_Records[entity.GetIndex()];
+
+		Entity moved = record.Owner->RemoveRow(record.Chunk, record.Row, true);
+		if (moved.IsValid())
+		{
+			m_Records[moved.GetIndex()].Chunk = record.Chunk;
+			m_Records[moved.GetIndex()].Row = record.Row;
+		}
+
+		record.Owner = nullptr;
+		record.Generation++;
+		m_FreeIndices.push_back(entity.GetIndex());
+		m_EntityCount--;
+	}
+
+	bool World::IsAlive(Entity entity) const
+	{
+		uint32_t index = entity.GetIndex();
+		return entity.IsValid() && index < m_Records.size() && m_Records[index].Owner && m_Records[index].Generation == entity.GetGeneration();
+	}
+
+	Entity World::AllocateEntity()
+	{
+		m_EntityCount++;
+		if (!m_FreeIndices.empty())
+		{
+			uint32_t index = m_FreeIndices.back();
+			m_FreeIndices.pop_back();
+			return Entity(index, m_Records[index].Generation);
+		}
+
+		FR_CORE_ASSERT(m_Records.size() <= Entity::MaxIndex, "Too many entities");
+		m_Records.emplace_back();
+		return Entity((uint32_t)m_Records.size() - 1, 0);
+	}
+
+	Archetype* World::GetOrCreateArchetype(const ComponentMask& mask)
+	{
+		auto it = m_ArchetypeMap.find(mask);
+		if (it != m_ArchetypeMap.end())
+			return it->second.get();
+
+		Archetype* archetype = m_ArchetypeMap.emplace(mask, CreateScope<Archetype>(mask)).first->second.get();
+		m_Archetypes.push_back(archetype);
+
+		for (auto& [queryMask, query] : m_Queries)
+		{
+			if ((mask & queryMask) == queryMask)
+				query->Archetypes.push_back(archetype);
+		}
+		return archetype;
+	}
+
+	Archetype* World::GetAddTarget(Archetype* archetype, ComponentID id)
+	{
+		if (!archetype->AddEdges[id])
+		{
+			ComponentMask mask = archetype->GetMask();
+			mask.set(id);
+			Archetype* target = GetOrCreateArchetype(mask);
+			archetype->AddEdges[id] = target;
+			target->RemoveEdges[id] = archetype;
+		}
+		return archetype->AddEdges[id];
+	}
+
+	Archetype* World::GetRemoveTarget(Archetype* archetype, ComponentID id)
+	{
+		if (!archetype->RemoveEdges[id])
+		{
+			ComponentMask mask = archetype->GetMask();
+			mask.reset(id);
+			Archetype* target = GetOrCreateArchetype(mask);
+			archetype->RemoveEdges[id] = target;
+			target->AddEdges[id] = archetype;
+		}
+		return archetype->RemoveEdges[id];
+	}
+
+	void World::MoveEntity(Entity entity, Archetype* target)
+	{
+		EntityRecord& record = m_Records[entity.GetIndex()];
+		Archetype* source = record.Owner;
+
+		uint32_t chunk, row;
+		target->AllocateRow(entity, chunk, row);
+
+		for (ComponentID id : source->GetComponents())
+		{
+			const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+			void* component = source->GetComponent(record.Chunk, source->GetColumnIndex(id), record.Row);
+			int16_t targetColumn = target->GetColumnIndex(id);
+			if (targetColumn != Archetype::InvalidColumn)
+				info.MoveConstruct(target->GetComponent(chunk, targetColumn, row), component);
+			info.Destruct(component);
+		}
+
+		// The components of the old row have been moved out or destroyed above
+		Entity moved = source->RemoveRow(record.Chunk, record.Row, false);
+		if (moved.IsValid())
+		{
+			m_Records[moved.GetIndex()].Chunk = record.Chunk;
+			m_Records[moved.GetIndex()].Row = record.Row;
+		}
+
+		record.Owner = target;
+		record.Chunk = chunk;
+		record.Row = row;
+	}
+
+	QueryCache* World::GetQueryCache(const ComponentMask& mask)
+	{
+		auto it = m_Queries.find(mask);
+		if (it != m_Queries.end())
+			return it->second.get();
+
+		Scope<QueryCache> query = CreateScope<QueryCache>();
+		query->Mask = mask;
+		for (Archetype* archetype : m_Archetypes)
+		{
+			if ((archetype->GetMask() & mask) == mask)
+				query->Archetypes.push_back(archetype);
+		}
+		return m_Queries.emplace(mask, std::move(query)).first->second.get();
+	}
+
+}
@@ -0,0 +1,338 @@
+#pragma once
+/*!
+* @file World.h
+* @brief Contains the World class that owns the entities and their components, and the Query class systems use to iterate them.
+*
+* @details The World is an archetype based entity component system. Entities with the same set of components share an Archetype and their components
+* are stored in contiguous arrays, so a system walks memory linearly instead of chasing a pointer per object.
+*
+* Usage:
+*
+* Fracture::World world;
+* Fracture::Entity entity = world.CreateEntity(Fracture::TransformComponent(), Velocity{ 1.0f, 0.0f });
+* world.AddComponent<Health>(entity, 100.0f);
+*
+* world.GetQuery<Fracture::TransformComponent, const Velocity>().Each([&](Fracture::Entity entity, Fracture::TransformComponent& transform, const Velocity& velocity)
+* {
+*     transform.Translate(glm::vec3(velocity.X, velocity.Y, 0.0f) * dt);
+* });
+*
+* Adding or removing components and creating or destroying entities moves rows between chunks, so it must not be done while a query is iterating.
+*
+* @see Archetype
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Core\JobSystem.h"
+#include "Fracture\Components\Archetype.h"
+
+#include <unordered_map>
+
+namespace Fracture {
+
+	/// The archetypes that match a query. Kept up to date by the World as new archetypes are created.
+	struct QueryCache
+	{
+		ComponentMask Mask; /// The components the query asks for.
+		std::vector<Archetype*> Archetypes; /// The archetypes that have all of them, in the order they were created.
+	};
+
+	/*!
+	* @brief A cached view of every entity that has the components Ts.
+	*
+	* @details A query is a cheap handle to a QueryCache owned by the World. The list of matching archetypes is built once and extended when new archetypes
+	* are created, so getting a query every frame does not rescan the archetypes. Component types can be const qualified to document that the system only reads them.
+	*/
+	template<typename... Ts>
+	class Query
+	{
+		static_assert(sizeof...(Ts) > 0, "A query needs at least one component type");
+	public:
+		Query(QueryCache* cache) : m_Cache(cache) {}
+
+		/*!
+		* @brief Calls fn(uint32_t count, const Entity* entities, Ts*... components) once per chunk with the arrays of the chunk.
+		*
+		* @details This is the fastest way to iterate: the loop over the arrays is in the caller, so the compiler can vectorise it.
+		*/
+		template<typename Fn>
+		void EachChunk(Fn&& fn) const
+		{
+			for (Archetype* archetype : m_Cache->Archetypes)
+			{
+				for (uint32_t chunkIndex = 0; chunkIndex < archetype->GetChunkCount(); chunkIndex++)
+					CallChunk(archetype, chunkIndex, fn, std::index_sequence_for<Ts...>());
+			}
+		}
+
+		/*!
+		* @brief Calls fn(Entity entity, Ts&... components) for every entity of the query.
+		*/
+		template<typename Fn>
+		void Each(Fn&& fn) const
+		{
+			EachChunk([&fn](uint32_t count, const Entity* entities, Ts*... components)
+			{
+				for (uint32_t i = 0; i < count; i++)
+					fn(entities[i], components[i]...);
+			});
+		}
+
+		/*!
+		* @brief Same as EachChunk but the chunks are split across the threads of the JobSystem. fn must be safe to call from several threads at once.
+		*
+		* @param[in] Fn&& fn: The function called for every chunk.
+		* @param[in] uint32_t chunksPerBatch: The number of chunks handed to a thread at a time.
+		*/
+		template<typename Fn>
+		void ParallelEachChunk(Fn&& fn, uint32_t chunksPerBatch = 1) const
+		{
+			struct ChunkRef
+			{
+				Archetype* Owner;
+				uint32_t ChunkIndex;
+			};
+
+			std::vector<ChunkRef> chunks;
+			for (Archetype* archetype : m_Cache->Archetypes)
+			{
+				for (uint32_t chunkIndex = 0; chunkIndex < archetype->GetChunkCount(); chunkIndex++)
+					chunks.push_back({ archetype, chunkIndex });
+			}
+
+			JobSystem::ParallelFor((uint32_t)chunks.size(), chunksPerBatch, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+					CallChunk(chunks[i].Owner, chunks[i].ChunkIndex, fn, std::index_sequence_for<Ts...>());
+			});
+		}
+
+		/*!
+		* @brief Same as Each but the chunks are split across the threads of the JobSystem. fn must be safe to call from several threads at once.
+		*
+		* @param[in] Fn&& fn: The function called for every entity.
+		* @param[in] uint32_t chunksPerBatch: The number of chunks handed to a thread at a time.
+		*/
+		template<typename Fn>
+		void ParallelEach(Fn&& fn, uint32_t chunksPerBatch = 1) const
+		{
+			ParallelEachChunk([&fn](uint32_t count, const Entity* entities, Ts*... components)
+			{
+				for (uint32_t i = 0; i < count; i++)
+					fn(entities[i], components[i]...);
+			}, chunksPerBatch);
+		}
+
+		/*!
+		* @brief Returns the number of entities that match the query.
+		*/
+		uint32_t GetEntityCount() const
+		{
+			uint32_t count = 0;
+			for (Archetype* archetype : m_Cache->Archetypes)
+				count += archetype->GetEntityCount();
+			return count;
+		}
+
+		/*!
+		* @brief Returns the number of chunks that match the query.
+		*/
+		uint32_t GetChunkCount() const
+		{
+			uint32_t count = 0;
+			for (Archetype* archetype : m_Cache->Archetypes)
+				count += archetype->GetChunkCount();
+			return count;
+		}
+	private:
+		template<typename Fn, size_t... Is>
+		static void CallChunk(Archetype* archetype, uint32_t chunkIndex, Fn& fn, std::index_sequence<Is...>)
+		{
+			const int16_t columns[] = { archetype->GetColumnIndex(ComponentRegistry::GetID<Ts>())... };
+			fn(archetype->GetChunks()[chunkIndex].Count, archetype->GetEntities(chunkIndex), static_cast<Ts*>(archetype->GetColumn(chunkIndex, columns[Is]))...);
+		}
+	private:
+		QueryCache* m_Cache; /// The archetypes of the query. Owned by the World.
+	};
+
+	/*!
+	* @brief Owns a set of entities and their components.
+	*
+	* @details Entities are created in the archetype of their components. Adding or removing a component moves the entity to the archetype of its new set of
+	* components; the archetype graph edges make that a pointer lookup after the first time. Entity handles are generation checked so using a handle
+	* of a destroyed entity asserts instead of touching the entity that reused its index.
+	*/
+	class FRACTURE_API World
+	{
+	public:
+		World();
+		~World();
+
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+
+		/*!
+		* @brief Creates an entity without components.
+		*/
+		Entity CreateEntity();
+
+		/*!
+		* @brief Creates an entity directly in the archetype of the given components, without moving it once per component.
+		*
+		* @param[in] Ts&&... components: The components of the entity. Every type can only be given once.
+		*/
+		template<typename... Ts>
+		Entity CreateEntity(Ts&&... components)
+		{
+			ComponentMask mask = ComponentRegistry::GetMask<std::decay_t<Ts>...>();
+			FR_CORE_ASSERT(mask.count() == sizeof...(Ts), "A component type was given more than once");
+
+			Archetype* archetype = GetOrCreateArchetype(mask);
+			Entity entity = AllocateEntity();
+			EntityRecord& record = m_Records[entity.GetIndex()];
+			record.Owner = archetype;
+			archetype->AllocateRow(entity, record.Chunk, record.Row);
+
+			(new (archetype->GetComponent(record.Chunk, archetype->GetColumnIndex(ComponentRegistry::GetID<Ts>()), record.Row)) std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+			return entity;
+		}
+
+		/*!
+		* @brief Destroys an entity and its components.
+		*/
+		void DestroyEntity(Entity entity);
+
+		/*!
+		* @brief Returns whether the handle refers to an entity that has not been destroyed.
+		*/
+		bool IsAlive(Entity entity) const;
+
+		/*!
+		* @brief Adds a component to an entity, moving it to the archetype with the component.
+		*
+		* @param[in] Entity entity: The entity. It must not already have a T.
+		* @param[in] Args&&... args: The arguments passed to the constructor of T.
+		*
+		* @return T&: The new component. Only valid until the next structural change of the World.
+		*/
+		template<typename T, typename... Args>
+		T& AddComponent(Entity entity, Args&&... args)
+		{
+			FR_CORE_ASSERT(IsAlive(entity), "Entity is not alive");
+			ComponentID id = ComponentRegistry::GetID<T>();
+			EntityRecord& record = m_Records[entity.GetIndex()];
+			FR_CORE_ASSERT(!record.Owner->GetMask().test(id), "Entity already has the component");
+
+			MoveEntity(entity, GetAddTarget(record.Owner, id));
+			void* component = record.Owner->GetComponent(record.Chunk, record.Owner->GetColumnIndex(id), record.Row);
+			return *new (component) T(std::forward<Args>(args)...);
+		}
+
+		/*!
+		* @brief Removes a component from an entity, moving it to the archetype without the component.
+		*/
+		template<typename T>
+		void RemoveComponent(Entity entity)
+		{
+			FR_CORE_ASSERT(IsAlive(entity), "Entity is not alive");
+			ComponentID id = ComponentRegistry::GetID<T>();
+			EntityRecord& record = m_Records[entity.GetIndex()];
+			FR_CORE_ASSERT(record.Owner->GetMask().test(id), "Entity does not have the component");
+
+			MoveEntity(entity, GetRemoveTarget(record.Owner, id));
+		}
+
+		/*!
+		* @brief Returns whether an entity has a component.
+		*/
+		template<typename T>
+		bool HasComponent(Entity entity) const
+		{
+			FR_CORE_ASSERT(IsAlive(entity), "Entity is not alive");
+			return m_Records[entity.GetIndex()].Owner->GetMask().test(ComponentRegistry::GetID<T>());
+		}
+
+		/*!
+		* @brief Returns a component of an entity, or nullptr if the entity does not have it. Only valid until the next structural change of the World.
+		*/
+		template<typename T>
+		T* TryGetComponent(Entity entity)
+		{
+			FR_CORE_ASSERT(IsAlive(entity), "Entity is not alive");
+			const EntityRecord& record = m_Records[entity.GetIndex()];
+			int16_t column = record.Owner->GetColumnIndex(ComponentRegistry::GetID<T>());
+			if (column == Archetype::InvalidColumn)
+				return nullptr;
+			return static_cast<T*>(record.Owner->GetComponent(record.Chunk, column, record.Row));
+		}
+
+		/*!
+		* @brief Returns a component of an entity. The entity must have it. Only valid until the next structural change of the World.
+		*/
+		template<typename T>
+		T& GetComponent(Entity entity)
+		{
+			T* component = TryGetComponent<T>(entity);
+			FR_CORE_ASSERT(component, "Entity does not have the component");
+			return *component;
+		}
+
+		/*!
+		* @brief Returns the query of the entities that have all the components Ts. The matching archetypes are cached the first time a set of components is queried.
+		*/
+		template<typename... Ts>
+		Query<Ts...> GetQuery()
+		{
+			return Query<Ts...>(GetQueryCache(ComponentRegistry::GetMask<Ts...>()));
+		}
+
+		/*!
+		* @brief Returns the number of entities alive.
+		*/
+		inline uint32_t GetEntityCount() const { return m_EntityCount; }
+
+		/*!
+		* @brief Returns the number of archetypes created so far.
+		*/
+		inline uint32_t GetArchetypeCount() const { return (uint32_t)m_Archetypes.size(); }
+	private:
+		/// Where the components of an entity are stored.
+		struct EntityRecord
+		{
+			Archetype* Owner = nullptr; /// The archetype of the entity. nullptr if the index is free.
+			uint32_t Chunk = 0; /// The chunk of the entity in the archetype.
+			uint32_t Row = 0; /// The row of the entity in the chunk.
+			uint8_t Generation = 0; /// The generation of the index. Incremented when the entity is destroyed.
+		};
+
+		/*!
+		* @brief Returns a handle with a free index, reusing the indices of destroyed entities first.
+		*/
+		Entity AllocateEntity();
+
+		Archetype* GetOrCreateArchetype(const ComponentMask& mask);
+		Archetype* GetAddTarget(Archetype* archetype, ComponentID id);
+		Archetype* GetRemoveTarget(Archetype* archetype, ComponentID id);
+
+		/*!
+		* @brief Moves an entity to another archetype. Components both archetypes have are moved, components the target does not have are destroyed
+		* and components only the target has are left uninitialised for the caller to construct.
+		*/
+		void MoveEntity(Entity entity, Archetype* target);
+
+		QueryCache* GetQueryCache(const ComponentMask& mask);
+	private:
+		std::vector<EntityRecord> m_Records; /// The record of every entity index.
+		std::vector<uint32_t> m_FreeIndices; /// The indices of destroyed entities.
+		uint32_t m_EntityCount = 0; /// The number of entities alive.
+
+		std::unordered_map<ComponentMask, Scope<Archetype>> m_ArchetypeMap; /// Owns the archetypes.
+		std::vector<Archetype*> m_Archetypes; /// The archetypes in the order they were created.
+		Archetype* m_EmptyArchetype = nullptr; /// The archetype of entities without components.
+
+		std::unordered_map<ComponentMask, Scope<QueryCache>> m_Queries; /// The cached queries.
+	};
+
+}
@@ -9,22 +9,93 @@
 #include "Fracture\Input\Input.h"
 #include "Fracture\Input\KeyCodes.h"
 
+#include "Fracture\Utils\FrameStats.h"
+
 
 namespace Fracture {
 
 	Application* Application::s_Instance = nullptr; /// this is a static pointer to the application class.
+	std::vector<std::string> Application::s_CommandLineArgs;
+
+	void Application::SetCommandLineArgs(int argc, char** argv)
+	{
+		s_CommandLineArgs.assign(argv + 1, argv + argc);
+	}
 
 	Application::Application()
 	{
 		FR_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
-		m_Window = Scope<Window>(Window::Create()); // we cant use make_unique because we want to use the Create function
-		m_Window->SetEventCallback(FRACTURE_BIND_EVENT_FN(Application::OnEvent));
+
+		std::string recordPath, replayPath;
+		float replayTimestep = 0.0f;
+		for (size_t i = 0; i < s_CommandLineArgs.size(); i++)
+		{
+			const std::string& arg = s_CommandLineArgs[i];
+			bool hasValue = i + 1 < s_CommandLineArgs.size();
+			if (arg == "--headless")
+				m_Headless = true;
+			else if (arg == "--record" && hasValue)
+				recordPath = s_CommandLineArgs[++i];
+			else if (arg == "--replay" && hasValue)
+				replayPath = s_CommandLineArgs[++i];
+			else if (arg == "--timestep" && hasValue)
+				replayTimestep = std::strtof(s_CommandLineArgs[++i].c_str(), nullptr); // 0 when it is not a number, which keeps the recorded delta times
+			else
+				FR_CORE_WARN("Unknown command line argument {0}", arg);
+		}
+
+		if (m_Headless && replayPath.empty())
+			FR_CORE_WARN("--headless without --replay runs with a hidden window until the process is stopped");
+
+		WindowProperties properties;
+		properties.Visible = !m_Headless;
+		m_Window = Scope<Window>(Window::Create(properties)); // we cant use make_unique because we want to use the Create function
+		m_Window->SetEventQueue(&m_EventQueue);
+		m_ApplicationEventHandlers.Subscribe<&Application::OnWindowClose>(this);
+		m_ApplicationEventHandlers.Subscribe<&Application::OnWindowResize>(this);
+		m_ApplicationEventHandlers.Subscribe<&Application::OnKeyPressed>(this);
 		m_Window->SetVSync(false);
 		Renderer::Init();
 
+#ifdef FR_ENABLE_IMGUI
 		m_ImGuiLayer = new ImGuiLayer();
 		PushOverlay(m_ImGuiLayer);
+
+		m_PerformanceLayer = new PerformanceLayer();
+		PushOverlay(m_PerformanceLayer);
+#endif
+
+		if (!recordPath.empty())
+			StartInputRecording(recordPath);
+		if (!replayPath.empty())
+			StartInputReplay(replayPath, replayTimestep);
+	}
+
+	void Application::StartInputRecording(const std::string& path)
+	{
+		m_InputRecorder = CreateScope<InputRecorder>(path);
+		if (!m_InputRecorder->IsOpen())
+			m_InputRecorder.reset();
+	}
+
+	void Application::StopInputRecording()
+	{
+		m_InputRecorder.reset();
+	}
+
+	void Application::StartInputReplay(const std::string& path, float fixedTimestep)
+	{
+		m_InputPlayer = CreateScope<InputPlayer>(path);
+		if (!m_InputPlayer->IsOpen())
+		{
+			m_InputPlayer.reset();
+			if (m_Headless)
+				m_Running = false; // Nothing to run without a replay
+			return;
+		}
+		m_ReplayTimestep = fixedTimestep;
+		StopInputRecording();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -57,28 +128,127 @@ namespace Fracture {
 		return false;
 	}
 
-	void Application::OnEvent(Event& event)
+	bool Application::OnKeyPressed(KeyPressedEvent& e)
+	{
+		if (e.GetKeyCode() != FR_KEY_F1 || e.IsRepeated() || !m_ImGuiLayer)
+			return false;
+
+		m_ImGuiLayer->SetEnabled(!m_ImGuiLayer->IsEnabled());
+		return true;
+	}
+
+	void Application::UpdateEventHandlers()
+	{
+		m_LayerStack.Refresh();
+		if (m_EventHandlersGeneration == m_LayerStack.GetGeneration())
+			return;
+
+		m_EventHandlers.Clear();
+		m_EventHandlers.Add(m_ApplicationEventHandlers);
+		for (const LayerStack::Entry& entry : m_LayerStack.GetEventLayers())
+		{
+			m_EventHandlers.Add(entry.Target->GetEventHandlers(), entry.StatsIndex); // Top to bottom. A handler that returns true blocks the layers below it
+		}
+		m_EventHandlersGeneration = m_LayerStack.GetGeneration();
+	}
+
+	void Application::DispatchEvents(Utils::Timestep& deltaTime)
 	{
-		EventDispatcher dispatcher(event);
-		dispatcher.Dispatch<WindowCloseEvent>(FRACTURE_BIND_EVENT_FN(Application::OnWindowClose));
-		dispatcher.Dispatch<WindowResizeEvent>(FRACTURE_BIND_EVENT_FN(Application::OnWindowResize));
+		FR_PROFILE_FUNCTION();
+		FR_MEMORY_TAG(Events);
+		UpdateEventHandlers();
+		Input::BeginFrame();
 
-		for (auto it = m_LayerStack.end(); it != m_LayerStack.begin();)
+		// The input snapshot and ImGui are updated first, so handlers see the state at their event. ImGui only gets its input from here, so replays drive the UI too
+		auto dispatch = [this](auto& e)
 		{
-			(*--it)->OnEvent(event); // here we do (*--it) because we want to call the OnEvent function of the layer and not the iterator. The -- is needed because the end iterator is not valid we need 1 before that.
-			if (event.Handled) // if the event is handled we break the loop because the layer that set handled=true is a blocking layer
+			Input::OnEvent(e);
+			if (m_ImGuiLayer)
+				m_ImGuiLayer->OnInputEvent(e);
+			m_EventHandlers.Dispatch(e);
+		};
+		if (m_InputPlayer)
+		{
+			// The live input would make the replay diverge, only closing the window still works
+			m_EventQueue.Drain([&](const QueuedEvent& queued)
+				{
+					if (queued.Type == EventType::WindowClose)
+						EventQueue::Visit(queued, dispatch);
+				});
+
+			if (m_InputPlayer->NextFrame(m_ReplayFrame))
 			{
-				break;
+				deltaTime = m_ReplayTimestep > 0.0f ? m_ReplayTimestep : m_ReplayFrame.DeltaTime;
+
+				// Pushed like live input so the raw mouse samples are rebuilt. The recording holds the events as they were dispatched, so nothing is merged again
+				EventCoalescing coalescing = m_EventQueue.GetCoalescing();
+				m_EventQueue.SetCoalescing({ false, false, false });
+				for (const QueuedEvent& queued : m_ReplayFrame.Events)
+					m_EventQueue.Push(queued);
+				m_EventQueue.SetCoalescing(coalescing);
+				m_EventQueue.Dispatch(dispatch);
+
+				// A replayed resize only reaches the renderer and the layers, so the window is resized to match, hidden or not. The resize event the
+				// window pushes for it is live input and dropped on the next frame
+				for (auto it = m_ReplayFrame.Events.rbegin(); it != m_ReplayFrame.Events.rend(); ++it)
+				{
+					if (it->Type == EventType::WindowResize && it->Resize.Width > 0 && it->Resize.Height > 0)
+					{
+						m_Window->SetSize(it->Resize.Width, it->Resize.Height);
+						break;
+					}
+				}
 			}
+			else
+			{
+				FR_CORE_INFO("Input replay finished after {0} frames", m_InputPlayer->GetFrameIndex());
+				m_InputPlayer.reset();
+				if (m_Headless)
+					m_Running = false;
+			}
+		}
+		else if (m_InputRecorder)
+		{
+			m_InputRecorder->BeginFrame(deltaTime);
+			m_EventQueue.Drain([&](const QueuedEvent& queued)
+				{
+					if (queued.Type != EventType::WindowClose) // The replay ends with the recording, not by closing the window
+						m_InputRecorder->Record(queued);
+					EventQueue::Visit(queued, dispatch);
+				});
+			m_InputRecorder->EndFrame();
+		}
+		else
+		{
+			m_EventQueue.Dispatch(dispatch);
+		}
+
+		m_PostedEvents.Drain([this](Event& e) { m_EventHandlers.Dispatch(e); });
+	}
+
+	void Application::OnEvent(Event& event)
+	{
+		// No refresh here: it may be called from a layer callback, while the frame loop still walks the lists of the layer stack
+		m_EventHandlers.Dispatch(event);
+	}
+
+	namespace {
+
+		/// Returns the milliseconds elapsed since start.
+		inline float MillisecondsSince(std::chrono::high_resolution_clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
 		}
+
 	}
 
 	void Application::Run()
 	{
-		FR_BEGIN_PROFILE_SESSION("Runtime", "../Logs/FractureProfile-Runtime.json");
+		FR_BEGIN_PROFILE_SESSION("Runtime", "../Logs/FractureProfile-Runtime.frtrace");
 		while (m_Running)
 		{
 			static uint32_t frameCount = 0;
+			FR_PROFILE_FRAME_BEGIN(frameCount);
 
 			auto m_StartTimepoint = std::chrono::high_resolution_clock::now();
 			long long startTime = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
@@ -90,9 +260,10 @@ namespace Fracture {
 				deltaTime = 0.0000001f;
 			}
 
-			std::string profile_name = "Fracture::Application::Run() Frame " + std::to_string(frameCount);
-			// TODO : The scops are not working correctly.
-			FR_PROFILE_SCOPE(profile_name.c_str());
+			FR_PROFILE_SCOPE_ARG("Application::Run::Frame", "frame", frameCount);
+
+			// Events raised by the window while it polled at the end of the last frame, then the events posted by other threads
+			DispatchEvents(deltaTime);
 
 			{ // Rendering
 				FR_PROFILE_SCOPE("Rendering");
@@ -103,36 +274,63 @@ namespace Fracture {
 				// Call the OnUpdate function of all the layers
 				if (!m_isMinimized)
 				{
-					for (Layer* layer : m_LayerStack)
+					auto updateStart = std::chrono::high_resolution_clock::now();
+					if (m_UpdateGraphGeneration != m_LayerStack.GetGeneration())
 					{
-						layer->OnUpdate(deltaTime);
+						m_UpdateGraph.Build(m_LayerStack.GetUpdateLayers());
+						m_UpdateGraphGeneration = m_LayerStack.GetGeneration();
 					}
+					m_UpdateGraph.Run(deltaTime); // Independent parallel layers update on the JobSystem, the others on this thread in stack order
+					Utils::FrameStats::Record(Utils::FrameStats::Metric::UpdateTime, MillisecondsSince(updateStart));
 				}
 			}
 
-			{ // ImGui rendering
+			// ImGui rendering. Skipped entirely while the debug UI is hidden
+			if (m_ImGuiLayer && m_ImGuiLayer->IsEnabled())
+			{
 				FR_PROFILE_SCOPE("ImGuiLayer::Rendering");
-				m_ImGuiLayer->Begin();
-				for (Layer* layer : m_LayerStack)
+				auto imguiStart = std::chrono::high_resolution_clock::now();
+				if (m_ImGuiLayer->ShouldRebuild(deltaTime))
+				{
+					m_ImGuiLayer->Begin();
+					for (const LayerStack::Entry& entry : m_LayerStack.GetImGuiLayers())
+					{
+						FR_PROFILE_SCOPE_INTERNED(Utils::FrameStats::GetLayerPhaseName(entry.StatsIndex, Utils::FrameStats::LayerPhase::ImGui));
+						auto layerStart = std::chrono::high_resolution_clock::now();
+						entry.Target->OnImGuiRender();
+						Utils::FrameStats::RecordLayerTime(entry.StatsIndex, Utils::FrameStats::LayerPhase::ImGui, MillisecondsSince(layerStart));
+					}
+					m_ImGuiLayer->End();
+				}
+				else
 				{
-					layer->OnImGuiRender();
+					m_ImGuiLayer->RenderCached(); // Nothing changed, draw the last UI again
 				}
-				m_ImGuiLayer->End();
+				Utils::FrameStats::Record(Utils::FrameStats::Metric::ImGuiTime, MillisecondsSince(imguiStart));
 			}
 
 			{ // Window updates
 				FR_PROFILE_SCOPE("Window::OnUpdate");
 				// Call the OnUpdate function of the window
+				auto swapStart = std::chrono::high_resolution_clock::now();
 				m_Window->OnUpdate();
+				Utils::FrameStats::Record(Utils::FrameStats::Metric::SwapTime, MillisecondsSince(swapStart));
 			}
 
 			auto endTimepoint = std::chrono::high_resolution_clock::now();
 			long long endTime = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
 
+			Utils::FrameStats::Record(Utils::FrameStats::Metric::FrameTime, std::chrono::duration<float, std::milli>(endTimepoint - m_StartTimepoint).count());
+			Utils::FrameStats::EndFrame();
+			Utils::MemoryTracker::EndFrame();
+
 			//FR_CORE_INFO("Frame: {0} Frame time: {1}", frameCount, endTime - startTime);
 
+			FR_PROFILE_FRAME_END(frameCount);
 			frameCount++;
 		}
+		Utils::MemoryTracker::LogReport();
+		Utils::MemoryTracker::WriteTopCallSites();
 		FR_END_PROFILE_SESSION();
 	}
 
@@ -24,9 +24,15 @@
 #include "Fracture\Events\ApplicationEvent.h"
 #include "Fracture\Events\MouseEvent.h"
 #include "Fracture\Events\KeyEvent.h"
+#include "Fracture\Events\EventHandlers.h"
+#include "Fracture\Events\PostedEventQueue.h"
+
+#include "Fracture\Input\InputRecording.h"
 
 #include "Fracture\Core\LayerStack.h"
+#include "Fracture\Core\LayerUpdateGraph.h"
 #include "Fracture\ImGui\ImGuiLayer.h"
+#include "Fracture\ImGui\PerformanceLayer.h"
 
 namespace Fracture {
 
@@ -48,7 +54,7 @@ namespace Fracture {
 		/*!
 		* @brief This is a constructor for the application class.
 		* 
-		* @details The constructor will create a window object, set the event callback function to the OnEvent function in the application class, and initialize the Renderer.
+		* @details The constructor will create a window object, give it the event queue of the application, and initialize the Renderer.
 		* 
 		* @see Window
 		* @see Renderer
@@ -62,9 +68,12 @@ namespace Fracture {
 		* @brief This is a function that is the main loop of the application.
 		* 
 		* @details The function will run the main loop of the application. The function will update the layers in the layer stack and render the ImGui UI.
-		* The function will also poll for events and dispatch them to the appropriate callback functions. In the future this function will also update the physics engine.
+		* The window polls for events at the end of each frame and pushes them to the event queue, which is dispatched to the subscribed event handlers at the start of the next frame,
+		* before the layers update. In the future this function will also update the physics engine.
+		* The layers update in the order of the LayerUpdateGraph: layers that declared themselves parallel and independent update at the same time on the JobSystem.
 		* 
 		* @see LayerStack
+		* @see LayerUpdateGraph
 		* @see ImGuiLayer
 		* @see Event
 		* @see Window
@@ -76,8 +85,9 @@ namespace Fracture {
 		/*!
 		* @brief This is a function that will be called when an event is triggered.
 		* 
-		* @details The function will be called when an event is triggered. The function will then dispatch the events to the appropriate callback functions.
-		* Currently it is only triggered by the window events(windows close/resize, key events, and mouse events, etc.).
+		* @details The function passes the event to the handlers subscribed to its type, the application first and then the layers from the top of the stack down.
+		* The queued window events do not go through this function; Run dispatches them to the same handlers with their type known at compile time.
+		* The handlers are the ones of the layers at the start of the frame. Layers pushed or popped since then are added or removed by the next frame.
 		* 
 		* @see Event
 		* @see WindowResizeEvent
@@ -125,6 +135,44 @@ namespace Fracture {
 		*/
 		inline Window& GetWindow() { return *m_Window; } 
 
+		/*!
+		* @brief This is a function that will return a reference to the layer stack.
+		* @details Used to find layers and to enable, disable or suspend them.
+		* @see LayerStack
+		* @return LayerStack& - returns a reference to the layer stack.
+		*/
+		inline LayerStack& GetLayerStack() { return m_LayerStack; }
+
+		/*!
+		* @brief This is a function that will return the layer that owns the ImGui context.
+		* @details Used to change when the UI is redrawn, or to hide all of the debug UI with SetEnabled.
+		* @see ImGuiLayer
+		* @return ImGuiLayer* - returns the ImGui layer, or nullptr when the engine is built without FR_ENABLE_IMGUI.
+		*/
+		inline ImGuiLayer* GetImGuiLayer() { return m_ImGuiLayer; }
+
+		/*!
+		* @brief This is a function that will return a reference to the event queue of the window events.
+		* @details Layers use it to change the event coalescing or to register for the raw mouse samples.
+		* @see EventQueue
+		* @return EventQueue& - returns a reference to the event queue.
+		*/
+		inline EventQueue& GetEventQueue() { return m_EventQueue; }
+
+		/*!
+		* @brief This is a function that will queue an event for the event handlers. It can be called from any thread.
+		* 
+		* @details The event is constructed now and dispatched on the main thread at the start of the next frame, after the window events.
+		* Worker threads use it to report finished work (a decoded texture, a reloaded asset) to the layers, usually with a custom event type.
+		* 
+		* @see PostedEventQueue
+		* @see EVENT_CLASS_CUSTOM_TYPE
+		* 
+		* @param[in] Args&&... args - the arguments of the constructor of the event class T.
+		*/
+		template<typename T, typename... Args>
+		inline void PostEvent(Args&&... args) { m_PostedEvents.Post<T>(std::forward<Args>(args)...); }
+
 
 		/*!
 		* @brief This is a static function that will return a reference to the application class.
@@ -132,6 +180,52 @@ namespace Fracture {
 		* @return Application& - returns a reference to the static instance of the application.
 		*/
 		inline static Application& Get() { return *s_Instance; } 
+
+		/*!
+		* @brief This is a static function that stores the command line arguments for the application to read in its constructor. Called by main.
+		* 
+		* @details The application understands:
+		* --record <file>: records the window events of every frame to the file.
+		* --replay <file>: plays the window events of the file back instead of the live input.
+		* --timestep <seconds>: the delta time of every replayed frame, instead of the recorded one.
+		* --headless: hides the window and closes the application when the replay ends.
+		*/
+		static void SetCommandLineArgs(int argc, char** argv);
+
+		/*!
+		* @brief This is a function that will start recording the window events and frame delta times to a file.
+		* 
+		* @see InputRecorder
+		* 
+		* @param[in] const std::string& path - the file to write the recording to. It is overwritten.
+		*/
+		void StartInputRecording(const std::string& path);
+
+		/*!
+		* @brief This is a function that will stop the recording and close the file.
+		*/
+		void StopInputRecording();
+
+		/*!
+		* @brief This is a function that will replay a recording instead of the live input, starting on the next frame.
+		* 
+		* @details Each replayed frame dispatches the recorded events through Input and the event handlers, like live events, and runs with the recorded
+		* delta time, or with the fixed timestep if it is not 0. The same recording therefore drives the layers through the same frames on every run.
+		* The replayed events go through the EventQueue without being merged again, so the raw mouse samples are those of the recorded events. A replayed
+		* resize also resizes the window, hidden or not, so the window matches the viewport the renderer was given.
+		* The live window events are dropped while replaying, except for closing the window. Replaying stops the recording.
+		* 
+		* @see InputPlayer
+		* 
+		* @param[in] const std::string& path - the recording to replay.
+		* @param[in] float fixedTimestep - the delta time of every frame in seconds, or 0 to use the recorded delta times.
+		*/
+		void StartInputReplay(const std::string& path, float fixedTimestep = 0.0f);
+
+		/*!
+		* @brief This is a function that will return true while a recording is being replayed.
+		*/
+		inline bool IsReplayingInput() const { return m_InputPlayer != nullptr; }
 	private:
 		/*!
 		* @brief This is a boolean function that will be called when the window is closed.
@@ -152,6 +246,26 @@ namespace Fracture {
 		* @return bool - returns true if the window resize event is handled here false if it needs to continue to be propogated.
 		*/
 		bool OnWindowResize(WindowResizeEvent& e);
+
+		/*!
+		* @brief This is a boolean function that will be called when a key is pressed. F1 shows and hides the debug UI.
+		* 
+		* @param[in] KeyPressedEvent& e - a reference to the key pressed event.
+		* @return bool - returns true if the key press is handled here false if it needs to continue to be propogated.
+		*/
+		bool OnKeyPressed(KeyPressedEvent& e);
+
+		/*!
+		* @brief Refreshes the lists of the layer stack and rebuilds the event dispatch table from the handlers of the application and the enabled layers if they changed.
+		*/
+		void UpdateEventHandlers();
+
+		/*!
+		* @brief Dispatches the window events, or the replayed events, then the posted events. Replacing the delta time with the replayed one.
+		* 
+		* @param[in, out] Utils::Timestep& deltaTime - the delta time of the frame.
+		*/
+		void DispatchEvents(Utils::Timestep& deltaTime);
 	private:
 		/*! 
 		* @brief A unique pointer to a window object tha is managed by the application class.
@@ -162,17 +276,32 @@ namespace Fracture {
 		* @see Window
 		*/
 		Ref<Window> m_Window; 
+		EventQueue m_EventQueue; /// The events pushed by the window. Dispatched once per frame in Run.
+		PostedEventQueue m_PostedEvents; /// The events posted by any thread with PostEvent. Dispatched once per frame in Run.
+		EventHandlers m_ApplicationEventHandlers; /// The window close and resize handlers of the application.
+		EventHandlerTable m_EventHandlers; /// The handlers of the application and the layers by event type.
+		uint32_t m_EventHandlersGeneration = 0; /// The generation of the layer stack m_EventHandlers was built from.
 
 		/// The application layer stack. This will store all the layers that are currently active and will be updated every frame.
 		LayerStack m_LayerStack;
-		ImGuiLayer* m_ImGuiLayer; /// A pointer to the ImGuiLayer object that is managed by the application class. This is used to render the ImGui UI.
+		LayerUpdateGraph m_UpdateGraph; /// The order of the layer updates. Rebuilt when the layer stack changes.
+		uint32_t m_UpdateGraphGeneration = 0; /// The generation of the layer stack m_UpdateGraph was built from.
+		ImGuiLayer* m_ImGuiLayer = nullptr; /// A pointer to the ImGuiLayer object that is managed by the application class. This is used to render the ImGui UI. nullptr without FR_ENABLE_IMGUI.
+		PerformanceLayer* m_PerformanceLayer = nullptr; /// The overlay that shows the FrameStats. Owned by the layer stack. nullptr without FR_ENABLE_IMGUI.
 
 		bool m_Running = true; /// this is a boolean that will be used to determine if the application is running or not.
 		bool m_isMinimized = false; /// this is a boolean that will be used to determine if the application is minimized or not.
 
 		long long m_LastFrameTime = 0; /// Stores the start time of the last frame. Used to calculate the delta time.
+
+		Scope<InputRecorder> m_InputRecorder; /// Records the window events while set.
+		Scope<InputPlayer> m_InputPlayer; /// Replays a recording instead of the live input while set.
+		InputFrame m_ReplayFrame; /// The frame read from the recording. Kept to reuse its events vector.
+		float m_ReplayTimestep = 0.0f; /// The delta time of the replayed frames, 0 for the recorded delta times.
+		bool m_Headless = false; /// Set by --headless. The window is hidden and the application closes when the replay ends.
 	private:
 		static Application* s_Instance; /// this is a static pointer to the application class.This is used to get the application class from anywhere in the program.
+		static std::vector<std::string> s_CommandLineArgs; /// The command line arguments, without the program name.
 	};
 
 	// To be defined in CLIENT
@@ -29,6 +29,11 @@
 	#define FR_ENABLE_ASSERTS
 #endif
 
+// The debug UI (the ImGui layer and the overlays drawn with it) is compiled out of distribution builds. FR_DISABLE_IMGUI removes it from the other builds as well.
+#if !defined(FR_DIST) && !defined(FR_DISABLE_IMGUI)
+	#define FR_ENABLE_IMGUI
+#endif
+
 #ifdef FR_ENABLE_ASSERTS
 	#define FR_ASSERT(x, ...) { if(!(x)) { FR_ERROR("Assertion Failed: "); FR_ERROR(__VA_ARGS__); __debugbreak(); } }
 	#define FR_CORE_ASSERT(x, ...) { if(!(x)) { FR_CORE_ERROR("Assertion Failed: "); FR_CORE_ERROR(__VA_ARGS__); __debugbreak(); } }
@@ -0,0 +1,160 @@
+#include "frpch.h"
+#include "JobSystem.h"
+
+namespace Fracture {
+
+	namespace {
+
+		thread_local bool t_InsideJob = false; /// Set while the thread runs batches of a job.
+
+	}
+
+	JobSystem& JobSystem::Get()
+	{
+		static JobSystem instance;
+		return instance;
+	}
+
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		JobSystem& js = Get();
+		std::lock_guard<std::mutex> lock(js.m_Mutex);
+		if (js.m_Running)
+			return;
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		js.m_Running = true;
+		js.m_Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			js.m_Workers.emplace_back(&JobSystem::WorkerLoop, &js);
+		}
+	}
+
+	void JobSystem::Shutdown()
+	{
+		JobSystem& js = Get();
+		{
+			std::lock_guard<std::mutex> lock(js.m_Mutex);
+			if (!js.m_Running)
+				return;
+			js.m_Running = false;
+		}
+		js.m_WakeCondition.notify_all();
+
+		for (std::thread& worker : js.m_Workers)
+		{
+			worker.join();
+		}
+		js.m_Workers.clear();
+	}
+
+	uint32_t JobSystem::GetThreadCount()
+	{
+		Init();
+		return (uint32_t)Get().m_Workers.size() + 1;
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeFn& fn)
+	{
+		if (count == 0)
+			return;
+
+		batchSize = std::max(batchSize, 1u);
+		uint32_t batchCount = (count + batchSize - 1) / batchSize;
+		if (batchCount == 1 || t_InsideJob)
+		{
+			fn(0, count);
+			return;
+		}
+
+		Init();
+		JobSystem& js = Get();
+		std::lock_guard<std::mutex> submitLock(js.m_SubmitMutex); // only one job is in flight at a time
+
+		{
+			std::unique_lock<std::mutex> lock(js.m_Mutex);
+			// A worker that woke up late for the previous job may still be leaving RunBatches. Wait for it so it can not pick up batches of this job with stale data.
+			js.m_DoneCondition.wait(lock, [&js]() { return js.m_ActiveWorkers == 0; });
+
+			js.m_Job = &fn;
+			js.m_JobCount = count;
+			js.m_JobBatchSize = batchSize;
+			js.m_NextBatch.store(0, std::memory_order_relaxed);
+			js.m_PendingBatches.store(batchCount, std::memory_order_relaxed);
+			js.m_JobGeneration++;
+		}
+		js.m_WakeCondition.notify_all();
+
+		// The submitting thread works on the job as well instead of idling
+		js.RunBatches();
+
+		std::unique_lock<std::mutex> lock(js.m_Mutex);
+		js.m_DoneCondition.wait(lock, [&js]() { return js.m_PendingBatches.load(std::memory_order_acquire) == 0 && js.m_ActiveWorkers == 0; });
+		js.m_Job = nullptr;
+	}
+
+	void JobSystem::RunBatches()
+	{
+		const RangeFn* job = m_Job;
+		if (job == nullptr)
+			return;
+
+		uint32_t batchCount = (m_JobCount + m_JobBatchSize - 1) / m_JobBatchSize;
+		t_InsideJob = true;
+		while (true)
+		{
+			uint32_t batch = m_NextBatch.fetch_add(1, std::memory_order_relaxed);
+			if (batch >= batchCount)
+				break;
+
+			uint32_t begin = batch * m_JobBatchSize;
+			uint32_t end = std::min(begin + m_JobBatchSize, m_JobCount);
+			(*job)(begin, end);
+
+			if (m_PendingBatches.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				// Last batch finished. Take the lock so the notification can not be missed by the submitter.
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_DoneCondition.notify_all();
+			}
+		}
+		t_InsideJob = false;
+	}
+
+	void JobSystem::WorkerLoop()
+	{
+		uint64_t seenGeneration = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_WakeCondition.wait(lock, [this, seenGeneration]() { return !m_Running || m_JobGeneration != seenGeneration; });
+				if (!m_Running)
+					return;
+				seenGeneration = m_JobGeneration;
+				m_ActiveWorkers++;
+			}
+
+			RunBatches();
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_ActiveWorkers--;
+				if (m_ActiveWorkers == 0)
+					m_DoneCondition.notify_all();
+			}
+		}
+	}
+
+}
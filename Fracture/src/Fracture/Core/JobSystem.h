@@ -0,0 +1,95 @@
+#pragma once
+/*!
+* @file JobSystem.h
+* @brief Contains the JobSystem class that owns a pool of worker threads used to split work across cores.
+*
+* @see SoftwareRasterizer
+*
+* @author Aditya Rajagopal
+*/
+
+#include "frpch.h"
+
+#include "Fracture\Core\Core.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace Fracture {
+
+	/*!
+	* @brief The JobSystem class is a singleton pool of worker threads.
+	*
+	* @details The pool is created lazily on first use with one worker per hardware thread minus one (the calling thread always takes part in the work it submits).
+	* Work is submitted as a range that is split into batches. Batches are handed out through an atomic counter so there is no per-batch locking.
+	*
+	* @todo: Add support for dependencies between jobs.
+	*/
+	class FRACTURE_API JobSystem
+	{
+	public:
+		/// The signature of a function that processes the range [begin, end).
+		using RangeFn = std::function<void(uint32_t begin, uint32_t end)>;
+
+		/*!
+		* @brief Function that starts the worker threads. Called lazily by the other functions, but can be called up front to avoid a hitch on first use.
+		*
+		* @param[in] uint32_t workerCount: The number of workers to start. 0 picks std::thread::hardware_concurrency() - 1.
+		*/
+		static void Init(uint32_t workerCount = 0);
+
+		/*!
+		* @brief Function that stops and joins all the worker threads.
+		*/
+		static void Shutdown();
+
+		/*!
+		* @brief Function that splits the range [0, count) into batches of batchSize and runs fn on them across the worker threads.
+		*
+		* @details The calling thread works on the range as well and the function only returns once every batch has finished.
+		* If the range fits into a single batch the function is called directly on the calling thread. So is a ParallelFor called from inside the batch of
+		* another one, for example by a layer updating on a worker, since only one job is in flight at a time and waiting for the outer one would never end.
+		*
+		* @param[in] uint32_t count: The number of items in the range.
+		* @param[in] uint32_t batchSize: The number of items handed out at a time.
+		* @param[in] const RangeFn& fn: The function called for each batch.
+		*/
+		static void ParallelFor(uint32_t count, uint32_t batchSize, const RangeFn& fn);
+
+		/*!
+		* @brief Function that returns the number of threads that take part in a ParallelFor (workers + the calling thread).
+		*
+		* @return uint32_t: The number of threads.
+		*/
+		static uint32_t GetThreadCount();
+	private:
+		JobSystem() = default;
+		~JobSystem();
+
+		static JobSystem& Get();
+
+		void WorkerLoop();
+
+		/*!
+		* @brief Processes batches of the current job until none are left.
+		*/
+		void RunBatches();
+	private:
+		std::vector<std::thread> m_Workers; /// The worker threads.
+		std::mutex m_Mutex; /// Guards the job slot and the wake up condition.
+		std::condition_variable m_WakeCondition; /// Signalled when a new job is posted or on shutdown.
+		std::condition_variable m_DoneCondition; /// Signalled when the last batch of a job has finished.
+		std::mutex m_SubmitMutex; /// Serialises ParallelFor calls from different threads.
+
+		const RangeFn* m_Job = nullptr; /// The function of the job currently being processed.
+		uint32_t m_JobCount = 0; /// The number of items in the current job.
+		uint32_t m_JobBatchSize = 1; /// The batch size of the current job.
+		uint64_t m_JobGeneration = 0; /// Incremented for every job so workers know when there is new work.
+		std::atomic<uint32_t> m_NextBatch = 0; /// The index of the next batch to hand out.
+		std::atomic<uint32_t> m_PendingBatches = 0; /// The number of batches that have not finished yet.
+		uint32_t m_ActiveWorkers = 0; /// The number of workers currently inside RunBatches.
+		bool m_Running = false; /// Whether the workers have been started.
+	};
+
+}
@@ -1,6 +1,8 @@
 #include "frpch.h"
 #include "Layer.h"
 
+#include "LayerStack.h"
+
 namespace Fracture {
 	
 	Layer::Layer(const std::string& name) :
@@ -8,4 +10,22 @@ namespace Fracture {
 	{
 	}
 
+	void Layer::SetEnabled(bool enabled)
+	{
+		if (m_Enabled == enabled)
+			return;
+		m_Enabled = enabled;
+		if (m_Stack)
+			m_Stack->Invalidate();
+	}
+
+	void Layer::SetSuspended(bool suspended)
+	{
+		if (m_Suspended == suspended)
+			return;
+		m_Suspended = suspended;
+		if (m_Stack)
+			m_Stack->Invalidate();
+	}
+
 }
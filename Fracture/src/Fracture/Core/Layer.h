@@ -12,11 +12,44 @@
 
 #include "Fracture\Core\Core.h"
 #include "Fracture\Events\Event.h"
+#include "Fracture\Events\EventHandlers.h"
 
 #include "Fracture\Utils\Helpers.h"
 
 namespace Fracture
 {
+	class LayerStack;
+
+	/*!
+	* @brief The phases of the layer updates. Every layer in a phase finishes OnUpdate before any layer in the next phase starts.
+	*/
+	enum class LayerUpdatePhase : uint8_t
+	{
+		PreUpdate = 0,	/// Input handling and anything the other layers read, for example a camera.
+		Update,			/// The default. Simulation, AI, gameplay.
+		PostUpdate		/// Work on the results of the update, for example audio preparation or building draw lists.
+	};
+
+	/*!
+	* @brief Declares how the OnUpdate of a layer may be scheduled. Set once in the constructor of the layer.
+	* 
+	* @details By default a layer updates on the main thread, in stack order, and nothing else runs at the same time.
+	* A layer that sets Parallel may update on a worker thread at the same time as the other parallel layers of its phase, as long as neither writes a resource the
+	* other reads or writes. Resources are free form names chosen by the layers, for example "Physics" or "AudioBuffers".
+	* 
+	* The OnUpdate of a parallel layer must not submit draws, touch the window or ImGui, or push, pop, enable or disable layers. Rendering stays in the layers
+	* that update on the main thread, so the draws are submitted in stack order.
+	* 
+	* @see LayerUpdateGraph
+	*/
+	struct LayerUpdateDesc
+	{
+		LayerUpdatePhase Phase = LayerUpdatePhase::Update; /// The phase the layer updates in.
+		bool Parallel = false; /// Whether OnUpdate may run on a worker thread.
+		std::vector<std::string> Reads; /// The resources OnUpdate reads.
+		std::vector<std::string> Writes; /// The resources OnUpdate writes.
+	};
+
 	/*!
 	* @brief The Layer class is the base class for all layers in the engine. Layers are used to separate different parts of the application and set an order of execution.
 	* 
@@ -51,14 +84,22 @@ namespace Fracture
 		virtual void OnUpdate(Utils::Timestep delta_time) {};
 
 		/*!
-		* @brief the function called by the application OnEvent function for each layer in the layerstack with the current event being handled.
+		* @brief Getter for the event handlers of the layer. The application copies them into its dispatch table when the layer is pushed.
+		* 
+		* @see EventHandlerTable
+		* 
+		* @return const EventHandlers&: The event handlers of the layer.
+		*/
+		inline const EventHandlers& GetEventHandlers() const { return m_EventHandlers; }
+
+		/*!
+		* @brief Getter for the update declaration of the layer. The application reads it when it builds the update graph.
 		* 
-		* @see Application::OnEvent
-		* @see Event
+		* @see LayerUpdateGraph
 		* 
-		* @param[in] Event& event: The event being handled.
+		* @return const LayerUpdateDesc&: The phase and the resources of the layer.
 		*/
-		virtual void OnEvent(Event& event) {};
+		inline const LayerUpdateDesc& GetUpdateDesc() const { return m_UpdateDesc; }
 
 		/*!
 		* @brief Function called every frame by the application for rendering ImGui elements.
@@ -73,8 +114,47 @@ namespace Fracture
 		* @return const std::string&: The name of the layer.
 		*/
 		inline const std::string& GetName() const { return m_DebugName; }
+
+		/*!
+		* @brief Enables or disables the layer. A disabled layer stays attached but gets no OnUpdate, OnImGuiRender or events.
+		* 
+		* @details The change takes effect at the start of the next frame, when the layer stack rebuilds its lists.
+		* 
+		* @param[in] bool enabled: Whether the layer runs.
+		*/
+		void SetEnabled(bool enabled);
+
+		/*!
+		* @brief Getter for the enabled flag of the layer.
+		* 
+		* @return bool: true if the layer runs, false if it is disabled.
+		*/
+		inline bool IsEnabled() const { return m_Enabled; }
+
+		/*!
+		* @brief Suspends or resumes the layer. A suspended layer skips OnUpdate but still draws its ImGui and handles events, for example a paused game view.
+		* 
+		* @details The change takes effect at the start of the next frame, when the layer stack rebuilds its lists.
+		* 
+		* @param[in] bool suspended: Whether the layer skips OnUpdate.
+		*/
+		void SetSuspended(bool suspended);
+
+		/*!
+		* @brief Getter for the suspended flag of the layer.
+		* 
+		* @return bool: true if the layer skips OnUpdate.
+		*/
+		inline bool IsSuspended() const { return m_Suspended; }
 	protected:
 		std::string m_DebugName; /// The name of the layer
+		EventHandlers m_EventHandlers; /// The event handlers of the layer. Subscribed once, in the constructor or OnAttach.
+		LayerUpdateDesc m_UpdateDesc; /// How OnUpdate may be scheduled. Set once, in the constructor.
+	private:
+		friend class LayerStack;
+		LayerStack* m_Stack = nullptr; /// The stack the layer is attached to. Told when a flag changes so it rebuilds its lists.
+		bool m_Enabled = true; /// Whether the layer runs at all.
+		bool m_Suspended = false; /// Whether the layer skips OnUpdate.
 	};
 
 } // namespace Fracture
@@ -2,6 +2,8 @@
 
 #include "LayerStack.h"
 
+#include "Fracture\Utils\FrameStats.h"
+
 
 namespace Fracture {
 	LayerStack::LayerStack()
@@ -15,29 +17,32 @@ namespace Fracture {
 			layer->OnDetach();
 			delete layer;
 		}
+		for (Layer* layer : m_PendingDetach)
+			layer->OnDetach(); // Popped, so owned by whoever popped them
 	}
 
 	void LayerStack::PushLayer(Layer* layer)
 	{
 		m_Layers.emplace(m_Layers.begin() + m_LayerInsertIndex, layer);
 		m_LayerInsertIndex++;
-		layer->OnAttach();
+		Attach(layer);
 	}
 
 	void LayerStack::PushOverlay(Layer* layer)
 	{
 		m_Layers.emplace_back(layer);
-		layer->OnAttach();
+		Attach(layer);
 	}
 
 	void LayerStack::PopLayer(Layer* layer)
 	{
-		auto it = std::find(m_Layers.begin(), m_Layers.begin() + m_LayerInsertIndex, layer);
-		if (it != m_Layers.end())
+		auto last = m_Layers.begin() + m_LayerInsertIndex;
+		auto it = std::find(m_Layers.begin(), last, layer);
+		if (it != last)
 		{
-			layer->OnDetach();
 			m_Layers.erase(it);
 			m_LayerInsertIndex--;
+			QueueDetach(layer);
 		}
 	}
 
@@ -46,8 +51,70 @@ namespace Fracture {
 		auto it = std::find(m_Layers.begin() + m_LayerInsertIndex, m_Layers.end(), layer);
 		if (it != m_Layers.end())
 		{
-			layer->OnDetach();
 			m_Layers.erase(it);
+			QueueDetach(layer);
 		}
 	}
+
+	void LayerStack::Attach(Layer* layer)
+	{
+		auto pending = std::find(m_PendingDetach.begin(), m_PendingDetach.end(), layer);
+		if (pending != m_PendingDetach.end())
+		{
+			// Pushed again before the pop took effect, so it never left
+			m_PendingDetach.erase(pending);
+			m_Dirty = true;
+			return;
+		}
+
+		layer->m_Stack = this;
+		m_StatsIndices[layer] = Utils::FrameStats::RegisterLayer(layer->GetName());
+		m_Dirty = true;
+		layer->OnAttach();
+	}
+
+	void LayerStack::QueueDetach(Layer* layer)
+	{
+		m_PendingDetach.push_back(layer);
+		m_Dirty = true;
+	}
+
+	void LayerStack::Detach(Layer* layer)
+	{
+		layer->OnDetach();
+		layer->m_Stack = nullptr;
+		m_StatsIndices.erase(layer);
+		m_Dirty = true;
+	}
+
+	bool LayerStack::Refresh()
+	{
+		if (!m_Dirty)
+			return false;
+
+		// Nothing walks the lists between frames, so this is the first point where no loop can still reach the popped layers
+		for (Layer* layer : m_PendingDetach)
+			Detach(layer);
+		m_PendingDetach.clear();
+
+		m_UpdateLayers.clear();
+		m_ImGuiLayers.clear();
+		m_EventLayers.clear();
+		for (Layer* layer : m_Layers)
+		{
+			if (!layer->IsEnabled())
+				continue;
+
+			Entry entry = { layer, m_StatsIndices[layer] };
+			if (!layer->IsSuspended())
+				m_UpdateLayers.push_back(entry);
+			m_ImGuiLayers.push_back(entry);
+			m_EventLayers.push_back(entry);
+		}
+		std::reverse(m_EventLayers.begin(), m_EventLayers.end()); // Overlays first. A handler that returns true blocks the layers below it
+
+		m_Generation++;
+		m_Dirty = false;
+		return true;
+	}
 }
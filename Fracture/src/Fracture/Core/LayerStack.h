@@ -24,6 +24,12 @@ namespace Fracture {
 	* The layers are stored in a vector of Layer pointers. 
 	* The layers are stored in the first half of the vector and the overlays are stored in the second half of the vector. The demarcation between the layers and the overlays is stored in the m_LayerInsertIndex variable.
 	* 
+	* The Application does not walk that vector every frame. Refresh builds three contiguous lists from it: the layers that update, the layers that draw ImGui
+	* and the layers that get events, top to bottom. Disabled and suspended layers are left out of the lists, so the frame loop never tests the flags.
+	* The lists are only rebuilt when a layer is pushed or popped or a flag changes, and the changes take effect at the next Refresh, so a layer can push,
+	* pop or disable another one from its own OnUpdate without breaking the loop that called it. Pops are queued: a popped layer stays in the lists, and
+	* keeps getting its callbacks, until the next Refresh detaches it. Its OnDetach is therefore always its last callback from the stack.
+	* 
 	* @see Layer
 	*/
 	class FRACTURE_API LayerStack
@@ -63,7 +69,8 @@ namespace Fracture {
 		/*!
 		* @brief Function that will detach a layer from the layer stack.
 		* 
-		* @details Here we will find the layer in the layer stack call its Layer::OnDetach function and erase it from the LayerStack.
+		* @details Here we will find the layer in the layer stack, erase it from the LayerStack and queue it to be detached. Its Layer::OnDetach function is called
+		* by the next Refresh, at the start of the next frame. The layer belongs to the caller again, but must not be deleted before it was detached.
 		* 
 		* @see Layer
 		* 
@@ -76,7 +83,7 @@ namespace Fracture {
 		/*!
 		* @brief Function that will detach an overlay from the layer stack.
 		* 
-		* @details Here we will find the overlay in the layer stack call its Layer::OnDetach function and erase it from the LayerStack.
+		* @details Here we will find the overlay in the layer stack, erase it from the LayerStack and queue it to be detached like PopLayer does.
 		* 
 		* @see Layer
 		* 
@@ -99,8 +106,70 @@ namespace Fracture {
 		* @return std::vector<Layer*>::iterator: An iterator to the end of the layer stack.
 		*/
 		std::vector<Layer*>::iterator end() { return m_Layers.end(); }
+
+		/// A layer in one of the per phase lists, with the index of its FrameStats timings.
+		struct Entry
+		{
+			Layer* Target; /// The layer.
+			uint32_t StatsIndex; /// The index returned by Utils::FrameStats::RegisterLayer for the layer.
+		};
+
+		/*!
+		* @brief Marks the per phase lists as out of date. Called when a layer is pushed or popped or changes its enabled or suspended flag.
+		*/
+		inline void Invalidate() { m_Dirty = true; }
+
+		/*!
+		* @brief Detaches the popped layers and rebuilds the per phase lists if they are out of date. Called by the Application at the start of every frame.
+		* 
+		* @return bool: true if the lists were rebuilt.
+		*/
+		bool Refresh();
+
+		/*!
+		* @brief Returns the layers to call OnUpdate on, bottom to top. Leaves out the disabled and the suspended layers.
+		*/
+		inline const std::vector<Entry>& GetUpdateLayers() const { return m_UpdateLayers; }
+
+		/*!
+		* @brief Returns the layers to call OnImGuiRender on, bottom to top. Leaves out the disabled layers.
+		*/
+		inline const std::vector<Entry>& GetImGuiLayers() const { return m_ImGuiLayers; }
+
+		/*!
+		* @brief Returns the layers whose event handlers are dispatched to, top to bottom. Leaves out the disabled layers.
+		*/
+		inline const std::vector<Entry>& GetEventLayers() const { return m_EventLayers; }
+
+		/*!
+		* @brief Returns a number that changes every time the lists are rebuilt, so users of the lists can tell when to rebuild what they derive from them.
+		*/
+		inline uint32_t GetGeneration() const { return m_Generation; }
+	private:
+		/*!
+		* @brief Attaches a layer that was just added to m_Layers.
+		*/
+		void Attach(Layer* layer);
+
+		/*!
+		* @brief Queues a layer that was just removed from m_Layers to be detached by the next Refresh.
+		*/
+		void QueueDetach(Layer* layer);
+
+		/*!
+		* @brief Detaches a layer that was removed from m_Layers.
+		*/
+		void Detach(Layer* layer);
 	private:
 		std::vector<Layer*> m_Layers; /// The vector of Layer pointers that will hold the layers
 		uint32_t m_LayerInsertIndex = 0; /// The current index in the layer stack where a Layer will be inserted (not an overlay)
+
+		std::vector<Entry> m_UpdateLayers; /// The layers that update, bottom to top.
+		std::vector<Entry> m_ImGuiLayers; /// The layers that draw ImGui, bottom to top.
+		std::vector<Entry> m_EventLayers; /// The layers that get events, top to bottom.
+		std::unordered_map<Layer*, uint32_t> m_StatsIndices; /// The FrameStats index of each attached layer.
+		std::vector<Layer*> m_PendingDetach; /// The layers popped since the last Refresh. Still attached and still in the lists.
+		uint32_t m_Generation = 0; /// Incremented every time the lists are rebuilt.
+		bool m_Dirty = true; /// Set when the lists are out of date.
 	};
 }
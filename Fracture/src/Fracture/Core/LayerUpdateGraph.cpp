@@ -0,0 +1,106 @@
+#include "frpch.h"
+#include "LayerUpdateGraph.h"
+
+#include "Fracture\Core\JobSystem.h"
+#include "Fracture\Utils\FrameStats.h"
+
+namespace Fracture {
+
+	namespace {
+
+		bool Contains(const std::vector<std::string>& resources, const std::string& resource)
+		{
+			return std::find(resources.begin(), resources.end(), resource) != resources.end();
+		}
+
+	}
+
+	bool LayerUpdateGraph::DependsOn(const LayerUpdateDesc& b, const LayerUpdateDesc& a)
+	{
+		if (!a.Parallel || !b.Parallel || a.Phase != b.Phase)
+			return true;
+
+		for (const std::string& resource : a.Writes)
+		{
+			if (Contains(b.Reads, resource) || Contains(b.Writes, resource))
+				return true;
+		}
+		for (const std::string& resource : a.Reads)
+		{
+			if (Contains(b.Writes, resource))
+				return true;
+		}
+		return false;
+	}
+
+	void LayerUpdateGraph::Build(const std::vector<LayerStack::Entry>& layers)
+	{
+		std::vector<LayerStack::Entry> order = layers;
+		std::stable_sort(order.begin(), order.end(), [](const LayerStack::Entry& a, const LayerStack::Entry& b)
+			{
+				return a.Target->GetUpdateDesc().Phase < b.Target->GetUpdateDesc().Phase;
+			});
+
+		// Longest path from the start of the graph. Stacks hold a handful of layers so the pairwise test is cheap.
+		std::vector<uint32_t> levels(order.size(), 0);
+		uint32_t levelCount = 0;
+		for (size_t j = 0; j < order.size(); j++)
+		{
+			for (size_t i = 0; i < j; i++)
+			{
+				if (DependsOn(order[j].Target->GetUpdateDesc(), order[i].Target->GetUpdateDesc()))
+					levels[j] = std::max(levels[j], levels[i] + 1);
+			}
+			levelCount = std::max(levelCount, levels[j] + 1);
+		}
+
+		m_Nodes.clear();
+		m_LevelStarts.clear();
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			m_LevelStarts.push_back((uint32_t)m_Nodes.size());
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				if (levels[i] == level)
+					m_Nodes.push_back({ order[i].Target, order[i].StatsIndex, Utils::FrameStats::GetLayerPhaseName(order[i].StatsIndex, Utils::FrameStats::LayerPhase::Update), 0.0f });
+			}
+		}
+		m_LevelStarts.push_back((uint32_t)m_Nodes.size());
+
+		FR_CORE_TRACE("Layer update graph: {0} layers in {1} levels", m_Nodes.size(), levelCount);
+	}
+
+	void LayerUpdateGraph::RunNode(Node& node, Utils::Timestep deltaTime)
+	{
+		FR_PROFILE_SCOPE_INTERNED(node.ProfileName);
+		auto start = std::chrono::high_resolution_clock::now();
+		node.Target->OnUpdate(deltaTime);
+		node.Milliseconds = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void LayerUpdateGraph::Run(Utils::Timestep deltaTime)
+	{
+		for (size_t level = 0; level + 1 < m_LevelStarts.size(); level++)
+		{
+			uint32_t begin = m_LevelStarts[level];
+			uint32_t count = m_LevelStarts[level + 1] - begin;
+			if (count == 1)
+			{
+				RunNode(m_Nodes[begin], deltaTime); // Main thread layers are always alone in their level
+				continue;
+			}
+
+			FR_PROFILE_SCOPE_ARG("LayerUpdateGraph::Level", "layers", count);
+			JobSystem::ParallelFor(count, 1, [this, begin, deltaTime](uint32_t first, uint32_t last)
+				{
+					for (uint32_t i = first; i < last; i++)
+						RunNode(m_Nodes[begin + i], deltaTime);
+				});
+		}
+
+		// FrameStats is only written on the main thread
+		for (const Node& node : m_Nodes)
+			Utils::FrameStats::RecordLayerTime(node.StatsIndex, Utils::FrameStats::LayerPhase::Update, node.Milliseconds);
+	}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+/*!
+* @file LayerUpdateGraph.h
+* @brief Contains the LayerUpdateGraph class that orders the layer updates by their declared phases and resources and runs the independent ones at the same time.
+*
+* @details Usage:
+*
+* SimulationLayer::SimulationLayer() : Layer("SimulationLayer")
+* {
+*     m_UpdateDesc.Parallel = true;
+*     m_UpdateDesc.Reads = { "Input" };
+*     m_UpdateDesc.Writes = { "Physics" };
+* }
+*
+* @see LayerUpdateDesc, Application::Run
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Core\LayerStack.h"
+
+#include "Fracture\Utils\Helpers.h"
+
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief The order of the layer updates as a dependency graph, split into levels that run one after the other.
+	*
+	* @details Build sorts the updating layers by phase, keeping the stack order inside a phase, and adds an edge from a layer to every later layer that
+	* depends on it: a later phase, a resource conflict, or either of the two updating on the main thread. Every layer is then placed one level after the last
+	* layer it depends on. The layers of a level do not depend on each other, so Run spreads a level with several layers across the JobSystem and waits for it
+	* before starting the next. A main thread layer depends on everything around it, so it is always alone in its level and runs on the main thread.
+	*
+	* The graph is only rebuilt when the layer stack changes. The update times of the layers are measured by the thread that ran them and recorded into
+	* FrameStats on the main thread after the last level.
+	*/
+	class LayerUpdateGraph
+	{
+	public:
+		/*!
+		* @brief Rebuilds the graph from the layers that update, bottom to top.
+		*
+		* @param[in] const std::vector<LayerStack::Entry>& layers: The layers, as returned by LayerStack::GetUpdateLayers.
+		*/
+		void Build(const std::vector<LayerStack::Entry>& layers);
+
+		/*!
+		* @brief Calls OnUpdate on every layer, level by level. Returns once every layer has updated.
+		*
+		* @param[in] Utils::Timestep deltaTime: The time passed since the last frame.
+		*/
+		void Run(Utils::Timestep deltaTime);
+
+		/*!
+		* @brief Returns the number of levels. Equal to the number of layers when nothing can update at the same time.
+		*/
+		inline uint32_t GetLevelCount() const { return m_LevelStarts.empty() ? 0 : (uint32_t)m_LevelStarts.size() - 1; }
+	private:
+		/// A layer in the graph.
+		struct Node
+		{
+			Layer* Target; /// The layer.
+			uint32_t StatsIndex; /// The FrameStats index of the layer.
+			const char* ProfileName; /// The profiler name of the OnUpdate of the layer.
+			float Milliseconds; /// The time the last OnUpdate took. Written by the thread that ran it.
+		};
+
+		/*!
+		* @brief Returns true if the update of b has to wait for the update of a. a comes before b in the phase order.
+		*/
+		static bool DependsOn(const LayerUpdateDesc& b, const LayerUpdateDesc& a);
+
+		/*!
+		* @brief Calls OnUpdate on the layer and times it.
+		*/
+		static void RunNode(Node& node, Utils::Timestep deltaTime);
+	private:
+		std::vector<Node> m_Nodes; /// The layers, grouped by level.
+		std::vector<uint32_t> m_LevelStarts; /// The index of the first node of each level, followed by the number of nodes.
+	};
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+/*!
+* @file Simd.h
+* @brief Contains thin wrappers over the SSE and AVX intrinsics, so SIMD loops are written once for both widths.
+*
+* @details The width is picked at compile time. The premake project builds with AVX2, which gives 8 float lanes; a build without AVX falls back to 4 SSE lanes.
+* Loops step by SimdLanes and handle the remainder themselves. Arrays that are stored to should be alignas(32) so they fit either width.
+*
+* @see BoundsList, TransformSystem, SoftwareRasterizer
+*
+* @author Aditya Rajagopal
+*/
+
+#include <cstdint>
+#include <immintrin.h>
+
+namespace Fracture {
+
+#if defined(__AVX__)
+	using SimdFloat = __m256;
+	inline constexpr uint32_t SimdLanes = 8; /// The number of floats in a SimdFloat.
+	inline SimdFloat SimdSet(float value) { return _mm256_set1_ps(value); }
+	inline SimdFloat SimdLaneOffsets() { return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f); }
+	inline SimdFloat SimdLoad(const float* in) { return _mm256_loadu_ps(in); }
+	inline void SimdStore(float* out, SimdFloat a) { _mm256_storeu_ps(out, a); }
+	inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b) { return _mm256_add_ps(a, b); }
+	inline SimdFloat SimdSub(SimdFloat a, SimdFloat b) { return _mm256_sub_ps(a, b); }
+	inline SimdFloat SimdMul(SimdFloat a, SimdFloat b) { return _mm256_mul_ps(a, b); }
+	inline SimdFloat SimdDiv(SimdFloat a, SimdFloat b) { return _mm256_div_ps(a, b); }
+	inline SimdFloat SimdAnd(SimdFloat a, SimdFloat b) { return _mm256_and_ps(a, b); }
+	inline SimdFloat SimdOr(SimdFloat a, SimdFloat b) { return _mm256_or_ps(a, b); }
+	inline SimdFloat SimdGreater(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	inline SimdFloat SimdGreaterEqual(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	inline SimdFloat SimdLessEqual(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	inline uint32_t SimdMask(SimdFloat a) { return (uint32_t)_mm256_movemask_ps(a); } /// Bit i is the sign bit of lane i.
+#else
+	using SimdFloat = __m128;
+	inline constexpr uint32_t SimdLanes = 4; /// The number of floats in a SimdFloat.
+	inline SimdFloat SimdSet(float value) { return _mm_set1_ps(value); }
+	inline SimdFloat SimdLaneOffsets() { return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f); }
+	inline SimdFloat SimdLoad(const float* in) { return _mm_loadu_ps(in); }
+	inline void SimdStore(float* out, SimdFloat a) { _mm_storeu_ps(out, a); }
+	inline SimdFloat SimdAdd(SimdFloat a, SimdFloat b) { return _mm_add_ps(a, b); }
+	inline SimdFloat SimdSub(SimdFloat a, SimdFloat b) { return _mm_sub_ps(a, b); }
+	inline SimdFloat SimdMul(SimdFloat a, SimdFloat b) { return _mm_mul_ps(a, b); }
+	inline SimdFloat SimdDiv(SimdFloat a, SimdFloat b) { return _mm_div_ps(a, b); }
+	inline SimdFloat SimdAnd(SimdFloat a, SimdFloat b) { return _mm_and_ps(a, b); }
+	inline SimdFloat SimdOr(SimdFloat a, SimdFloat b) { return _mm_or_ps(a, b); }
+	inline SimdFloat SimdGreater(SimdFloat a, SimdFloat b) { return _mm_cmpgt_ps(a, b); }
+	inline SimdFloat SimdGreaterEqual(SimdFloat a, SimdFloat b) { return _mm_cmpge_ps(a, b); }
+	inline SimdFloat SimdLessEqual(SimdFloat a, SimdFloat b) { return _mm_cmple_ps(a, b); }
+	inline uint32_t SimdMask(SimdFloat a) { return (uint32_t)_mm_movemask_ps(a); } /// Bit i is the sign bit of lane i.
+#endif
+
+}
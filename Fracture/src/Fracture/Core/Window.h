@@ -14,6 +14,7 @@
 
 #include "Fracture\Core\Core.h"
 #include "Fracture\Events\Event.h"
+#include "Fracture\Events\EventQueue.h"
 
 namespace Fracture {
 
@@ -25,6 +26,7 @@ namespace Fracture {
 		std::string Title; /// The title of the window
 		uint32_t Width; /// The width of the window
 		uint32_t Height; /// The height of the window
+		bool Visible = true; /// Whether the window is shown. Hidden windows still render, for headless runs.
 
 		/*!
 		* @brief Constructor for the WindowProperties struct.
@@ -47,8 +49,6 @@ namespace Fracture {
 	class FRACTURE_API Window
 	{
 	public:
-		using EventCallbackFn = std::function<void(Event&)>; /// Defines a type for the event callback function. This is a function that takes an event as a parameter and returns void.
-
 		virtual ~Window() {}
 
 		/*!
@@ -71,11 +71,23 @@ namespace Fracture {
 		virtual uint32_t GetHeight() const = 0;
 
 		/*!
-		* @brief Function that must be implemented by the platform specific window class. This function will set the event callback function.
+		* @brief Function that must be implemented by the platform specific window class. This function will resize the window, hidden or not.
+		* 
+		* @details The window pushes a WindowResize event for it, like for a resize by the user.
+		* 
+		* @param[in] uint32_t width: The new width of the window.
+		* @param[in] uint32_t height: The new height of the window.
+		*/
+		virtual void SetSize(uint32_t width, uint32_t height) = 0;
+
+		/*!
+		* @brief Function that must be implemented by the platform specific window class. This function will set the queue the window events are pushed to.
+		* 
+		* @details The window never dispatches events itself. It pushes them while it polls in OnUpdate and the owner of the queue dispatches them later.
 		* 
-		* @param[in] const EventCallbackFn& callback: The event callback function.
+		* @param[in] EventQueue* queue: The queue that receives the window events. Must outlive the window.
 		*/
-		virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
+		virtual void SetEventQueue(EventQueue* queue) = 0;
 
 		/*!
 		* @brief Function that must be implemented by the platform specific window class. This function will set the VSync flag.
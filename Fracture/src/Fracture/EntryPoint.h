@@ -33,6 +33,7 @@
 		FR_CORE_WARN("Initialized Fracture Log!");
 		FR_WARN("Initialized Game Log with macros!");
 
+		Fracture::Application::SetCommandLineArgs(argc, argv);
 		auto app = Fracture::CreateApplication();
 		app->Run();
 		delete app;
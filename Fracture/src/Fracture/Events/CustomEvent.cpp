@@ -0,0 +1,26 @@
+#include "frpch.h"
+#include "CustomEvent.h"
+
+#include <atomic>
+
+namespace Fracture {
+
+	namespace {
+
+		std::atomic<uint32_t> s_TypeCount{ EventTypeRegistry::FirstCustomType };
+
+	}
+
+	EventType EventTypeRegistry::Register(const char* name)
+	{
+		uint32_t type = s_TypeCount.fetch_add(1, std::memory_order_relaxed);
+		FR_CORE_TRACE("Registered event type {0}: {1}", type, name);
+		return (EventType)type;
+	}
+
+	uint32_t EventTypeRegistry::GetTypeCount()
+	{
+		return s_TypeCount.load(std::memory_order_relaxed);
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+/*!
+* @file CustomEvent.h
+* @brief Contains the EventTypeRegistry that hands out event types beyond the EventType enum, for events defined by the client or by engine systems.
+*
+* @details Usage:
+*
+* class TextureLoadedEvent : public Fracture::Event
+* {
+* public:
+*     TextureLoadedEvent(const std::string& path) : m_Path(path) {}
+*     EVENT_CLASS_CUSTOM_TYPE(TextureLoaded)
+*     EVENT_CLASS_CATEGORY(Fracture::EventCategoryCustom)
+* private:
+*     std::string m_Path;
+* };
+*
+* m_EventHandlers.Subscribe<&MyLayer::OnTextureLoaded>(this); // handled like the window events
+* Application::Get().PostEvent<TextureLoadedEvent>(path); // from any thread
+*
+* @see Event, PostedEventQueue
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Events\Event.h"
+
+namespace Fracture {
+
+	/*!
+	* @brief Hands out the EventType values of the custom event classes. Thread safe.
+	*
+	* @details The values start after the last value of the EventType enum. They are assigned in the order the classes first ask for their type, so they can
+	* differ between runs and must not be saved.
+	*/
+	class FRACTURE_API EventTypeRegistry
+	{
+	public:
+		static constexpr uint32_t FirstCustomType = (uint32_t)EventType::MouseScrolled + 1; /// The value of the first registered type.
+
+		/*!
+		* @brief Returns a new event type. Called once per custom event class by EVENT_CLASS_CUSTOM_TYPE.
+		*
+		* @param[in] const char* name: The name of the event class. Only logged.
+		*/
+		static EventType Register(const char* name);
+
+		/*!
+		* @brief Returns the number of event types, the values of the EventType enum included.
+		*/
+		static uint32_t GetTypeCount();
+	};
+
+/// The EVENT_CLASS_TYPE of custom event classes. The type is registered the first time it is asked for
+#define EVENT_CLASS_CUSTOM_TYPE(type) static ::Fracture::EventType GetStaticType() { static const ::Fracture::EventType s_Type = ::Fracture::EventTypeRegistry::Register(#type); return s_Type; }\
+								virtual ::Fracture::EventType GetEventType() const override { return GetStaticType(); }\
+								virtual const char* GetName() const override { return #type; }
+
+}
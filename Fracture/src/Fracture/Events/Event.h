@@ -16,8 +16,6 @@
 
 namespace Fracture {
 
-	//TODO: Buffer events and process during update stage in an events pass
-
 	/*!
 	* @brief Enum class for the different types of events.
 	*/
@@ -42,6 +40,7 @@ namespace Fracture {
 		EventCategoryKeyboard		= BIT(2),
 		EventCategoryMouse			= BIT(3),
 		EventCategoryMouseButton	= BIT(4),
+		EventCategoryCustom			= BIT(5), /// Events of a type registered at runtime. See CustomEvent.h
 	};
 
 // Here ## is the token pasting operator (https://en.cppreference.com/w/cpp/preprocessor/replace) 
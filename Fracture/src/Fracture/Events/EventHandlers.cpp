@@ -0,0 +1,55 @@
+#include "frpch.h"
+#include "EventHandlers.h"
+
+#include "Fracture\Utils\FrameStats.h"
+
+namespace Fracture {
+
+	void EventHandlerTable::Add(const EventHandlers& handlers, uint32_t owner)
+	{
+		FR_MEMORY_TAG(Events);
+		for (const EventHandlers::Subscription& subscription : handlers.GetSubscriptions())
+		{
+			uint32_t type = (uint32_t)subscription.Type;
+			if (type >= m_Handlers.size())
+				m_Handlers.resize(type + 1);
+			m_Handlers[type].push_back({ subscription.Handler, owner });
+		}
+	}
+
+	void EventHandlerTable::Clear()
+	{
+		for (std::vector<Handler>& handlers : m_Handlers)
+			handlers.clear();
+	}
+
+	void EventHandlerTable::Dispatch(EventType type, Event& e)
+	{
+		if ((uint32_t)type >= m_Handlers.size())
+			return; // A custom type nobody subscribed to
+
+		for (const Handler& handler : m_Handlers[(uint32_t)type])
+		{
+			bool handled;
+			if (handler.Owner == NoOwner)
+			{
+				handled = handler.Delegate(e);
+			}
+			else
+			{
+				using Utils::FrameStats;
+				FR_PROFILE_SCOPE_INTERNED(FrameStats::GetLayerPhaseName(handler.Owner, FrameStats::LayerPhase::Events));
+				auto start = std::chrono::high_resolution_clock::now();
+				handled = handler.Delegate(e);
+				FrameStats::RecordLayerTime(handler.Owner, FrameStats::LayerPhase::Events, std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+			}
+
+			if (handled)
+			{
+				e.Handled = true;
+				return;
+			}
+		}
+	}
+
+}
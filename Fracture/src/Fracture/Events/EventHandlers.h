@@ -0,0 +1,174 @@
+#pragma once
+/*!
+* @file EventHandlers.h
+* @brief Contains the EventDelegate, EventHandlers and EventHandlerTable classes that dispatch events to the handlers subscribed to their type.
+*
+* @details Usage:
+*
+* MyLayer::MyLayer() : Layer("MyLayer")
+* {
+*     m_EventHandlers.Subscribe<&MyLayer::OnMouseScrolled>(this); // bool MyLayer::OnMouseScrolled(MouseScrolledEvent& e)
+* }
+*
+* @see Layer, Application::OnEvent, EventDispatcher
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Events\Event.h"
+#include "Fracture\Events\CustomEvent.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace Fracture {
+
+	namespace Internal {
+
+		/// Extracts the class and the event type of a handler of the form bool C::Method(T&).
+		template<typename M>
+		struct EventMethodTraits;
+
+		template<typename C, typename T>
+		struct EventMethodTraits<bool(C::*)(T&)>
+		{
+			using Class = C;
+			using EventT = T;
+		};
+
+	}
+
+	/*!
+	* @brief A non owning handle to a member function that handles one event type. Two pointers, no allocation and no std::function.
+	*
+	* @details Bind creates a function for each handler that casts the event and calls the member function, so the cast is resolved at compile time.
+	*/
+	class EventDelegate
+	{
+	public:
+		using InvokeFn = bool(*)(void*, Event&); /// Calls the handler of the instance with the event. Returns true when the event was handled.
+
+		EventDelegate() = default;
+		EventDelegate(void* instance, InvokeFn invoke) : m_Instance(instance), m_Invoke(invoke) {}
+
+		/*!
+		* @brief Creates a delegate for a member function handling the event type T.
+		*
+		* @tparam Method: The member function, with the signature bool C::Method(T&).
+		* @param[in] C* instance: The object the member function is called on. Must outlive the delegate.
+		*/
+		template<auto Method, typename C>
+		static EventDelegate Bind(C* instance)
+		{
+			using Traits = Internal::EventMethodTraits<decltype(Method)>;
+			using EventT = typename Traits::EventT;
+			using Class = typename Traits::Class;
+			static_assert(std::is_base_of_v<Event, EventT>, "Event handlers must take a reference to an Event class");
+			static_assert(std::is_base_of_v<Class, C>, "The instance must be of the class of the handler");
+			return EventDelegate(static_cast<Class*>(instance), [](void* object, Event& e) { return (static_cast<Class*>(object)->*Method)(static_cast<EventT&>(e)); });
+		}
+
+		inline bool operator()(Event& e) const { return m_Invoke(m_Instance, e); }
+	private:
+		void* m_Instance = nullptr; /// The object the handler is called on.
+		InvokeFn m_Invoke = nullptr; /// The function that casts the event and calls the handler.
+	};
+
+	/*!
+	* @brief The handlers of one owner (a layer, the application) and the event types they are subscribed to.
+	*
+	* @details Owners subscribe once, in their constructor or OnAttach. The EventHandlerTable of the application copies the subscriptions when the layer
+	* is pushed.
+	*/
+	class EventHandlers
+	{
+	public:
+		/*!
+		* @brief A handler and the event type it handles.
+		*/
+		struct Subscription
+		{
+			EventType Type;
+			EventDelegate Handler;
+		};
+
+		/*!
+		* @brief Subscribes a member function to the event type it takes.
+		*
+		* @tparam Method: The member function, with the signature bool C::Method(T&). Returning true stops the event from reaching the handlers after it.
+		* @param[in] C* instance: The object the member function is called on. Must outlive the subscription.
+		*/
+		template<auto Method, typename C>
+		void Subscribe(C* instance)
+		{
+			using EventT = typename Internal::EventMethodTraits<decltype(Method)>::EventT;
+			m_Subscriptions.push_back({ EventT::GetStaticType(), EventDelegate::Bind<Method>(instance) });
+		}
+
+		inline const std::vector<Subscription>& GetSubscriptions() const { return m_Subscriptions; }
+		inline void Clear() { m_Subscriptions.clear(); }
+	private:
+		std::vector<Subscription> m_Subscriptions; /// The handlers in the order they were subscribed.
+	};
+
+	/*!
+	* @brief The handlers of every event type, in the order they are called.
+	*
+	* @details Dispatch goes straight to the handlers of the event type, so an event never reaches an owner that did not subscribe to it and the handlers are
+	* called through plain function pointers. The typed overload takes the event type at compile time and makes no virtual call at all.
+	*
+	* The handlers of each type are called in the order the owners were added, until one returns true. Then the event is marked handled and not passed on.
+	* Custom event types registered with the EventTypeRegistry get their slot the first time a handler subscribes to them.
+	* The handlers of an owner added with a FrameStats layer index are timed, into the OnEvent time of the layer and a profiler scope.
+	*/
+	class EventHandlerTable
+	{
+	public:
+		static constexpr uint32_t NoOwner = UINT32_MAX; /// The owner of handlers that are not timed.
+
+		/*!
+		* @brief Appends the subscriptions of an owner after the ones already added.
+		*
+		* @param[in] const EventHandlers& handlers: The subscriptions of the owner.
+		* @param[in] uint32_t owner: The index returned by Utils::FrameStats::RegisterLayer for the owner, or NoOwner to not time its handlers.
+		*/
+		void Add(const EventHandlers& handlers, uint32_t owner = NoOwner);
+
+		/*!
+		* @brief Removes every handler.
+		*/
+		void Clear();
+
+		/*!
+		* @brief Dispatches an event whose type is known at compile time.
+		*/
+		template<typename T>
+		inline void Dispatch(T& e) { Dispatch(T::GetStaticType(), e); }
+
+		/*!
+		* @brief Dispatches an event through its base class, reading its type with GetEventType.
+		*/
+		inline void Dispatch(Event& e) { Dispatch(e.GetEventType(), e); }
+
+		/*!
+		* @brief Calls the handlers subscribed to the type until one returns true.
+		*/
+		void Dispatch(EventType type, Event& e);
+
+		/*!
+		* @brief Returns the number of handlers subscribed to the type.
+		*/
+		inline uint32_t GetHandlerCount(EventType type) const { return (uint32_t)type < m_Handlers.size() ? (uint32_t)m_Handlers[(uint32_t)type].size() : 0; }
+	private:
+		/// A handler and the owner it is timed for.
+		struct Handler
+		{
+			EventDelegate Delegate;
+			uint32_t Owner;
+		};
+
+		std::vector<std::vector<Handler>> m_Handlers = std::vector<std::vector<Handler>>(EventTypeRegistry::FirstCustomType); /// The handlers of each event type, indexed by EventType.
+	};
+
+}
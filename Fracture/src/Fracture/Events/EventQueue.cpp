@@ -0,0 +1,97 @@
+#include "frpch.h"
+#include "EventQueue.h"
+
+namespace Fracture {
+
+	EventQueue::EventQueue(uint32_t capacity)
+	{
+		uint32_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+		m_Events.resize(size);
+		std::fill(std::begin(m_Pending), std::end(m_Pending), NoPending);
+	}
+
+	void EventQueue::Push(const QueuedEvent& event)
+	{
+		bool mouseSample = event.Type == EventType::MouseMoved || event.Type == EventType::MouseScrolled;
+		if (mouseSample && m_RawSampleListeners > 0)
+		{
+			FR_MEMORY_TAG(Events);
+			m_RawSamples.push_back(event);
+		}
+
+		if (Coalesce(event))
+		{
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::EventsCoalesced);
+			return;
+		}
+
+		if (m_Size == Capacity())
+			Grow();
+		m_Events[(m_Head + m_Size) & (Capacity() - 1)] = event;
+		uint64_t sequence = m_Popped + m_Size;
+		m_Size++;
+
+		switch (event.Type)
+		{
+		// A move merged past a scroll would change the cursor position the scroll happened at, and the other way around
+		case EventType::MouseMoved: m_Pending[PendingMouseMoved] = sequence; m_Pending[PendingMouseScrolled] = NoPending; break;
+		case EventType::MouseScrolled: m_Pending[PendingMouseScrolled] = sequence; m_Pending[PendingMouseMoved] = NoPending; break;
+		case EventType::WindowResize: m_Pending[PendingWindowResize] = sequence; break;
+		default:
+			// Anything else may depend on the events before it (a click on the cursor position), so nothing queued before it is merged into anymore
+			std::fill(std::begin(m_Pending), std::end(m_Pending), NoPending);
+			break;
+		}
+	}
+
+	bool EventQueue::Coalesce(const QueuedEvent& event)
+	{
+		uint32_t pending;
+		switch (event.Type)
+		{
+		case EventType::MouseMoved: if (!m_Coalescing.MouseMoves) return false; pending = PendingMouseMoved; break;
+		case EventType::MouseScrolled: if (!m_Coalescing.Scrolls) return false; pending = PendingMouseScrolled; break;
+		case EventType::WindowResize: if (!m_Coalescing.Resizes) return false; pending = PendingWindowResize; break;
+		default: return false;
+		}
+
+		uint64_t sequence = m_Pending[pending];
+		if (sequence == NoPending || sequence < m_Popped)
+			return false;
+
+		QueuedEvent& queued = m_Events[(m_Head + (uint32_t)(sequence - m_Popped)) & (Capacity() - 1)];
+		if (event.Type == EventType::MouseScrolled)
+		{
+			queued.Mouse.X += event.Mouse.X;
+			queued.Mouse.Y += event.Mouse.Y;
+		}
+		else
+		{
+			queued = event; // Last wins
+		}
+		return true;
+	}
+
+	void EventQueue::RemoveRawSampleListener()
+	{
+		FR_CORE_ASSERT(m_RawSampleListeners > 0, "RemoveRawSampleListener called without a matching AddRawSampleListener");
+		if (--m_RawSampleListeners == 0)
+		{
+			m_RawSamples.clear();
+			m_DispatchedRawSamples.clear();
+		}
+	}
+
+	void EventQueue::Grow()
+	{
+		FR_MEMORY_TAG(Events);
+		std::vector<QueuedEvent> events(Capacity() * 2);
+		for (uint32_t i = 0; i < m_Size; i++)
+			events[i] = m_Events[(m_Head + i) & (Capacity() - 1)];
+		m_Events.swap(events);
+		m_Head = 0;
+	}
+
+}
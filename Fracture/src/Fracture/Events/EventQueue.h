@@ -0,0 +1,211 @@
+#pragma once
+/*!
+* @file EventQueue.h
+* @brief Contains the QueuedEvent struct and the EventQueue class that buffers the window events of a frame and dispatches them in one pass.
+*
+* @details Usage:
+*
+* EventQueue queue;
+* queue.Push(QueuedEvent::MouseMoved(x, y)); // from the GLFW callbacks, while the window polls events
+*
+* queue.Dispatch([this](auto& e) { m_EventHandlers.Dispatch(e); }); // once per frame, from Application::Run
+*
+* queue.AddRawSampleListener(); // in OnAttach of a layer that needs every mouse sample
+* for (const QueuedEvent& sample : queue.GetRawSamples()) { ... } // in OnUpdate
+*
+* @see Application::Run, Window::SetEventQueue
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Events\Event.h"
+#include "Fracture\Events\ApplicationEvent.h"
+#include "Fracture\Events\KeyEvent.h"
+#include "Fracture\Events\MouseEvent.h"
+
+#include "Fracture\Utils\FrameStats.h"
+
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief A plain copy of an event. The payload that is valid depends on Type.
+	*/
+	struct QueuedEvent
+	{
+		struct ResizeData { uint32_t Width, Height; };
+		struct KeyData { int32_t KeyCode, Mods; bool Repeated; };
+		struct MouseButtonData { int32_t Button, Mods; };
+		struct MouseData { float X, Y; };
+
+		EventType Type = EventType::None;
+		union
+		{
+			ResizeData Resize; /// WindowResize
+			KeyData Key; /// KeyPressed, KeyReleased, KeyTyped
+			MouseButtonData MouseButton; /// MouseButtonPressed, MouseButtonReleased
+			MouseData Mouse; /// The position for MouseMoved, the offset for MouseScrolled
+		};
+
+		QueuedEvent() : Resize{ 0, 0 } {}
+
+		static QueuedEvent WindowResize(uint32_t width, uint32_t height) { QueuedEvent e; e.Type = EventType::WindowResize; e.Resize = { width, height }; return e; }
+		static QueuedEvent WindowClose() { QueuedEvent e; e.Type = EventType::WindowClose; return e; }
+		static QueuedEvent KeyPressed(int32_t keyCode, bool repeated, int32_t mods) { QueuedEvent e; e.Type = EventType::KeyPressed; e.Key = { keyCode, mods, repeated }; return e; }
+		static QueuedEvent KeyReleased(int32_t keyCode, int32_t mods) { QueuedEvent e; e.Type = EventType::KeyReleased; e.Key = { keyCode, mods, false }; return e; }
+		static QueuedEvent KeyTyped(int32_t keyCode) { QueuedEvent e; e.Type = EventType::KeyTyped; e.Key = { keyCode, 0, false }; return e; }
+		static QueuedEvent MouseButtonPressed(int32_t button, int32_t mods) { QueuedEvent e; e.Type = EventType::MouseButtonPressed; e.MouseButton = { button, mods }; return e; }
+		static QueuedEvent MouseButtonReleased(int32_t button, int32_t mods) { QueuedEvent e; e.Type = EventType::MouseButtonReleased; e.MouseButton = { button, mods }; return e; }
+		static QueuedEvent MouseMoved(float x, float y) { QueuedEvent e; e.Type = EventType::MouseMoved; e.Mouse = { x, y }; return e; }
+		static QueuedEvent MouseScrolled(float xOffset, float yOffset) { QueuedEvent e; e.Type = EventType::MouseScrolled; e.Mouse = { xOffset, yOffset }; return e; }
+	};
+
+	/*!
+	* @brief Selects the events the EventQueue merges when they are pushed.
+	*/
+	struct EventCoalescing
+	{
+		bool MouseMoves = true; /// Only the last MouseMoved position is kept.
+		bool Resizes = true; /// Only the last WindowResize size is kept.
+		bool Scrolls = true; /// The MouseScrolled offsets are added up.
+	};
+
+	/*!
+	* @brief Ring buffer of the events raised during a frame.
+	*
+	* @details The window only copies its events into the queue while it polls, which is cheap and keeps the layers out of the GLFW callbacks. Dispatch
+	* turns each queued event back into its Event class on the stack and hands it to the handler, in the order the events were pushed. The events are
+	* walked in one pass over contiguous memory at a fixed point of the frame.
+	*
+	* Mouse moves, resizes and scrolls can arrive many times per frame, and each one would walk the whole layer stack and, for resizes, reset the viewport
+	* and the camera projections. Push merges them into the matching event that is still queued, as selected by the EventCoalescing settings. An event is only
+	* merged while no key or mouse button event has been queued after it, so a click is still dispatched after the move that brought the cursor to it.
+	* Moves and scrolls are not merged across each other either, so a scroll keeps the cursor position it happened at.
+	*
+	* Layers that need every mouse sample (drawing, gestures) register with AddRawSampleListener. While there is a listener, every MouseMoved and MouseScrolled
+	* sample is also recorded unmerged and GetRawSamples returns the samples of the last dispatch, in the order they arrived.
+	*
+	* The buffer doubles when it is full and never shrinks. Only used from the main thread.
+	*/
+	class EventQueue
+	{
+	public:
+		EventQueue(uint32_t capacity = 256);
+
+		/*!
+		* @brief Appends an event.
+		*/
+		void Push(const QueuedEvent& event);
+
+		inline void SetCoalescing(const EventCoalescing& coalescing) { m_Coalescing = coalescing; }
+		inline const EventCoalescing& GetCoalescing() const { return m_Coalescing; }
+
+		/*!
+		* @brief Starts recording the raw mouse samples. Calls must be balanced with RemoveRawSampleListener.
+		*/
+		inline void AddRawSampleListener() { m_RawSampleListeners++; }
+
+		/*!
+		* @brief Stops recording the raw mouse samples once every listener is removed.
+		*/
+		void RemoveRawSampleListener();
+
+		/*!
+		* @brief Returns the unmerged MouseMoved and MouseScrolled samples that arrived before the last Dispatch. Empty without a listener.
+		*/
+		inline const std::vector<QueuedEvent>& GetRawSamples() const { return m_DispatchedRawSamples; }
+
+		/*!
+		* @brief Hands every queued event to the handler, oldest first, and empties the queue.
+		*
+		* @details Events pushed by the handler are kept for the next Dispatch.
+		*
+		* @tparam F: Callable with the signature void(Event&). A generic lambda is called with the concrete event class.
+		*/
+		template<typename F>
+		void Dispatch(F&& handler)
+		{
+			Drain([&handler](const QueuedEvent& queued) { Visit(queued, handler); });
+		}
+
+		/*!
+		* @brief Hands every queued event to the function as a QueuedEvent, oldest first, and empties the queue. Dispatch without constructing the events.
+		*
+		* @tparam F: Callable with the signature void(const QueuedEvent&).
+		*/
+		template<typename F>
+		void Drain(F&& fn)
+		{
+			m_DispatchedRawSamples.swap(m_RawSamples);
+			m_RawSamples.clear();
+			std::fill(std::begin(m_Pending), std::end(m_Pending), NoPending);
+
+			uint32_t count = m_Size;
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::EventsDispatched, count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				// Copied out because the handler may push and grow the buffer
+				QueuedEvent queued = m_Events[m_Head];
+				m_Head = (m_Head + 1) & (Capacity() - 1);
+				m_Size--;
+				m_Popped++;
+				fn(queued);
+			}
+		}
+
+		inline uint32_t GetSize() const { return m_Size; }
+		inline bool IsEmpty() const { return m_Size == 0; }
+
+		/*!
+		* @brief Constructs the Event class of a queued event on the stack and passes it to the handler.
+		*/
+		template<typename F>
+		static void Visit(const QueuedEvent& queued, F&& handler)
+		{
+			switch (queued.Type)
+			{
+			case EventType::WindowResize: { WindowResizeEvent e(queued.Resize.Width, queued.Resize.Height); handler(e); break; }
+			case EventType::WindowClose: { WindowCloseEvent e; handler(e); break; }
+			case EventType::KeyPressed: { KeyPressedEvent e(queued.Key.KeyCode, queued.Key.Repeated, queued.Key.Mods); handler(e); break; }
+			case EventType::KeyReleased: { KeyReleasedEvent e(queued.Key.KeyCode, queued.Key.Mods); handler(e); break; }
+			case EventType::KeyTyped: { KeyTypedEvent e(queued.Key.KeyCode); handler(e); break; }
+			case EventType::MouseButtonPressed: { MouseButtonPressedEvent e(queued.MouseButton.Button, queued.MouseButton.Mods); handler(e); break; }
+			case EventType::MouseButtonReleased: { MouseButtonReleasedEvent e(queued.MouseButton.Button, queued.MouseButton.Mods); handler(e); break; }
+			case EventType::MouseMoved: { MouseMovedEvent e(queued.Mouse.X, queued.Mouse.Y); handler(e); break; }
+			case EventType::MouseScrolled: { MouseScrolledEvent e(queued.Mouse.X, queued.Mouse.Y); handler(e); break; }
+			default: FR_CORE_ASSERT(false, "Event type {0} cannot be queued", (int)queued.Type); break;
+			}
+		}
+	private:
+		inline uint32_t Capacity() const { return (uint32_t)m_Events.size(); }
+
+		/*!
+		* @brief Doubles the buffer, moving the queued events to its start.
+		*/
+		void Grow();
+
+		/*!
+		* @brief Merges the event into the queued event of the same type. Returns false when there is none to merge into.
+		*/
+		bool Coalesce(const QueuedEvent& event);
+	private:
+		/// The events that can be merged, indexing m_Pending.
+		enum PendingType : uint32_t { PendingMouseMoved = 0, PendingMouseScrolled, PendingWindowResize, PendingCount };
+		static constexpr uint64_t NoPending = ~0ull;
+
+		std::vector<QueuedEvent> m_Events; /// The ring buffer. Its size is a power of two.
+		uint32_t m_Head = 0; /// The index of the oldest event.
+		uint32_t m_Size = 0; /// The number of queued events.
+		uint64_t m_Popped = 0; /// The number of events taken out of the queue since it was created. The sequence number of the event at m_Head.
+
+		EventCoalescing m_Coalescing; /// The events merged by Push.
+		uint64_t m_Pending[PendingCount]; /// The sequence number of the queued event each type is merged into, or NoPending.
+
+		uint32_t m_RawSampleListeners = 0; /// The number of layers that want the raw mouse samples.
+		std::vector<QueuedEvent> m_RawSamples; /// The raw mouse samples pushed since the last Dispatch.
+		std::vector<QueuedEvent> m_DispatchedRawSamples; /// The raw mouse samples of the last Dispatch.
+	};
+
+}
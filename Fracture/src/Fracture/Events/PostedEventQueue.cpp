@@ -0,0 +1,42 @@
+#include "frpch.h"
+#include "PostedEventQueue.h"
+
+namespace Fracture {
+
+	PostedEventQueue::~PostedEventQueue()
+	{
+		Node* node = TakeAll();
+		while (node)
+		{
+			Node* next = node->Next;
+			delete node;
+			node = next;
+		}
+	}
+
+	void PostedEventQueue::Push(Node* node)
+	{
+		Node* head = m_Head.load(std::memory_order_relaxed);
+		do
+		{
+			node->Next = head;
+		} while (!m_Head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	PostedEventQueue::Node* PostedEventQueue::TakeAll()
+	{
+		Node* node = m_Head.exchange(nullptr, std::memory_order_acquire);
+
+		// The list is newest first, reverse it to dispatch in posting order
+		Node* oldest = nullptr;
+		while (node)
+		{
+			Node* next = node->Next;
+			node->Next = oldest;
+			oldest = node;
+			node = next;
+		}
+		return oldest;
+	}
+
+}
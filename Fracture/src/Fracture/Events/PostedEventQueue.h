@@ -0,0 +1,117 @@
+#pragma once
+/*!
+* @file PostedEventQueue.h
+* @brief Contains the PostedEventQueue class through which any thread can post events to the main thread.
+*
+* @details Usage:
+*
+* queue.Post<TextureLoadedEvent>(path); // from a worker thread
+*
+* queue.Drain([this](Event& e) { m_EventHandlers.Dispatch(e); }); // once per frame, on the main thread
+*
+* @see Application::PostEvent, CustomEvent.h
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Events\Event.h"
+
+#include <atomic>
+#include <utility>
+
+namespace Fracture {
+
+	/*!
+	* @brief Lock free multiple producer, single consumer queue of events.
+	*
+	* @details Post allocates the event and pushes it onto an intrusive list with a compare exchange loop, so producers never block each other or the main thread.
+	* Drain takes the whole list with one exchange and reverses it, so each drain dispatches the events in the order they were posted. Because the consumer
+	* always takes the whole list and nodes are only freed by the consumer, the list has no ABA problem.
+	*
+	* Post may be called from any thread. Drain must only be called from one thread, the main thread in the Application.
+	*/
+	class PostedEventQueue
+	{
+	public:
+		PostedEventQueue() = default;
+		~PostedEventQueue();
+
+		PostedEventQueue(const PostedEventQueue&) = delete;
+		PostedEventQueue& operator=(const PostedEventQueue&) = delete;
+
+		/*!
+		* @brief Constructs an event and queues it. Thread safe.
+		*
+		* @tparam T: The event class.
+		* @param[in] Args&&... args: The arguments of the constructor of T.
+		*/
+		template<typename T, typename... Args>
+		void Post(Args&&... args)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "Only Event classes can be posted");
+			FR_MEMORY_TAG(Events);
+			Push(new PostedEvent<T>(std::forward<Args>(args)...));
+		}
+
+		/*!
+		* @brief Hands every event posted before the call to the handler, oldest first, and frees them.
+		*
+		* @details Events posted while draining, by the handler or by other threads, are kept for the next Drain.
+		*
+		* @tparam F: Callable with the signature void(Event&).
+		*/
+		template<typename F>
+		void Drain(F&& handler)
+		{
+			Node* node = TakeAll();
+			while (node)
+			{
+				Node* next = node->Next;
+				handler(node->Get());
+				delete node;
+				node = next;
+			}
+		}
+
+		/*!
+		* @brief Returns true if nothing was posted since the last Drain. Only a hint while other threads post.
+		*/
+		inline bool IsEmpty() const { return m_Head.load(std::memory_order_relaxed) == nullptr; }
+	private:
+		/*!
+		* @brief A queued event. The list is linked through Next.
+		*/
+		struct Node
+		{
+			Node* Next = nullptr;
+
+			virtual ~Node() = default;
+			virtual Event& Get() = 0;
+		};
+
+		template<typename T>
+		struct PostedEvent : public Node
+		{
+			T Value;
+
+			template<typename... Args>
+			PostedEvent(Args&&... args) : Value(std::forward<Args>(args)...) {}
+
+			Event& Get() override { return Value; }
+		};
+
+		/*!
+		* @brief Pushes a node onto the list. Thread safe.
+		*/
+		void Push(Node* node);
+
+		/*!
+		* @brief Takes the whole list and returns it oldest first.
+		*/
+		Node* TakeAll();
+	private:
+		std::atomic<Node*> m_Head{ nullptr }; /// The newest posted event. The list runs from the newest to the oldest.
+	};
+
+}
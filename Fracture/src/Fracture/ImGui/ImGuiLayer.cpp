@@ -5,6 +5,10 @@
 #include "imgui.h"
 #include "Fracture\Core\Core.h"
 #include "Fracture\Core\Application.h"
+#include "Fracture\Input\KeyCodes.h"
+#include "Fracture\Renderer\RendererAPI.h"
+#include "Fracture\Utils\FrameStats.h"
+#include "Platform\OpenGL\OpenGLState.h"
 
 #define IMGUI_IMPL_API
 #include "backends\imgui_impl_glfw.h"
@@ -15,6 +19,83 @@
 
 namespace Fracture {
 
+	namespace {
+
+		/// Translates an engine key code to the ImGui key. The engine uses the GLFW key codes, so this is the table of the GLFW backend.
+		ImGuiKey ToImGuiKey(int keyCode)
+		{
+			if (keyCode >= FR_KEY_0 && keyCode <= FR_KEY_9)
+				return (ImGuiKey)(ImGuiKey_0 + (keyCode - FR_KEY_0));
+			if (keyCode >= FR_KEY_A && keyCode <= FR_KEY_Z)
+				return (ImGuiKey)(ImGuiKey_A + (keyCode - FR_KEY_A));
+			if (keyCode >= FR_KEY_F1 && keyCode <= FR_KEY_F12)
+				return (ImGuiKey)(ImGuiKey_F1 + (keyCode - FR_KEY_F1));
+			if (keyCode >= FR_KEY_KP_0 && keyCode <= FR_KEY_KP_9)
+				return (ImGuiKey)(ImGuiKey_Keypad0 + (keyCode - FR_KEY_KP_0));
+
+			switch (keyCode)
+			{
+			case FR_KEY_TAB: return ImGuiKey_Tab;
+			case FR_KEY_LEFT: return ImGuiKey_LeftArrow;
+			case FR_KEY_RIGHT: return ImGuiKey_RightArrow;
+			case FR_KEY_UP: return ImGuiKey_UpArrow;
+			case FR_KEY_DOWN: return ImGuiKey_DownArrow;
+			case FR_KEY_PAGE_UP: return ImGuiKey_PageUp;
+			case FR_KEY_PAGE_DOWN: return ImGuiKey_PageDown;
+			case FR_KEY_HOME: return ImGuiKey_Home;
+			case FR_KEY_END: return ImGuiKey_End;
+			case FR_KEY_INSERT: return ImGuiKey_Insert;
+			case FR_KEY_DELETE: return ImGuiKey_Delete;
+			case FR_KEY_BACKSPACE: return ImGuiKey_Backspace;
+			case FR_KEY_SPACE: return ImGuiKey_Space;
+			case FR_KEY_ENTER: return ImGuiKey_Enter;
+			case FR_KEY_ESCAPE: return ImGuiKey_Escape;
+			case FR_KEY_APOSTROPHE: return ImGuiKey_Apostrophe;
+			case FR_KEY_COMMA: return ImGuiKey_Comma;
+			case FR_KEY_MINUS: return ImGuiKey_Minus;
+			case FR_KEY_PERIOD: return ImGuiKey_Period;
+			case FR_KEY_SLASH: return ImGuiKey_Slash;
+			case FR_KEY_SEMICOLON: return ImGuiKey_Semicolon;
+			case FR_KEY_EQUAL: return ImGuiKey_Equal;
+			case FR_KEY_LEFT_BRACKET: return ImGuiKey_LeftBracket;
+			case FR_KEY_BACKSLASH: return ImGuiKey_Backslash;
+			case FR_KEY_RIGHT_BRACKET: return ImGuiKey_RightBracket;
+			case FR_KEY_GRAVE_ACCENT: return ImGuiKey_GraveAccent;
+			case FR_KEY_CAPS_LOCK: return ImGuiKey_CapsLock;
+			case FR_KEY_SCROLL_LOCK: return ImGuiKey_ScrollLock;
+			case FR_KEY_NUM_LOCK: return ImGuiKey_NumLock;
+			case FR_KEY_PRINT_SCREEN: return ImGuiKey_PrintScreen;
+			case FR_KEY_PAUSE: return ImGuiKey_Pause;
+			case FR_KEY_KP_DECIMAL: return ImGuiKey_KeypadDecimal;
+			case FR_KEY_KP_DIVIDE: return ImGuiKey_KeypadDivide;
+			case FR_KEY_KP_MULTIPLY: return ImGuiKey_KeypadMultiply;
+			case FR_KEY_KP_SUBTRACT: return ImGuiKey_KeypadSubtract;
+			case FR_KEY_KP_ADD: return ImGuiKey_KeypadAdd;
+			case FR_KEY_KP_ENTER: return ImGuiKey_KeypadEnter;
+			case FR_KEY_KP_EQUAL: return ImGuiKey_KeypadEqual;
+			case FR_KEY_LEFT_SHIFT: return ImGuiKey_LeftShift;
+			case FR_KEY_LEFT_CONTROL: return ImGuiKey_LeftCtrl;
+			case FR_KEY_LEFT_ALT: return ImGuiKey_LeftAlt;
+			case FR_KEY_LEFT_SUPER: return ImGuiKey_LeftSuper;
+			case FR_KEY_RIGHT_SHIFT: return ImGuiKey_RightShift;
+			case FR_KEY_RIGHT_CONTROL: return ImGuiKey_RightCtrl;
+			case FR_KEY_RIGHT_ALT: return ImGuiKey_RightAlt;
+			case FR_KEY_RIGHT_SUPER: return ImGuiKey_RightSuper;
+			case FR_KEY_MENU: return ImGuiKey_Menu;
+			default: return ImGuiKey_None;
+			}
+		}
+
+		/// Returns whether a modifier is held after a key event. GLFW does not report a modifier key in its own mods on every platform, so the key decides its own modifier.
+		bool IsModifierDown(int keyCode, int mods, bool down, int mod, int leftKey, int rightKey)
+		{
+			if (keyCode == leftKey || keyCode == rightKey)
+				return down;
+			return (mods & mod) != 0;
+		}
+
+	}
+
 	ImGuiLayer::ImGuiLayer() :
 		Layer("ImGuiLayer")
 	{
@@ -29,7 +110,8 @@ namespace Fracture {
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
 		//io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+		if (AreViewportsSupported())
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
 
 		ImGui::StyleColorsDark();
 
@@ -46,13 +128,22 @@ namespace Fracture {
 		/*io.BackendFlags |= ImGuiBackendFlags_HasMouseCursors;
 		io.BackendFlags |= ImGuiBackendFlags_HasSetMousePos;*/
 
-		ImGui_ImplGlfw_InitForOpenGL(window, true);
-		ImGui_ImplOpenGL3_Init("#version 410");
+		if (RendererAPI::GetAPI() == RendererAPI::API::OpenGL)
+		{
+			ImGui_ImplGlfw_InitForOpenGL(window, false); // Input comes from OnInputEvent, so recorded input can be replayed
+			ImGui_ImplOpenGL3_Init("#version 410");
+		}
+		else
+		{
+			// The software renderer has no ImGui backend yet. Input still reaches ImGui through OnInputEvent but the draw data is not rendered.
+			ImGui_ImplGlfw_InitForOther(window, false);
+		}
 	}
 
 	void ImGuiLayer::OnDetach()
 	{
-		ImGui_ImplOpenGL3_Shutdown();
+		if (RendererAPI::GetAPI() == RendererAPI::API::OpenGL)
+			ImGui_ImplOpenGL3_Shutdown();
 		ImGui_ImplGlfw_Shutdown();
 		ImGui::DestroyContext();
 	}
@@ -60,8 +151,10 @@ namespace Fracture {
     void ImGuiLayer::Begin()
     {
 		FR_PROFILE_SCOPE("ImGuiLayer::Begin");
-		ImGui_ImplOpenGL3_NewFrame();
+		if (RendererAPI::GetAPI() == RendererAPI::API::OpenGL)
+			ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplGlfw_NewFrame();
+		AddMousePosition(); // Without its callbacks the backend polls the live cursor of the focused window. The position of the events is queued after it and wins
 		ImGui::NewFrame();
     }
 
@@ -79,20 +172,166 @@ namespace Fracture {
 		}
 		{
 			FR_PROFILE_SCOPE("ImGuiLayer::End::DrawData");
-			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			if (RendererAPI::GetAPI() == RendererAPI::API::OpenGL)
+			{
+				ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+				OpenGLState::Invalidate(); // The backend changes OpenGL state behind the state cache
+			}
 		}
+		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
 			FR_PROFILE_SCOPE("ImGuiLayer::End::Viewport");
-			if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
-			{
-				GLFWwindow* backup_current_context = glfwGetCurrentContext();
-				ImGui::UpdatePlatformWindows();
-				ImGui::RenderPlatformWindowsDefault();
-				glfwMakeContextCurrent(backup_current_context);
-			}
+			auto viewportStart = std::chrono::high_resolution_clock::now();
+			GLFWwindow* backup_current_context = glfwGetCurrentContext();
+			ImGui::UpdatePlatformWindows();
+			ImGui::RenderPlatformWindowsDefault();
+			glfwMakeContextCurrent(backup_current_context);
+			Utils::FrameStats::Record(Utils::FrameStats::Metric::ViewportTime, std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - viewportStart).count());
 		}
+		m_HasFrame = true;
     }
 
+	bool ImGuiLayer::ShouldRebuild(float deltaTime)
+	{
+		bool input = m_InputThisFrame;
+		m_InputThisFrame = false;
+		if (input)
+			m_SettleFrames = SettleFrameCount;
+
+		m_TimeSinceRebuild += deltaTime;
+		bool rebuild = m_RedrawMode == RedrawMode::EveryFrame || !m_HasFrame || m_SettleFrames > 0 || m_TimeSinceRebuild >= m_IdleRefreshInterval;
+		if (rebuild)
+		{
+			m_TimeSinceRebuild = 0.0f;
+			if (m_SettleFrames > 0)
+				m_SettleFrames--;
+		}
+		return rebuild;
+	}
+
+	void ImGuiLayer::RenderCached()
+	{
+		FR_PROFILE_SCOPE("ImGuiLayer::RenderCached");
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ImGuiFramesReused);
+		if (RendererAPI::GetAPI() == RendererAPI::API::OpenGL)
+		{
+			// Valid until the next NewFrame. The platform windows keep showing their last frame.
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			OpenGLState::Invalidate();
+		}
+	}
+
+	void ImGuiLayer::OnInputEvent(const KeyPressedEvent& e)
+	{
+		AddKeyEvent(e.GetKeyCode(), e.GetKeyMods(), true);
+	}
+
+	void ImGuiLayer::OnInputEvent(const KeyReleasedEvent& e)
+	{
+		AddKeyEvent(e.GetKeyCode(), e.GetKeyMods(), false);
+	}
+
+	void ImGuiLayer::OnInputEvent(const KeyTypedEvent& e)
+	{
+		m_InputThisFrame = true;
+		if (e.GetKeyCode() > 0)
+			ImGui::GetIO().AddInputCharacter((unsigned int)e.GetKeyCode());
+	}
+
+	void ImGuiLayer::OnInputEvent(const MouseButtonPressedEvent& e)
+	{
+		AddMouseButtonEvent(e.GetMouseButton(), e.GetMouseMod(), true);
+	}
+
+	void ImGuiLayer::OnInputEvent(const MouseButtonReleasedEvent& e)
+	{
+		AddMouseButtonEvent(e.GetMouseButton(), e.GetMouseMod(), false);
+	}
+
+	void ImGuiLayer::OnInputEvent(const MouseMovedEvent& e)
+	{
+		m_InputThisFrame = true;
+		m_MouseX = e.GetX();
+		m_MouseY = e.GetY();
+		m_HasMousePosition = true;
+		if (IsEnabled())
+			AddMousePosition(); // While the UI is hidden only the last position is kept, so the moves do not pile up in the ImGui input queue
+	}
+
+	void ImGuiLayer::OnInputEvent(const MouseScrolledEvent& e)
+	{
+		m_InputThisFrame = true;
+		ImGui::GetIO().AddMouseWheelEvent(e.GetXOffset(), e.GetYOffset());
+	}
+
+	void ImGuiLayer::AddKeyEvent(int keyCode, int mods, bool down)
+	{
+		m_InputThisFrame = true;
+		ImGuiIO& io = ImGui::GetIO();
+		io.AddKeyEvent(ImGuiMod_Ctrl, IsModifierDown(keyCode, mods, down, FR_MOD_CONTROL, FR_KEY_LEFT_CONTROL, FR_KEY_RIGHT_CONTROL));
+		io.AddKeyEvent(ImGuiMod_Shift, IsModifierDown(keyCode, mods, down, FR_MOD_SHIFT, FR_KEY_LEFT_SHIFT, FR_KEY_RIGHT_SHIFT));
+		io.AddKeyEvent(ImGuiMod_Alt, IsModifierDown(keyCode, mods, down, FR_MOD_ALT, FR_KEY_LEFT_ALT, FR_KEY_RIGHT_ALT));
+		io.AddKeyEvent(ImGuiMod_Super, IsModifierDown(keyCode, mods, down, FR_MOD_SUPER, FR_KEY_LEFT_SUPER, FR_KEY_RIGHT_SUPER));
+
+		ImGuiKey key = ToImGuiKey(keyCode);
+		if (key != ImGuiKey_None)
+			io.AddKeyEvent(key, down);
+	}
+
+	void ImGuiLayer::AddMouseButtonEvent(int button, int mods, bool down)
+	{
+		m_InputThisFrame = true;
+		ImGuiIO& io = ImGui::GetIO();
+		io.AddKeyEvent(ImGuiMod_Ctrl, (mods & FR_MOD_CONTROL) != 0);
+		io.AddKeyEvent(ImGuiMod_Shift, (mods & FR_MOD_SHIFT) != 0);
+		io.AddKeyEvent(ImGuiMod_Alt, (mods & FR_MOD_ALT) != 0);
+		io.AddKeyEvent(ImGuiMod_Super, (mods & FR_MOD_SUPER) != 0);
+		if (button >= 0 && button < ImGuiMouseButton_COUNT)
+			io.AddMouseButtonEvent(button, down);
+	}
+
+	void ImGuiLayer::AddMousePosition()
+	{
+		if (!m_HasMousePosition)
+			return;
+
+		float x = m_MouseX, y = m_MouseY;
+		ImGuiIO& io = ImGui::GetIO();
+		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+		{
+			// With viewports ImGui works in desktop coordinates
+			int windowX = 0, windowY = 0;
+			glfwGetWindowPos(static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow()), &windowX, &windowY);
+			x += (float)windowX;
+			y += (float)windowY;
+		}
+		io.AddMousePosEvent(x, y);
+	}
+
+	bool ImGuiLayer::AreViewportsSupported() const
+	{
+		// Platform windows are rendered with OpenGL so they are only available with the OpenGL renderer
+		return RendererAPI::GetAPI() == RendererAPI::API::OpenGL;
+	}
+
+	void ImGuiLayer::SetViewportsEnabled(bool enabled)
+	{
+		if (!AreViewportsSupported())
+			return;
+
+		// ImGui picks the change up at the next NewFrame and moves the windows of the platform windows back into the main viewport
+		ImGuiIO& io = ImGui::GetIO();
+		if (enabled)
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+		else
+			io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+	}
+
+	bool ImGuiLayer::AreViewportsEnabled() const
+	{
+		return (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable) != 0;
+	}
+
 	void ImGuiLayer::OnImGuiRender()
 	{
 		/*static bool show = true;
@@ -7,9 +7,26 @@
 
 namespace Fracture {
 
+	/*!
+	* @brief The layer that owns the ImGui context. The Application calls Begin before the OnImGuiRender of the layers and End after them.
+	*
+	* @details In RedrawMode::OnInput the UI is only rebuilt for a few frames after the window received input, and every IdleRefreshInterval seconds so
+	* the statistics keep moving. The other frames skip NewFrame, the OnImGuiRender of the layers and ImGui::Render and draw the draw data of the last
+	* rebuilt frame again. ImGui keeps that draw data untouched until the next NewFrame, so nothing is copied.
+	*
+	* The platform windows of the viewports are only updated on rebuilt frames. Their context switches are timed into FrameStats::Metric::ViewportTime and
+	* they can be turned off at runtime with SetViewportsEnabled, which merges the ImGui windows back into the main window.
+	*/
 	class FRACTURE_API ImGuiLayer : public Layer
 	{
 	public:
+		/// When the UI is rebuilt.
+		enum class RedrawMode
+		{
+			EveryFrame = 0,	/// Rebuild every frame.
+			OnInput			/// Rebuild after input and every IdleRefreshInterval seconds, draw the last frame again otherwise.
+		};
+
 		ImGuiLayer();
 		~ImGuiLayer() = default;
 
@@ -19,8 +36,78 @@ namespace Fracture {
 
 		void Begin();
 		void End();
+
+		/*!
+		* @brief Returns true if the UI has to be rebuilt this frame with Begin, the OnImGuiRender of the layers and End. Otherwise call RenderCached. Called once per frame.
+		*
+		* @param[in] float deltaTime: The time passed since the last frame in seconds.
+		*/
+		bool ShouldRebuild(float deltaTime);
+
+		/*!
+		* @brief Draws the draw data of the last rebuilt frame into the main window again.
+		*/
+		void RenderCached();
+
+		/*!
+		* @brief Forward a window event to ImGui and mark the UI for a rebuild. Called by the Application for every queued or replayed event, so a replay drives the UI like the live input did.
+		*
+		* @details The GLFW backend is initialised without its callbacks, so these events are the only input ImGui gets from the main window. The platform
+		* windows of the viewports still install their own callbacks and are not recorded.
+		*/
+		void OnInputEvent(const KeyPressedEvent& e);
+		void OnInputEvent(const KeyReleasedEvent& e);
+		void OnInputEvent(const KeyTypedEvent& e);
+		void OnInputEvent(const MouseButtonPressedEvent& e);
+		void OnInputEvent(const MouseButtonReleasedEvent& e);
+		void OnInputEvent(const MouseMovedEvent& e);
+		void OnInputEvent(const MouseScrolledEvent& e);
+		inline void OnInputEvent(const Event& e) { m_InputThisFrame = true; } /// The other window events, like resizes, only rebuild the UI.
+
+		inline void SetRedrawMode(RedrawMode mode) { m_RedrawMode = mode; }
+		inline RedrawMode GetRedrawMode() const { return m_RedrawMode; }
+
+		/*!
+		* @brief Sets how often an idle UI is rebuilt in RedrawMode::OnInput.
+		*
+		* @param[in] float seconds: The longest time between two rebuilds.
+		*/
+		inline void SetIdleRefreshInterval(float seconds) { m_IdleRefreshInterval = seconds; }
+		inline float GetIdleRefreshInterval() const { return m_IdleRefreshInterval; }
+
+		/*!
+		* @brief Turns the ImGui platform windows on or off from the next rebuilt frame. Does nothing when the renderer does not support them.
+		*/
+		void SetViewportsEnabled(bool enabled);
+		bool AreViewportsEnabled() const;
+
+		/*!
+		* @brief Returns true if the renderer can draw ImGui platform windows.
+		*/
+		bool AreViewportsSupported() const;
 	private:
+		/*!
+		* @brief Sends a key or a mouse button to ImGui, with the modifiers that were held.
+		*/
+		void AddKeyEvent(int keyCode, int mods, bool down);
+		void AddMouseButtonEvent(int button, int mods, bool down);
+
+		/*!
+		* @brief Sends the last mouse position of the events to ImGui, in the coordinates it expects with and without viewports.
+		*/
+		void AddMousePosition();
+	private:
+		static constexpr uint32_t SettleFrameCount = 3; /// The frames rebuilt after input. Hover states and new windows take a couple of frames to settle.
+
 		float m_Time = 0.0f;
+		RedrawMode m_RedrawMode = RedrawMode::EveryFrame; /// When the UI is rebuilt.
+		float m_IdleRefreshInterval = 0.25f; /// The longest time between two rebuilds in RedrawMode::OnInput, in seconds.
+		float m_TimeSinceRebuild = 0.0f; /// The time since the UI was last rebuilt, in seconds.
+		uint32_t m_SettleFrames = 0; /// The frames left to rebuild after the last input.
+		bool m_InputThisFrame = false; /// Set by OnInputEvent, cleared by ShouldRebuild.
+		float m_MouseX = 0.0f, m_MouseY = 0.0f; /// The last mouse position of the events, relative to the main window.
+		bool m_HasMousePosition = false; /// Set once a mouse move was forwarded.
+		bool m_HasFrame = false; /// Set once a frame was rendered, so there is draw data to reuse.
 	};
 
 }
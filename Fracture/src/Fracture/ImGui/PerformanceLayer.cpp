@@ -0,0 +1,274 @@
+#include "frpch.h"
+#include "PerformanceLayer.h"
+
+#include "Fracture\Core\Application.h"
+
+#include "imgui.h"
+
+#include <cfloat>
+
+namespace Fracture {
+
+	using Utils::FrameStats;
+	using Utils::StatHistory;
+	using Utils::MemoryTracker;
+	using Utils::MemoryTag;
+
+	PerformanceLayer::PerformanceLayer() :
+		Layer("PerformanceLayer")
+	{
+	}
+
+	void PerformanceLayer::OnImGuiRender()
+	{
+		FR_PROFILE_SCOPE("PerformanceLayer::OnImGuiRender");
+		if (!m_Visible)
+			return;
+
+		ImGui::Begin("Performance");
+
+		StatHistory::Summary frame = FrameStats::GetSummary(FrameStats::Metric::FrameTime);
+		ImGui::Text("Frame %llu  |  %.1f FPS (p50)  |  p99 %.3f ms  |  max %.3f ms", (unsigned long long)FrameStats::GetFrameIndex(),
+			frame.P50 > 0.0f ? 1000.0f / frame.P50 : 0.0f, frame.P99, frame.Max);
+		ImGui::Checkbox("Show Plots", &m_ShowPlots);
+		DrawImGuiControls();
+
+		const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+		if (ImGui::BeginTable("FrameStatsTable", 7, tableFlags))
+		{
+			ImGui::TableSetupColumn("Metric");
+			ImGui::TableSetupColumn("Last");
+			ImGui::TableSetupColumn("Avg");
+			ImGui::TableSetupColumn("p50");
+			ImGui::TableSetupColumn("p95");
+			ImGui::TableSetupColumn("p99");
+			ImGui::TableSetupColumn("Max");
+			ImGui::TableHeadersRow();
+
+			for (uint32_t i = 0; i < (uint32_t)FrameStats::Metric::Count; i++)
+			{
+				FrameStats::Metric metric = (FrameStats::Metric)i;
+				DrawSummaryRow(FrameStats::GetName(metric), FrameStats::GetHistory(metric), FrameStats::IsTiming(metric));
+			}
+			for (const FrameStats::LayerHistory& layer : FrameStats::GetLayerHistories())
+			{
+				for (uint32_t phase = 0; phase < (uint32_t)FrameStats::LayerPhase::Count; phase++)
+					DrawSummaryRow(layer.PhaseNames[phase], layer.Histories[phase], true);
+			}
+
+			ImGui::EndTable();
+		}
+
+		if (m_ShowPlots)
+		{
+			if (ImGui::CollapsingHeader("Timings (ms)", ImGuiTreeNodeFlags_DefaultOpen))
+			{
+				DrawDistribution("Frame Time Distribution", FrameStats::GetHistory(FrameStats::Metric::FrameTime));
+				for (uint32_t i = 0; i < (uint32_t)FrameStats::Metric::DrawCalls; i++)
+				{
+					FrameStats::Metric metric = (FrameStats::Metric)i;
+					DrawPlot(FrameStats::GetName(metric), FrameStats::GetHistory(metric), true);
+				}
+			}
+			if (ImGui::CollapsingHeader("Layer Timings (ms)"))
+			{
+				for (const FrameStats::LayerHistory& layer : FrameStats::GetLayerHistories())
+				{
+					for (uint32_t phase = 0; phase < (uint32_t)FrameStats::LayerPhase::Count; phase++)
+						DrawPlot(layer.PhaseNames[phase], layer.Histories[phase], true);
+				}
+			}
+			if (ImGui::CollapsingHeader("Renderer Counters"))
+			{
+				for (uint32_t i = (uint32_t)FrameStats::Metric::DrawCalls; i < (uint32_t)FrameStats::Metric::Count; i++)
+				{
+					FrameStats::Metric metric = (FrameStats::Metric)i;
+					DrawPlot(FrameStats::GetName(metric), FrameStats::GetHistory(metric), false);
+				}
+			}
+		}
+
+		if (ImGui::CollapsingHeader("Layers"))
+			DrawLayerControls();
+
+		ImGui::End();
+
+		if (MemoryTracker::IsEnabled())
+			DrawMemoryWindow();
+	}
+
+	void PerformanceLayer::DrawMemoryWindow()
+	{
+		ImGui::Begin("Memory");
+
+		MemoryTracker::Totals totals = MemoryTracker::GetTotals();
+		MemoryTracker::FrameTotals frame = MemoryTracker::GetLastFrame();
+		ImGui::Text("Live: %.3f MB in %llu allocations", totals.LiveBytes / (1024.0 * 1024.0), (unsigned long long)totals.LiveCount);
+		ImGui::Text("Last frame: %llu allocations, %llu bytes, %llu frees", (unsigned long long)frame.Count, (unsigned long long)frame.Bytes, (unsigned long long)frame.Frees);
+
+		const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+		if (ImGui::BeginTable("MemoryTagTable", 4, tableFlags))
+		{
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Live Bytes");
+			ImGui::TableSetupColumn("Live Count");
+			ImGui::TableSetupColumn("Total Count");
+			ImGui::TableHeadersRow();
+			for (uint32_t i = 0; i < (uint32_t)MemoryTag::Count; i++)
+			{
+				MemoryTracker::Totals tag = MemoryTracker::GetTagTotals((MemoryTag)i);
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(MemoryTracker::GetTagName((MemoryTag)i));
+				ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)tag.LiveBytes);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)tag.LiveCount);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)tag.TotalCount);
+			}
+			ImGui::EndTable();
+		}
+
+		DrawPlot("Allocations per Frame", MemoryTracker::GetFrameCountHistory(), false);
+		DrawPlot("Bytes per Frame", MemoryTracker::GetFrameBytesHistory(), false);
+
+		if (ImGui::CollapsingHeader("Top Scopes"))
+		{
+			if (ImGui::BeginTable("MemoryScopeTable", 4, tableFlags))
+			{
+				ImGui::TableSetupColumn("Total Bytes");
+				ImGui::TableSetupColumn("Total Count");
+				ImGui::TableSetupColumn("Live Bytes");
+				ImGui::TableSetupColumn("Scope");
+				ImGui::TableHeadersRow();
+				for (const MemoryTracker::ScopeTotals& scope : MemoryTracker::GetTopScopes(20))
+				{
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)scope.Stats.TotalBytes);
+					ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)scope.Stats.TotalCount);
+					ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)scope.Stats.LiveBytes);
+					ImGui::TableNextColumn(); ImGui::TextUnformatted(scope.Name ? scope.Name : "<no scope>");
+				}
+				ImGui::EndTable();
+			}
+		}
+
+		if (ImGui::CollapsingHeader("Top Call Sites"))
+		{
+			if (ImGui::BeginTable("MemoryCallSiteTable", 4, tableFlags))
+			{
+				ImGui::TableSetupColumn("Total Bytes");
+				ImGui::TableSetupColumn("Total Count");
+				ImGui::TableSetupColumn("Live Bytes");
+				ImGui::TableSetupColumn("Call Site");
+				ImGui::TableHeadersRow();
+				for (const MemoryTracker::CallSiteTotals& site : MemoryTracker::GetTopCallSites(20))
+				{
+					auto name = m_CallSiteNames.find(site.Address);
+					if (name == m_CallSiteNames.end())
+						name = m_CallSiteNames.emplace(site.Address, MemoryTracker::DescribeCallSite(site.Address)).first;
+
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)site.Stats.TotalBytes);
+					ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)site.Stats.TotalCount);
+					ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)site.Stats.LiveBytes);
+					ImGui::TableNextColumn(); ImGui::TextUnformatted(name->second.c_str());
+				}
+				ImGui::EndTable();
+			}
+		}
+
+		ImGui::End();
+	}
+
+	void PerformanceLayer::DrawImGuiControls()
+	{
+		ImGuiLayer* imguiLayer = Application::Get().GetImGuiLayer();
+		bool redrawOnInput = imguiLayer->GetRedrawMode() == ImGuiLayer::RedrawMode::OnInput;
+		ImGui::SameLine();
+		if (ImGui::Checkbox("Redraw UI On Input", &redrawOnInput))
+			imguiLayer->SetRedrawMode(redrawOnInput ? ImGuiLayer::RedrawMode::OnInput : ImGuiLayer::RedrawMode::EveryFrame);
+		if (imguiLayer->AreViewportsSupported())
+		{
+			bool viewports = imguiLayer->AreViewportsEnabled();
+			ImGui::SameLine();
+			if (ImGui::Checkbox("Platform Windows", &viewports))
+				imguiLayer->SetViewportsEnabled(viewports);
+		}
+		ImGui::SameLine();
+		ImGui::TextDisabled("(F1 hides the UI)");
+	}
+
+	void PerformanceLayer::DrawLayerControls()
+	{
+		const ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+		if (!ImGui::BeginTable("LayerTable", 3, tableFlags))
+			return;
+
+		ImGui::TableSetupColumn("Layer");
+		ImGui::TableSetupColumn("Enabled");
+		ImGui::TableSetupColumn("Suspended");
+		ImGui::TableHeadersRow();
+
+		for (Layer* layer : Application::Get().GetLayerStack())
+		{
+			if (layer == this)
+				continue; // Disabling this layer would hide the only way to enable it again
+
+			ImGui::PushID(layer);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(layer->GetName().c_str());
+			bool enabled = layer->IsEnabled();
+			ImGui::TableNextColumn();
+			if (ImGui::Checkbox("##Enabled", &enabled))
+				layer->SetEnabled(enabled);
+			bool suspended = layer->IsSuspended();
+			ImGui::TableNextColumn();
+			if (ImGui::Checkbox("##Suspended", &suspended))
+				layer->SetSuspended(suspended);
+			ImGui::PopID();
+		}
+		ImGui::EndTable();
+	}
+
+	void PerformanceLayer::DrawSummaryRow(const char* name, const StatHistory& history, bool timing)
+	{
+		StatHistory::Summary summary = history.ComputeSummary();
+		const char* format = timing ? "%.3f" : "%.0f";
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+		ImGui::TableNextColumn(); ImGui::Text(format, summary.Last);
+		ImGui::TableNextColumn(); ImGui::Text(format, summary.Average);
+		ImGui::TableNextColumn(); ImGui::Text(format, summary.P50);
+		ImGui::TableNextColumn(); ImGui::Text(format, summary.P95);
+		ImGui::TableNextColumn(); ImGui::Text(format, summary.P99);
+		ImGui::TableNextColumn(); ImGui::Text(format, summary.Max);
+	}
+
+	void PerformanceLayer::DrawPlot(const char* label, const StatHistory& history, bool timing)
+	{
+		StatHistory::Summary summary = history.ComputeSummary();
+
+		char overlay[64];
+		snprintf(overlay, sizeof(overlay), timing ? "p99 %.3f  max %.3f" : "p99 %.0f  max %.0f", summary.P99, summary.Max);
+
+		// Scaled to the maximum so a single hitch stands out against the rest of the history
+		ImGui::PlotLines(label, history.GetData(), (int)history.GetSize(), (int)history.GetOffset(), overlay,
+			0.0f, summary.Max > 0.0f ? summary.Max : 1.0f, ImVec2(0.0f, 50.0f));
+	}
+
+	void PerformanceLayer::DrawDistribution(const char* label, const StatHistory& history)
+	{
+		constexpr int binCount = 32;
+		float bins[binCount] = {};
+
+		StatHistory::Summary summary = history.ComputeSummary();
+		float binWidth = summary.Max > 0.0f ? summary.Max / binCount : 1.0f;
+		const float* samples = history.GetData();
+		for (uint32_t i = 0; i < history.GetSize(); i++)
+			bins[std::min((int)(samples[i] / binWidth), binCount - 1)] += 1.0f;
+
+		char overlay[64];
+		snprintf(overlay, sizeof(overlay), "0 - %.3f ms, %.3f ms per bin", summary.Max, binWidth);
+		ImGui::PlotHistogram(label, bins, binCount, 0, overlay, 0.0f, FLT_MAX, ImVec2(0.0f, 80.0f));
+	}
+
+}
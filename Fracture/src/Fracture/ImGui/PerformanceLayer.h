@@ -0,0 +1,71 @@
+#pragma once
+/*!
+* @file PerformanceLayer.h
+* @brief Contains the PerformanceLayer overlay that shows the FrameStats of the engine.
+*
+* @see FrameStats
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Core/Layer.h"
+#include "Fracture/Utils/FrameStats.h"
+#include "Fracture/Utils/MemoryTracker.h"
+
+#include <unordered_map>
+
+namespace Fracture {
+
+	/*!
+	* @brief Overlay that draws an ImGui window with the percentiles and the history of every FrameStats metric and the OnUpdate, OnEvent and OnImGuiRender times of every layer.
+	*
+	* @details Pushed by the Application so every client gets it. When the engine is built with FR_TRACK_ALLOCATIONS it also draws a Memory window with the
+	* MemoryTracker totals per tag, the allocations per frame and the scopes and call sites that allocate the most.
+	*/
+	class FRACTURE_API PerformanceLayer : public Layer
+	{
+	public:
+		PerformanceLayer();
+		~PerformanceLayer() = default;
+
+		virtual void OnImGuiRender() override;
+
+		inline void SetVisible(bool visible) { m_Visible = visible; }
+		inline bool IsVisible() const { return m_Visible; }
+	private:
+		/*!
+		* @brief Draws a table row with the percentiles of a history.
+		*/
+		void DrawSummaryRow(const char* name, const Utils::StatHistory& history, bool timing);
+
+		/*!
+		* @brief Plots a history, scaled to its maximum.
+		*/
+		void DrawPlot(const char* label, const Utils::StatHistory& history, bool timing);
+
+		/*!
+		* @brief Plots how the samples of a history are distributed between 0 and its maximum, so the long tail of hitches is visible next to the bulk of the frames.
+		*/
+		void DrawDistribution(const char* label, const Utils::StatHistory& history);
+
+		/*!
+		* @brief Draws the Memory window.
+		*/
+		void DrawMemoryWindow();
+
+		/*!
+		* @brief Draws a checkbox to enable and one to suspend each layer of the application, so a layer can be switched off to see what it costs.
+		*/
+		void DrawLayerControls();
+
+		/*!
+		* @brief Draws the checkboxes that choose when the UI is rebuilt and whether the ImGui platform windows are used.
+		*/
+		void DrawImGuiControls();
+	private:
+		bool m_Visible = true; /// Whether the window is drawn.
+		bool m_ShowPlots = true; /// Whether the history plots are drawn below the table.
+		std::unordered_map<uintptr_t, std::string> m_CallSiteNames; /// Resolved call site names. Symbol lookups are slow so each address is resolved once.
+	};
+
+}
@@ -0,0 +1,83 @@
+#include "frpch.h"
+#include "Input.h"
+
+namespace Fracture {
+
+	InputState Input::s_State;
+
+	namespace {
+
+		bool s_HasMousePosition = false; /// False until the first cursor position arrives, so it does not count as a move from the origin.
+
+	}
+
+	void Input::BeginFrame()
+	{
+		s_State.KeysPressed.reset();
+		s_State.KeysReleased.reset();
+		s_State.MouseButtonsPressed.reset();
+		s_State.MouseButtonsReleased.reset();
+		s_State.MouseDeltaX = s_State.MouseDeltaY = 0.0f;
+		s_State.ScrollX = s_State.ScrollY = 0.0f;
+	}
+
+	void Input::OnEvent(const KeyPressedEvent& e)
+	{
+		int keyCode = e.GetKeyCode();
+		if (!IsKey(keyCode))
+			return;
+
+		if (!e.IsRepeated())
+			s_State.KeysPressed.set(keyCode);
+		s_State.Keys.set(keyCode);
+	}
+
+	void Input::OnEvent(const KeyReleasedEvent& e)
+	{
+		int keyCode = e.GetKeyCode();
+		if (!IsKey(keyCode))
+			return;
+
+		s_State.KeysReleased.set(keyCode);
+		s_State.Keys.reset(keyCode);
+	}
+
+	void Input::OnEvent(const MouseButtonPressedEvent& e)
+	{
+		int button = e.GetMouseButton();
+		if (!IsMouseButton(button))
+			return;
+
+		s_State.MouseButtonsPressed.set(button);
+		s_State.MouseButtons.set(button);
+	}
+
+	void Input::OnEvent(const MouseButtonReleasedEvent& e)
+	{
+		int button = e.GetMouseButton();
+		if (!IsMouseButton(button))
+			return;
+
+		s_State.MouseButtonsReleased.set(button);
+		s_State.MouseButtons.reset(button);
+	}
+
+	void Input::OnEvent(const MouseMovedEvent& e)
+	{
+		if (s_HasMousePosition)
+		{
+			s_State.MouseDeltaX += e.GetX() - s_State.MouseX;
+			s_State.MouseDeltaY += e.GetY() - s_State.MouseY;
+		}
+		s_State.MouseX = e.GetX();
+		s_State.MouseY = e.GetY();
+		s_HasMousePosition = true;
+	}
+
+	void Input::OnEvent(const MouseScrolledEvent& e)
+	{
+		s_State.ScrollX += e.GetXOffset();
+		s_State.ScrollY += e.GetYOffset();
+	}
+
+}
@@ -1,91 +1,170 @@
 #pragma once
 /*!
 * @file Input.h
-* @brief Input header file conatins the singleton class that will be implemented per platform to handle polling inputs.
-* 
-* @see WindowsInput
+* @brief Input header file containing the Input class that answers input queries from a snapshot of the keyboard and mouse built once per frame.
+*
+* @see InputState
 * @see KeyCodes.h
 * @see MouseButtonCodes.h
-* 
+*
 * @author Aditya Rajagopal
 */
 
 #include "Fracture\Core\Core.h"
+#include "Fracture\Events\ApplicationEvent.h"
+#include "Fracture\Events\KeyEvent.h"
+#include "Fracture\Events\MouseEvent.h"
+#include "Fracture\Input\KeyCodes.h"
+#include "Fracture\Input\MouseButtonCodes.h"
+
+#include <bitset>
 
 namespace Fracture {
 
 	/*!
-	* @brief The base class for Input polling. This class will be implemented per platform.
-	* 
-	* @details This class will be implemented per platform. This is a singleton class.
-	* 
-	* @see WindowsInput
+	* @brief The state of the keyboard and the mouse for one frame.
+	*/
+	struct InputState
+	{
+		static constexpr uint32_t KeyCount = FR_KEY_MENU + 1; /// The number of key codes, the highest is FR_KEY_MENU.
+		static constexpr uint32_t MouseButtonCount = FR_MOUSE_BUTTON_LAST + 1; /// The number of mouse button codes.
+
+		std::bitset<KeyCount> Keys; /// The keys held down.
+		std::bitset<KeyCount> KeysPressed; /// The keys that went down this frame. Repeats are not counted.
+		std::bitset<KeyCount> KeysReleased; /// The keys that went up this frame.
+		std::bitset<MouseButtonCount> MouseButtons; /// The mouse buttons held down.
+		std::bitset<MouseButtonCount> MouseButtonsPressed; /// The mouse buttons that went down this frame.
+		std::bitset<MouseButtonCount> MouseButtonsReleased; /// The mouse buttons that went up this frame.
+		float MouseX = 0.0f, MouseY = 0.0f; /// The cursor position in pixels from the top left corner of the window.
+		float MouseDeltaX = 0.0f, MouseDeltaY = 0.0f; /// How far the cursor moved this frame.
+		float ScrollX = 0.0f, ScrollY = 0.0f; /// The scroll offsets of this frame, added up.
+	};
+
+	/*!
+	* @brief Static service answering input queries from the InputState of the current frame.
+	*
+	* @details The Application clears the edges with BeginFrame at the start of the frame and passes every queued window event to OnEvent before the
+	* event handlers see it, so a handler reading the mouse position gets the position at the time of its event. Queries are bit tests on the snapshot and
+	* never call the platform. The state is only written and read on the main thread.
+	*
+	* Besides the held state, the snapshot keeps the keys and mouse buttons that went down or up this frame, so WasKeyPressed catches a key that was
+	* pressed and released between two frames.
 	*/
 	class FRACTURE_API Input
 	{
-	protected:
-		/*!
-		* @brief protected constructor so that only the child classes can create an instance of this class.
-		*/
-		Input() = default;
 	public:
 		/*!
-		* @brief Deleted copy constructor so that we can not copy this class since it is a singleton
+		* @brief Static function that returns if a key is held down
+		*
+		* @param[in] int keyCode the key code of the key that we want to check if it is pressed
+		*
+		* @return bool true if the key is pressed, false otherwise
 		*/
-		Input(const Input&) = delete;
+		inline static bool IsKeyPressed(int keyCode) { return IsKey(keyCode) && s_State.Keys[keyCode]; }
 
 		/*!
-		* @brief Deleted assignment operator so that we can not copy this class since it is a singleton
+		* @brief Static function that returns if a key went down this frame
+		*
+		* @param[in] int keyCode the key code of the key
+		*
+		* @return bool true if the key went down this frame, false otherwise. Key repeats do not count.
 		*/
-		Input& operator=(const Input&) = delete;
+		inline static bool WasKeyPressed(int keyCode) { return IsKey(keyCode) && s_State.KeysPressed[keyCode]; }
 
 		/*!
-		* @brief Static function that returns if a key is pressed or not
-		* 
-		* @param[in] int keyCode the key code of the key that we want to check if it is pressed
-		* 
-		* @return bool true if the key is pressed, false otherwise
+		* @brief Static function that returns if a key went up this frame
+		*
+		* @param[in] int keyCode the key code of the key
+		*
+		* @return bool true if the key went up this frame, false otherwise
 		*/
-		inline static bool IsKeyPressed(int keyCode) { return s_Instance->IsKeyPressedImpl(keyCode); }
+		inline static bool WasKeyReleased(int keyCode) { return IsKey(keyCode) && s_State.KeysReleased[keyCode]; }
 
 		/*!
-		* @brief Static function that returns if a mouse button is pressed or not
-		* 
+		* @brief Static function that returns if a mouse button is held down
+		*
 		* @param[in] int button the mouse button code of the mouse button that we want to check if it is pressed
-		* 
+		*
 		* @return bool true if the mouse button is pressed, false otherwise
 		*/
-		inline static bool IsMouseButtonPressed(int button) { return s_Instance->IsMouseButtonPressedImpl(button); }
+		inline static bool IsMouseButtonPressed(int button) { return IsMouseButton(button) && s_State.MouseButtons[button]; }
+
+		/*!
+		* @brief Static function that returns if a mouse button went down this frame
+		*
+		* @param[in] int button the mouse button code
+		*
+		* @return bool true if the mouse button went down this frame, false otherwise
+		*/
+		inline static bool WasMouseButtonPressed(int button) { return IsMouseButton(button) && s_State.MouseButtonsPressed[button]; }
+
+		/*!
+		* @brief Static function that returns if a mouse button went up this frame
+		*
+		* @param[in] int button the mouse button code
+		*
+		* @return bool true if the mouse button went up this frame, false otherwise
+		*/
+		inline static bool WasMouseButtonReleased(int button) { return IsMouseButton(button) && s_State.MouseButtonsReleased[button]; }
 
 		/*!
 		* @brief Static function that returns the current x coordinate of the mouse
-		* 
+		*
 		* @return float the current x coordinate of the mouse
 		*/
-		inline static float GetMouseX() { return s_Instance->GetMouseXImpl(); }
+		inline static float GetMouseX() { return s_State.MouseX; }
 
 		/*!
 		* @brief Static function that returns the current y coordinate of the mouse
-		* 
+		*
 		* @return float the current y coordinate of the mouse
 		*/
-		inline static float GetMouseY() { return s_Instance->GetMouseYImpl(); }
+		inline static float GetMouseY() { return s_State.MouseY; }
 
 		/*!
 		* @brief Static function that returns the current x and y coordinates of the mouse at once
-		* 
+		*
 		* @return std::pair<float, float> the current x and y coordinates of the mouse
 		*/
-		inline static std::pair<float, float> GetMousePosition() { return s_Instance->GetMousePositionImpl(); }
-	protected:
-		// These are the backend pure virtual functions that will be implemented per platform.
-		virtual bool IsKeyPressedImpl(int keyCode) = 0;
-		virtual bool IsMouseButtonPressedImpl(int button) = 0;
-		virtual float GetMouseXImpl() = 0;
-		virtual float GetMouseYImpl() = 0;
-		virtual std::pair<float, float> GetMousePositionImpl() = 0;
+		inline static std::pair<float, float> GetMousePosition() { return { s_State.MouseX, s_State.MouseY }; }
+
+		/*!
+		* @brief Static function that returns how far the mouse moved this frame
+		*
+		* @return std::pair<float, float> the x and y distance in pixels
+		*/
+		inline static std::pair<float, float> GetMouseDelta() { return { s_State.MouseDeltaX, s_State.MouseDeltaY }; }
+
+		/*!
+		* @brief Static function that returns the scroll offsets of this frame
+		*
+		* @return std::pair<float, float> the x and y scroll offsets, added up over the frame
+		*/
+		inline static std::pair<float, float> GetScroll() { return { s_State.ScrollX, s_State.ScrollY }; }
+
+		/*!
+		* @brief Static function that returns the whole snapshot of the current frame
+		*/
+		inline static const InputState& GetState() { return s_State; }
+
+		/*!
+		* @brief Clears the pressed and released edges, the mouse delta and the scroll. Called by the Application before it dispatches the events of a frame.
+		*/
+		static void BeginFrame();
+
+		/// Update the snapshot with an event. Called by the Application for every queued window event, before the event handlers.
+		static void OnEvent(const KeyPressedEvent& e);
+		static void OnEvent(const KeyReleasedEvent& e);
+		static void OnEvent(const MouseButtonPressedEvent& e);
+		static void OnEvent(const MouseButtonReleasedEvent& e);
+		static void OnEvent(const MouseMovedEvent& e);
+		static void OnEvent(const MouseScrolledEvent& e);
+		inline static void OnEvent(const Event& e) {} /// The events that do not change the input state.
+	private:
+		inline static bool IsKey(int keyCode) { return (uint32_t)keyCode < InputState::KeyCount; }
+		inline static bool IsMouseButton(int button) { return (uint32_t)button < InputState::MouseButtonCount; }
 	private:
-		static Scope<Input> s_Instance;
+		static InputState s_State; /// The snapshot of the current frame.
 	};
 
-}
\ No newline at end of file
+}
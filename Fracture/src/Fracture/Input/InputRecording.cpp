@@ -0,0 +1,156 @@
+#include "frpch.h"
+#include "InputRecording.h"
+
+#include "Fracture\Utils\Helpers.h"
+
+#include <cstring>
+
+namespace Fracture {
+
+	namespace {
+
+		constexpr char Magic[4] = { 'F', 'R', 'I', 'R' };
+		constexpr uint32_t Version = 1;
+		constexpr size_t HeaderSize = sizeof(Magic) + sizeof(Version);
+
+		template<typename T>
+		void Write(std::vector<uint8_t>& buffer, const T& value)
+		{
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+			buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+		}
+
+		/// Reads a value and advances the offset. Returns false if the data ends first.
+		template<typename T>
+		bool Read(const std::string& data, size_t& offset, T& value)
+		{
+			if (offset + sizeof(T) > data.size())
+				return false;
+			std::memcpy(&value, data.data() + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+	}
+
+	InputRecorder::InputRecorder(const std::string& path) :
+		m_Stream(path, std::ios::out | std::ios::binary)
+	{
+		if (!m_Stream)
+		{
+			FR_CORE_ERROR("Could not open file {0} for recording input", path);
+			return;
+		}
+		m_Stream.write(Magic, sizeof(Magic));
+		m_Stream.write((const char*)&Version, sizeof(Version));
+		FR_CORE_INFO("Recording input to {0}", path);
+	}
+
+	InputRecorder::~InputRecorder()
+	{
+		if (IsOpen())
+			FR_CORE_INFO("Recorded {0} frames of input", m_FrameCount);
+	}
+
+	void InputRecorder::BeginFrame(float deltaTime)
+	{
+		m_Frame.clear();
+		m_EventCount = 0;
+		Write(m_Frame, deltaTime);
+		Write(m_Frame, m_EventCount); // Patched in EndFrame
+	}
+
+	void InputRecorder::Record(const QueuedEvent& event)
+	{
+		if (m_EventCount == UINT16_MAX)
+		{
+			FR_CORE_WARN("More than {0} events in one frame, the rest are not recorded", UINT16_MAX);
+			return;
+		}
+
+		Write(m_Frame, (uint8_t)event.Type);
+		switch (event.Type)
+		{
+		case EventType::WindowResize: Write(m_Frame, event.Resize); break;
+		case EventType::KeyPressed: case EventType::KeyReleased: case EventType::KeyTyped:
+			Write(m_Frame, event.Key.KeyCode);
+			Write(m_Frame, event.Key.Mods);
+			Write(m_Frame, (uint8_t)event.Key.Repeated);
+			break;
+		case EventType::MouseButtonPressed: case EventType::MouseButtonReleased: Write(m_Frame, event.MouseButton); break;
+		case EventType::MouseMoved: case EventType::MouseScrolled: Write(m_Frame, event.Mouse); break;
+		default: break; // WindowClose has no payload
+		}
+		m_EventCount++;
+	}
+
+	void InputRecorder::EndFrame()
+	{
+		if (!IsOpen())
+			return;
+
+		std::memcpy(m_Frame.data() + sizeof(float), &m_EventCount, sizeof(m_EventCount));
+		m_Stream.write((const char*)m_Frame.data(), m_Frame.size());
+		m_FrameCount++;
+	}
+
+	InputPlayer::InputPlayer(const std::string& path)
+	{
+		m_Data = Utils::ReadFile(path);
+		uint32_t version = 0;
+		size_t offset = sizeof(Magic);
+		if (m_Data.size() < HeaderSize || std::memcmp(m_Data.data(), Magic, sizeof(Magic)) != 0 || !Read(m_Data, offset, version) || version != Version)
+		{
+			FR_CORE_ERROR("{0} is not an input recording", path);
+			return;
+		}
+		m_Offset = HeaderSize;
+		m_Open = true;
+		FR_CORE_INFO("Replaying input from {0}", path);
+	}
+
+	bool InputPlayer::NextFrame(InputFrame& frame)
+	{
+		if (!m_Open || m_Offset >= m_Data.size())
+			return false;
+
+		uint16_t eventCount = 0;
+		if (!Read(m_Data, m_Offset, frame.DeltaTime) || !Read(m_Data, m_Offset, eventCount))
+			return false;
+
+		frame.Events.clear();
+		for (uint16_t i = 0; i < eventCount; i++)
+		{
+			QueuedEvent event;
+			uint8_t type = 0;
+			bool valid = Read(m_Data, m_Offset, type);
+			event.Type = (EventType)type;
+			switch (event.Type)
+			{
+			case EventType::WindowResize: valid = valid && Read(m_Data, m_Offset, event.Resize); break;
+			case EventType::KeyPressed: case EventType::KeyReleased: case EventType::KeyTyped:
+			{
+				uint8_t repeated = 0;
+				valid = valid && Read(m_Data, m_Offset, event.Key.KeyCode) && Read(m_Data, m_Offset, event.Key.Mods) && Read(m_Data, m_Offset, repeated);
+				event.Key.Repeated = repeated != 0;
+				break;
+			}
+			case EventType::MouseButtonPressed: case EventType::MouseButtonReleased: valid = valid && Read(m_Data, m_Offset, event.MouseButton); break;
+			case EventType::MouseMoved: case EventType::MouseScrolled: valid = valid && Read(m_Data, m_Offset, event.Mouse); break;
+			case EventType::WindowClose: break;
+			default: valid = false; break;
+			}
+
+			if (!valid)
+			{
+				FR_CORE_ERROR("Input recording is damaged at frame {0}", m_FrameIndex);
+				m_Offset = m_Data.size();
+				return false;
+			}
+			frame.Events.push_back(event);
+		}
+		m_FrameIndex++;
+		return true;
+	}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+/*!
+* @file InputRecording.h
+* @brief Contains the InputRecorder and InputPlayer classes that save the window events of each frame to a file and play them back.
+*
+* @details The file starts with the magic "FRIR" and a version, followed by one record per frame: the frame delta time as a float, the number of
+* events as a uint16 and the events. Each event is a uint8 EventType followed by only the payload of that type, so a mouse move takes 9 bytes.
+* Values are written in the byte order of the machine.
+*
+* @see Application::StartInputRecording, Application::StartInputReplay
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Events\EventQueue.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief The events and the delta time of one recorded frame.
+	*/
+	struct InputFrame
+	{
+		float DeltaTime = 0.0f; /// The delta time of the frame in seconds.
+		std::vector<QueuedEvent> Events; /// The window events dispatched in the frame, in order.
+	};
+
+	/*!
+	* @brief Writes the window events of each frame to a file.
+	*
+	* @details The events of a frame are collected with Record between BeginFrame and EndFrame and written as one record at EndFrame.
+	*/
+	class InputRecorder
+	{
+	public:
+		/*!
+		* @brief Opens the file and writes the header. Logs an error and stays closed if the file cannot be opened.
+		*/
+		InputRecorder(const std::string& path);
+		~InputRecorder();
+
+		inline bool IsOpen() const { return m_Stream.is_open(); }
+		inline uint32_t GetFrameCount() const { return m_FrameCount; }
+
+		void BeginFrame(float deltaTime);
+		void Record(const QueuedEvent& event);
+		void EndFrame();
+	private:
+		std::ofstream m_Stream; /// The recording file.
+		std::vector<uint8_t> m_Frame; /// The record of the current frame.
+		uint16_t m_EventCount = 0; /// The number of events in the current frame.
+		uint32_t m_FrameCount = 0; /// The number of frames written.
+	};
+
+	/*!
+	* @brief Reads a recording written by InputRecorder and returns it one frame at a time.
+	*
+	* @details The whole file is read when the player is created.
+	*/
+	class InputPlayer
+	{
+	public:
+		/*!
+		* @brief Reads the file. Logs an error and stays closed if the file is missing or is not a recording.
+		*/
+		InputPlayer(const std::string& path);
+
+		inline bool IsOpen() const { return m_Open; }
+		inline uint32_t GetFrameIndex() const { return m_FrameIndex; }
+
+		/*!
+		* @brief Reads the next frame into frame. Returns false at the end of the recording or when the rest of the file is damaged.
+		*/
+		bool NextFrame(InputFrame& frame);
+	private:
+		std::string m_Data; /// The contents of the file.
+		size_t m_Offset = 0; /// The position of the next frame in m_Data.
+		uint32_t m_FrameIndex = 0; /// The number of frames read.
+		bool m_Open = false; /// Set when the file was read and the header matched.
+	};
+
+}
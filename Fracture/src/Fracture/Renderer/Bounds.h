@@ -0,0 +1,73 @@
+#pragma once
+/*!
+* @file Bounds.h
+* @brief Contains the AABB struct used for culling and spatial queries of 2D scenes.
+*
+* @see BoundsList
+*
+* @author Aditya Rajagopal
+*/
+
+#include <glm\glm.hpp>
+
+#include <cfloat>
+#include <cmath>
+
+namespace Fracture {
+
+	/*!
+	* @brief A 2D axis aligned bounding box on the XY plane.
+	*
+	* @details A default constructed box is empty (Min > Max). Empty boxes do not intersect anything, and a VertexArray with empty bounds is never culled.
+	*/
+	struct AABB
+	{
+		glm::vec2 Min = { FLT_MAX, FLT_MAX }; /// The bottom left corner.
+		glm::vec2 Max = { -FLT_MAX, -FLT_MAX }; /// The top right corner.
+
+		AABB() = default;
+		AABB(const glm::vec2& min, const glm::vec2& max)
+			: Min(min), Max(max) {}
+
+		inline bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y; }
+		inline glm::vec2 GetCenter() const { return (Min + Max) * 0.5f; }
+		inline glm::vec2 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		inline bool Intersects(const AABB& other) const
+		{
+			return Max.x >= other.Min.x && Min.x <= other.Max.x && Max.y >= other.Min.y && Min.y <= other.Max.y;
+		}
+
+		inline bool Contains(const glm::vec2& point) const
+		{
+			return point.x >= Min.x && point.x <= Max.x && point.y >= Min.y && point.y <= Max.y;
+		}
+
+		/*!
+		* @brief Grows the box so it contains another box.
+		*/
+		inline void Merge(const AABB& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+
+		/*!
+		* @brief Returns the box that contains this box after an affine transform, using the center and the absolute value of the linear part on the extents.
+		*/
+		inline AABB Transform(const glm::mat4& transform) const
+		{
+			if (!IsValid())
+				return *this;
+
+			glm::vec2 center = GetCenter();
+			glm::vec2 extents = GetExtents();
+			glm::vec2 newCenter(transform[0][0] * center.x + transform[1][0] * center.y + transform[3][0],
+								transform[0][1] * center.x + transform[1][1] * center.y + transform[3][1]);
+			glm::vec2 newExtents(std::fabs(transform[0][0]) * extents.x + std::fabs(transform[1][0]) * extents.y,
+								 std::fabs(transform[0][1]) * extents.x + std::fabs(transform[1][1]) * extents.y);
+			return AABB(newCenter - newExtents, newCenter + newExtents);
+		}
+	};
+
+}
@@ -3,11 +3,13 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Software/SoftwareBuffer.h"
 
 namespace Fracture {
 
 	Ref<VertexBuffer> VertexBuffer::Create(float* vertices, uint32_t size)
 	{
+		FR_MEMORY_TAG(Renderer);
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:
@@ -15,6 +17,8 @@ namespace Fracture {
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLVertexBuffer>(vertices, size);
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareVertexBuffer>(vertices, size);
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -23,6 +27,7 @@ namespace Fracture {
 
 	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t size)
 	{
+		FR_MEMORY_TAG(Renderer);
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:
@@ -30,6 +35,26 @@ namespace Fracture {
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLIndexBuffer>(indices, size);
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareIndexBuffer>(indices, size);
+		}
+
+		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<StorageBuffer> StorageBuffer::Create(uint32_t size)
+	{
+		FR_MEMORY_TAG(Renderer);
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			FR_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLStorageBuffer>(size);
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareStorageBuffer>(size);
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -205,6 +205,15 @@ namespace Fracture {
 
 		virtual void SetData(const void* data, uint32_t size) = 0;
 
+		/*!
+		* @brief Function that overwrites part of the vertex buffer without reallocating it.
+		* 
+		* @param[in] const void* data: The new vertex data.
+		* @param[in] uint32_t size: The size of the data in bytes.
+		* @param[in] uint32_t offset: The offset in bytes into the buffer. offset + size must not exceed the size of the buffer.
+		*/
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) = 0;
+
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 		virtual const BufferLayout& GetLayout() const = 0;
 
@@ -239,6 +248,15 @@ namespace Fracture {
 
 		virtual void SetData(const void* data, uint32_t size) = 0;
 
+		/*!
+		* @brief Function that overwrites part of the index buffer without reallocating it.
+		* 
+		* @param[in] const void* data: The new indices.
+		* @param[in] uint32_t size: The size of the data in bytes.
+		* @param[in] uint32_t offset: The offset in bytes into the buffer. offset + size must not exceed the size of the buffer.
+		*/
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) = 0;
+
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
@@ -260,4 +278,39 @@ namespace Fracture {
 		*/
 		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t size);
 	};
+
+	/*!
+	* @brief The StorageBuffer class is an abstract class for a block of memory shaders read by index, for example the per draw data of a multi draw.
+	* 
+	* @see OpenGLStorageBuffer
+	* @see IndirectDrawList
+	*/
+	class StorageBuffer {
+	public:
+		virtual ~StorageBuffer() = default;
+
+		/*!
+		* @brief Function that replaces the contents of the buffer. The buffer grows when the data does not fit.
+		* 
+		* @param[in] const void* data: The new contents.
+		* @param[in] uint32_t size: The size of the data in bytes.
+		*/
+		virtual void SetData(const void* data, uint32_t size) = 0;
+
+		/*!
+		* @brief Function that binds the buffer to a shader storage binding point, the binding of the buffer block in the shader.
+		*/
+		virtual void Bind(uint32_t binding) const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+
+		/*!
+		* @brief Function that creates a storage buffer based on the renderer api that is being used.
+		* 
+		* @param[in] uint32_t size: The initial size of the buffer in bytes.
+		* 
+		* @returns A shared pointer to the storage buffer.
+		*/
+		static Ref<StorageBuffer> Create(uint32_t size);
+	};
 }
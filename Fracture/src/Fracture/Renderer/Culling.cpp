@@ -0,0 +1,79 @@
+#include "frpch.h"
+#include "Culling.h"
+
+#include "Fracture\Core\Simd.h"
+
+namespace Fracture {
+
+	uint32_t BoundsList::Add(const AABB& bounds)
+	{
+		uint32_t index = m_Count++;
+		if (m_Count > m_MinX.size())
+		{
+			// Pad with empty boxes so the last batch can always be loaded whole
+			size_t size = (m_Count + SimdLanes - 1) / SimdLanes * SimdLanes;
+			m_MinX.resize(size, FLT_MAX);
+			m_MinY.resize(size, FLT_MAX);
+			m_MaxX.resize(size, -FLT_MAX);
+			m_MaxY.resize(size, -FLT_MAX);
+		}
+		Set(index, bounds);
+		return index;
+	}
+
+	void BoundsList::Set(uint32_t index, const AABB& bounds)
+	{
+		FR_CORE_ASSERT(index < m_Count, "Invalid bounds index");
+		m_MinX[index] = bounds.Min.x;
+		m_MinY[index] = bounds.Min.y;
+		m_MaxX[index] = bounds.Max.x;
+		m_MaxY[index] = bounds.Max.y;
+	}
+
+	AABB BoundsList::Get(uint32_t index) const
+	{
+		FR_CORE_ASSERT(index < m_Count, "Invalid bounds index");
+		return AABB({ m_MinX[index], m_MinY[index] }, { m_MaxX[index], m_MaxY[index] });
+	}
+
+	void BoundsList::Clear()
+	{
+		std::fill(m_MinX.begin(), m_MinX.end(), FLT_MAX);
+		std::fill(m_MinY.begin(), m_MinY.end(), FLT_MAX);
+		std::fill(m_MaxX.begin(), m_MaxX.end(), -FLT_MAX);
+		std::fill(m_MaxY.begin(), m_MaxY.end(), -FLT_MAX);
+		m_Count = 0;
+	}
+
+	uint32_t BoundsList::Cull(const AABB& view, std::vector<uint32_t>& visible) const
+	{
+		visible.clear();
+
+		const SimdFloat viewMinX = SimdSet(view.Min.x);
+		const SimdFloat viewMinY = SimdSet(view.Min.y);
+		const SimdFloat viewMaxX = SimdSet(view.Max.x);
+		const SimdFloat viewMaxY = SimdSet(view.Max.y);
+
+		for (uint32_t first = 0; first < m_Count; first += SimdLanes)
+		{
+			SimdFloat inside = SimdAnd(
+				SimdAnd(SimdGreaterEqual(SimdLoad(&m_MaxX[first]), viewMinX), SimdLessEqual(SimdLoad(&m_MinX[first]), viewMaxX)),
+				SimdAnd(SimdGreaterEqual(SimdLoad(&m_MaxY[first]), viewMinY), SimdLessEqual(SimdLoad(&m_MinY[first]), viewMaxY)));
+
+			uint32_t mask = SimdMask(inside);
+			if (m_Count - first < SimdLanes)
+				mask &= (1u << (m_Count - first)) - 1; // An unbounded view would let the padding of the last batch pass
+			while (mask)
+			{
+				uint32_t lane = 0;
+				while (!(mask & (1u << lane)))
+					lane++;
+				visible.push_back(first + lane);
+				mask &= mask - 1;
+			}
+		}
+
+		return (uint32_t)visible.size();
+	}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+/*!
+* @file Culling.h
+* @brief Contains the BoundsList class that tests many bounding boxes against a view at once with SIMD.
+*
+* @see Renderer::Cull
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Renderer\Bounds.h"
+
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief A list of bounding boxes stored as four float arrays (min x, min y, max x, max y) so they can be tested 4 (SSE) or 8 (AVX) at a time.
+	*
+	* @details Usage:
+	*
+	* Fracture::BoundsList bounds;
+	* for (const Object& object : objects)
+	*     bounds.Add(object.LocalBounds.Transform(object.Transform));
+	*
+	* std::vector<uint32_t> visible;
+	* Fracture::Renderer::Cull(bounds, visible); // visible holds the indices of the boxes in view
+	*/
+	class BoundsList
+	{
+	public:
+		/*!
+		* @brief Adds a box and returns its index.
+		*/
+		uint32_t Add(const AABB& bounds);
+
+		/*!
+		* @brief Replaces the box at an index.
+		*/
+		void Set(uint32_t index, const AABB& bounds);
+
+		/*!
+		* @brief Returns the box at an index.
+		*/
+		AABB Get(uint32_t index) const;
+
+		/*!
+		* @brief Removes all the boxes. Keeps the memory.
+		*/
+		void Clear();
+
+		inline uint32_t GetCount() const { return m_Count; }
+
+		/*!
+		* @brief Appends the indices of the boxes that intersect the view to visible.
+		*
+		* @param[in] const AABB& view: The box to test against.
+		* @param[out] std::vector<uint32_t>& visible: The indices of the intersecting boxes, in increasing order. Cleared first.
+		*
+		* @return uint32_t: The number of intersecting boxes.
+		*/
+		uint32_t Cull(const AABB& view, std::vector<uint32_t>& visible) const;
+	private:
+		std::vector<float> m_MinX, m_MinY, m_MaxX, m_MaxY; /// The boxes, padded with empty boxes to a whole number of SIMD batches.
+		uint32_t m_Count = 0; /// The number of boxes.
+	};
+
+}
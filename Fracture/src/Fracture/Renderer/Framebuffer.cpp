@@ -0,0 +1,29 @@
+#include "frpch.h"
+#include "Framebuffer.h"
+
+#include "Fracture/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLFramebuffer.h"
+
+namespace Fracture {
+
+	Ref<Framebuffer> Framebuffer::Create(const FramebufferSpecification& specification)
+	{
+		FR_MEMORY_TAG(Renderer);
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:
+				FR_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+				return nullptr;
+			case RendererAPI::API::OpenGL:
+				return CreateRef<OpenGLFramebuffer>(specification);
+			case RendererAPI::API::Software:
+				// The software rasterizer only draws into its own SoftwareFramebuffer
+				FR_CORE_WARN("Framebuffers are not supported by the software renderer");
+				return nullptr;
+		}
+
+		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+/*!
+* @file Framebuffer.h
+* @brief Contains the Framebuffer class that is used to render into textures instead of the window. Each renderer will have its own implementation of the framebuffer class.
+*
+* @details Usage, rendering the scene at a lower resolution and scaling it up to the window:
+*
+* FramebufferSpecification spec;
+* spec.Width = (uint32_t)(windowWidth * renderScale);
+* spec.Height = (uint32_t)(windowHeight * renderScale);
+* Ref<Framebuffer> scene = Framebuffer::Create(spec);
+*
+* scene->Bind();
+* RenderCommand::Clear();
+* // Draw the scene
+* scene->Unbind();
+* scene->BlitToScreen(0, 0, windowWidth, windowHeight, FramebufferFilter::Linear);
+*
+* @see OpenGLFramebuffer
+* @see Renderer
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief The formats of the framebuffer attachments.
+	*/
+	enum class FramebufferFormat : uint8_t
+	{
+		None = 0,
+		RGBA8,				/// 8 bit colour, the format of the window.
+		RGBA16F,			/// Half float colour, for post effects that need values above 1.
+		Depth24Stencil8		/// Depth and stencil. Only used as the depth attachment.
+	};
+
+	/*!
+	* @brief How a blit samples the source when the source and the destination have different sizes.
+	*/
+	enum class FramebufferFilter : uint8_t
+	{
+		Nearest = 0,	/// Sharp pixels, the cheapest.
+		Linear			/// Bilinear, smoother when scaling up a lower render resolution.
+	};
+
+	/*!
+	* @brief The size, the attachments and the sample count of a framebuffer.
+	*/
+	struct FramebufferSpecification
+	{
+		uint32_t Width = 0, Height = 0; /// The size of the attachments in pixels.
+		std::vector<FramebufferFormat> ColorAttachments = { FramebufferFormat::RGBA8 }; /// The colour attachments, bound to the fragment shader outputs in order.
+		FramebufferFormat DepthAttachment = FramebufferFormat::Depth24Stencil8; /// The depth attachment, or None.
+		uint32_t Samples = 1; /// The MSAA sample count. Above 1 the framebuffer renders multisampled and resolves into textures before they are read.
+	};
+
+	/*!
+	* @brief The Framebuffer class is an abstract class for a set of textures that can be rendered into. Each renderer will have its own implementation of the framebuffer class.
+	*
+	* @details While a framebuffer is bound every draw and clear goes into it, with the viewport set to its size. The colour attachments can then be bound as
+	* textures, or copied into another framebuffer or the window with a blit that scales them. A multisampled framebuffer is resolved into single sampled
+	* textures the first time they are read after rendering, so Resolve only has to be called to control when that happens.
+	*/
+	class Framebuffer
+	{
+	public:
+		virtual ~Framebuffer() = default;
+
+		/*!
+		* @brief Makes the framebuffer the target of the following draws and clears and sets the viewport to its size.
+		*/
+		virtual void Bind() = 0;
+
+		/*!
+		* @brief Makes the window the target of the following draws again and restores the viewport Bind replaced.
+		*/
+		virtual void Unbind() = 0;
+
+		/*!
+		* @brief Recreates the attachments with a new size. The contents are lost. Does nothing if the size does not change or is 0.
+		*
+		* @param[in] uint32_t width: The new width in pixels.
+		* @param[in] uint32_t height: The new height in pixels.
+		*/
+		virtual void Resize(uint32_t width, uint32_t height) = 0;
+
+		/*!
+		* @brief Resolves the multisampled colour attachments into their textures. Does nothing if the framebuffer is not multisampled or was not rendered into since the last resolve.
+		*/
+		virtual void Resolve() = 0;
+
+		/*!
+		* @brief Binds a colour attachment as a texture to the specified slot. Resolves first if needed.
+		*
+		* @param[in] uint32_t index: The index of the colour attachment.
+		* @param[in] uint32_t slot: The slot to which the texture should be bound.
+		*/
+		virtual void BindColorAttachment(uint32_t index = 0, uint32_t slot = 0) = 0;
+
+		/*!
+		* @brief Function that returns the handle of the texture of a colour attachment, for example to show it in ImGui. Call Resolve first if the framebuffer is multisampled.
+		*
+		* @param[in] uint32_t index: The index of the colour attachment.
+		*
+		* @return uint32_t: The handle of the texture.
+		*/
+		virtual uint32_t GetColorAttachmentHandle(uint32_t index = 0) const = 0;
+
+		/*!
+		* @brief Copies the first colour attachment into the first colour attachment of another framebuffer, scaled to its size. Resolves first if needed.
+		*
+		* @param[in] Framebuffer& target: The framebuffer to copy into. Must not be multisampled.
+		* @param[in] FramebufferFilter filter: How the attachment is sampled when the sizes differ.
+		*/
+		virtual void Blit(Framebuffer& target, FramebufferFilter filter = FramebufferFilter::Linear) = 0;
+
+		/*!
+		* @brief Copies the first colour attachment into a rectangle of the window, scaled to its size. Resolves first if needed.
+		*
+		* @param[in] uint32_t x, y: The bottom left corner of the rectangle in pixels.
+		* @param[in] uint32_t width, height: The size of the rectangle in pixels.
+		* @param[in] FramebufferFilter filter: How the attachment is sampled when the sizes differ.
+		*/
+		virtual void BlitToScreen(uint32_t x, uint32_t y, uint32_t width, uint32_t height, FramebufferFilter filter = FramebufferFilter::Linear) = 0;
+
+		/*!
+		* @brief Function that returns the specification of the framebuffer, with its current size.
+		*/
+		virtual const FramebufferSpecification& GetSpecification() const = 0;
+
+		/*!
+		* @brief Function that creates a framebuffer.
+		*
+		* @details We check the renderer api that is being used and create the appropriate framebuffer for that renderer.
+		*
+		* @see OpenGLFramebuffer
+		*
+		* @param[in] const FramebufferSpecification& specification: The size, attachments and sample count of the framebuffer.
+		*
+		* @returns A shared pointer to the framebuffer, or nullptr when the renderer does not support framebuffers.
+		*/
+		static Ref<Framebuffer> Create(const FramebufferSpecification& specification);
+	};
+
+}
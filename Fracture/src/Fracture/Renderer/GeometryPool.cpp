@@ -0,0 +1,336 @@
+#include "frpch.h"
+#include "GeometryPool.h"
+
+namespace Fracture {
+
+	/// FNV-1a over the bytes of a range. Only used to find candidates, equal hashes are confirmed with memcmp.
+	static uint64_t HashBytes(const void* data, size_t size)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RangeAllocator /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RangeAllocator::RangeAllocator(uint32_t capacity)
+	{
+		Grow(capacity);
+	}
+
+	uint32_t RangeAllocator::Allocate(uint32_t size)
+	{
+		if (size == 0)
+			return 0;
+
+		uint32_t best = InvalidOffset;
+		for (uint32_t i = 0; i < (uint32_t)m_FreeBlocks.size(); i++)
+		{
+			if (m_FreeBlocks[i].Size >= size && (best == InvalidOffset || m_FreeBlocks[i].Size < m_FreeBlocks[best].Size))
+			{
+				best = i;
+				if (m_FreeBlocks[i].Size == size)
+					break;
+			}
+		}
+		if (best == InvalidOffset)
+			return InvalidOffset;
+
+		FreeBlock& block = m_FreeBlocks[best];
+		uint32_t offset = block.Offset;
+		block.Offset += size;
+		block.Size -= size;
+		if (block.Size == 0)
+			m_FreeBlocks.erase(m_FreeBlocks.begin() + best);
+		m_FreeSize -= size;
+		return offset;
+	}
+
+	void RangeAllocator::Free(uint32_t offset, uint32_t size)
+	{
+		if (size == 0)
+			return;
+		FR_CORE_ASSERT(offset + size <= m_Capacity, "Freed range is out of the allocator");
+
+		auto next = std::lower_bound(m_FreeBlocks.begin(), m_FreeBlocks.end(), offset, [](const FreeBlock& block, uint32_t value) { return block.Offset < value; });
+		FR_CORE_ASSERT(next == m_FreeBlocks.end() || offset + size <= next->Offset, "Freed range overlaps a free block");
+		m_FreeSize += size;
+
+		// Merge with the free block before and after it, so neighbouring free space is always one block
+		bool mergePrevious = next != m_FreeBlocks.begin() && (next - 1)->Offset + (next - 1)->Size == offset;
+		bool mergeNext = next != m_FreeBlocks.end() && offset + size == next->Offset;
+		if (mergePrevious && mergeNext)
+		{
+			(next - 1)->Size += size + next->Size;
+			m_FreeBlocks.erase(next);
+		}
+		else if (mergePrevious)
+			(next - 1)->Size += size;
+		else if (mergeNext)
+		{
+			next->Offset = offset;
+			next->Size += size;
+		}
+		else
+			m_FreeBlocks.insert(next, { offset, size });
+	}
+
+	void RangeAllocator::Grow(uint32_t capacity)
+	{
+		if (capacity <= m_Capacity)
+			return;
+		uint32_t previous = m_Capacity;
+		m_Capacity = capacity;
+		Free(previous, capacity - previous);
+	}
+
+	void RangeAllocator::Reset(uint32_t used)
+	{
+		FR_CORE_ASSERT(used <= m_Capacity, "More elements in use than the capacity");
+		m_FreeBlocks.clear();
+		m_FreeSize = m_Capacity - used;
+		if (m_FreeSize > 0)
+			m_FreeBlocks.push_back({ used, m_FreeSize });
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GeometryPool ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GeometryPool::GeometryPool(const BufferLayout& layout, uint32_t vertexCapacity, uint32_t indexCapacity)
+		: m_Layout(layout), m_Stride(layout.GetStride() / sizeof(float)), m_PositionOffset(0)
+	{
+		FR_MEMORY_TAG(Renderer);
+		auto position = std::find_if(layout.begin(), layout.end(), [](const BufferElement& element) { return element.Name == "a_Position"; });
+		FR_CORE_ASSERT(position != layout.end(), "A geometry pool needs an a_Position element in its layout");
+		m_PositionOffset = position->Offset / sizeof(float);
+
+		m_Vertices.ElementSize = layout.GetStride();
+		m_Vertices.Allocator.Grow(vertexCapacity);
+		m_Vertices.Data.resize((size_t)vertexCapacity * m_Vertices.ElementSize);
+		m_Indices.ElementSize = sizeof(uint32_t);
+		m_Indices.Allocator.Grow(indexCapacity);
+		m_Indices.Data.resize((size_t)indexCapacity * m_Indices.ElementSize);
+		Reallocate();
+	}
+
+	GeometryHandle GeometryPool::Add(const float* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+	{
+		FR_PROFILE_FUNCTION();
+		FR_MEMORY_TAG(Renderer);
+		bool vertexCreated = false, indexCreated = false, grew = false;
+		Mesh mesh;
+		mesh.VertexBlock = Acquire(m_Vertices, vertices, vertexCount, vertexCreated, grew);
+		mesh.IndexBlock = Acquire(m_Indices, indices, indexCount, indexCreated, grew);
+		mesh.Alive = true;
+		UpdateRange(mesh);
+		for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+		{
+			const float* position = vertices + vertex * m_Stride + m_PositionOffset;
+			mesh.Range.Bounds.Merge(AABB({ position[0], position[1] }, { position[0], position[1] }));
+		}
+
+		if (grew)
+			Reallocate();
+		else
+		{
+			// Only ranges that were not found in the pool are uploaded
+			const Block& vertexBlock = m_Vertices.Blocks[mesh.VertexBlock];
+			const Block& indexBlock = m_Indices.Blocks[mesh.IndexBlock];
+			if (vertexCreated && vertexCount > 0)
+				m_VertexBuffer->SetSubData(vertices, vertexCount * m_Vertices.ElementSize, vertexBlock.Offset * m_Vertices.ElementSize);
+			if (indexCreated && indexCount > 0)
+				m_IndexBuffer->SetSubData(indices, indexCount * m_Indices.ElementSize, indexBlock.Offset * m_Indices.ElementSize);
+		}
+
+		GeometryHandle handle;
+		if (!m_FreeMeshes.empty())
+		{
+			handle.ID = m_FreeMeshes.back();
+			m_FreeMeshes.pop_back();
+			m_Meshes[handle.ID] = mesh;
+		}
+		else
+		{
+			handle.ID = (uint32_t)m_Meshes.size();
+			m_Meshes.push_back(mesh);
+		}
+		return handle;
+	}
+
+	void GeometryPool::Remove(GeometryHandle mesh)
+	{
+		FR_CORE_ASSERT(mesh.ID < m_Meshes.size() && m_Meshes[mesh.ID].Alive, "Invalid geometry handle");
+		Mesh& entry = m_Meshes[mesh.ID];
+		Release(m_Vertices, entry.VertexBlock);
+		Release(m_Indices, entry.IndexBlock);
+		entry.Alive = false;
+		m_FreeMeshes.push_back(mesh.ID);
+	}
+
+	const MeshRange& GeometryPool::GetRange(GeometryHandle mesh) const
+	{
+		FR_CORE_ASSERT(mesh.ID < m_Meshes.size() && m_Meshes[mesh.ID].Alive, "Invalid geometry handle");
+		return m_Meshes[mesh.ID].Range;
+	}
+
+	void GeometryPool::Defragment()
+	{
+		if (m_Vertices.Allocator.IsCompact() && m_Indices.Allocator.IsCompact())
+			return;
+
+		FR_PROFILE_FUNCTION();
+		uint32_t usedVertices = Compact(m_Vertices);
+		uint32_t usedIndices = Compact(m_Indices);
+		for (Mesh& mesh : m_Meshes)
+		{
+			if (mesh.Alive)
+				UpdateRange(mesh);
+		}
+
+		// The buffers keep their capacity, only the packed part is uploaded again
+		if (usedVertices > 0)
+			m_VertexBuffer->SetSubData(m_Vertices.Data.data(), usedVertices * m_Vertices.ElementSize, 0);
+		if (usedIndices > 0)
+			m_IndexBuffer->SetSubData(m_Indices.Data.data(), usedIndices * m_Indices.ElementSize, 0);
+		m_Generation++;
+	}
+
+	GeometryPoolStats GeometryPool::GetStats() const
+	{
+		GeometryPoolStats stats;
+		stats.MeshCount = (uint32_t)(m_Meshes.size() - m_FreeMeshes.size());
+		stats.VertexRanges = (uint32_t)(m_Vertices.Blocks.size() - m_Vertices.FreeSlots.size());
+		stats.IndexRanges = (uint32_t)(m_Indices.Blocks.size() - m_Indices.FreeSlots.size());
+		stats.DeduplicatedUploads = m_Vertices.Deduplicated + m_Indices.Deduplicated;
+		stats.VertexCapacity = m_Vertices.Allocator.GetCapacity();
+		stats.UsedVertices = stats.VertexCapacity - m_Vertices.Allocator.GetFreeSize();
+		stats.IndexCapacity = m_Indices.Allocator.GetCapacity();
+		stats.UsedIndices = stats.IndexCapacity - m_Indices.Allocator.GetFreeSize();
+		stats.FreeBlocks = m_Vertices.Allocator.GetFreeBlockCount() + m_Indices.Allocator.GetFreeBlockCount();
+		return stats;
+	}
+
+	uint32_t GeometryPool::Acquire(Arena& arena, const void* data, uint32_t count, bool& created, bool& grew)
+	{
+		size_t size = (size_t)count * arena.ElementSize;
+		uint64_t hash = HashBytes(data, size);
+
+		auto candidates = arena.Lookup.equal_range(hash);
+		for (auto it = candidates.first; it != candidates.second; ++it)
+		{
+			Block& block = arena.Blocks[it->second];
+			if (block.Size == count && memcmp(arena.Data.data() + (size_t)block.Offset * arena.ElementSize, data, size) == 0)
+			{
+				block.RefCount++;
+				arena.Deduplicated++;
+				return it->second;
+			}
+		}
+
+		uint32_t offset = arena.Allocator.Allocate(count);
+		if (offset == RangeAllocator::InvalidOffset)
+		{
+			uint32_t capacity = arena.Allocator.GetCapacity();
+			arena.Allocator.Grow(std::max(capacity * 2, capacity + count));
+			arena.Data.resize((size_t)arena.Allocator.GetCapacity() * arena.ElementSize);
+			offset = arena.Allocator.Allocate(count);
+			grew = true;
+		}
+		if (size > 0)
+			memcpy(arena.Data.data() + (size_t)offset * arena.ElementSize, data, size);
+
+		uint32_t slot;
+		if (!arena.FreeSlots.empty())
+		{
+			slot = arena.FreeSlots.back();
+			arena.FreeSlots.pop_back();
+		}
+		else
+		{
+			slot = (uint32_t)arena.Blocks.size();
+			arena.Blocks.emplace_back();
+		}
+		arena.Blocks[slot] = { offset, count, 1, hash };
+		arena.Lookup.emplace(hash, slot);
+		created = true;
+		return slot;
+	}
+
+	void GeometryPool::Release(Arena& arena, uint32_t slot)
+	{
+		Block& block = arena.Blocks[slot];
+		FR_CORE_ASSERT(block.RefCount > 0, "Released a geometry range that is not in use");
+		if (--block.RefCount > 0)
+			return;
+
+		arena.Allocator.Free(block.Offset, block.Size);
+		auto candidates = arena.Lookup.equal_range(block.Hash);
+		for (auto it = candidates.first; it != candidates.second; ++it)
+		{
+			if (it->second == slot)
+			{
+				arena.Lookup.erase(it);
+				break;
+			}
+		}
+		arena.FreeSlots.push_back(slot);
+	}
+
+	uint32_t GeometryPool::Compact(Arena& arena)
+	{
+		std::vector<uint32_t> live;
+		for (uint32_t slot = 0; slot < (uint32_t)arena.Blocks.size(); slot++)
+		{
+			if (arena.Blocks[slot].RefCount > 0)
+				live.push_back(slot);
+		}
+		std::sort(live.begin(), live.end(), [&arena](uint32_t a, uint32_t b) { return arena.Blocks[a].Offset < arena.Blocks[b].Offset; });
+
+		// Walking in offset order every block moves down or stays, so memmove never overwrites a block that has not moved yet
+		uint32_t cursor = 0;
+		for (uint32_t slot : live)
+		{
+			Block& block = arena.Blocks[slot];
+			if (block.Offset != cursor)
+			{
+				memmove(arena.Data.data() + (size_t)cursor * arena.ElementSize, arena.Data.data() + (size_t)block.Offset * arena.ElementSize, (size_t)block.Size * arena.ElementSize);
+				block.Offset = cursor;
+			}
+			cursor += block.Size;
+		}
+		arena.Allocator.Reset(cursor);
+		return cursor;
+	}
+
+	void GeometryPool::Reallocate()
+	{
+		FR_PROFILE_FUNCTION();
+		FR_MEMORY_TAG(Renderer);
+		m_VertexBuffer = VertexBuffer::Create((float*)m_Vertices.Data.data(), (uint32_t)m_Vertices.Data.size());
+		m_VertexBuffer->SetLayout(m_Layout);
+		m_IndexBuffer = IndexBuffer::Create((uint32_t*)m_Indices.Data.data(), m_Indices.Allocator.GetCapacity());
+
+		m_VertexArray = VertexArray::Create();
+		m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+		m_VertexArray->SetIndexBuffer(m_IndexBuffer);
+	}
+
+	void GeometryPool::UpdateRange(Mesh& mesh)
+	{
+		const Block& vertexBlock = m_Vertices.Blocks[mesh.VertexBlock];
+		const Block& indexBlock = m_Indices.Blocks[mesh.IndexBlock];
+		mesh.Range.BaseVertex = (int32_t)vertexBlock.Offset;
+		mesh.Range.VertexCount = vertexBlock.Size;
+		mesh.Range.FirstIndex = indexBlock.Offset;
+		mesh.Range.IndexCount = indexBlock.Size;
+	}
+
+}
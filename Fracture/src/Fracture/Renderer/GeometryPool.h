@@ -0,0 +1,274 @@
+#pragma once
+/*!
+* @file GeometryPool.h
+* @brief Contains the GeometryPool class that sub-allocates the vertices and indices of many meshes from one large vertex and index buffer.
+*
+* @details Usage:
+*
+* Fracture::GeometryPool pool(layout);
+* Fracture::GeometryHandle square = pool.Add(squareVertices, 4, squareIndices, 6);
+* Fracture::GeometryHandle quad = pool.Add(quadVertices, 4, squareIndices, 6); // shares the index range of the square
+*
+* Fracture::Renderer::Submit(pool, square, shader, transform); // one mesh
+*
+* Fracture::IndirectDrawList draws;
+* draws.Add(pool.GetRange(square), squareTransform);
+* draws.Add(pool.GetRange(quad), quadTransform);
+* Fracture::Renderer::SubmitIndirect(pool, draws, shader); // every mesh with one call
+*
+* pool.Remove(quad);
+* pool.Defragment(); // moves the ranges, draw lists holding ranges of the pool have to be refilled
+*
+* @see IndirectDrawList, Renderer::SubmitIndirect
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Renderer\Bounds.h"
+#include "Fracture\Renderer\Buffer.h"
+#include "Fracture\Renderer\RendererAPI.h"
+#include "Fracture\Renderer\VertexArray.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace Fracture {
+
+	/// A handle to a mesh of a GeometryPool. Stays valid while meshes are added and removed around it and when the pool is defragmented.
+	struct GeometryHandle
+	{
+		static constexpr uint32_t InvalidID = 0xFFFFFFFF; /// The id of a null handle.
+
+		uint32_t ID = InvalidID; /// The slot of the mesh in the GeometryPool.
+
+		inline bool IsValid() const { return ID != InvalidID; }
+		inline bool operator==(const GeometryHandle& other) const { return ID == other.ID; }
+		inline bool operator!=(const GeometryHandle& other) const { return ID != other.ID; }
+	};
+
+	/// The part of the buffers of a GeometryPool a mesh occupies.
+	struct MeshRange
+	{
+		uint32_t FirstIndex = 0; /// The first index of the mesh in the shared index buffer.
+		uint32_t IndexCount = 0; /// The number of indices of the mesh.
+		int32_t BaseVertex = 0; /// The first vertex of the mesh in the shared vertex buffer. The indices of the mesh are relative to it.
+		uint32_t VertexCount = 0; /// The number of vertices of the mesh.
+		AABB Bounds; /// The model space bounds of the mesh.
+
+		/*!
+		* @brief Returns the indirect command that draws the mesh.
+		*/
+		inline DrawIndexedIndirectCommand GetCommand() const { return { IndexCount, 1, FirstIndex, BaseVertex, 0 }; }
+	};
+
+	/*!
+	* @brief Free list allocator of ranges of [0, capacity). Sizes and offsets are in elements, not bytes.
+	*
+	* @details The free blocks are kept sorted by offset. Allocate takes the front of the smallest free block the size fits in (best fit) and Free merges
+	* the block with its free neighbours, so the list stays short for the few hundred meshes a pool usually holds.
+	*/
+	class RangeAllocator
+	{
+	public:
+		static constexpr uint32_t InvalidOffset = 0xFFFFFFFF; /// Returned by Allocate when no free block is large enough.
+
+		RangeAllocator(uint32_t capacity = 0);
+
+		/*!
+		* @brief Allocates a range of size elements.
+		*
+		* @return uint32_t: The offset of the range, or InvalidOffset if no free block is large enough.
+		*/
+		uint32_t Allocate(uint32_t size);
+
+		/*!
+		* @brief Returns a range to the allocator.
+		*/
+		void Free(uint32_t offset, uint32_t size);
+
+		/*!
+		* @brief Extends the capacity. The new space is free.
+		*/
+		void Grow(uint32_t capacity);
+
+		/*!
+		* @brief Marks [0, used) as allocated and the rest as one free block. Used after the allocations were compacted.
+		*/
+		void Reset(uint32_t used);
+
+		inline uint32_t GetCapacity() const { return m_Capacity; }
+		inline uint32_t GetFreeSize() const { return m_FreeSize; }
+		inline uint32_t GetFreeBlockCount() const { return (uint32_t)m_FreeBlocks.size(); }
+
+		/*!
+		* @brief Returns whether every allocation is packed at the start, in which case compacting moves nothing.
+		*/
+		inline bool IsCompact() const { return m_FreeBlocks.empty() || (m_FreeBlocks.size() == 1 && m_FreeBlocks[0].Offset + m_FreeBlocks[0].Size == m_Capacity); }
+	private:
+		struct FreeBlock
+		{
+			uint32_t Offset;
+			uint32_t Size;
+		};
+
+		std::vector<FreeBlock> m_FreeBlocks; /// The free blocks, sorted by offset. Neighbouring free blocks are always merged.
+		uint32_t m_Capacity = 0; /// The number of elements managed.
+		uint32_t m_FreeSize = 0; /// The number of free elements.
+	};
+
+	/// The counters of a GeometryPool, for debug overlays.
+	struct GeometryPoolStats
+	{
+		uint32_t MeshCount = 0; /// The number of meshes in the pool.
+		uint32_t VertexRanges = 0; /// The number of distinct vertex ranges. Lower than MeshCount when meshes share vertices.
+		uint32_t IndexRanges = 0; /// The number of distinct index ranges. Lower than MeshCount when meshes share indices.
+		uint32_t DeduplicatedUploads = 0; /// The number of vertex and index ranges that were found in the pool instead of uploaded.
+		uint32_t UsedVertices = 0;
+		uint32_t VertexCapacity = 0;
+		uint32_t UsedIndices = 0;
+		uint32_t IndexCapacity = 0;
+		uint32_t FreeBlocks = 0; /// The number of free vertex and index blocks. More than 2 means the pool is fragmented.
+	};
+
+	/*!
+	* @brief A large shared vertex and index buffer that the vertices and indices of meshes are sub-allocated from.
+	*
+	* @details The vertices and the indices of a mesh are stored as two separate ranges. Each range is hashed when it is added and a range with the same
+	* contents already in the pool is shared instead of uploaded again, so meshes with identical indices (every quad) or identical vertices cost one
+	* range. Ranges are reference counted and freed when the last mesh using them is removed.
+	*
+	* New ranges are uploaded with SetSubData. When a range does not fit the capacity is doubled and the buffers and the vertex array are recreated from
+	* the system memory copy. Removing meshes leaves holes that later meshes reuse; Defragment packs the ranges at the start of the buffers again.
+	*
+	* Indices stay relative to the first vertex of their mesh (the BaseVertex of its range), which is what lets index ranges be shared and moved.
+	*/
+	class GeometryPool
+	{
+	public:
+		/*!
+		* @brief Constructs the buffers.
+		*
+		* @param[in] const BufferLayout& layout: The layout of the vertices of every mesh. It must contain an element named "a_Position".
+		* @param[in] uint32_t vertexCapacity: The number of vertices the buffers initially hold.
+		* @param[in] uint32_t indexCapacity: The number of indices the buffers initially hold.
+		*/
+		GeometryPool(const BufferLayout& layout, uint32_t vertexCapacity = 4096, uint32_t indexCapacity = 16384);
+
+		/*!
+		* @brief Adds a mesh to the pool.
+		*
+		* @param[in] const float* vertices: The vertices, laid out as described by the layout of the pool.
+		* @param[in] uint32_t vertexCount: The number of vertices.
+		* @param[in] const uint32_t* indices: The indices, relative to the first vertex of the mesh.
+		* @param[in] uint32_t indexCount: The number of indices.
+		*
+		* @return GeometryHandle: The handle of the mesh.
+		*/
+		GeometryHandle Add(const float* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+		/*!
+		* @brief Removes a mesh. Its ranges are freed once no other mesh shares them. The GPU buffers are not touched.
+		*/
+		void Remove(GeometryHandle mesh);
+
+		/*!
+		* @brief Returns the range a mesh occupies. It changes when the pool is defragmented.
+		*/
+		const MeshRange& GetRange(GeometryHandle mesh) const;
+
+		/*!
+		* @brief Moves every range to the start of the buffers, closing the holes left by removed meshes, and uploads the moved part once.
+		*
+		* @details Handles stay valid but their ranges move. GetGeneration changes, so draw lists holding ranges of the pool know to refill.
+		*/
+		void Defragment();
+
+		/*!
+		* @brief Returns a counter that changes every time the ranges of existing meshes move.
+		*/
+		inline uint32_t GetGeneration() const { return m_Generation; }
+
+		GeometryPoolStats GetStats() const;
+
+		inline const Ref<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+		inline const BufferLayout& GetLayout() const { return m_Layout; }
+	private:
+		/// A range of one of the buffers, shared by every mesh with the same contents.
+		struct Block
+		{
+			uint32_t Offset = 0; /// The offset of the range in elements.
+			uint32_t Size = 0; /// The size of the range in elements.
+			uint32_t RefCount = 0; /// The number of meshes using the range. 0 for an unused slot.
+			uint64_t Hash = 0; /// The hash of the contents.
+		};
+
+		/// The ranges of one of the buffers and the system memory copy of the buffer.
+		struct Arena
+		{
+			uint32_t ElementSize = 0; /// The size of an element (a vertex or an index) in bytes.
+			RangeAllocator Allocator;
+			std::vector<uint8_t> Data; /// The system memory copy of the buffer, used when it is reallocated or defragmented.
+			std::vector<Block> Blocks; /// The ranges, addressed by slot.
+			std::vector<uint32_t> FreeSlots; /// The unused slots of Blocks.
+			std::unordered_multimap<uint64_t, uint32_t> Lookup; /// The slots of the ranges by the hash of their contents.
+			uint32_t Deduplicated = 0; /// The number of ranges that were shared instead of allocated.
+		};
+
+		/// A mesh, the pair of ranges it uses.
+		struct Mesh
+		{
+			uint32_t VertexBlock = 0;
+			uint32_t IndexBlock = 0;
+			MeshRange Range;
+			bool Alive = false;
+		};
+
+		/*!
+		* @brief Finds a range with the given contents or allocates and fills a new one.
+		*
+		* @param[out] bool& created: Set to true when a new range was allocated.
+		* @param[out] bool& grew: Set to true when the arena had to grow, in which case the GPU buffers have to be recreated.
+		*
+		* @return uint32_t: The slot of the range.
+		*/
+		static uint32_t Acquire(Arena& arena, const void* data, uint32_t count, bool& created, bool& grew);
+
+		/*!
+		* @brief Drops a reference to a range and frees it when it was the last.
+		*/
+		static void Release(Arena& arena, uint32_t slot);
+
+		/*!
+		* @brief Moves the ranges of the arena to its start.
+		*
+		* @return uint32_t: The number of elements in use, all at the start of the arena.
+		*/
+		static uint32_t Compact(Arena& arena);
+
+		/*!
+		* @brief Recreates the buffers and the vertex array with the capacity of the arenas and uploads the system memory copies.
+		*/
+		void Reallocate();
+
+		/*!
+		* @brief Recomputes the range of a mesh from the offsets of its blocks.
+		*/
+		void UpdateRange(Mesh& mesh);
+	private:
+		BufferLayout m_Layout; /// The layout of the vertices.
+		uint32_t m_Stride; /// The number of floats per vertex.
+		uint32_t m_PositionOffset; /// The index of the x coordinate of the position within a vertex, in floats.
+
+		Arena m_Vertices; /// The vertex ranges. An element is a vertex.
+		Arena m_Indices; /// The index ranges. An element is a uint32_t index.
+		std::vector<Mesh> m_Meshes; /// The meshes, addressed by the id of their handle.
+		std::vector<uint32_t> m_FreeMeshes; /// The unused slots of m_Meshes.
+		uint32_t m_Generation = 0; /// Incremented when the ranges move.
+
+		Ref<VertexArray> m_VertexArray; /// The vertex array of the shared buffers.
+		Ref<VertexBuffer> m_VertexBuffer; /// The shared vertex buffer.
+		Ref<IndexBuffer> m_IndexBuffer; /// The shared index buffer.
+	};
+
+}
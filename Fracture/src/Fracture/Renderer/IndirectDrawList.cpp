@@ -0,0 +1,37 @@
+#include "frpch.h"
+#include "IndirectDrawList.h"
+
+namespace Fracture {
+
+	void IndirectDrawList::Add(const MeshRange& mesh, const glm::mat4& transform, uint32_t materialIndex)
+	{
+		FR_MEMORY_TAG(Renderer);
+		m_Commands.push_back(mesh.GetCommand());
+		IndirectDrawData data;
+		data.Transform = transform;
+		data.MaterialIndex = materialIndex;
+		m_DrawData.push_back(data);
+		m_Dirty = true;
+	}
+
+	void IndirectDrawList::Clear()
+	{
+		m_Commands.clear();
+		m_DrawData.clear();
+		m_Dirty = true;
+	}
+
+	void IndirectDrawList::Upload()
+	{
+		if (!m_Dirty || m_DrawData.empty())
+			return;
+
+		FR_PROFILE_FUNCTION();
+		uint32_t size = (uint32_t)(m_DrawData.size() * sizeof(IndirectDrawData));
+		if (!m_DrawDataBuffer)
+			m_DrawDataBuffer = StorageBuffer::Create(size);
+		m_DrawDataBuffer->SetData(m_DrawData.data(), size);
+		m_Dirty = false;
+	}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+/*!
+* @file IndirectDrawList.h
+* @brief Contains the IndirectDrawList class that collects the draws of meshes of a GeometryPool for a single multi draw.
+*
+* @see GeometryPool, Renderer::SubmitIndirect
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Renderer\Buffer.h"
+#include "Fracture\Renderer\GeometryPool.h"
+#include "Fracture\Renderer\RendererAPI.h"
+
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief A list of indirect draw commands with their per draw data (transform and material index).
+	*
+	* @details The per draw data is uploaded to a storage buffer that the shader indexes with gl_DrawID, so every draw can have its own transform and
+	* material while the whole list is drawn with one call. Usually cleared and refilled every frame; the storage buffer is reused and only grows.
+	*
+	* The vertex shader reads the data with:
+	*
+	* #extension GL_ARB_shader_draw_parameters : require
+	* struct DrawData { mat4 Transform; uint MaterialIndex; };
+	* layout(std430, binding = 0) readonly buffer DrawDataBuffer { DrawData u_Draws[]; };
+	* ... u_Draws[gl_DrawIDARB].Transform ...
+	*/
+	class IndirectDrawList
+	{
+	public:
+		IndirectDrawList() = default;
+
+		/*!
+		* @brief Adds a draw of a mesh.
+		*
+		* @param[in] const MeshRange& mesh: The mesh to draw, from the GeometryPool the list is submitted with. Refill the list when the generation of the pool changes.
+		* @param[in] const glm::mat4& transform: The model matrix of the draw.
+		* @param[in] uint32_t materialIndex: The material index the shader receives for the draw.
+		*/
+		void Add(const MeshRange& mesh, const glm::mat4& transform, uint32_t materialIndex = 0);
+
+		/*!
+		* @brief Removes every draw. Keeps the memory.
+		*/
+		void Clear();
+
+		/*!
+		* @brief Uploads the per draw data to the storage buffer if it changed since the last upload.
+		*/
+		void Upload();
+
+		inline uint32_t GetDrawCount() const { return (uint32_t)m_Commands.size(); }
+		inline const std::vector<DrawIndexedIndirectCommand>& GetCommands() const { return m_Commands; }
+		inline const std::vector<IndirectDrawData>& GetDrawData() const { return m_DrawData; }
+
+		/*!
+		* @brief Returns the storage buffer holding the per draw data, or nullptr before the first upload.
+		*/
+		inline const Ref<StorageBuffer>& GetDrawDataBuffer() const { return m_DrawDataBuffer; }
+	private:
+		std::vector<DrawIndexedIndirectCommand> m_Commands; /// The draws.
+		std::vector<IndirectDrawData> m_DrawData; /// The per draw data, in the same order as the commands.
+		Ref<StorageBuffer> m_DrawDataBuffer; /// The storage buffer the per draw data is uploaded to.
+		bool m_Dirty = false; /// Whether the draw data changed since the last upload.
+	};
+
+}
@@ -23,4 +23,11 @@ namespace Fracture {
 		m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
 	}
 
+	glm::vec2 OrthographicCamera::ScreenToWorld(const glm::vec2& screenPosition, const glm::vec2& viewportSize) const
+	{
+		glm::vec4 ndc((screenPosition.x / viewportSize.x) * 2.0f - 1.0f, 1.0f - (screenPosition.y / viewportSize.y) * 2.0f, 0.0f, 1.0f);
+		glm::vec4 world = glm::inverse(m_ViewProjectionMatrix) * ndc;
+		return glm::vec2(world.x, world.y) / world.w;
+	}
+
 }
\ No newline at end of file
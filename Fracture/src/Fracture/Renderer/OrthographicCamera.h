@@ -87,6 +87,17 @@ namespace Fracture {
 		* @param[in] const glm::mat4& view The view matrix of the camera.
 		*/
 		void SetViewMatrix(const glm::mat4& view) { m_ViewMatrix = view; m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix; }
+		/*!
+		* @brief Function that unprojects a position on the screen to the world space position under it on the XY plane.
+		* 
+		* @details The screen position is converted to normalized device coordinates (y points down on the screen and up in clip space) and transformed by the inverse view projection matrix.
+		* 
+		* @param[in] const glm::vec2& screenPosition The position in pixels from the top left corner of the viewport, for example Input::GetMousePosition.
+		* @param[in] const glm::vec2& viewportSize The size of the viewport in pixels.
+		* 
+		* @return glm::vec2 The world space position.
+		*/
+		glm::vec2 ScreenToWorld(const glm::vec2& screenPosition, const glm::vec2& viewportSize) const;
 	private:
 		glm::mat4 m_ProjectionMatrix; /// 4x4 projection matrix of the camera
 		glm::mat4 m_ViewMatrix; /// 4x4 view matrix of the camera
@@ -11,7 +11,6 @@ namespace Fracture {
 	OrthographicCameraController::OrthographicCameraController(float aspectRatio, float enableRotation) :m_AspectRatio(aspectRatio), m_Camera(-aspectRatio * m_ZoomLevel, aspectRatio * m_ZoomLevel, -m_ZoomLevel, m_ZoomLevel), m_EnableRotation(enableRotation)
 	{
 		//FR_PROFILE_FUNCTION();
-		//Fracture::EventDispatcher::Connect<Fracture::MouseButtonPressedEvent>(FR_BIND_EVENT_FN(OrthographicCameraController::OnMouseButtonDownEvent));
 	}
 
 	void OrthographicCameraController::OnUpdate(Utils::Timestep delta_time)
@@ -59,13 +58,12 @@ namespace Fracture {
 		m_MiddleMouseScale = m_ZoomLevel * 0.005f;
 	}
 
-	void OrthographicCameraController::OnEvent(Event& e)
+	void OrthographicCameraController::SubscribeEvents(EventHandlers& handlers)
 	{
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<MouseScrolledEvent>(FRACTURE_BIND_EVENT_FN(OrthographicCameraController::OnMouseScrolledEvent));
-		dispatcher.Dispatch<WindowResizeEvent>(FRACTURE_BIND_EVENT_FN(OrthographicCameraController::OnWindowResizedEvent));
-		dispatcher.Dispatch<MouseButtonPressedEvent>(FRACTURE_BIND_EVENT_FN(OrthographicCameraController::OnMouseButtonDownEvent));
-		dispatcher.Dispatch<MouseButtonReleasedEvent>(FRACTURE_BIND_EVENT_FN(OrthographicCameraController::OnMouseButtonUpEvent));
+		handlers.Subscribe<&OrthographicCameraController::OnMouseScrolledEvent>(this);
+		handlers.Subscribe<&OrthographicCameraController::OnWindowResizedEvent>(this);
+		handlers.Subscribe<&OrthographicCameraController::OnMouseButtonDownEvent>(this);
+		handlers.Subscribe<&OrthographicCameraController::OnMouseButtonUpEvent>(this);
 	}
 
 	bool OrthographicCameraController::OnMouseScrolledEvent(MouseScrolledEvent& e)
@@ -17,6 +17,7 @@
 #include <Fracture\Events\ApplicationEvent.h>
 #include <Fracture\Events\MouseEvent.h>
 #include <Fracture\Events\KeyEvent.h>
+#include <Fracture\Events\EventHandlers.h>
 
 
 #include <glm\glm.hpp>
@@ -47,11 +48,11 @@ namespace Fracture {
 		void OnUpdate(Utils::Timestep ts);
 
 		/*!
-		* @brief the OnEvent function that is called by the layer that owns the OrthographicCameraController when an event is triggered.
+		* @brief Subscribes the event handlers of the controller to the handlers of the layer that owns it. Called once by the layer.
 		* 
-		* @param[in] Event& e The event that is triggered.
+		* @param[in] EventHandlers& handlers The event handlers of the owning layer.
 		*/
-		void OnEvent(Event& e);
+		void SubscribeEvents(EventHandlers& handlers);
 
 		/*!
 		* @brief Getter for the OrthographicCamera.
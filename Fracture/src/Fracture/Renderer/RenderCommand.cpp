@@ -2,6 +2,7 @@
 #include "RenderCommand.h"
 
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
 
 namespace Fracture {
 
@@ -9,6 +10,7 @@ namespace Fracture {
 		switch (RendererAPI::GetAPI()) {
 			case RendererAPI::API::None: FR_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL: return CreateScope<OpenGLRendererAPI>();
+			case RendererAPI::API::Software: return CreateScope<SoftwareRendererAPI>();
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
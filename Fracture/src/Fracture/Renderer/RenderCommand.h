@@ -12,6 +12,7 @@
 */
 
 #include "Fracture\Renderer\RendererAPI.h"
+#include "Fracture\Utils\FrameStats.h"
 
 namespace Fracture{
 
@@ -45,9 +46,57 @@ namespace Fracture{
 		*/
 		inline static void DrawIndexed(uint32_t indexCount)
 		{
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::DrawCalls);
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::Indices, indexCount);
 			GetRendererAPI()->DrawIndexed(indexCount);
 		}
 
+		/*!
+		* @brief Function that draws a range of the index buffer of the currently bound vertex array. Calls the DrawIndexedRange function of the current renderer API.
+		* 
+		* @param[in] uint32_t indexCount: The number of indices to draw.
+		* @param[in] uint32_t firstIndex: The first index to draw.
+		* @param[in] int32_t baseVertex: The value added to every index before fetching the vertex.
+		*/
+		inline static void DrawIndexedRange(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
+		{
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::DrawCalls);
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::Indices, indexCount);
+			GetRendererAPI()->DrawIndexedRange(indexCount, firstIndex, baseVertex);
+		}
+
+		/*!
+		* @brief Function that draws a range of the index buffer of the currently bound vertex array, described by an indirect command.
+		* 
+		* @see RendererAPI::DrawIndexedIndirect
+		* 
+		* @param[in] const DrawIndexedIndirectCommand& command: The draw.
+		*/
+		inline static void DrawIndexedIndirect(const DrawIndexedIndirectCommand& command)
+		{
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::DrawCalls);
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::Indices, command.Count * command.InstanceCount);
+			GetRendererAPI()->DrawIndexedIndirect(command);
+		}
+
+		/*!
+		* @brief Function that draws many ranges of the currently bound vertex array with one call to the current renderer API. Counts as one draw call.
+		* 
+		* @see RendererAPI::MultiDrawIndexedIndirect
+		* 
+		* @param[in] const DrawIndexedIndirectCommand* commands: The draws.
+		* @param[in] uint32_t drawCount: The number of draws.
+		*/
+		inline static void MultiDrawIndexedIndirect(const DrawIndexedIndirectCommand* commands, uint32_t drawCount)
+		{
+			uint32_t indexCount = 0;
+			for (uint32_t i = 0; i < drawCount; i++)
+				indexCount += commands[i].Count * commands[i].InstanceCount;
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::DrawCalls);
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::Indices, indexCount);
+			GetRendererAPI()->MultiDrawIndexedIndirect(commands, drawCount);
+		}
+
 		/*!
 		* @brief Function that sets the clear color of the renderer API. Calls the SetClearColor function of the current renderer API.
 		*
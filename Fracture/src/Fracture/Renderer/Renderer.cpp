@@ -8,17 +8,25 @@ namespace Fracture
 
 	void Renderer::Init()
 	{
+		FR_MEMORY_TAG(Renderer);
 		RenderCommand::GetRendererAPI();
 	}
 
 	void Renderer::BeginScene(OrthographicCamera& camera)
 	{
+		FR_MEMORY_TAG(Renderer);
 		s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
 		s_SceneData->CurrentBoundShader = 0;
+
+		// The view is the clip space square [-1, 1] taken back to world space
+		glm::mat4 inverseViewProjection = glm::inverse(s_SceneData->ViewProjectionMatrix);
+		s_SceneData->ViewBounds = AABB({ -1.0f, -1.0f }, { 1.0f, 1.0f }).Transform(inverseViewProjection);
 	}
 
 	void Renderer::EndScene()
 	{
+		// A draw outside a scene has no view to be culled against
+		s_SceneData->ViewBounds = AABB({ -FLT_MAX, -FLT_MAX }, { FLT_MAX, FLT_MAX });
 	}
 
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
@@ -28,6 +36,15 @@ namespace Fracture
 
 	void Renderer::Submit(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, const glm::mat4& transform = glm::mat4(1.0))
 	{
+		FR_MEMORY_TAG(Renderer);
+		const AABB& bounds = vertexArray->GetBounds();
+		if (bounds.IsValid() && !bounds.Transform(transform).Intersects(s_SceneData->ViewBounds))
+		{
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsCulled);
+			return;
+		}
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsDrawn);
+
 		if (shader->GetHandle() != s_SceneData->CurrentBoundShader)
 		{
 			shader->Bind();
@@ -39,4 +56,81 @@ namespace Fracture
 		RenderCommand::DrawIndexed(vertexArray->GetIndexBuffer()->GetCount());
 	}
 
+	void Renderer::Submit(const GeometryPool& pool, GeometryHandle mesh, const Ref<Shader>& shader, const glm::mat4& transform)
+	{
+		FR_MEMORY_TAG(Renderer);
+		const MeshRange& range = pool.GetRange(mesh);
+		if (range.Bounds.IsValid() && !range.Bounds.Transform(transform).Intersects(s_SceneData->ViewBounds))
+		{
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsCulled);
+			return;
+		}
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsDrawn);
+
+		if (shader->GetHandle() != s_SceneData->CurrentBoundShader)
+		{
+			shader->Bind();
+			s_SceneData->CurrentBoundShader = shader->GetHandle();
+		}
+		shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
+		shader->SetMat4("u_Transform", transform);
+		pool.GetVertexArray()->Bind();
+		RenderCommand::DrawIndexedRange(range.IndexCount, range.FirstIndex, range.BaseVertex);
+	}
+
+	void Renderer::SubmitRanges(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, const DrawIndexedIndirectCommand* ranges, uint32_t rangeCount, const glm::mat4& transform)
+	{
+		FR_MEMORY_TAG(Renderer);
+		if (rangeCount == 0)
+			return;
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsDrawn, rangeCount);
+
+		if (shader->GetHandle() != s_SceneData->CurrentBoundShader)
+		{
+			shader->Bind();
+			s_SceneData->CurrentBoundShader = shader->GetHandle();
+		}
+		shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
+		shader->SetMat4("u_Transform", transform);
+		vertexArray->Bind();
+		RenderCommand::MultiDrawIndexedIndirect(ranges, rangeCount);
+	}
+
+	void Renderer::SubmitIndirect(const GeometryPool& pool, IndirectDrawList& draws, const Ref<Shader>& shader)
+	{
+		FR_PROFILE_FUNCTION();
+		FR_MEMORY_TAG(Renderer);
+		if (draws.GetDrawCount() == 0)
+			return;
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsDrawn, draws.GetDrawCount());
+
+		if (shader->GetHandle() != s_SceneData->CurrentBoundShader)
+		{
+			shader->Bind();
+			s_SceneData->CurrentBoundShader = shader->GetHandle();
+		}
+		shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
+
+		draws.Upload();
+		draws.GetDrawDataBuffer()->Bind(IndirectDrawData::Binding);
+		pool.GetVertexArray()->Bind();
+		RenderCommand::MultiDrawIndexedIndirect(draws.GetCommands().data(), draws.GetDrawCount());
+	}
+
+	uint32_t Renderer::Cull(const BoundsList& bounds, std::vector<uint32_t>& visible)
+	{
+		FR_PROFILE_FUNCTION();
+		uint32_t visibleCount = bounds.Cull(s_SceneData->ViewBounds, visible);
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsCulled, bounds.GetCount() - visibleCount);
+		return visibleCount;
+	}
+
+	uint32_t Renderer::Cull(const SpatialGrid& grid, std::vector<uint32_t>& visible)
+	{
+		FR_PROFILE_FUNCTION();
+		uint32_t visibleCount = grid.QueryRect(s_SceneData->ViewBounds, visible);
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::ObjectsCulled, grid.GetCount() - visibleCount);
+		return visibleCount;
+	}
+
 }
\ No newline at end of file
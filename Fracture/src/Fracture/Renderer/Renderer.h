@@ -20,6 +20,9 @@
 #include "Fracture\Renderer\VertexArray.h"
 #include "Fracture\Renderer\Shader.h"
 #include "Fracture\Renderer\OrthographicCamera.h"
+#include "Fracture\Renderer\Culling.h"
+#include "Fracture\Renderer\SpatialGrid.h"
+#include "Fracture\Renderer\IndirectDrawList.h"
 
 #include <glm/glm.hpp>
 
@@ -40,6 +43,8 @@ namespace Fracture
 		/*!
 		* @brief Function that declares the beginning of a scene. It sets the view projection matrix for the scene from the provided camera.
 		* 
+		* @details The world space bounds of the camera view are computed here once so every submission of the scene can be culled against them.
+		* 
 		* @todo: Currently only supports orthographic camera. Add support for any camera.
 		* 
 		* @param[in] OrthographicCamera& camera: The camera that is used to set the view projection matrix.
@@ -63,10 +68,10 @@ namespace Fracture
 		/*!
 		* @brief Function that submits a vertex array, shader, and transform to the renderer API. Sets the shader uniforms and does a draw call.
 		* 
-		* @details The shader uniforms for the view projection matrix and the model matrix are set. The draw call is done using the current renderer API.
+		* @details If the vertex array has bounds they are transformed by the model matrix and the submission is dropped when they are outside the camera view.
+		* Otherwise the shader uniforms for the view projection matrix and the model matrix are set and the draw call is done using the current renderer API.
 		* 
 		* @todo: Add support for materails.
-		* @todo: Add support for batch rendering.
 		* @todo: Add support for instanced rendering.
 		* 
 		* @param[in] const Ref<VertexArray>& vertexArray: Pointer to the vertex array to submit.
@@ -75,6 +80,66 @@ namespace Fracture
 		*/
 		static void Submit(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, const glm::mat4& transform);
 
+		/*!
+		* @brief Function that submits one mesh of a geometry pool to be rendered. Culled like the vertex array overload, with the bounds of the mesh.
+		* 
+		* @param[in] const GeometryPool& pool: The pool the mesh was added to.
+		* @param[in] GeometryHandle mesh: The mesh to draw.
+		* @param[in] const Ref<Shader>& shader: Pointer to the shader to use.
+		* @param[in] const glm::mat4& transform: The transform of the mesh.
+		*/
+		static void Submit(const GeometryPool& pool, GeometryHandle mesh, const Ref<Shader>& shader, const glm::mat4& transform = glm::mat4(1.0f));
+
+		/*!
+		* @brief Function that draws some ranges of the index buffer of a vertex array with one multi draw. Used to draw the visible part of a StaticBatch.
+		* 
+		* @details The ranges are not culled; they are usually what a Cull of the objects they belong to found.
+		* 
+		* @param[in] const Ref<VertexArray>& vertexArray: The vertex array the ranges index.
+		* @param[in] const Ref<Shader>& shader: The shader to draw with.
+		* @param[in] const DrawIndexedIndirectCommand* ranges: The ranges to draw.
+		* @param[in] uint32_t rangeCount: The number of ranges.
+		* @param[in] const glm::mat4& transform: The model matrix of every range.
+		*/
+		static void SubmitRanges(const Ref<VertexArray>& vertexArray, const Ref<Shader>& shader, const DrawIndexedIndirectCommand* ranges, uint32_t rangeCount, const glm::mat4& transform = glm::mat4(1.0f));
+
+		/*!
+		* @brief Function that draws every draw of a list with one multi draw indirect call.
+		* 
+		* @details The per draw data of the list is uploaded and bound to IndirectDrawData::Binding, u_ViewProjection is set and the shared vertex array of
+		* the pool is drawn with RenderCommand::MultiDrawIndexedIndirect. The draws are not culled; cull them before adding them to the list.
+		* 
+		* @param[in] const GeometryPool& pool: The pool the meshes of the draws were added to.
+		* @param[in] IndirectDrawList& draws: The draws.
+		* @param[in] const Ref<Shader>& shader: The shader to draw with. It has to read its model matrix from the draw data with gl_DrawID.
+		*/
+		static void SubmitIndirect(const GeometryPool& pool, IndirectDrawList& draws, const Ref<Shader>& shader);
+
+		/*!
+		* @brief Function that culls a list of world space bounds against the camera view of the current scene with SIMD. Use it as a pre-pass over large object lists.
+		* 
+		* @param[in] const BoundsList& bounds: The world space bounds of the objects.
+		* @param[out] std::vector<uint32_t>& visible: The indices of the bounds that are in view.
+		* 
+		* @return uint32_t: The number of bounds in view.
+		*/
+		static uint32_t Cull(const BoundsList& bounds, std::vector<uint32_t>& visible);
+
+		/*!
+		* @brief Function that finds the objects of a spatial index in the camera view of the current scene. Only the cells around the view are visited.
+		* 
+		* @param[in] const SpatialGrid& grid: The spatial index of the objects.
+		* @param[out] std::vector<uint32_t>& visible: The user data of the objects that are in view.
+		* 
+		* @return uint32_t: The number of objects in view.
+		*/
+		static uint32_t Cull(const SpatialGrid& grid, std::vector<uint32_t>& visible);
+
+		/*!
+		* @brief Function that returns the world space bounds of the camera view of the current scene. Unbounded outside BeginScene and EndScene.
+		*/
+		inline static const AABB& GetViewBounds() { return s_SceneData->ViewBounds; }
+
 		/*!
 		* @brief Function that returns the current renderer API.
 		* 
@@ -90,6 +155,7 @@ namespace Fracture
 		struct SceneData
 		{
 			glm::mat4 ViewProjectionMatrix; /// The view projection matrix of the camera that is used to render the scene.
+			AABB ViewBounds = { { -FLT_MAX, -FLT_MAX }, { FLT_MAX, FLT_MAX } }; /// The world space bounds of what the camera sees. Unbounded outside a scene, so nothing is culled.
 			uint32_t CurrentBoundShader = 0; /// The current shader that is bound to the renderer API.
 		};
 
@@ -4,4 +4,11 @@
 
 namespace Fracture {
 
-}
\ No newline at end of file
+	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
+
+	void RendererAPI::SetAPI(API api)
+	{
+		s_API = api;
+	}
+
+}
@@ -15,6 +15,33 @@
 
 namespace Fracture {
 
+	/*!
+	* @brief The arguments of one draw of a multi draw. Laid out like the DrawElementsIndirectCommand of OpenGL so an array of them can be uploaded as is.
+	*/
+	struct DrawIndexedIndirectCommand
+	{
+		uint32_t Count = 0; /// The number of indices to draw.
+		uint32_t InstanceCount = 1; /// The number of instances to draw.
+		uint32_t FirstIndex = 0; /// The first index to draw, in indices from the start of the index buffer.
+		int32_t BaseVertex = 0; /// The value added to every index before fetching the vertex.
+		uint32_t BaseInstance = 0; /// The first instance.
+	};
+
+	/*!
+	* @brief The data of one draw of a multi draw, read by the shader from the storage buffer at Binding with gl_DrawID as the index. Matches the std430 layout
+	* 
+	* struct DrawData { mat4 Transform; uint MaterialIndex; };
+	* layout(std430, binding = 0) readonly buffer DrawDataBuffer { DrawData u_Draws[]; };
+	*/
+	struct IndirectDrawData
+	{
+		static constexpr uint32_t Binding = 0; /// The storage buffer binding the draw data is bound to.
+
+		glm::mat4 Transform = glm::mat4(1.0f); /// The model matrix of the draw.
+		uint32_t MaterialIndex = 0; /// The index of the material of the draw, in whatever material buffer the shader uses.
+		uint32_t Padding[3] = { 0, 0, 0 }; /// Pads the struct to the 16 byte alignment of std430.
+	};
+
 	/*!
 	* @brief The RendererAPI class provides an interface for the RendererAPI that needs to be implemented by each renderer.
 	* 
@@ -29,7 +56,7 @@ namespace Fracture {
 		*/
 		enum class API
 		{
-			None = 0, OpenGL = 1
+			None = 0, OpenGL = 1, Software = 2
 		};
 	public:
 		/*!
@@ -67,6 +94,36 @@ namespace Fracture {
 		*/
 		virtual void DrawIndexed(uint32_t indexCount = 0) = 0;
 
+		/*!
+		* @brief Indexed draw call of a range of the index buffer. Must be implemented by each renderer.
+		* 
+		* @details Must draw indexCount indices starting at firstIndex from the currently bound vertex array, adding baseVertex to every index.
+		* 
+		* @param[in] uint32_t indexCount: The number of indices to draw.
+		* @param[in] uint32_t firstIndex: The first index to draw, in indices from the start of the index buffer.
+		* @param[in] int32_t baseVertex: The value added to every index before fetching the vertex.
+		*/
+		virtual void DrawIndexedRange(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) = 0;
+
+		/*!
+		* @brief Draws one range of the currently bound vertex array, described by an indirect command. Must be implemented by each renderer.
+		* 
+		* @details The draw has gl_DrawID 0, so a shader that reads IndirectDrawData reads the first entry.
+		* 
+		* @param[in] const DrawIndexedIndirectCommand& command: The draw.
+		*/
+		virtual void DrawIndexedIndirect(const DrawIndexedIndirectCommand& command) = 0;
+
+		/*!
+		* @brief Draws many ranges of the currently bound vertex array with one call. Must be implemented by each renderer.
+		* 
+		* @details Every command draws a range of the index buffer. The shader tells the draws apart with gl_DrawID, usually to read their IndirectDrawData.
+		* 
+		* @param[in] const DrawIndexedIndirectCommand* commands: The draws.
+		* @param[in] uint32_t drawCount: The number of draws.
+		*/
+		virtual void MultiDrawIndexedIndirect(const DrawIndexedIndirectCommand* commands, uint32_t drawCount) = 0;
+
 		/*!
 		* @brief Function that returns the current state of initialization of the renderer API. Must be implemented by each renderer.
 		*/
@@ -75,15 +132,20 @@ namespace Fracture {
 		/*!
 		* @brief Function that returns the current API that is being used by the renderer.
 		* 
-		* @todo: Provide a way for the api to be set by the user and not be hardcoded.
-		* 
 		* @returns API: The current API that is being used by the renderer.
 		*/
-		inline static API GetAPI() 
-		{
-			static API s_API = API::OpenGL;
-			return s_API;
-		}
+		inline static API GetAPI() { return s_API; }
+
+		/*!
+		* @brief Function that sets the API to be used by the renderer.
+		* 
+		* @details Must be called before the Application is created. The window, the graphics context and every renderer resource are created for the API that is set at the time of their creation.
+		* 
+		* @param[in] API api: The API to use.
+		*/
+		static void SetAPI(API api);
+	private:
+		static API s_API; /// The API currently used by the renderer. Defaults to OpenGL.
 	};
 
 }
@@ -4,15 +4,18 @@
 #include "Renderer.h"
 
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Software/SoftwareShader.h"
 
 namespace Fracture
 {
 	Ref<Shader> Shader::Create(const std::string& name, const std::string& vertex_source, const std::string fragment_source)
 	{
+		FR_MEMORY_TAG(Assets);
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:    FR_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertex_source, fragment_source);
+		case RendererAPI::API::Software:  return CreateRef<SoftwareShader>(name, vertex_source, fragment_source);
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -21,6 +24,7 @@ namespace Fracture
 
 	Ref<Shader> Shader::Create(const std::string& shaderFilePath)
 	{
+		FR_MEMORY_TAG(Assets);
 		std::filesystem::path path = shaderFilePath;
 		std::string name = path.stem().string();
 
@@ -29,10 +33,12 @@ namespace Fracture
 
 	Ref<Shader> Shader::Create(const std::string& name, const std::string& shaderFilePath)
 	{
+		FR_MEMORY_TAG(Assets);
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:    FR_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, shaderFilePath);
+		case RendererAPI::API::Software:  return CreateRef<SoftwareShader>(name, shaderFilePath);
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
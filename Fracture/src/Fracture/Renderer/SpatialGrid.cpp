@@ -0,0 +1,284 @@
+#include "frpch.h"
+#include "SpatialGrid.h"
+
+#include <numeric>
+
+namespace Fracture {
+
+	SpatialGrid::SpatialGrid(float cellSize)
+		: m_CellSize(cellSize), m_InverseCellSize(1.0f / cellSize)
+	{
+		FR_CORE_ASSERT(cellSize > 0.0f, "The cell size of a spatial grid must be positive");
+	}
+
+	uint32_t SpatialGrid::Insert(const AABB& bounds, uint32_t userData)
+	{
+		FR_CORE_ASSERT(bounds.IsValid(), "Cannot insert empty bounds into a spatial grid");
+		uint32_t proxy;
+		if (!m_FreeProxies.empty())
+		{
+			proxy = m_FreeProxies.back();
+			m_FreeProxies.pop_back();
+		}
+		else
+		{
+			proxy = (uint32_t)m_Proxies.size();
+			m_Proxies.emplace_back();
+			m_QueryStamps.push_back(0);
+		}
+
+		Proxy& entry = m_Proxies[proxy];
+		entry.Bounds = bounds;
+		entry.UserData = userData;
+		entry.Alive = true;
+		Link(proxy);
+		m_Count++;
+		return proxy;
+	}
+
+	void SpatialGrid::Remove(uint32_t proxy)
+	{
+		FR_CORE_ASSERT(proxy < m_Proxies.size() && m_Proxies[proxy].Alive, "Invalid spatial grid proxy");
+		Unlink(proxy);
+		m_Proxies[proxy].Alive = false;
+		m_FreeProxies.push_back(proxy);
+		m_Count--;
+	}
+
+	void SpatialGrid::Move(uint32_t proxy, const AABB& bounds)
+	{
+		FR_CORE_ASSERT(proxy < m_Proxies.size() && m_Proxies[proxy].Alive, "Invalid spatial grid proxy");
+		FR_CORE_ASSERT(bounds.IsValid(), "Cannot move a spatial grid proxy to empty bounds");
+		Proxy& entry = m_Proxies[proxy];
+		entry.Bounds = bounds;
+
+		// Most moves stay inside the same cells, in which case the new bounds are all that changes
+		if (!entry.Large && ToCell(bounds.Min.x) == entry.MinX && ToCell(bounds.Min.y) == entry.MinY &&
+			ToCell(bounds.Max.x) == entry.MaxX && ToCell(bounds.Max.y) == entry.MaxY)
+			return;
+
+		Unlink(proxy);
+		Link(proxy);
+	}
+
+	void SpatialGrid::MoveBatch(const uint32_t* proxies, const AABB* bounds, uint32_t count)
+	{
+		FR_PROFILE_FUNCTION();
+		if (count < m_Count / 4)
+		{
+			for (uint32_t i = 0; i < count; i++)
+				Move(proxies[i], bounds[i]);
+			return;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			FR_CORE_ASSERT(proxies[i] < m_Proxies.size() && m_Proxies[proxies[i]].Alive, "Invalid spatial grid proxy");
+			m_Proxies[proxies[i]].Bounds = bounds[i];
+		}
+
+		for (std::vector<uint32_t>& cell : m_Cells)
+			cell.clear();
+		m_CellLookup.clear();
+		m_LargeProxies.clear();
+		// Every slot is free, with the lowest ones reused first so the populated cells end up at the front
+		m_FreeCells.resize(m_Cells.size());
+		std::iota(m_FreeCells.rbegin(), m_FreeCells.rend(), 0);
+
+		for (uint32_t proxy = 0; proxy < (uint32_t)m_Proxies.size(); proxy++)
+		{
+			if (m_Proxies[proxy].Alive)
+				Link(proxy);
+		}
+
+		// The slots left over are the ones past the last populated cell
+		m_Cells.resize(m_Cells.size() - m_FreeCells.size());
+		m_FreeCells.clear();
+	}
+
+	void SpatialGrid::Clear()
+	{
+		m_Cells.clear();
+		m_CellLookup.clear();
+		m_FreeCells.clear();
+		m_LargeProxies.clear();
+		m_Proxies.clear();
+		m_FreeProxies.clear();
+		m_QueryStamps.clear();
+		m_Count = 0;
+	}
+
+	uint32_t SpatialGrid::QueryRect(const AABB& area, std::vector<uint32_t>& results) const
+	{
+		FR_PROFILE_FUNCTION();
+		results.clear();
+		if (!area.IsValid())
+			return 0;
+
+		Visit(ToCell(area.Min.x), ToCell(area.Min.y), ToCell(area.Max.x), ToCell(area.Max.y),
+			[&area](const AABB& bounds) { return bounds.Intersects(area); }, results);
+		return (uint32_t)results.size();
+	}
+
+	uint32_t SpatialGrid::QueryPoint(const glm::vec2& point, std::vector<uint32_t>& results) const
+	{
+		results.clear();
+		int32_t x = ToCell(point.x);
+		int32_t y = ToCell(point.y);
+		Visit(x, y, x, y, [&point](const AABB& bounds) { return bounds.Contains(point); }, results);
+		return (uint32_t)results.size();
+	}
+
+	uint32_t SpatialGrid::QueryRadius(const glm::vec2& center, float radius, std::vector<uint32_t>& results) const
+	{
+		FR_PROFILE_FUNCTION();
+		results.clear();
+		float radiusSquared = radius * radius;
+		Visit(ToCell(center.x - radius), ToCell(center.y - radius), ToCell(center.x + radius), ToCell(center.y + radius),
+			[&center, radiusSquared](const AABB& bounds)
+		{
+			glm::vec2 offset = glm::clamp(center, bounds.Min, bounds.Max) - center;
+			return offset.x * offset.x + offset.y * offset.y <= radiusSquared;
+		}, results);
+		return (uint32_t)results.size();
+	}
+
+	void SpatialGrid::Link(uint32_t proxy)
+	{
+		FR_MEMORY_TAG(Renderer);
+		Proxy& entry = m_Proxies[proxy];
+		int32_t minX = ToCell(entry.Bounds.Min.x);
+		int32_t minY = ToCell(entry.Bounds.Min.y);
+		int32_t maxX = ToCell(entry.Bounds.Max.x);
+		int32_t maxY = ToCell(entry.Bounds.Max.y);
+
+		uint64_t cellCount = (uint64_t)((int64_t)maxX - minX + 1) * (uint64_t)((int64_t)maxY - minY + 1);
+		if (cellCount > MaxCellsPerProxy)
+		{
+			entry.Large = true;
+			entry.MinX = entry.MinY = 0;
+			entry.MaxX = entry.MaxY = -1;
+			m_LargeProxies.push_back(proxy);
+			return;
+		}
+
+		entry.Large = false;
+		entry.MinX = minX;
+		entry.MinY = minY;
+		entry.MaxX = maxX;
+		entry.MaxY = maxY;
+		for (int32_t y = minY; y <= maxY; y++)
+		{
+			for (int32_t x = minX; x <= maxX; x++)
+			{
+				auto [it, inserted] = m_CellLookup.try_emplace(GetKey(x, y), 0);
+				if (inserted)
+				{
+					if (!m_FreeCells.empty())
+					{
+						it->second = m_FreeCells.back();
+						m_FreeCells.pop_back();
+					}
+					else
+					{
+						it->second = (uint32_t)m_Cells.size();
+						m_Cells.emplace_back();
+					}
+				}
+				m_Cells[it->second].push_back(proxy);
+			}
+		}
+	}
+
+	void SpatialGrid::Unlink(uint32_t proxy)
+	{
+		Proxy& entry = m_Proxies[proxy];
+		if (entry.Large)
+		{
+			auto it = std::find(m_LargeProxies.begin(), m_LargeProxies.end(), proxy);
+			FR_CORE_ASSERT(it != m_LargeProxies.end(), "Large spatial grid proxy is missing from its list");
+			*it = m_LargeProxies.back();
+			m_LargeProxies.pop_back();
+			entry.Large = false;
+			return;
+		}
+
+		for (int32_t y = entry.MinY; y <= entry.MaxY; y++)
+		{
+			for (int32_t x = entry.MinX; x <= entry.MaxX; x++)
+			{
+				// Cells hold a handful of proxies, so a linear search and a swap with the last one is cheapest
+				auto lookup = m_CellLookup.find(GetKey(x, y));
+				FR_CORE_ASSERT(lookup != m_CellLookup.end(), "Spatial grid proxy is missing from one of its cells");
+				std::vector<uint32_t>& cell = m_Cells[lookup->second];
+				auto it = std::find(cell.begin(), cell.end(), proxy);
+				FR_CORE_ASSERT(it != cell.end(), "Spatial grid proxy is missing from one of its cells");
+				*it = cell.back();
+				cell.pop_back();
+				if (cell.empty())
+				{
+					// The slot keeps the memory of the cell for the next one that is populated
+					m_FreeCells.push_back(lookup->second);
+					m_CellLookup.erase(lookup);
+				}
+			}
+		}
+		entry.MinX = entry.MinY = 0;
+		entry.MaxX = entry.MaxY = -1;
+	}
+
+	uint32_t SpatialGrid::NextStamp() const
+	{
+		if (++m_QueryStamp == 0)
+		{
+			// The stamp wrapped around, so old stamps could be mistaken for the current query
+			std::fill(m_QueryStamps.begin(), m_QueryStamps.end(), 0);
+			m_QueryStamp = 1;
+		}
+		return m_QueryStamp;
+	}
+
+	template<typename Test>
+	void SpatialGrid::Visit(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY, const Test& test, std::vector<uint32_t>& results) const
+	{
+		uint32_t stamp = NextStamp();
+		auto visitProxy = [this, stamp, &test, &results](uint32_t proxy)
+		{
+			if (m_QueryStamps[proxy] == stamp)
+				return;
+			m_QueryStamps[proxy] = stamp;
+			if (test(m_Proxies[proxy].Bounds))
+				results.push_back(m_Proxies[proxy].UserData);
+		};
+
+		uint64_t rangeCount = (uint64_t)((int64_t)maxX - minX + 1) * (uint64_t)((int64_t)maxY - minY + 1);
+		if (rangeCount > m_CellLookup.size())
+		{
+			// The range is larger than the populated part of the grid (a zoomed out camera), so walking the populated cells is cheaper than hashing every coordinate.
+			// Released slots are empty and cost nothing here
+			for (const std::vector<uint32_t>& cell : m_Cells)
+			{
+				for (uint32_t proxy : cell)
+					visitProxy(proxy);
+			}
+		}
+		else
+		{
+			for (int32_t y = minY; y <= maxY; y++)
+			{
+				for (int32_t x = minX; x <= maxX; x++)
+				{
+					auto it = m_CellLookup.find(GetKey(x, y));
+					if (it == m_CellLookup.end())
+						continue;
+					for (uint32_t proxy : m_Cells[it->second])
+						visitProxy(proxy);
+				}
+			}
+		}
+
+		for (uint32_t proxy : m_LargeProxies)
+			visitProxy(proxy);
+	}
+
+}
@@ -0,0 +1,169 @@
+#pragma once
+/*!
+* @file SpatialGrid.h
+* @brief Contains the SpatialGrid class, a dynamic spatial index for the bounds of 2D scenes.
+*
+* @details Usage:
+*
+* Fracture::SpatialGrid grid(0.5f);
+* uint32_t proxy = grid.Insert(bounds, objectIndex); // objectIndex is returned by the queries
+*
+* grid.Move(proxy, newBounds); // only touches the cells the bounds enter and leave
+*
+* std::vector<uint32_t> visible;
+* Fracture::Renderer::Cull(grid, visible); // the object indices in the camera view
+* grid.QueryPoint(camera.ScreenToWorld(mousePosition, viewportSize), picked);
+*
+* @see AABB, Renderer::Cull, OrthographicCamera::ScreenToWorld
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Renderer\Bounds.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief A hashed uniform grid over the XY plane. Every object is stored in each cell its bounds overlap, and only the cells that hold objects are allocated.
+	*
+	* @details Queries visit the cells overlapping the query shape and test the bounds of the objects in them, so their cost depends on the number of
+	* objects nearby instead of the total number of objects. Objects that cover more than MaxCellsPerProxy cells are kept in a separate list that every
+	* query tests, so a few huge objects do not flood the grid.
+	*
+	* Moving an object only updates the cells it leaves and enters; if it stays within the same cells only its bounds are stored. MoveBatch rebuilds
+	* every cell in one pass instead when a large part of the objects moved, which is cheaper than removing and inserting each one. A cell that empties is
+	* released and its slot reused by the next cell that is populated, so objects roaming over the plane do not leave a trail of empty cells behind.
+	*
+	* The queries are not thread safe, even between each other, because they share the stamps used to report every object once.
+	*/
+	class SpatialGrid
+	{
+	public:
+		static constexpr uint32_t InvalidProxy = 0xFFFFFFFF; /// The id of a null proxy.
+		static constexpr uint32_t MaxCellsPerProxy = 64; /// Objects overlapping more cells than this are stored in the large object list.
+
+		/*!
+		* @brief Constructs an empty grid.
+		*
+		* @param[in] float cellSize: The width and height of a cell in world units. Works best at around the size of the typical object.
+		*/
+		explicit SpatialGrid(float cellSize = 1.0f);
+
+		/*!
+		* @brief Adds an object to the grid.
+		*
+		* @param[in] const AABB& bounds: The world space bounds of the object.
+		* @param[in] uint32_t userData: The value the queries report for the object, usually its index in the array of the caller.
+		*
+		* @return uint32_t: The proxy that identifies the object in the grid.
+		*/
+		uint32_t Insert(const AABB& bounds, uint32_t userData);
+
+		/*!
+		* @brief Removes an object from the grid. The proxy must not be used afterwards.
+		*/
+		void Remove(uint32_t proxy);
+
+		/*!
+		* @brief Updates the bounds of an object, moving it between cells if needed.
+		*/
+		void Move(uint32_t proxy, const AABB& bounds);
+
+		/*!
+		* @brief Updates the bounds of many objects at once, typically after a TransformSystem update.
+		*
+		* @details When at least a quarter of the objects move the cells are cleared and refilled in one pass, otherwise every object is moved on its own.
+		*
+		* @param[in] const uint32_t* proxies: The proxies of the objects that moved.
+		* @param[in] const AABB* bounds: The new bounds, in the same order.
+		* @param[in] uint32_t count: The number of objects that moved.
+		*/
+		void MoveBatch(const uint32_t* proxies, const AABB* bounds, uint32_t count);
+
+		/*!
+		* @brief Removes every object and releases every cell.
+		*/
+		void Clear();
+
+		inline const AABB& GetBounds(uint32_t proxy) const { return m_Proxies[proxy].Bounds; }
+		inline uint32_t GetUserData(uint32_t proxy) const { return m_Proxies[proxy].UserData; }
+		inline uint32_t GetCount() const { return m_Count; }
+		inline uint32_t GetCellCount() const { return (uint32_t)m_CellLookup.size(); }
+		inline float GetCellSize() const { return m_CellSize; }
+
+		/*!
+		* @brief Finds the objects whose bounds intersect a box.
+		*
+		* @param[in] const AABB& area: The box to search.
+		* @param[out] std::vector<uint32_t>& results: The user data of the objects found, each reported once in no particular order. Cleared first.
+		*
+		* @return uint32_t: The number of objects found.
+		*/
+		uint32_t QueryRect(const AABB& area, std::vector<uint32_t>& results) const;
+
+		/*!
+		* @brief Finds the objects whose bounds contain a point. Used for picking.
+		*/
+		uint32_t QueryPoint(const glm::vec2& point, std::vector<uint32_t>& results) const;
+
+		/*!
+		* @brief Finds the objects whose bounds are within a distance of a point.
+		*/
+		uint32_t QueryRadius(const glm::vec2& center, float radius, std::vector<uint32_t>& results) const;
+	private:
+		/// An object in the grid.
+		struct Proxy
+		{
+			AABB Bounds; /// The world space bounds of the object.
+			uint32_t UserData = 0; /// The value reported by the queries.
+			int32_t MinX = 0, MinY = 0, MaxX = -1, MaxY = -1; /// The range of cells the object is stored in. Empty for large and removed objects.
+			bool Large = false; /// Whether the object is in the large object list instead of the cells.
+			bool Alive = false; /// Whether the proxy is in use.
+		};
+
+		/// Clamped so the coordinates of huge bounds (like an unbounded view) still fit in an int32_t.
+		inline int32_t ToCell(float coordinate) const { return (int32_t)std::floor(glm::clamp(coordinate * m_InverseCellSize, -1.0e9f, 1.0e9f)); }
+		inline static uint64_t GetKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+
+		/*!
+		* @brief Stores a proxy in the cells its bounds overlap, or in the large object list.
+		*/
+		void Link(uint32_t proxy);
+
+		/*!
+		* @brief Removes a proxy from its cells, or from the large object list.
+		*/
+		void Unlink(uint32_t proxy);
+
+		/*!
+		* @brief Starts a query and returns the stamp that marks the objects it already reported.
+		*/
+		uint32_t NextStamp() const;
+
+		/*!
+		* @brief Calls test on every object of the cells in a range and of the large object list, once per object.
+		*/
+		template<typename Test>
+		void Visit(int32_t minX, int32_t minY, int32_t maxX, int32_t maxY, const Test& test, std::vector<uint32_t>& results) const;
+	private:
+		float m_CellSize; /// The width and height of a cell.
+		float m_InverseCellSize; /// 1 / m_CellSize.
+
+		std::vector<Proxy> m_Proxies; /// The objects, indexed by proxy.
+		std::vector<uint32_t> m_FreeProxies; /// The proxies of removed objects.
+		uint32_t m_Count = 0; /// The number of objects.
+
+		std::unordered_map<uint64_t, uint32_t> m_CellLookup; /// Maps the packed coordinates of a cell to its index in m_Cells.
+		std::vector<std::vector<uint32_t>> m_Cells; /// The proxies in every populated cell. Released slots are empty.
+		std::vector<uint32_t> m_FreeCells; /// The slots of m_Cells released when their cell emptied.
+		std::vector<uint32_t> m_LargeProxies; /// The proxies of the objects that overlap too many cells.
+
+		mutable std::vector<uint32_t> m_QueryStamps; /// The stamp of the last query that reported each proxy.
+		mutable uint32_t m_QueryStamp = 0; /// The stamp of the current query.
+	};
+
+}
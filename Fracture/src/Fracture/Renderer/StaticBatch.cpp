@@ -0,0 +1,147 @@
+#include "frpch.h"
+#include "StaticBatch.h"
+
+#include "Fracture\Renderer\Renderer.h"
+
+namespace Fracture {
+
+	StaticBatch::StaticBatch(const BufferLayout& layout)
+		: m_Layout(layout), m_Stride(layout.GetStride() / sizeof(float)), m_PositionOffset(0)
+	{
+		auto position = std::find_if(layout.begin(), layout.end(), [](const BufferElement& element) { return element.Name == "a_Position"; });
+		FR_CORE_ASSERT(position != layout.end() && position->Type == ShaderDataType::Float3, "A static batch needs a Float3 a_Position element in its layout");
+		m_PositionOffset = position->Offset / sizeof(float);
+	}
+
+	uint32_t StaticBatch::Add(const float* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const glm::mat4& transform)
+	{
+		FR_MEMORY_TAG(Renderer);
+		Member member = { m_VertexCount, vertexCount, (uint32_t)m_Indices.size(), indexCount, transform, AABB() };
+		m_LocalVertices.insert(m_LocalVertices.end(), vertices, vertices + vertexCount * m_Stride);
+		m_Vertices.resize(m_LocalVertices.size());
+		for (uint32_t i = 0; i < indexCount; i++)
+			m_Indices.push_back(member.FirstVertex + indices[i]);
+
+		m_VertexCount += vertexCount;
+		m_Members.push_back(member);
+		Bake(m_Members.back());
+		m_Invalid = true;
+		return (uint32_t)m_Members.size() - 1;
+	}
+
+	void StaticBatch::SetTransform(uint32_t member, const glm::mat4& transform)
+	{
+		FR_CORE_ASSERT(member < m_Members.size(), "Invalid static batch member");
+		Member& entry = m_Members[member];
+		entry.Transform = transform;
+		Bake(entry);
+
+		m_DirtyFirstVertex = std::min(m_DirtyFirstVertex, entry.FirstVertex);
+		m_DirtyEndVertex = std::max(m_DirtyEndVertex, entry.FirstVertex + entry.VertexCount);
+		m_DirtyBounds.Merge(entry.Bounds);
+	}
+
+	void StaticBatch::Clear()
+	{
+		m_Members.clear();
+		m_LocalVertices.clear();
+		m_Vertices.clear();
+		m_Indices.clear();
+		m_VertexCount = 0;
+		m_Bounds = AABB();
+		m_DirtyFirstVertex = 0xFFFFFFFF;
+		m_DirtyEndVertex = 0;
+		m_DirtyBounds = AABB();
+		m_Invalid = true;
+	}
+
+	void StaticBatch::Draw(const Ref<Shader>& shader)
+	{
+		FR_PROFILE_FUNCTION();
+		if (m_Members.empty())
+			return;
+
+		Upload();
+		Renderer::Submit(m_VertexArray, shader, glm::mat4(1.0f));
+	}
+
+	void StaticBatch::Draw(const Ref<Shader>& shader, const std::vector<uint32_t>& members)
+	{
+		FR_PROFILE_FUNCTION();
+		FR_MEMORY_TAG(Renderer);
+		if (members.empty())
+			return;
+
+		Upload();
+		m_Ranges.clear();
+		for (uint32_t id : members)
+		{
+			FR_CORE_ASSERT(id < m_Members.size(), "Invalid static batch member");
+			const Member& member = m_Members[id];
+			m_Ranges.push_back({ member.IndexCount, 1, member.FirstIndex, 0, 0 }); // The indices are already offset to the first vertex of the member
+		}
+		Renderer::SubmitRanges(m_VertexArray, shader, m_Ranges.data(), (uint32_t)m_Ranges.size());
+	}
+
+	void StaticBatch::Upload()
+	{
+		if (m_Invalid)
+		{
+			Build();
+		}
+		else if (m_DirtyFirstVertex < m_DirtyEndVertex)
+		{
+			// One upload of the range spanning every moved member. Members that move together are usually added together, so the range stays tight
+			uint32_t first = m_DirtyFirstVertex * m_Stride;
+			uint32_t count = (m_DirtyEndVertex - m_DirtyFirstVertex) * m_Stride;
+			m_VertexBuffer->SetSubData(&m_Vertices[first], count * sizeof(float), first * sizeof(float));
+			m_Bounds.Merge(m_DirtyBounds);
+			m_VertexArray->SetBounds(m_Bounds);
+		}
+		m_DirtyFirstVertex = 0xFFFFFFFF;
+		m_DirtyEndVertex = 0;
+		m_DirtyBounds = AABB();
+	}
+
+	void StaticBatch::Bake(Member& member)
+	{
+		const glm::mat4& transform = member.Transform;
+		uint32_t first = member.FirstVertex * m_Stride;
+		uint32_t end = first + member.VertexCount * m_Stride;
+		// Copy the attributes that are not transformed, then overwrite the positions
+		std::copy(m_LocalVertices.begin() + first, m_LocalVertices.begin() + end, m_Vertices.begin() + first);
+		member.Bounds = AABB();
+		for (uint32_t vertex = first; vertex < end; vertex += m_Stride)
+		{
+			const float* local = &m_LocalVertices[vertex + m_PositionOffset];
+			float* world = &m_Vertices[vertex + m_PositionOffset];
+			glm::vec4 position = transform * glm::vec4(local[0], local[1], local[2], 1.0f);
+			world[0] = position.x;
+			world[1] = position.y;
+			world[2] = position.z;
+			member.Bounds.Merge(AABB({ position.x, position.y }, { position.x, position.y }));
+		}
+	}
+
+	void StaticBatch::Build()
+	{
+		FR_PROFILE_FUNCTION();
+		FR_MEMORY_TAG(Renderer);
+		m_VertexArray = VertexArray::Create();
+		m_VertexBuffer = VertexBuffer::Create(m_Vertices.data(), (uint32_t)(m_Vertices.size() * sizeof(float)));
+		m_VertexBuffer->SetLayout(m_Layout);
+		m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+		m_VertexArray->SetIndexBuffer(IndexBuffer::Create(m_Indices.data(), (uint32_t)m_Indices.size()));
+		UpdateBounds();
+		m_Invalid = false;
+	}
+
+	void StaticBatch::UpdateBounds()
+	{
+		m_Bounds = AABB();
+		for (const Member& member : m_Members)
+			m_Bounds.Merge(member.Bounds);
+		m_VertexArray->SetBounds(m_Bounds);
+	}
+
+}
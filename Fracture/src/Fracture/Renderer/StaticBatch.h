@@ -0,0 +1,166 @@
+#pragma once
+/*!
+* @file StaticBatch.h
+* @brief Contains the StaticBatch class that bakes many submissions of rarely moving geometry into one vertex array drawn with a single call.
+*
+* @details Usage:
+*
+* Fracture::StaticBatch batch(layout); // the layout must have a Float3 "a_Position" element
+* for (const Tile& tile : tiles)
+*     tile.Member = batch.Add(squareVertices, 4, squareIndices, 6, tile.Transform);
+*
+* batch.Draw(shader); // the first draw uploads everything, later draws reuse the buffers
+*
+* batch.SetTransform(tiles[3].Member, newTransform); // only the vertices of that member are uploaded again on the next draw
+*
+* Fracture::Renderer::Cull(tileIndex, visibleTiles); // tileIndex is a SpatialGrid of the tiles
+* batch.Draw(shader, visibleMembers); // only the members of the visible tiles, still one draw call
+*
+* @see Renderer::Submit, Renderer::SubmitRanges, SpatialGrid
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Core\Core.h"
+#include "Fracture\Renderer\Buffer.h"
+#include "Fracture\Renderer\RendererAPI.h"
+#include "Fracture\Renderer\Shader.h"
+#include "Fracture\Renderer\VertexArray.h"
+
+#include <glm\glm.hpp>
+
+#include <vector>
+
+namespace Fracture {
+
+	/*!
+	* @brief A retained render list. Geometry added to it is transformed to world space on the CPU once and stored in a single vertex and index buffer.
+	*
+	* @details Every member keeps its local vertices so it can be moved later. SetTransform re-transforms the vertices of that member and marks
+	* their range dirty; the next Draw uploads the range spanning all dirty members with VertexBuffer::SetSubData instead of the whole buffer. Adding
+	* members or clearing the batch invalidates it and the next Draw rebuilds the buffers. Members can not be removed one at a time.
+	*
+	* All members are drawn with the same shader, which sees the baked vertices with an identity model matrix. The bounds of the vertex array contain
+	* every member so the whole batch is culled by the Renderer when it is out of view. Moved members are merged into them, so they only grow until
+	* the next rebuild makes them tight again.
+	*/
+	class StaticBatch
+	{
+	public:
+		/*!
+		* @brief Constructs an empty batch.
+		*
+		* @param[in] const BufferLayout& layout: The layout of the vertices of every member. It must contain a Float3 element named "a_Position".
+		*/
+		StaticBatch(const BufferLayout& layout);
+
+		/*!
+		* @brief Adds geometry to the batch.
+		*
+		* @param[in] const float* vertices: The vertices in model space, laid out as described by the layout of the batch.
+		* @param[in] uint32_t vertexCount: The number of vertices.
+		* @param[in] const uint32_t* indices: The indices of the geometry, relative to its first vertex.
+		* @param[in] uint32_t indexCount: The number of indices.
+		* @param[in] const glm::mat4& transform: The model matrix the vertices are baked with.
+		*
+		* @return uint32_t: The id of the member, used to move it.
+		*/
+		uint32_t Add(const float* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const glm::mat4& transform);
+
+		/*!
+		* @brief Moves a member. Only its vertices are re-transformed and uploaded on the next Draw.
+		*/
+		void SetTransform(uint32_t member, const glm::mat4& transform);
+
+		inline const glm::mat4& GetTransform(uint32_t member) const { return m_Members[member].Transform; }
+
+		/*!
+		* @brief Removes every member.
+		*/
+		void Clear();
+
+		/*!
+		* @brief Forces the next Draw to rebuild the buffers from scratch.
+		*/
+		inline void Invalidate() { m_Invalid = true; }
+
+		/*!
+		* @brief Uploads pending changes and draws every member with one draw call through Renderer::Submit.
+		*
+		* @param[in] const Ref<Shader>& shader: The shader to draw the batch with.
+		*/
+		void Draw(const Ref<Shader>& shader);
+
+		/*!
+		* @brief Uploads pending changes and draws some of the members with one multi draw through Renderer::SubmitRanges.
+		*
+		* @details Used with a spatial index of the members, so only the members in view are drawn.
+		*
+		* @param[in] const Ref<Shader>& shader: The shader to draw the batch with.
+		* @param[in] const std::vector<uint32_t>& members: The ids of the members to draw.
+		*/
+		void Draw(const Ref<Shader>& shader, const std::vector<uint32_t>& members);
+
+		inline uint32_t GetMemberCount() const { return (uint32_t)m_Members.size(); }
+		inline uint32_t GetVertexCount() const { return m_VertexCount; }
+		inline uint32_t GetIndexCount() const { return (uint32_t)m_Indices.size(); }
+		inline const AABB& GetBounds() const { return m_Bounds; }
+
+		/*!
+		* @brief Returns the vertex array of the batch, or nullptr before the first Draw.
+		*/
+		inline const Ref<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+	private:
+		/// A piece of geometry of the batch.
+		struct Member
+		{
+			uint32_t FirstVertex; /// The first vertex of the member in the batch.
+			uint32_t VertexCount; /// The number of vertices of the member.
+			uint32_t FirstIndex; /// The first index of the member in the batch.
+			uint32_t IndexCount; /// The number of indices of the member.
+			glm::mat4 Transform; /// The model matrix the vertices are baked with.
+			AABB Bounds; /// The world space bounds of the baked vertices.
+		};
+
+		/*!
+		* @brief Writes the world space vertices of a member from its local vertices and transform, and its bounds.
+		*/
+		void Bake(Member& member);
+
+		/*!
+		* @brief Rebuilds the buffers if the batch is invalid, otherwise uploads the vertices of the members moved since the last Draw.
+		*/
+		void Upload();
+
+		/*!
+		* @brief Recreates the vertex array and the buffers from the baked vertices.
+		*/
+		void Build();
+
+		/*!
+		* @brief Recomputes the bounds of the batch from the bounds of every member.
+		*/
+		void UpdateBounds();
+	private:
+		BufferLayout m_Layout; /// The layout of the vertices.
+		uint32_t m_Stride; /// The number of floats per vertex.
+		uint32_t m_PositionOffset; /// The index of the x coordinate of the position within a vertex, in floats.
+
+		std::vector<Member> m_Members; /// The members of the batch.
+		std::vector<float> m_LocalVertices; /// The model space vertices of every member, in member order.
+		std::vector<float> m_Vertices; /// The baked world space vertices, uploaded to the vertex buffer.
+		std::vector<uint32_t> m_Indices; /// The indices, offset to the first vertex of each member.
+		uint32_t m_VertexCount = 0; /// The number of vertices.
+		AABB m_Bounds; /// The world space bounds of every member.
+
+		Ref<VertexArray> m_VertexArray; /// The vertex array drawn by the batch.
+		Ref<VertexBuffer> m_VertexBuffer; /// The vertex buffer of m_VertexArray.
+
+		bool m_Invalid = true; /// Whether the buffers have to be rebuilt on the next Draw.
+		uint32_t m_DirtyFirstVertex = 0xFFFFFFFF; /// The first vertex of the range to upload on the next Draw.
+		uint32_t m_DirtyEndVertex = 0; /// One past the last vertex of the range to upload on the next Draw.
+		AABB m_DirtyBounds; /// The bounds of the members moved since the last Draw, merged into m_Bounds by it.
+		std::vector<DrawIndexedIndirectCommand> m_Ranges; /// The index ranges of the members drawn by the last partial Draw. Kept to reuse the memory.
+	};
+
+}
@@ -3,11 +3,13 @@
 
 #include "Fracture/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Software/SoftwareTexture.h"
 
 namespace Fracture {
 
 	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, glm::vec4 color)
 	{
+		FR_MEMORY_TAG(Assets);
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:
@@ -15,6 +17,8 @@ namespace Fracture {
 				return nullptr;
 			case RendererAPI::API::OpenGL:
 				return  CreateRef<OpenGLTexture2D>(width, height, color);
+			case RendererAPI::API::Software:
+				return CreateRef<SoftwareTexture2D>(width, height, color);
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -23,6 +27,7 @@ namespace Fracture {
 
 	Ref<Texture2D> Texture2D::Create(const std::string& path)
 	{
+		FR_MEMORY_TAG(Assets);
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:
@@ -30,6 +35,8 @@ namespace Fracture {
 				return nullptr;
 			case RendererAPI::API::OpenGL:
 				return CreateRef<OpenGLTexture2D>(path);
+			case RendererAPI::API::Software:
+				return CreateRef<SoftwareTexture2D>(path);
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -4,11 +4,13 @@
 #include "Fracture/Renderer/Renderer.h"
 
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Software/SoftwareVertexArray.h"
 
 namespace Fracture {
 
 	Ref<VertexArray> VertexArray::Create()
 	{
+		FR_MEMORY_TAG(Renderer);
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:
@@ -16,6 +18,8 @@ namespace Fracture {
 			return nullptr;
 		case RendererAPI::API::OpenGL:
 			return CreateRef<OpenGLVertexArray>();
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareVertexArray>();
 		}
 
 		FR_CORE_ASSERT(false, "Unknown RendererAPI!");
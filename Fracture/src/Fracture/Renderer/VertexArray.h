@@ -10,6 +10,7 @@
 */
 
 #include "Fracture/Renderer/Buffer.h"
+#include "Fracture/Renderer/Bounds.h"
 
 namespace Fracture {
 	
@@ -60,6 +61,18 @@ namespace Fracture {
 		*/
 		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const = 0;
 
+		/*!
+		* @brief Function that sets the bounds of the vertex positions in model space. The Renderer uses them to cull submissions outside the camera view.
+		* 
+		* @param[in] const AABB& bounds: The bounds of the vertices. An empty box (the default) means the vertex array is never culled.
+		*/
+		virtual void SetBounds(const AABB& bounds) = 0;
+
+		/*!
+		* @brief Function that returns the bounds of the vertex positions in model space.
+		*/
+		virtual const AABB& GetBounds() const = 0;
+
 		/*!
 		* @brief Function that creates a VertexArray. This function will create a VertexArray based on the current active renderer.
 		* 
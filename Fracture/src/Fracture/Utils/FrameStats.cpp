@@ -0,0 +1,184 @@
+#include "frpch.h"
+#include "FrameStats.h"
+
+#include <array>
+#include <cmath>
+#include <deque>
+
+namespace Fracture {
+	namespace Utils {
+
+		namespace {
+
+			constexpr uint32_t MetricCount = (uint32_t)FrameStats::Metric::Count;
+			constexpr uint32_t LayerPhaseCount = (uint32_t)FrameStats::LayerPhase::Count;
+			const char* const LayerPhaseSuffixes[LayerPhaseCount] = { "::OnUpdate", "::OnEvent", "::OnImGuiRender" };
+
+			/// The state of the service that is only touched by the main thread.
+			struct FrameStatsData
+			{
+				StatHistory Histories[MetricCount]; /// The history of every metric.
+				float Timings[MetricCount] = {}; /// The timings recorded for the current frame.
+				std::vector<FrameStats::LayerHistory> Layers; /// The histories of the layers.
+				std::vector<std::array<float, LayerPhaseCount>> LayerTimings; /// The layer timings recorded for the current frame, parallel to Layers.
+				std::unordered_map<std::string, uint32_t> LayerIndices; /// Maps a layer name to its index in Layers.
+				std::deque<std::string> LayerPhaseNames; /// The storage of the phase names. A deque so the names never move.
+				uint64_t FrameIndex = 0; /// The number of frames ended.
+			};
+
+			FrameStatsData& GetData()
+			{
+				static FrameStatsData data;
+				return data;
+			}
+
+			const char* const MetricNames[MetricCount] = {
+				"Frame Time", "Update Time", "ImGui Time", "Viewport Time", "Swap Time",
+				"Draw Calls", "Indices", "Uniform Uploads", "Buffer Bytes", "Objects Drawn", "Objects Culled",
+				"GL State Calls", "GL State Calls Elided", "Events Dispatched", "Events Coalesced", "ImGui Frames Reused"
+			};
+
+		}
+
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		// StatHistory ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+		void StatHistory::Push(float value)
+		{
+			m_Samples[m_Next] = value;
+			m_Next = (m_Next + 1) % Capacity;
+			if (m_Size < Capacity)
+				m_Size++;
+		}
+
+		StatHistory::Summary StatHistory::ComputeSummary() const
+		{
+			Summary summary;
+			if (m_Size == 0)
+				return summary;
+
+			summary.Last = m_Samples[(m_Next + Capacity - 1) % Capacity];
+
+			float sorted[Capacity];
+			std::copy(m_Samples, m_Samples + m_Size, sorted);
+
+			double sum = 0.0;
+			for (uint32_t i = 0; i < m_Size; i++)
+				sum += sorted[i];
+			summary.Average = (float)(sum / m_Size);
+
+			// nth_element partitions around the requested rank, so asking for the ranks in increasing order only has to look at what is right of the previous one
+			auto percentile = [&](uint32_t start, double fraction) -> uint32_t
+			{
+				uint32_t rank = (uint32_t)std::ceil(fraction * m_Size);
+				rank = rank > 0 ? rank - 1 : 0;
+				std::nth_element(sorted + start, sorted + rank, sorted + m_Size);
+				return rank;
+			};
+
+			uint32_t rank = percentile(0, 0.50);
+			summary.P50 = sorted[rank];
+			rank = percentile(rank, 0.95);
+			summary.P95 = sorted[rank];
+			rank = percentile(rank, 0.99);
+			summary.P99 = sorted[rank];
+			summary.Max = *std::max_element(sorted + rank, sorted + m_Size);
+
+			return summary;
+		}
+
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		// FrameStats /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+		std::atomic<uint64_t> FrameStats::s_Counters[(uint32_t)FrameStats::Metric::Count] = {};
+
+		void FrameStats::Record(Metric metric, float value)
+		{
+			if (IsTiming(metric))
+				GetData().Timings[(uint32_t)metric] = value;
+			else
+				s_Counters[(uint32_t)metric].store((uint64_t)value, std::memory_order_relaxed);
+		}
+
+		uint32_t FrameStats::RegisterLayer(const std::string& layerName)
+		{
+			FrameStatsData& data = GetData();
+			auto it = data.LayerIndices.find(layerName);
+			if (it != data.LayerIndices.end())
+				return it->second;
+
+			uint32_t index = (uint32_t)data.Layers.size();
+			data.LayerIndices.emplace(layerName, index);
+			LayerHistory& layer = data.Layers.emplace_back();
+			layer.Name = layerName;
+			for (uint32_t phase = 0; phase < LayerPhaseCount; phase++)
+				layer.PhaseNames[phase] = data.LayerPhaseNames.emplace_back(layerName + LayerPhaseSuffixes[phase]).c_str();
+			data.LayerTimings.push_back({});
+			return index;
+		}
+
+		void FrameStats::RecordLayerTime(uint32_t layer, LayerPhase phase, float milliseconds)
+		{
+			GetData().LayerTimings[layer][(uint32_t)phase] += milliseconds;
+		}
+
+		const char* FrameStats::GetLayerPhaseName(uint32_t layer, LayerPhase phase)
+		{
+			return GetData().Layers[layer].PhaseNames[(uint32_t)phase];
+		}
+
+		void FrameStats::EndFrame()
+		{
+			FrameStatsData& data = GetData();
+			for (uint32_t i = 0; i < MetricCount; i++)
+			{
+				if (IsTiming((Metric)i))
+				{
+					data.Histories[i].Push(data.Timings[i]);
+					data.Timings[i] = 0.0f;
+				}
+				else
+				{
+					data.Histories[i].Push((float)s_Counters[i].exchange(0, std::memory_order_relaxed));
+				}
+			}
+
+			// Layers that did not run this frame (disabled, or the window is minimized) record 0 so all the histories stay aligned
+			for (size_t i = 0; i < data.Layers.size(); i++)
+			{
+				for (uint32_t phase = 0; phase < LayerPhaseCount; phase++)
+				{
+					data.Layers[i].Histories[phase].Push(data.LayerTimings[i][phase]);
+					data.LayerTimings[i][phase] = 0.0f;
+				}
+			}
+
+			data.FrameIndex++;
+		}
+
+		const StatHistory& FrameStats::GetHistory(Metric metric)
+		{
+			FR_CORE_ASSERT(metric < Metric::Count, "Invalid metric");
+			return GetData().Histories[(uint32_t)metric];
+		}
+
+		const char* FrameStats::GetName(Metric metric)
+		{
+			FR_CORE_ASSERT(metric < Metric::Count, "Invalid metric");
+			return MetricNames[(uint32_t)metric];
+		}
+
+		const std::vector<FrameStats::LayerHistory>& FrameStats::GetLayerHistories()
+		{
+			return GetData().Layers;
+		}
+
+		uint64_t FrameStats::GetFrameIndex()
+		{
+			return GetData().FrameIndex;
+		}
+
+	}
+}
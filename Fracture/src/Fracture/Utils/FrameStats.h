@@ -0,0 +1,199 @@
+#pragma once
+/*!
+* @file FrameStats.h
+* @brief Contains the FrameStats service that keeps a rolling history of per frame timings and renderer counters.
+*
+* @details Usage:
+*
+* FrameStats::AddCount(FrameStats::Metric::DrawCalls);              // anywhere during the frame, from any thread
+* FrameStats::Record(FrameStats::Metric::SwapTime, milliseconds);    // timings measured by the application
+* FrameStats::EndFrame();                                            // once per frame, pushes the frame into the history
+*
+* FrameStats::GetSummary(FrameStats::Metric::FrameTime).P99;         // percentiles over the history
+*
+* @see PerformanceLayer
+*
+* @author Aditya Rajagopal
+*/
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace Fracture {
+	namespace Utils {
+
+		/*!
+		* @brief Fixed size ring buffer of samples with percentile queries.
+		*/
+		class StatHistory
+		{
+		public:
+			static constexpr uint32_t Capacity = 512; /// The number of frames kept in the history.
+
+			/// The percentiles of the samples in the history.
+			struct Summary
+			{
+				float Last = 0.0f; /// The most recent sample.
+				float Average = 0.0f; /// The mean of the samples.
+				float P50 = 0.0f; /// The median.
+				float P95 = 0.0f; /// The 95th percentile.
+				float P99 = 0.0f; /// The 99th percentile.
+				float Max = 0.0f; /// The largest sample.
+			};
+
+			/*!
+			* @brief Adds a sample, overwriting the oldest one once the history is full.
+			*/
+			void Push(float value);
+
+			/*!
+			* @brief Computes the percentiles of the samples in the history with the nearest rank method.
+			*/
+			Summary ComputeSummary() const;
+
+			/*!
+			* @brief Returns the raw ring of samples. Use GetOffset as the index of the oldest sample when plotting.
+			*/
+			inline const float* GetData() const { return m_Samples; }
+			inline uint32_t GetSize() const { return m_Size; }
+			inline uint32_t GetOffset() const { return m_Size < Capacity ? 0 : m_Next; }
+		private:
+			float m_Samples[Capacity] = {}; /// The ring of samples.
+			uint32_t m_Next = 0; /// The slot the next sample is written to.
+			uint32_t m_Size = 0; /// The number of valid samples.
+		};
+
+		/*!
+		* @brief Static service that collects per frame statistics of the engine.
+		*
+		* @details Timings are recorded once per frame by the Application. Counters such as draw calls are accumulated with AddCount while the frame runs and
+		* moved into their history by EndFrame. Counters are atomic so jobs running on the JobSystem can add to them as well.
+		* Averages hide the occasional long frame so the summaries report p50, p95, p99 and the maximum over the last StatHistory::Capacity frames.
+		*/
+		class FrameStats
+		{
+		public:
+			/// The engine wide metrics.
+			enum class Metric : uint32_t
+			{
+				// Timings in milliseconds
+				FrameTime = 0,	/// The CPU time of the whole frame.
+				UpdateTime,		/// The time spent in the OnUpdate of all layers.
+				ImGuiTime,		/// The time spent building and rendering the ImGui frame.
+				ViewportTime,	/// The part of ImGuiTime spent updating and rendering the ImGui platform windows, with their context switches.
+				SwapTime,		/// The time spent in Window::OnUpdate, polling events and swapping buffers.
+
+				// Counters, per frame
+				DrawCalls,		/// The number of draw calls issued.
+				Indices,		/// The number of indices submitted to draw calls.
+				UniformUploads,	/// The number of uniforms uploaded to shaders.
+				BufferBytes,	/// The number of bytes uploaded to vertex and index buffers.
+				ObjectsDrawn,	/// The number of submissions that passed culling.
+				ObjectsCulled,	/// The number of submissions and bounds culled because they are outside the camera view.
+				GLStateCalls,	/// The number of OpenGL state changes issued.
+				GLStateCallsElided,	/// The number of OpenGL state changes skipped because the state already had the value.
+				EventsDispatched,	/// The number of queued events dispatched to the layers.
+				EventsCoalesced,	/// The number of events merged into an already queued event instead of being queued.
+				ImGuiFramesReused,	/// 1 when the ImGui draw data of an earlier frame was drawn again instead of rebuilding the UI.
+
+				Count
+			};
+
+			/*!
+			* @brief Adds to a counter of the current frame. Thread safe.
+			*
+			* @param[in] Metric metric: The counter to add to.
+			* @param[in] uint64_t amount: The amount to add.
+			*/
+			inline static void AddCount(Metric metric, uint64_t amount = 1)
+			{
+				s_Counters[(uint32_t)metric].fetch_add(amount, std::memory_order_relaxed);
+			}
+
+			/*!
+			* @brief Sets the value of a metric for the current frame. Replaces any counts added this frame. Only called from the main thread.
+			*
+			* @param[in] Metric metric: The metric to set.
+			* @param[in] float value: The value of the metric.
+			*/
+			static void Record(Metric metric, float value);
+
+			/// The parts of a frame timed per layer.
+			enum class LayerPhase : uint32_t
+			{
+				Update = 0,	/// OnUpdate.
+				Events,		/// The event handlers of the layer.
+				ImGui,		/// OnImGuiRender.
+				Count
+			};
+
+			/*!
+			* @brief Returns the index of the timing histories of a layer, creating them the first time the name is seen. Only called from the main thread.
+			*
+			* @param[in] const std::string& layerName: The name of the layer. Layers with the same name share the histories.
+			*/
+			static uint32_t RegisterLayer(const std::string& layerName);
+
+			/*!
+			* @brief Adds to the time of a layer in a phase for the current frame. Only called from the main thread.
+			*
+			* @param[in] uint32_t layer: The index returned by RegisterLayer.
+			* @param[in] LayerPhase phase: The phase that was timed.
+			* @param[in] float milliseconds: The time spent.
+			*/
+			static void RecordLayerTime(uint32_t layer, LayerPhase phase, float milliseconds);
+
+			/*!
+			* @brief Returns the name of a layer phase for the profiler, for example "Sandbox2D::OnUpdate". The string lives as long as the program.
+			*/
+			static const char* GetLayerPhaseName(uint32_t layer, LayerPhase phase);
+
+			/*!
+			* @brief Pushes the metrics of the current frame into their histories and resets the counters. Only called from the main thread.
+			*/
+			static void EndFrame();
+
+			/*!
+			* @brief Returns the history of a metric.
+			*/
+			static const StatHistory& GetHistory(Metric metric);
+
+			/*!
+			* @brief Returns the percentiles of a metric over the history.
+			*/
+			inline static StatHistory::Summary GetSummary(Metric metric) { return GetHistory(metric).ComputeSummary(); }
+
+			/*!
+			* @brief Returns the display name of a metric.
+			*/
+			static const char* GetName(Metric metric);
+
+			/*!
+			* @brief Returns whether a metric is a timing in milliseconds or a per frame counter.
+			*/
+			inline static bool IsTiming(Metric metric) { return metric < Metric::DrawCalls; }
+
+			/// The timing histories of a layer.
+			struct LayerHistory
+			{
+				std::string Name; /// The name of the layer.
+				const char* PhaseNames[(uint32_t)LayerPhase::Count]; /// The names of the phases, see GetLayerPhaseName.
+				StatHistory Histories[(uint32_t)LayerPhase::Count]; /// The times of each phase in milliseconds.
+			};
+
+			/*!
+			* @brief Returns the histories of the layers in the order they were registered.
+			*/
+			static const std::vector<LayerHistory>& GetLayerHistories();
+
+			/*!
+			* @brief Returns the number of frames ended since the start of the application.
+			*/
+			static uint64_t GetFrameIndex();
+		private:
+			static std::atomic<uint64_t> s_Counters[(uint32_t)Metric::Count]; /// The counters of the current frame.
+		};
+
+	}
+}
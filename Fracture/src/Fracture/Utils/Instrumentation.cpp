@@ -0,0 +1,288 @@
+#include "frpch.h"
+#include "Instrumentation.h"
+
+namespace Fracture {
+	namespace Utils {
+
+		static constexpr auto s_DrainInterval = std::chrono::milliseconds(10); /// How often the writer thread drains the buffers.
+		static constexpr auto s_CalibrationTime = std::chrono::milliseconds(50); /// How long the timestamp counter is measured against the steady clock before the first drain.
+		static constexpr size_t s_WriteChunkSize = 256 * 1024; /// The amount of output collected before it is written to the file.
+
+		Instrumentor::~Instrumentor()
+		{
+			EndSession();
+		}
+
+		void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+		{
+			EndSession();
+
+			std::lock_guard<std::mutex> lock(m_SessionMutex);
+			m_OutputStream.open(filepath, std::ios::out | std::ios::binary);
+			if (!m_OutputStream)
+			{
+				FR_CORE_ERROR("Could not open profile file {0}", filepath);
+				return;
+			}
+
+			m_SessionName = name;
+			m_EventCount = 0;
+			m_DroppedCount = 0;
+			m_WriteBuffer.clear();
+			m_WriteBuffer.reserve(s_WriteChunkSize + 4096);
+			m_NameIds.clear();
+			m_PendingNames.clear();
+
+			std::filesystem::path path = filepath;
+			m_Binary = path.extension() == TraceFormat::Extension;
+			if (m_Binary)
+			{
+				TraceFormat::FileHeader header = {};
+				memcpy(header.Magic, TraceFormat::Magic, sizeof(header.Magic));
+				header.Version = TraceFormat::Version;
+				TraceFormat::WriteRaw(m_WriteBuffer, header);
+			}
+			else
+			{
+				m_WriteBuffer += "{\"otherData\": {},\"traceEvents\":[";
+			}
+
+			{
+				// Events recorded after the previous session ended are stale
+				std::lock_guard<std::mutex> buffersLock(m_BuffersMutex);
+				for (auto& buffer : m_Buffers)
+				{
+					buffer->Discard();
+					buffer->TakeDropped();
+				}
+			}
+
+			m_StartTime = std::chrono::steady_clock::now();
+			m_StartTicks = Now();
+			m_MicrosecondsPerTick = 0.0;
+			m_Active.store(true, std::memory_order_release);
+			m_Writer = std::thread(&Instrumentor::WriterLoop, this);
+		}
+
+		void Instrumentor::EndSession()
+		{
+			std::lock_guard<std::mutex> lock(m_SessionMutex);
+			if (!m_Writer.joinable())
+				return;
+
+			{
+				std::lock_guard<std::mutex> writerLock(m_WriterMutex);
+				m_Active.store(false, std::memory_order_release);
+			}
+			m_WriterCondition.notify_all();
+			m_Writer.join();
+
+			if (m_Binary)
+			{
+				std::string end;
+				TraceFormat::WriteVarint(end, m_EventCount);
+				TraceFormat::WriteVarint(end, m_DroppedCount);
+				WriteChunk(TraceFormat::ChunkType::End, end);
+			}
+			else
+			{
+				m_WriteBuffer += "]}";
+			}
+			FlushWriteBuffer(true);
+			m_OutputStream.close();
+
+			if (m_DroppedCount)
+				FR_CORE_WARN("Profile session {0}: dropped {1} events because the ring buffers were full", m_SessionName, m_DroppedCount);
+		}
+
+		ProfileEventBuffer* Instrumentor::RegisterThread()
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			m_Buffers.push_back(std::make_unique<ProfileEventBuffer>((uint32_t)m_Buffers.size()));
+			return m_Buffers.back().get();
+		}
+
+		void Instrumentor::WriterLoop()
+		{
+			std::unique_lock<std::mutex> lock(m_WriterMutex);
+
+			// The timestamp counter runs at a constant rate on any CPU from the last decade but the rate is not exposed, so measure it against the steady clock.
+			m_WriterCondition.wait_for(lock, s_CalibrationTime, [this]() { return !m_Active.load(std::memory_order_acquire); });
+			uint64_t ticks = Now() - m_StartTicks;
+			double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_StartTime).count();
+			m_MicrosecondsPerTick = ticks ? microseconds / (double)ticks : 0.0;
+
+			if (m_Binary)
+			{
+				std::string info;
+				TraceFormat::WriteRaw(info, TraceFormat::InfoChunk{ m_MicrosecondsPerTick, m_StartTicks });
+				TraceFormat::WriteVarint(info, m_SessionName.size());
+				info += m_SessionName;
+				WriteChunk(TraceFormat::ChunkType::Info, info);
+			}
+
+			while (m_Active.load(std::memory_order_acquire))
+			{
+				lock.unlock();
+				Drain();
+				lock.lock();
+				m_WriterCondition.wait_for(lock, s_DrainInterval, [this]() { return !m_Active.load(std::memory_order_acquire); });
+			}
+			lock.unlock();
+
+			// Final drain for the events recorded before the session ended
+			Drain();
+		}
+
+		void Instrumentor::Drain()
+		{
+			std::vector<ProfileEventBuffer*> buffers;
+			{
+				std::lock_guard<std::mutex> lock(m_BuffersMutex);
+				buffers.reserve(m_Buffers.size());
+				for (auto& buffer : m_Buffers)
+					buffers.push_back(buffer.get());
+			}
+
+			for (ProfileEventBuffer* buffer : buffers)
+			{
+				m_DroppedCount += buffer->TakeDropped();
+				if (m_Binary)
+					DrainBinary(*buffer);
+				else
+					DrainJson(*buffer);
+				FlushWriteBuffer(false);
+			}
+		}
+
+		void Instrumentor::DrainJson(ProfileEventBuffer& buffer)
+		{
+			char number[96];
+			buffer.Consume([this, &number](const ProfileEvent& event)
+				{
+					if (event.Start < m_StartTicks)
+						return; // recorded before the session began
+
+					if (m_EventCount++ > 0)
+						m_WriteBuffer += ',';
+
+					double start = (event.Start - m_StartTicks) * m_MicrosecondsPerTick;
+					int length;
+					if (event.Type == TraceFormat::EventType::Scope)
+					{
+						m_WriteBuffer += "{\"cat\":\"function\",\"name\":\"";
+						AppendJsonName(event.Name);
+						double duration = (event.End - event.Start) * m_MicrosecondsPerTick;
+						length = snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f", event.ThreadID, start, duration);
+					}
+					else if (event.Type == TraceFormat::EventType::Counter)
+					{
+						m_WriteBuffer += "{\"cat\":\"counter\",\"name\":\"";
+						AppendJsonName(event.Name);
+						length = snprintf(number, sizeof(number), "\",\"ph\":\"C\",\"pid\":0,\"tid\":%u,\"ts\":%.3f", event.ThreadID, start);
+					}
+					else
+					{
+						// Frame markers are global instant events so they are drawn across every thread of the timeline
+						m_WriteBuffer += event.Type == TraceFormat::EventType::FrameBegin ? "{\"cat\":\"frame\",\"name\":\"FrameBegin" : "{\"cat\":\"frame\",\"name\":\"FrameEnd";
+						length = snprintf(number, sizeof(number), "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":%u,\"ts\":%.3f", event.ThreadID, start);
+					}
+					m_WriteBuffer.append(number, length);
+
+					if (event.ArgumentName)
+					{
+						m_WriteBuffer += ",\"args\":{\"";
+						AppendJsonName(event.ArgumentName);
+						length = snprintf(number, sizeof(number), "\":%lld}", (long long)event.Argument);
+						m_WriteBuffer.append(number, length);
+					}
+					m_WriteBuffer += '}';
+				});
+		}
+
+		void Instrumentor::AppendJsonName(const char* name)
+		{
+			for (const char* c = name; *c; c++)
+			{
+				if (*c == '"' || *c == '\\')
+					m_WriteBuffer += '\'';
+				else
+					m_WriteBuffer += *c;
+			}
+		}
+
+		void Instrumentor::DrainBinary(ProfileEventBuffer& buffer)
+		{
+			m_EventBlock.clear();
+			uint64_t count = 0;
+			uint64_t previousStart = m_StartTicks;
+			buffer.Consume([this, &count, &previousStart](const ProfileEvent& event)
+				{
+					if (event.Start < m_StartTicks)
+						return; // recorded before the session began
+
+					bool hasArgument = event.ArgumentName != nullptr;
+					TraceFormat::WriteVarint(m_EventBlock, TraceFormat::EncodeEventHeader(InternName(event.Name), event.Type, hasArgument));
+					TraceFormat::WriteVarint(m_EventBlock, TraceFormat::ZigZagEncode((int64_t)(event.Start - previousStart)));
+					if (event.Type == TraceFormat::EventType::Scope)
+						TraceFormat::WriteVarint(m_EventBlock, event.End - event.Start);
+					if (hasArgument)
+					{
+						TraceFormat::WriteVarint(m_EventBlock, InternName(event.ArgumentName));
+						TraceFormat::WriteVarint(m_EventBlock, TraceFormat::ZigZagEncode(event.Argument));
+					}
+					previousStart = event.Start;
+					count++;
+				});
+
+			if (count == 0)
+				return;
+
+			// The names have to be known before the events that use them are read
+			if (!m_PendingNames.empty())
+			{
+				WriteChunk(TraceFormat::ChunkType::Strings, m_PendingNames);
+				m_PendingNames.clear();
+			}
+
+			std::string head;
+			TraceFormat::WriteVarint(head, buffer.GetThreadID());
+			TraceFormat::WriteVarint(head, count);
+			WriteChunk(TraceFormat::ChunkType::Events, head, m_EventBlock);
+			m_EventCount += count;
+		}
+
+		void Instrumentor::WriteChunk(TraceFormat::ChunkType type, const std::string& head, const std::string& body)
+		{
+			TraceFormat::WriteRaw(m_WriteBuffer, TraceFormat::ChunkHeader{ type, (uint32_t)(head.size() + body.size()) });
+			m_WriteBuffer += head;
+			m_WriteBuffer += body;
+		}
+
+		uint32_t Instrumentor::InternName(const char* name)
+		{
+			auto it = m_NameIds.find(name);
+			if (it != m_NameIds.end())
+				return it->second;
+
+			uint32_t id = (uint32_t)m_NameIds.size();
+			m_NameIds.emplace(name, id);
+
+			size_t length = strlen(name);
+			TraceFormat::WriteVarint(m_PendingNames, id);
+			TraceFormat::WriteVarint(m_PendingNames, length);
+			m_PendingNames.append(name, length);
+			return id;
+		}
+
+		void Instrumentor::FlushWriteBuffer(bool force)
+		{
+			if (m_WriteBuffer.empty() || (!force && m_WriteBuffer.size() < s_WriteChunkSize))
+				return;
+
+			m_OutputStream.write(m_WriteBuffer.data(), m_WriteBuffer.size());
+			m_WriteBuffer.clear();
+		}
+
+	}
+}
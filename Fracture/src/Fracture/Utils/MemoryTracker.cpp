@@ -0,0 +1,445 @@
+#include "frpch.h"
+#include "MemoryTracker.h"
+
+#include <new>
+#include <cstdlib>
+#include <malloc.h>
+#include <intrin.h>
+
+#ifdef FR_TRACK_ALLOCATIONS
+	#include <DbgHelp.h>
+	#pragma comment(lib, "Dbghelp.lib")
+	#pragma intrinsic(_ReturnAddress)
+#endif
+
+namespace Fracture {
+	namespace Utils {
+
+		namespace {
+
+			constexpr uint32_t TagCount = (uint32_t)MemoryTag::Count;
+
+			constexpr uint16_t ScopeSlots = 1024; /// Slot 0 is for allocations outside of any scope and the last slot collects the scopes that did not fit.
+			constexpr uint16_t NoScopeSlot = 0;
+			constexpr uint16_t ScopeOverflowSlot = ScopeSlots - 1;
+
+			constexpr uint16_t CallSiteSlots = 4096; /// Slot 0 collects the call sites that did not fit.
+			constexpr uint16_t CallSiteOverflowSlot = 0;
+
+			constexpr uint32_t MaxProbes = 32; /// How far the open addressing tables are searched before giving up.
+
+			/// Spinlock for the tables. The hooks run inside every new and delete so they cannot use a lock that may allocate.
+			class SpinLock
+			{
+			public:
+				inline void Lock()
+				{
+					while (m_Flag.test_and_set(std::memory_order_acquire))
+						_mm_pause();
+				}
+
+				inline void Unlock() { m_Flag.clear(std::memory_order_release); }
+			private:
+				std::atomic_flag m_Flag = ATOMIC_FLAG_INIT;
+			};
+
+			/// The state of the tracker. Every member has a constant initializer so it is initialized before any allocation of another translation unit can happen.
+			struct TrackerData
+			{
+				SpinLock Lock;
+				MemoryTracker::Totals All = {};
+				MemoryTracker::Totals Tags[TagCount] = {};
+				MemoryTracker::ScopeTotals Scopes[ScopeSlots] = {};
+				MemoryTracker::CallSiteTotals CallSites[CallSiteSlots] = {};
+				MemoryTracker::FrameTotals CurrentFrame = {};
+				MemoryTracker::FrameTotals LastFrame = {};
+			};
+
+			TrackerData s_Data;
+
+			/// The per frame histories, only touched by the main thread.
+			struct FrameHistories
+			{
+				StatHistory Count;
+				StatHistory Bytes;
+			};
+
+			FrameHistories& GetHistories()
+			{
+				static FrameHistories histories;
+				return histories;
+			}
+
+			inline uint32_t HashPointer(uintptr_t value)
+			{
+				value ^= value >> 33;
+				value *= 0xFF51AFD7ED558CCDull;
+				value ^= value >> 33;
+				return (uint32_t)value;
+			}
+
+			/// Returns the slot of a scope name, claiming a free one the first time it is seen. Called with the lock held.
+			uint16_t FindScopeSlot(const char* name)
+			{
+				if (name == nullptr)
+					return NoScopeSlot;
+
+				constexpr uint32_t usable = ScopeSlots - 2;
+				uint32_t hash = HashPointer((uintptr_t)name);
+				for (uint32_t probe = 0; probe < MaxProbes; probe++)
+				{
+					uint16_t slot = (uint16_t)(1 + (hash + probe) % usable);
+					if (s_Data.Scopes[slot].Name == nullptr)
+					{
+						s_Data.Scopes[slot].Name = name;
+						return slot;
+					}
+					if (s_Data.Scopes[slot].Name == name)
+						return slot;
+				}
+				return ScopeOverflowSlot;
+			}
+
+			/// Returns the slot of a call site, claiming a free one the first time it is seen. Called with the lock held.
+			uint16_t FindCallSiteSlot(uintptr_t address)
+			{
+				constexpr uint32_t usable = CallSiteSlots - 1;
+				uint32_t hash = HashPointer(address);
+				for (uint32_t probe = 0; probe < MaxProbes; probe++)
+				{
+					uint16_t slot = (uint16_t)(1 + (hash + probe) % usable);
+					if (s_Data.CallSites[slot].Address == 0)
+					{
+						s_Data.CallSites[slot].Address = address;
+						return slot;
+					}
+					if (s_Data.CallSites[slot].Address == address)
+						return slot;
+				}
+				return CallSiteOverflowSlot;
+			}
+
+			inline void AddAllocation(MemoryTracker::Totals& totals, size_t size)
+			{
+				totals.LiveBytes += size;
+				totals.LiveCount++;
+				totals.TotalBytes += size;
+				totals.TotalCount++;
+			}
+
+			inline void RemoveAllocation(MemoryTracker::Totals& totals, size_t size)
+			{
+				totals.LiveBytes -= size;
+				totals.LiveCount--;
+			}
+
+			const char* const TagNames[TagCount] = { "Untagged", "Renderer", "Assets", "Events" };
+
+			// The counter names have to be literals for the profiler
+			const char* const TagCounterNames[TagCount] = {
+				"Memory Live Bytes (Untagged)", "Memory Live Bytes (Renderer)", "Memory Live Bytes (Assets)", "Memory Live Bytes (Events)"
+			};
+
+		}
+
+		void MemoryTracker::OnAllocate(size_t size, uintptr_t callSite, uint16_t& scopeSlot, uint16_t& callSiteSlot, MemoryTag& tag)
+		{
+			tag = CurrentTag();
+			const char* scope = CurrentScope();
+
+			s_Data.Lock.Lock();
+			scopeSlot = FindScopeSlot(scope);
+			callSiteSlot = FindCallSiteSlot(callSite);
+			AddAllocation(s_Data.All, size);
+			AddAllocation(s_Data.Tags[(uint32_t)tag], size);
+			AddAllocation(s_Data.Scopes[scopeSlot].Stats, size);
+			AddAllocation(s_Data.CallSites[callSiteSlot].Stats, size);
+			s_Data.CurrentFrame.Count++;
+			s_Data.CurrentFrame.Bytes += size;
+			s_Data.Lock.Unlock();
+		}
+
+		void MemoryTracker::OnFree(size_t size, uint16_t scopeSlot, uint16_t callSiteSlot, MemoryTag tag)
+		{
+			s_Data.Lock.Lock();
+			RemoveAllocation(s_Data.All, size);
+			RemoveAllocation(s_Data.Tags[(uint32_t)tag], size);
+			RemoveAllocation(s_Data.Scopes[scopeSlot].Stats, size);
+			RemoveAllocation(s_Data.CallSites[callSiteSlot].Stats, size);
+			s_Data.CurrentFrame.Frees++;
+			s_Data.Lock.Unlock();
+		}
+
+		void MemoryTracker::EndFrame()
+		{
+			if (!IsEnabled())
+				return;
+
+			s_Data.Lock.Lock();
+			FrameTotals frame = s_Data.CurrentFrame;
+			s_Data.CurrentFrame = FrameTotals();
+			s_Data.LastFrame = frame;
+			Totals all = s_Data.All;
+			Totals tags[TagCount];
+			for (uint32_t i = 0; i < TagCount; i++)
+				tags[i] = s_Data.Tags[i];
+			s_Data.Lock.Unlock();
+
+			FrameHistories& histories = GetHistories();
+			histories.Count.Push((float)frame.Count);
+			histories.Bytes.Push((float)frame.Bytes);
+
+			Instrumentor& instrumentor = Instrumentor::Get();
+			instrumentor.WriteCounter("Memory Live Bytes", (int64_t)all.LiveBytes);
+			instrumentor.WriteCounter("Memory Frame Allocations", (int64_t)frame.Count);
+			instrumentor.WriteCounter("Memory Frame Bytes", (int64_t)frame.Bytes);
+			for (uint32_t i = 0; i < TagCount; i++)
+				instrumentor.WriteCounter(TagCounterNames[i], (int64_t)tags[i].LiveBytes);
+		}
+
+		MemoryTracker::Totals MemoryTracker::GetTotals()
+		{
+			s_Data.Lock.Lock();
+			Totals totals = s_Data.All;
+			s_Data.Lock.Unlock();
+			return totals;
+		}
+
+		MemoryTracker::Totals MemoryTracker::GetTagTotals(MemoryTag tag)
+		{
+			FR_CORE_ASSERT(tag < MemoryTag::Count, "Invalid memory tag");
+			s_Data.Lock.Lock();
+			Totals totals = s_Data.Tags[(uint32_t)tag];
+			s_Data.Lock.Unlock();
+			return totals;
+		}
+
+		MemoryTracker::FrameTotals MemoryTracker::GetLastFrame()
+		{
+			s_Data.Lock.Lock();
+			FrameTotals frame = s_Data.LastFrame;
+			s_Data.Lock.Unlock();
+			return frame;
+		}
+
+		const StatHistory& MemoryTracker::GetFrameCountHistory()
+		{
+			return GetHistories().Count;
+		}
+
+		const StatHistory& MemoryTracker::GetFrameBytesHistory()
+		{
+			return GetHistories().Bytes;
+		}
+
+		std::vector<MemoryTracker::ScopeTotals> MemoryTracker::GetTopScopes(size_t count)
+		{
+			// Copied out under the lock into a fixed array; the vector is only allocated once the lock is released
+			static ScopeTotals copy[ScopeSlots];
+			uint32_t used = 0;
+			s_Data.Lock.Lock();
+			for (uint32_t i = 0; i < ScopeSlots; i++)
+			{
+				if (s_Data.Scopes[i].Stats.TotalCount)
+				{
+					copy[used] = s_Data.Scopes[i];
+					if (i == ScopeOverflowSlot)
+						copy[used].Name = "<other scopes>";
+					used++;
+				}
+			}
+			s_Data.Lock.Unlock();
+
+			std::vector<ScopeTotals> result(copy, copy + used);
+			std::sort(result.begin(), result.end(), [](const ScopeTotals& a, const ScopeTotals& b) { return a.Stats.TotalBytes > b.Stats.TotalBytes; });
+			if (result.size() > count)
+				result.resize(count);
+			return result;
+		}
+
+		std::vector<MemoryTracker::CallSiteTotals> MemoryTracker::GetTopCallSites(size_t count)
+		{
+			static CallSiteTotals copy[CallSiteSlots];
+			uint32_t used = 0;
+			s_Data.Lock.Lock();
+			for (uint32_t i = 0; i < CallSiteSlots; i++)
+			{
+				if (s_Data.CallSites[i].Stats.TotalCount)
+					copy[used++] = s_Data.CallSites[i];
+			}
+			s_Data.Lock.Unlock();
+
+			std::vector<CallSiteTotals> result(copy, copy + used);
+			std::sort(result.begin(), result.end(), [](const CallSiteTotals& a, const CallSiteTotals& b) { return a.Stats.TotalBytes > b.Stats.TotalBytes; });
+			if (result.size() > count)
+				result.resize(count);
+			return result;
+		}
+
+		std::string MemoryTracker::DescribeCallSite(uintptr_t address)
+		{
+			if (address == 0)
+				return "<other call sites>";
+
+			char hex[32];
+			snprintf(hex, sizeof(hex), "0x%llx", (unsigned long long)address);
+			std::string result = hex;
+
+#ifdef FR_TRACK_ALLOCATIONS
+			// DbgHelp is single threaded; the description is only requested from the main thread
+			HANDLE process = GetCurrentProcess();
+			static bool s_SymbolsLoaded = [process]()
+			{
+				SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+				return SymInitialize(process, nullptr, TRUE) == TRUE;
+			}();
+			if (!s_SymbolsLoaded)
+				return result;
+
+			alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+			SYMBOL_INFO* symbol = (SYMBOL_INFO*)buffer;
+			symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+			symbol->MaxNameLen = MAX_SYM_NAME;
+			DWORD64 displacement = 0;
+			if (SymFromAddr(process, (DWORD64)address, &displacement, symbol))
+				result = symbol->Name;
+
+			IMAGEHLP_LINE64 line = {};
+			line.SizeOfStruct = sizeof(IMAGEHLP_LINE64);
+			DWORD lineDisplacement = 0;
+			if (SymGetLineFromAddr64(process, (DWORD64)address, &lineDisplacement, &line))
+				result += " (" + std::filesystem::path(line.FileName).filename().string() + ":" + std::to_string(line.LineNumber) + ")";
+#endif
+
+			return result;
+		}
+
+		void MemoryTracker::LogReport(size_t count)
+		{
+			if (!IsEnabled())
+				return;
+
+			Totals all = GetTotals();
+			FR_CORE_INFO("Memory: {0} live allocations, {1} live bytes, {2} allocations and {3} bytes in total", all.LiveCount, all.LiveBytes, all.TotalCount, all.TotalBytes);
+			for (uint32_t i = 0; i < TagCount; i++)
+			{
+				Totals tag = GetTagTotals((MemoryTag)i);
+				FR_CORE_INFO("    {0}: {1} live bytes, {2} allocations", TagNames[i], tag.LiveBytes, tag.TotalCount);
+			}
+
+			FR_CORE_INFO("Top {0} call sites by bytes allocated:", count);
+			for (const CallSiteTotals& site : GetTopCallSites(count))
+				FR_CORE_INFO("    {0} bytes in {1} allocations, {2} bytes live: {3}", site.Stats.TotalBytes, site.Stats.TotalCount, site.Stats.LiveBytes, DescribeCallSite(site.Address));
+		}
+
+		void MemoryTracker::WriteTopCallSites(size_t count)
+		{
+			Instrumentor& instrumentor = Instrumentor::Get();
+			if (!IsEnabled() || !instrumentor.IsActive())
+				return;
+
+			static std::unordered_map<uintptr_t, std::string> s_CounterNames; // Never erased, the profiler keeps the pointers
+			for (const CallSiteTotals& site : GetTopCallSites(count))
+			{
+				std::string& name = s_CounterNames[site.Address];
+				if (name.empty())
+					name = "Call Site Bytes: " + DescribeCallSite(site.Address);
+				instrumentor.WriteCounter(name.c_str(), (int64_t)site.Stats.TotalBytes);
+			}
+		}
+
+		const char* MemoryTracker::GetTagName(MemoryTag tag)
+		{
+			FR_CORE_ASSERT(tag < MemoryTag::Count, "Invalid memory tag");
+			return TagNames[(uint32_t)tag];
+		}
+
+	}
+}
+
+#ifdef FR_TRACK_ALLOCATIONS
+
+namespace {
+
+	using Fracture::Utils::MemoryTag;
+	using Fracture::Utils::MemoryTracker;
+
+	/// Stored in front of every allocation so a free knows what it releases and where it was counted.
+	struct AllocationHeader
+	{
+		uint64_t Size; /// The requested size.
+		uint16_t ScopeSlot; /// The scope slot the allocation was counted in.
+		uint16_t CallSiteSlot; /// The call site slot the allocation was counted in.
+		MemoryTag Tag; /// The tag the allocation was counted in.
+		uint8_t Padding[3];
+	};
+	static_assert(sizeof(AllocationHeader) == 16, "The header must keep the 16 byte alignment of malloc");
+
+	inline size_t GetHeaderSize(size_t alignment)
+	{
+		return alignment > sizeof(AllocationHeader) ? alignment : sizeof(AllocationHeader);
+	}
+
+	void* TrackedAllocate(size_t size, size_t alignment, uintptr_t callSite)
+	{
+		size_t headerSize = GetHeaderSize(alignment);
+		void* raw = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? _aligned_malloc(size + headerSize, alignment) : malloc(size + headerSize);
+		if (!raw)
+			return nullptr;
+
+		void* user = (char*)raw + headerSize;
+		AllocationHeader* header = (AllocationHeader*)user - 1;
+		header->Size = size;
+		MemoryTracker::OnAllocate(size, callSite, header->ScopeSlot, header->CallSiteSlot, header->Tag);
+		return user;
+	}
+
+	void TrackedFree(void* user, size_t alignment)
+	{
+		if (!user)
+			return;
+
+		AllocationHeader* header = (AllocationHeader*)user - 1;
+		MemoryTracker::OnFree((size_t)header->Size, header->ScopeSlot, header->CallSiteSlot, header->Tag);
+
+		void* raw = (char*)user - GetHeaderSize(alignment);
+		if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			_aligned_free(raw);
+		else
+			free(raw);
+	}
+
+	void* TrackedAllocateOrThrow(size_t size, size_t alignment, uintptr_t callSite)
+	{
+		void* result = TrackedAllocate(size, alignment, callSite);
+		if (!result)
+			throw std::bad_alloc();
+		return result;
+	}
+
+}
+
+// Replacements of the global allocation functions. _ReturnAddress has to be read here, in the function called by the new expression, to get the caller.
+void* operator new(size_t size) { return TrackedAllocateOrThrow(size, 0, (uintptr_t)_ReturnAddress()); }
+void* operator new[](size_t size) { return TrackedAllocateOrThrow(size, 0, (uintptr_t)_ReturnAddress()); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, 0, (uintptr_t)_ReturnAddress()); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, 0, (uintptr_t)_ReturnAddress()); }
+void* operator new(size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, (size_t)alignment, (uintptr_t)_ReturnAddress()); }
+void* operator new[](size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, (size_t)alignment, (uintptr_t)_ReturnAddress()); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, (size_t)alignment, (uintptr_t)_ReturnAddress()); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, (size_t)alignment, (uintptr_t)_ReturnAddress()); }
+
+void operator delete(void* memory) noexcept { TrackedFree(memory, 0); }
+void operator delete[](void* memory) noexcept { TrackedFree(memory, 0); }
+void operator delete(void* memory, size_t) noexcept { TrackedFree(memory, 0); }
+void operator delete[](void* memory, size_t) noexcept { TrackedFree(memory, 0); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory, 0); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory, 0); }
+void operator delete(void* memory, std::align_val_t alignment) noexcept { TrackedFree(memory, (size_t)alignment); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { TrackedFree(memory, (size_t)alignment); }
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept { TrackedFree(memory, (size_t)alignment); }
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept { TrackedFree(memory, (size_t)alignment); }
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedFree(memory, (size_t)alignment); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedFree(memory, (size_t)alignment); }
+
+#endif
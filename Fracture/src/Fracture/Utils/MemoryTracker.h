@@ -0,0 +1,224 @@
+#pragma once
+/*!
+* @file MemoryTracker.h
+* @brief Contains the MemoryTracker that attributes heap allocations to tags, profiler scopes and call sites.
+*
+* @details Tracking is opt-in. When the engine is built with FR_TRACK_ALLOCATIONS (premake5 --track-allocations) the global operator new and delete are replaced
+* and every allocation is recorded with:
+* - the MemoryTag set by the innermost FR_MEMORY_TAG on the thread,
+* - the innermost FR_PROFILE_SCOPE on the thread,
+* - the return address of operator new as the call site.
+*
+* Usage:
+*
+* {
+*     FR_MEMORY_TAG(Renderer); // Allocations in this scope are counted as Renderer allocations
+*     // Code
+* }
+*
+* Without FR_TRACK_ALLOCATIONS the macro is empty, IsEnabled returns false and the queries return zeros.
+*
+* @see PerformanceLayer
+*
+* @author Aditya Rajagopal
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Fracture\Utils\FrameStats.h"
+
+namespace Fracture {
+	namespace Utils {
+
+		/// The subsystems allocations are attributed to.
+		enum class MemoryTag : uint8_t
+		{
+			Untagged = 0, Renderer, Assets, Events,
+			Count
+		};
+
+		/*!
+		* @brief Static service that records the heap allocations of the program when FR_TRACK_ALLOCATIONS is defined.
+		*
+		* @details The hooks only use fixed size tables guarded by a spinlock, so they never allocate themselves. Every allocation carries a 16 byte header
+		* with its size, tag, scope and call site so frees can be attributed without a lookup.
+		* The scope and call site tables have a fixed number of slots; once they are full new scopes and call sites are merged into an overflow slot.
+		*/
+		class MemoryTracker
+		{
+		public:
+			/// The totals of a tag, a scope or a call site.
+			struct Totals
+			{
+				uint64_t LiveBytes = 0; /// The bytes currently allocated.
+				uint64_t LiveCount = 0; /// The number of allocations currently alive.
+				uint64_t TotalBytes = 0; /// The bytes allocated since the start of the program.
+				uint64_t TotalCount = 0; /// The number of allocations since the start of the program.
+			};
+
+			/// The totals of a profiler scope.
+			struct ScopeTotals
+			{
+				const char* Name = nullptr; /// The name of the scope. nullptr for allocations outside of any scope.
+				Totals Stats; /// The totals of the scope.
+			};
+
+			/// The totals of a call site.
+			struct CallSiteTotals
+			{
+				uintptr_t Address = 0; /// The return address of operator new.
+				Totals Stats; /// The totals of the call site.
+			};
+
+			/// The allocations of the last finished frame.
+			struct FrameTotals
+			{
+				uint64_t Count = 0; /// The number of allocations.
+				uint64_t Bytes = 0; /// The bytes allocated.
+				uint64_t Frees = 0; /// The number of frees.
+			};
+
+			/*!
+			* @brief Returns whether the engine was built with FR_TRACK_ALLOCATIONS.
+			*/
+			static constexpr bool IsEnabled()
+			{
+#ifdef FR_TRACK_ALLOCATIONS
+				return true;
+#else
+				return false;
+#endif
+			}
+
+			/*!
+			* @brief Records an allocation. Called by the operator new replacements.
+			*
+			* @param[in] size_t size: The requested size.
+			* @param[in] uintptr_t callSite: The return address of operator new.
+			* @param[out] uint16_t& scopeSlot: The slot of the scope the allocation was attributed to, stored in the allocation header.
+			* @param[out] uint16_t& callSiteSlot: The slot of the call site, stored in the allocation header.
+			* @param[out] MemoryTag& tag: The tag of the allocation, stored in the allocation header.
+			*/
+			static void OnAllocate(size_t size, uintptr_t callSite, uint16_t& scopeSlot, uint16_t& callSiteSlot, MemoryTag& tag);
+
+			/*!
+			* @brief Records a free. Called by the operator delete replacements with the values stored in the allocation header.
+			*/
+			static void OnFree(size_t size, uint16_t scopeSlot, uint16_t callSiteSlot, MemoryTag tag);
+
+			/*!
+			* @brief Finishes the frame: stores the allocation counts of the frame and writes them and the live bytes as counters to the profiler. Called once per frame by the Application.
+			*/
+			static void EndFrame();
+
+			/*!
+			* @brief Returns the totals of all allocations.
+			*/
+			static Totals GetTotals();
+
+			/*!
+			* @brief Returns the totals of a tag.
+			*/
+			static Totals GetTagTotals(MemoryTag tag);
+
+			/*!
+			* @brief Returns the allocations of the last finished frame.
+			*/
+			static FrameTotals GetLastFrame();
+
+			/*!
+			* @brief Returns the history of the number of allocations per frame.
+			*/
+			static const StatHistory& GetFrameCountHistory();
+
+			/*!
+			* @brief Returns the history of the bytes allocated per frame.
+			*/
+			static const StatHistory& GetFrameBytesHistory();
+
+			/*!
+			* @brief Returns the scopes sorted by the bytes allocated since the start of the program.
+			*
+			* @param[in] size_t count: The maximum number of scopes to return.
+			*/
+			static std::vector<ScopeTotals> GetTopScopes(size_t count);
+
+			/*!
+			* @brief Returns the call sites sorted by the bytes allocated since the start of the program.
+			*
+			* @param[in] size_t count: The maximum number of call sites to return.
+			*/
+			static std::vector<CallSiteTotals> GetTopCallSites(size_t count);
+
+			/*!
+			* @brief Returns the function, file and line of a call site, or its address if the debug symbols are not available.
+			*/
+			static std::string DescribeCallSite(uintptr_t address);
+
+			/*!
+			* @brief Logs the totals, the tags and the top call sites.
+			*
+			* @param[in] size_t count: The number of call sites to log.
+			*/
+			static void LogReport(size_t count = 10);
+
+			/*!
+			* @brief Writes the top call sites to the profile session as counters named after the call site, with the bytes allocated there as the value.
+			*
+			* @details Meant for the end of a session, next to LogReport. The names are kept for the lifetime of the program, as the profiler requires.
+			*
+			* @param[in] size_t count: The number of call sites to write.
+			*/
+			static void WriteTopCallSites(size_t count = 10);
+
+			static const char* GetTagName(MemoryTag tag);
+
+			/*!
+			* @brief Returns the current tag of the calling thread.
+			*/
+			inline static MemoryTag& CurrentTag()
+			{
+				thread_local MemoryTag t_Tag = MemoryTag::Untagged;
+				return t_Tag;
+			}
+
+			/*!
+			* @brief Returns the innermost profiler scope of the calling thread. Maintained by InstrumentationTimer when tracking is enabled.
+			*/
+			inline static const char*& CurrentScope()
+			{
+				thread_local const char* t_Scope = nullptr;
+				return t_Scope;
+			}
+		};
+
+		/*!
+		* @brief RAII helper that sets the MemoryTag of the calling thread for the scope it lives in.
+		*/
+		class MemoryTagScope
+		{
+		public:
+			MemoryTagScope(MemoryTag tag)
+				: m_Previous(MemoryTracker::CurrentTag())
+			{
+				MemoryTracker::CurrentTag() = tag;
+			}
+
+			~MemoryTagScope()
+			{
+				MemoryTracker::CurrentTag() = m_Previous;
+			}
+		private:
+			MemoryTag m_Previous; /// The tag to restore.
+		};
+	}
+}
+
+#ifdef FR_TRACK_ALLOCATIONS
+	#define FR_MEMORY_TAG(tag) ::Fracture::Utils::MemoryTagScope FR_PROFILE_CONCAT(fr_memory_tag_, __LINE__)(::Fracture::Utils::MemoryTag::tag)
+#else
+	#define FR_MEMORY_TAG(tag)
+#endif
@@ -0,0 +1,166 @@
+#pragma once
+/*!
+* @file TraceFormat.h
+* @brief Contains the layout of the binary .frtrace files written by the Instrumentor and the helpers to encode and decode them.
+*
+* @details The header only depends on the standard library so tools can read traces without linking the engine.
+*
+* A trace is the FileHeader followed by a stream of chunks. Every chunk starts with a ChunkHeader that gives its type and payload size, so readers can skip chunks they do not know.
+* - Info: the tick calibration and the session name. Written once, before the first Events chunk.
+* - Strings: scope names interned since the previous Strings chunk as (varint id, varint length, bytes).
+* - Events: a block of events of one thread as (varint thread id, varint count) followed by one record per event:
+*   (varint EncodeEventHeader(name id, type, has argument), zigzag varint start delta, [varint duration if the type is Scope], [varint argument name id, zigzag varint argument value if it has one]).
+*   The start of the first event is relative to the session start and every other start is relative to the previous one. Starts are not sorted (a parent scope ends after its children) hence the zigzag encoding.
+*   Version 1 files store only (varint name id, zigzag varint start delta, varint duration), every event being a Scope without an argument.
+* - End: (varint event count, varint dropped count). Missing if the application did not end the session.
+*
+* @see Instrumentor
+*
+* @author Aditya Rajagopal
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace Fracture {
+	namespace Utils {
+		namespace TraceFormat {
+
+			static constexpr char Magic[8] = { 'F', 'R', 'T', 'R', 'A', 'C', 'E', '\0' }; /// The first bytes of every trace file.
+			static constexpr uint32_t Version = 2; /// The version of the format written by this build.
+			static constexpr const char* Extension = ".frtrace"; /// Profile files with this extension are written in the binary format.
+
+			/// The header at the start of the file.
+			struct FileHeader
+			{
+				char Magic[8]; /// Always TraceFormat::Magic.
+				uint32_t Version; /// The version of the format.
+				uint32_t Reserved; /// Padding, always 0.
+			};
+
+			/// The types of the chunks in the file.
+			enum class ChunkType : uint32_t
+			{
+				Info = 1, Strings = 2, Events = 3, End = 4
+			};
+
+			/// The header in front of every chunk.
+			struct ChunkHeader
+			{
+				ChunkType Type; /// The type of the chunk.
+				uint32_t Size; /// The size of the payload following the header in bytes.
+			};
+
+			/// The kinds of events.
+			enum class EventType : uint8_t
+			{
+				Scope = 0,		/// A timed scope with a start and a duration.
+				FrameBegin = 1,	/// An instant marking the start of a frame. The argument is the frame index.
+				FrameEnd = 2,	/// An instant marking the end of a frame. The argument is the frame index.
+				Counter = 3		/// The value of a counter at an instant. The argument is the value.
+			};
+
+			/// Packs the name id, the event type and whether the event has an argument into the first varint of an event record.
+			inline uint64_t EncodeEventHeader(uint32_t nameID, EventType type, bool hasArgument)
+			{
+				return ((uint64_t)nameID << 3) | ((uint64_t)type << 1) | (hasArgument ? 1 : 0);
+			}
+
+			inline uint32_t GetEventHeaderName(uint64_t header) { return (uint32_t)(header >> 3); }
+			inline EventType GetEventHeaderType(uint64_t header) { return (EventType)((header >> 1) & 0x3); }
+			inline bool GetEventHeaderHasArgument(uint64_t header) { return header & 1; }
+
+			/// The fixed part of the Info chunk. Followed by the session name as a varint length and the bytes.
+			struct InfoChunk
+			{
+				double MicrosecondsPerTick; /// The length of a timestamp tick.
+				uint64_t StartTicks; /// The timestamp the event times are relative to.
+			};
+
+			inline void WriteVarint(std::string& out, uint64_t value)
+			{
+				while (value >= 0x80)
+				{
+					out += (char)((value & 0x7F) | 0x80);
+					value >>= 7;
+				}
+				out += (char)value;
+			}
+
+			inline uint64_t ZigZagEncode(int64_t value) { return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63); }
+			inline int64_t ZigZagDecode(uint64_t value) { return (int64_t)(value >> 1) ^ -(int64_t)(value & 1); }
+
+			/// Appends the raw bytes of a POD value.
+			template<typename T>
+			inline void WriteRaw(std::string& out, const T& value)
+			{
+				out.append((const char*)&value, sizeof(T));
+			}
+
+			/*!
+			* @brief Cursor over a chunk payload. Reads past the end set the error flag and return 0 instead of reading out of bounds.
+			*/
+			class Reader
+			{
+			public:
+				Reader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+				uint64_t ReadVarint()
+				{
+					uint64_t result = 0;
+					for (int shift = 0; shift < 64; shift += 7)
+					{
+						if (m_Offset >= m_Size)
+						{
+							m_Error = true;
+							return 0;
+						}
+						uint8_t byte = m_Data[m_Offset++];
+						result |= (uint64_t)(byte & 0x7F) << shift;
+						if (!(byte & 0x80))
+							return result;
+					}
+					m_Error = true;
+					return result;
+				}
+
+				template<typename T>
+				T ReadRaw()
+				{
+					T value = {};
+					if (m_Offset + sizeof(T) > m_Size)
+					{
+						m_Error = true;
+						return value;
+					}
+					memcpy(&value, m_Data + m_Offset, sizeof(T));
+					m_Offset += sizeof(T);
+					return value;
+				}
+
+				std::string ReadString()
+				{
+					uint64_t length = ReadVarint();
+					if (m_Error || m_Offset + length > m_Size)
+					{
+						m_Error = true;
+						return std::string();
+					}
+					std::string result((const char*)m_Data + m_Offset, (size_t)length);
+					m_Offset += (size_t)length;
+					return result;
+				}
+
+				inline bool AtEnd() const { return m_Offset >= m_Size; }
+				inline bool HasError() const { return m_Error; }
+			private:
+				const uint8_t* m_Data; /// The payload.
+				size_t m_Size; /// The size of the payload.
+				size_t m_Offset = 0; /// The read position.
+				bool m_Error = false; /// Set when a read went past the end of the payload.
+			};
+
+		}
+	}
+}
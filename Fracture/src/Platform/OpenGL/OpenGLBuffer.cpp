@@ -1,6 +1,9 @@
 #include "frpch.h"
 #include "OpenGLBuffer.h"
 
+#include "Fracture/Utils/FrameStats.h"
+#include "Platform/OpenGL/OpenGLState.h"
+
 #include <glad/glad.h>
 
 namespace Fracture {
@@ -14,17 +17,20 @@ namespace Fracture {
 		m_RendererID(0)
 	{
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		OpenGLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		SetData((void*)vertices, size);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
+		OpenGLState::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		OpenGLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID); // glBufferData writes to the bound buffer. Skipped by the state cache when it already is
 		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);// copy the vertex data into the buffer's memory by calling glBufferData with the vertex buffer object bound to GL_ARRAY_BUFFER. The fourth argument specifies how we want the graphics card to manage the given data. We have 3 options:
 																					// GL_STATIC_DRAW: the data will most likely not change at all or very rarely.
 																					// GL_DYNAMIC_DRAW: the data is likely to change a lot.
@@ -32,14 +38,20 @@ namespace Fracture {
 																					// We want to draw the triangle only once, so we'll use GL_STATIC_DRAW.
 	}
 
+	void OpenGLVertexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset)
+	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
 	void OpenGLVertexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		OpenGLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLState::BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 
@@ -55,28 +67,71 @@ namespace Fracture {
 		// We bind the buffer to GL_ARRAY_BUFFER instead of GL_ELEMENT_ARRAY_BUFFER because  when we want to upload teh data we want to bind the buffer to GL_ARRAY_BUFFER like any other buffer. 
 		// We can then call glBufferData with the index buffer object bound to GL_ARRAY_BUFFER. This will upload the data to the currently bound buffer. 
 		// We only need to bind to GL_ELEMENT_ARRAY_BUFFER when we want to draw something. This means that we can just bind the index buffer before we want to draw something and it will be used. This will tell openGL that the current buffer i am binding is an index buffer.
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		OpenGLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		SetData((void*)indices, count * sizeof(uint32_t));
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
+		OpenGLState::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::SetData(const void* data, uint32_t size)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		OpenGLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererID); // glBufferData writes to the bound buffer. Skipped by the state cache when it already is
 		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW); // copy the index data into the buffer's memory by calling glBufferData with the index buffer object bound to GL_ELEMENT_ARRAY_BUFFER. We use GL_STATIC_DRAW because the index data will not change.
 	}
 
+	void OpenGLIndexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset)
+	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
 	void OpenGLIndexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		OpenGLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		OpenGLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// StorageBuffer //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size):
+		m_RendererID(0), m_Size(size)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW); // GL_DYNAMIC_DRAW because the contents are usually rewritten every frame
+	}
+
+	OpenGLStorageBuffer::~OpenGLStorageBuffer()
+	{
+		OpenGLState::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLStorageBuffer::SetData(const void* data, uint32_t size)
+	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		if (size > m_Size)
+		{
+			m_Size = std::max(size, m_Size * 2);
+			glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+		}
+		glNamedBufferSubData(m_RendererID, 0, size, data);
+	}
+
+	void OpenGLStorageBuffer::Bind(uint32_t binding) const
+	{
+		OpenGLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
 	}
 
 }
\ No newline at end of file
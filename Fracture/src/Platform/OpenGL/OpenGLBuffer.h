@@ -50,6 +50,11 @@ namespace Fracture {
 		*/
 		virtual void SetData(const void* data, uint32_t size) override;
 
+		/*!
+		* @brief Overwrites part of the vertex buffer with glNamedBufferSubData. The buffer keeps its storage.
+		*/
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) override;
+
 		/*!
 		* @brief Function that sets the layout of the vertex buffer. This is needed to be used to draw.
 		* 
@@ -89,6 +94,7 @@ namespace Fracture {
 		~OpenGLIndexBuffer();
 
 		virtual void SetData(const void* data, uint32_t size) override;
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) override;
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
@@ -100,4 +106,36 @@ namespace Fracture {
 		uint32_t m_Count;
 	};
 
+	/*!
+	* @brief Implementation of the StorageBuffer class for OpenGL. A GL_SHADER_STORAGE_BUFFER read by the shaders through a buffer block.
+	* 
+	* @see StorageBuffer
+	*/
+	class OpenGLStorageBuffer : public StorageBuffer
+	{
+	public:
+		/*!
+		* @brief Constructor for the OpenGLStorageBuffer class. Allocates the storage without initialising it.
+		* 
+		* @param[in] uint32_t size: The initial size of the buffer in bytes.
+		*/
+		OpenGLStorageBuffer(uint32_t size);
+		~OpenGLStorageBuffer();
+
+		/*!
+		* @brief Uploads the data with glNamedBufferSubData, reallocating the storage first if it is too small.
+		*/
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		/*!
+		* @brief Binds the buffer with glBindBufferBase to the GL_SHADER_STORAGE_BUFFER binding point.
+		*/
+		virtual void Bind(uint32_t binding) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_RendererID; /// The handle to the buffer.
+		uint32_t m_Size; /// The size of the storage in bytes.
+	};
+
 }
\ No newline at end of file
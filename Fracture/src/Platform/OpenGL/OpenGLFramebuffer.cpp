@@ -0,0 +1,238 @@
+#include "frpch.h"
+#include "OpenGLFramebuffer.h"
+
+#include "Platform/OpenGL/OpenGLState.h"
+
+#include <glad/glad.h>
+
+namespace Fracture {
+
+	namespace {
+
+		constexpr uint32_t MaxFramebufferSize = 8192; /// The largest size accepted by Resize. Larger requests are a bug, not a render target.
+
+		GLenum ToInternalFormat(FramebufferFormat format)
+		{
+			switch (format)
+			{
+			case FramebufferFormat::RGBA8: return GL_RGBA8;
+			case FramebufferFormat::RGBA16F: return GL_RGBA16F;
+			case FramebufferFormat::Depth24Stencil8: return GL_DEPTH24_STENCIL8;
+			default: break;
+			}
+			FR_CORE_ASSERT(false, "Unknown framebuffer format!");
+			return 0;
+		}
+
+		GLenum ToFilter(FramebufferFilter filter)
+		{
+			return filter == FramebufferFilter::Linear ? GL_LINEAR : GL_NEAREST;
+		}
+
+		uint32_t CreateRenderbuffer(FramebufferFormat format, uint32_t samples, uint32_t width, uint32_t height)
+		{
+			uint32_t renderbuffer = 0;
+			glCreateRenderbuffers(1, &renderbuffer);
+			if (samples > 1)
+				glNamedRenderbufferStorageMultisample(renderbuffer, samples, ToInternalFormat(format), width, height);
+			else
+				glNamedRenderbufferStorage(renderbuffer, ToInternalFormat(format), width, height);
+			return renderbuffer;
+		}
+
+		uint32_t CreateTexture(FramebufferFormat format, uint32_t width, uint32_t height)
+		{
+			uint32_t texture = 0;
+			glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+			glTextureStorage2D(texture, 1, ToInternalFormat(format), width, height);
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			return texture;
+		}
+
+		/// Sends the fragment shader outputs to the colour attachments in order.
+		void SetDrawBuffers(uint32_t framebuffer, uint32_t count)
+		{
+			if (count == 0)
+			{
+				glNamedFramebufferDrawBuffer(framebuffer, GL_NONE); // Depth only
+				return;
+			}
+
+			std::vector<GLenum> buffers(count);
+			for (uint32_t i = 0; i < count; i++)
+				buffers[i] = GL_COLOR_ATTACHMENT0 + i;
+			glNamedFramebufferDrawBuffers(framebuffer, (GLsizei)count, buffers.data());
+		}
+
+	}
+
+	OpenGLFramebuffer::OpenGLFramebuffer(const FramebufferSpecification& specification) :
+		m_Specification(specification)
+	{
+		Invalidate();
+	}
+
+	OpenGLFramebuffer::~OpenGLFramebuffer()
+	{
+		Release();
+	}
+
+	void OpenGLFramebuffer::Release()
+	{
+		if (m_RendererID != 0)
+		{
+			OpenGLState::OnFramebufferDeleted(m_RendererID);
+			glDeleteFramebuffers(1, &m_RendererID);
+		}
+		if (m_ResolveID != 0)
+		{
+			OpenGLState::OnFramebufferDeleted(m_ResolveID);
+			glDeleteFramebuffers(1, &m_ResolveID);
+		}
+		for (uint32_t texture : m_ColorTextures)
+			OpenGLState::OnTextureDeleted(texture);
+		glDeleteTextures((GLsizei)m_ColorTextures.size(), m_ColorTextures.data());
+		glDeleteRenderbuffers((GLsizei)m_ColorRenderbuffers.size(), m_ColorRenderbuffers.data());
+		if (m_DepthRenderbuffer != 0)
+			glDeleteRenderbuffers(1, &m_DepthRenderbuffer);
+
+		m_RendererID = m_ResolveID = m_DepthRenderbuffer = 0;
+		m_ColorTextures.clear();
+		m_ColorRenderbuffers.clear();
+	}
+
+	void OpenGLFramebuffer::Invalidate()
+	{
+		FR_PROFILE_FUNCTION();
+		Release();
+
+		FramebufferSpecification& spec = m_Specification;
+		GLint maxSamples = 1;
+		glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+		if (spec.Samples > (uint32_t)maxSamples)
+		{
+			FR_CORE_WARN("{0} MSAA samples requested, the GPU supports {1}", spec.Samples, maxSamples);
+			spec.Samples = (uint32_t)maxSamples;
+		}
+		spec.Samples = std::max(spec.Samples, 1u);
+		bool multisampled = spec.Samples > 1;
+		uint32_t colorCount = (uint32_t)spec.ColorAttachments.size();
+
+		glCreateFramebuffers(1, &m_RendererID);
+		if (multisampled)
+			glCreateFramebuffers(1, &m_ResolveID);
+
+		for (uint32_t i = 0; i < colorCount; i++)
+		{
+			uint32_t texture = CreateTexture(spec.ColorAttachments[i], spec.Width, spec.Height);
+			m_ColorTextures.push_back(texture);
+			if (multisampled)
+			{
+				uint32_t renderbuffer = CreateRenderbuffer(spec.ColorAttachments[i], spec.Samples, spec.Width, spec.Height);
+				m_ColorRenderbuffers.push_back(renderbuffer);
+				glNamedFramebufferRenderbuffer(m_RendererID, GL_COLOR_ATTACHMENT0 + i, GL_RENDERBUFFER, renderbuffer);
+				glNamedFramebufferTexture(m_ResolveID, GL_COLOR_ATTACHMENT0 + i, texture, 0);
+			}
+			else
+			{
+				glNamedFramebufferTexture(m_RendererID, GL_COLOR_ATTACHMENT0 + i, texture, 0);
+			}
+		}
+
+		if (spec.DepthAttachment != FramebufferFormat::None)
+		{
+			m_DepthRenderbuffer = CreateRenderbuffer(spec.DepthAttachment, spec.Samples, spec.Width, spec.Height);
+			glNamedFramebufferRenderbuffer(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthRenderbuffer);
+		}
+
+		SetDrawBuffers(m_RendererID, colorCount);
+		FR_CORE_ASSERT(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
+		if (multisampled)
+		{
+			SetDrawBuffers(m_ResolveID, colorCount);
+			FR_CORE_ASSERT(glCheckNamedFramebufferStatus(m_ResolveID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Resolve framebuffer is incomplete!");
+		}
+		m_NeedsResolve = false;
+	}
+
+	void OpenGLFramebuffer::Bind()
+	{
+		m_SavedViewport = OpenGLState::GetViewport();
+		OpenGLState::BindFramebuffer(m_RendererID);
+		OpenGLState::Viewport(0, 0, m_Specification.Width, m_Specification.Height);
+		m_NeedsResolve = m_ResolveID != 0;
+	}
+
+	void OpenGLFramebuffer::Unbind()
+	{
+		OpenGLState::BindFramebuffer(0);
+		OpenGLState::Viewport(m_SavedViewport.x, m_SavedViewport.y, m_SavedViewport.z, m_SavedViewport.w);
+	}
+
+	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0 || (width == m_Specification.Width && height == m_Specification.Height))
+			return;
+		if (width > MaxFramebufferSize || height > MaxFramebufferSize)
+		{
+			FR_CORE_WARN("Framebuffer size {0}x{1} is too large", width, height);
+			return;
+		}
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+		Invalidate();
+	}
+
+	void OpenGLFramebuffer::Resolve()
+	{
+		if (!m_NeedsResolve)
+			return;
+
+		FR_PROFILE_FUNCTION();
+		int32_t width = (int32_t)m_Specification.Width, height = (int32_t)m_Specification.Height;
+		for (uint32_t i = 0; i < (uint32_t)m_ColorTextures.size(); i++)
+		{
+			// Multisampled blits copy one attachment at a time, between rectangles of the same size
+			glNamedFramebufferReadBuffer(m_RendererID, GL_COLOR_ATTACHMENT0 + i);
+			glNamedFramebufferDrawBuffer(m_ResolveID, GL_COLOR_ATTACHMENT0 + i);
+			glBlitNamedFramebuffer(m_RendererID, m_ResolveID, 0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		}
+		glNamedFramebufferReadBuffer(m_RendererID, GL_COLOR_ATTACHMENT0);
+		m_NeedsResolve = false;
+	}
+
+	void OpenGLFramebuffer::BindColorAttachment(uint32_t index, uint32_t slot)
+	{
+		FR_CORE_ASSERT(index < m_ColorTextures.size(), "Framebuffer has no colour attachment {0}", index);
+		Resolve();
+		OpenGLState::BindTextureUnit(slot, m_ColorTextures[index]);
+	}
+
+	void OpenGLFramebuffer::BlitTo(uint32_t framebuffer, int32_t x, int32_t y, int32_t width, int32_t height, FramebufferFilter filter)
+	{
+		FR_PROFILE_FUNCTION();
+		FR_CORE_ASSERT(!m_ColorTextures.empty(), "Framebuffer has no colour attachment to blit");
+		Resolve();
+
+		uint32_t source = GetReadFramebuffer();
+		glNamedFramebufferReadBuffer(source, GL_COLOR_ATTACHMENT0);
+		glBlitNamedFramebuffer(source, framebuffer, 0, 0, (int32_t)m_Specification.Width, (int32_t)m_Specification.Height, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, ToFilter(filter));
+	}
+
+	void OpenGLFramebuffer::Blit(Framebuffer& target, FramebufferFilter filter)
+	{
+		OpenGLFramebuffer& destination = static_cast<OpenGLFramebuffer&>(target);
+		FR_CORE_ASSERT(destination.m_Specification.Samples == 1, "Can not blit into a multisampled framebuffer");
+		BlitTo(destination.m_RendererID, 0, 0, (int32_t)destination.m_Specification.Width, (int32_t)destination.m_Specification.Height, filter);
+	}
+
+	void OpenGLFramebuffer::BlitToScreen(uint32_t x, uint32_t y, uint32_t width, uint32_t height, FramebufferFilter filter)
+	{
+		BlitTo(0, (int32_t)x, (int32_t)y, (int32_t)width, (int32_t)height, filter);
+	}
+
+}
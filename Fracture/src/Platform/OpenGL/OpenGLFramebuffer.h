@@ -0,0 +1,75 @@
+#pragma once
+/*!
+* @file OpenGLFramebuffer.h
+* @brief contains the OpenGL implementation of the Framebuffer class
+*
+* @see Framebuffer
+*
+* @author Aditya Rajagopal
+*/
+#include "Fracture/Core/Core.h"
+#include "Fracture/Renderer/Framebuffer.h"
+
+#include <glm/glm.hpp>
+
+namespace Fracture
+{
+	/*!
+	* @brief OpenGL implementation of the Framebuffer class
+	*
+	* @details A single sampled framebuffer has textures as colour attachments. A multisampled one renders into multisampled renderbuffers and owns a second
+	* framebuffer with the single sampled textures, which Resolve blits into. The depth attachment is a renderbuffer since it is never sampled.
+	* Blits use the direct state access functions, so they do not change the framebuffer binding.
+	*/
+	class OpenGLFramebuffer : public Framebuffer
+	{
+	public:
+		/*!
+		* @brief Constructor for the OpenGLFramebuffer class that creates the attachments of the specification.
+		*
+		* @param[in] const FramebufferSpecification& specification: The size, attachments and sample count of the framebuffer.
+		*/
+		OpenGLFramebuffer(const FramebufferSpecification& specification);
+		virtual ~OpenGLFramebuffer();
+
+		virtual void Bind() override;
+		virtual void Unbind() override;
+		virtual void Resize(uint32_t width, uint32_t height) override;
+		virtual void Resolve() override;
+		virtual void BindColorAttachment(uint32_t index = 0, uint32_t slot = 0) override;
+		virtual uint32_t GetColorAttachmentHandle(uint32_t index = 0) const override { return m_ColorTextures[index]; }
+		virtual void Blit(Framebuffer& target, FramebufferFilter filter = FramebufferFilter::Linear) override;
+		virtual void BlitToScreen(uint32_t x, uint32_t y, uint32_t width, uint32_t height, FramebufferFilter filter = FramebufferFilter::Linear) override;
+		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		/*!
+		* @brief Deletes the attachments and creates them again from m_Specification.
+		*/
+		void Invalidate();
+
+		/*!
+		* @brief Deletes the framebuffers and their attachments.
+		*/
+		void Release();
+
+		/*!
+		* @brief Returns the framebuffer that holds the single sampled textures, the one blits read from.
+		*/
+		inline uint32_t GetReadFramebuffer() const { return m_ResolveID != 0 ? m_ResolveID : m_RendererID; }
+
+		/*!
+		* @brief Copies the first colour attachment into a rectangle of another framebuffer, 0 for the window.
+		*/
+		void BlitTo(uint32_t framebuffer, int32_t x, int32_t y, int32_t width, int32_t height, FramebufferFilter filter);
+	private:
+		FramebufferSpecification m_Specification; /// The size, attachments and sample count.
+		uint32_t m_RendererID = 0; /// The handle of the framebuffer drawn into.
+		uint32_t m_ResolveID = 0; /// The handle of the framebuffer holding the resolved textures. 0 when not multisampled.
+		std::vector<uint32_t> m_ColorRenderbuffers; /// The multisampled colour attachments. Empty when not multisampled.
+		std::vector<uint32_t> m_ColorTextures; /// The single sampled colour textures.
+		uint32_t m_DepthRenderbuffer = 0; /// The depth attachment, 0 when there is none.
+		glm::ivec4 m_SavedViewport = glm::ivec4(0); /// The viewport replaced by Bind, restored by Unbind.
+		bool m_NeedsResolve = false; /// Set when the multisampled attachments were rendered into since the last resolve.
+	};
+
+}
@@ -1,6 +1,8 @@
 #include "frpch.h"
 #include "OpenGLRendererAPI.h"
 
+#include "Platform/OpenGL/OpenGLState.h"
+
 #include <glad/glad.h>
 
 namespace Fracture {
@@ -12,17 +14,22 @@ namespace Fracture {
 
 	OpenGLRendererAPI::~OpenGLRendererAPI()
 	{
+		if (m_IndirectBuffer)
+		{
+			OpenGLState::OnBufferDeleted(m_IndirectBuffer);
+			glDeleteBuffers(1, &m_IndirectBuffer);
+		}
 	}
 
 	void OpenGLRendererAPI::Init()
 	{
 		// Enable blending
-		glEnable(GL_BLEND);
+		OpenGLState::SetCapability(GL_BLEND, true);
 
 		// Set the blend function to use alpha blending. Here the first parameter specifies the source factor and the second parameter specifies the destination factor. The source factor specifies how the source color (the color of the fragment that is being rendered) is combined with the destination color (the color that is already in the framebuffer). The destination factor specifies how the destination color is combined with the source color.
 		// The possible factors are GL_ZERO, GL_ONE, GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR, GL_DST_COLOR, GL_ONE_MINUS_DST_COLOR, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_CONSTANT_COLOR, GL_ONE_MINUS_CONSTANT_COLOR, GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA, and GL_SRC_ALPHA_SATURATE.
 		// We use GL_SRC_ALPHA and GL_ONE_MINUS_SRC_ALPHA as the source and destination factors respectively. This means that we take the alpha value of the source fragment (the texture we try to draw) and multiply it by its color. Then we take 1.0 - alpha for the destination fragment (the color that is already in the framebuffer) and multiply it by the color of the source fragment. The result is then added together to form the final color.
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		OpenGLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		// Enable depth testing
 		//glEnable(GL_DEPTH_TEST);
@@ -37,12 +44,12 @@ namespace Fracture {
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
 	{
-		glClearColor(color.r, color.g, color.b, color.a);
+		OpenGLState::ClearColor(color);
 	}
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		OpenGLState::Viewport(x, y, width, height);
 	}
 
 	void OpenGLRendererAPI::Clear()
@@ -62,4 +69,46 @@ namespace Fracture {
 		// This is because we bound the index buffer to the vertex array object. This also means that we don't need to bind the index buffer every time we want to draw something. As long as we have the vertex array object bound we can just call glDrawElements and OpenGL will know which index buffer to use.
 	}
 
+	void OpenGLRendererAPI::DrawIndexedRange(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
+	{
+		// The pointer argument is the byte offset of the first index into the bound index buffer
+		glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (const void*)(uintptr_t)(firstIndex * sizeof(uint32_t)), baseVertex);
+	}
+
+	void OpenGLRendererAPI::DrawIndexedIndirect(const DrawIndexedIndirectCommand& command)
+	{
+		UploadIndirectCommands(&command, 1);
+		glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr);
+	}
+
+	void OpenGLRendererAPI::MultiDrawIndexedIndirect(const DrawIndexedIndirectCommand* commands, uint32_t drawCount)
+	{
+		if (drawCount == 0)
+			return;
+
+		// Every command is read by the GPU, so the whole list is one call
+		UploadIndirectCommands(commands, drawCount);
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, drawCount, 0);
+	}
+
+	void OpenGLRendererAPI::UploadIndirectCommands(const DrawIndexedIndirectCommand* commands, uint32_t drawCount)
+	{
+		uint32_t size = drawCount * sizeof(DrawIndexedIndirectCommand);
+		if (size > m_IndirectBufferSize)
+		{
+			if (m_IndirectBuffer)
+			{
+				OpenGLState::OnBufferDeleted(m_IndirectBuffer);
+				glDeleteBuffers(1, &m_IndirectBuffer);
+			}
+			m_IndirectBufferSize = std::max(size, m_IndirectBufferSize * 2);
+			glCreateBuffers(1, &m_IndirectBuffer);
+			glNamedBufferData(m_IndirectBuffer, m_IndirectBufferSize, nullptr, GL_STREAM_DRAW); // GL_STREAM_DRAW because the commands are rewritten for every indirect draw
+		}
+		glNamedBufferSubData(m_IndirectBuffer, 0, size, commands);
+
+		// With a buffer bound to GL_DRAW_INDIRECT_BUFFER the pointer argument of the indirect draws is an offset into it
+		OpenGLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+	}
+
 }
\ No newline at end of file
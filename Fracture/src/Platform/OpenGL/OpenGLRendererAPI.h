@@ -77,6 +77,29 @@ namespace Fracture {
 		* 
 		*/
 		virtual void DrawIndexed(uint32_t indexCount = 0) override;
+		/*!
+		* @brief Function that draws a range of the index buffer of the currently bound vertex array with glDrawElementsBaseVertex.
+		* 
+		* @param[in] uint32_t indexCount: The number of indices to draw.
+		* @param[in] uint32_t firstIndex: The first index to draw.
+		* @param[in] int32_t baseVertex: The value added to every index before fetching the vertex.
+		*/
+		virtual void DrawIndexedRange(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) override;
+		/*!
+		* @brief Function that draws one range of the currently bound vertex array with glDrawElementsIndirect.
+		* 
+		* @param[in] const DrawIndexedIndirectCommand& command: The draw. Uploaded to the same buffer as the multi draw commands.
+		*/
+		virtual void DrawIndexedIndirect(const DrawIndexedIndirectCommand& command) override;
+		/*!
+		* @brief Function that draws many ranges of the currently bound vertex array with glMultiDrawElementsIndirect.
+		* 
+		* @details The commands are uploaded to a GL_DRAW_INDIRECT_BUFFER owned by the renderer API, which grows when needed.
+		* 
+		* @param[in] const DrawIndexedIndirectCommand* commands: The draws.
+		* @param[in] uint32_t drawCount: The number of draws.
+		*/
+		virtual void MultiDrawIndexedIndirect(const DrawIndexedIndirectCommand* commands, uint32_t drawCount) override;
 
 		/*!
 		* @brief Checks if the OpenGLRendererAPI is initialized.
@@ -85,7 +108,14 @@ namespace Fracture {
 		*/
 		virtual bool IsInitialized() const override { return m_IsInitialized; }
 	private:
+		/*!
+		* @brief Uploads the commands to the start of m_IndirectBuffer, growing it when needed, and binds it to GL_DRAW_INDIRECT_BUFFER.
+		*/
+		void UploadIndirectCommands(const DrawIndexedIndirectCommand* commands, uint32_t drawCount);
+
 		bool m_IsInitialized = false; /// Flag to check if the OpenGLRendererAPI is initialized.
+		uint32_t m_IndirectBuffer = 0; /// The handle to the buffer the indirect commands are uploaded to. Created on the first indirect draw.
+		uint32_t m_IndirectBufferSize = 0; /// The size of the indirect buffer in bytes.
 	};
 
 }
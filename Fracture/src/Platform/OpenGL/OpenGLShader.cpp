@@ -2,6 +2,8 @@
 
 #include "OpenGLShader.h"
 #include "Fracture\Renderer\Shader.h"
+#include "Fracture\Utils\FrameStats.h"
+#include "Platform\OpenGL\OpenGLState.h"
 
 #include "glm\gtc\type_ptr.hpp"
 
@@ -195,17 +197,18 @@ namespace Fracture
 
 	OpenGLShader::~OpenGLShader()
 	{
+		OpenGLState::OnProgramDeleted(m_RendererID);
 		glDeleteProgram(m_RendererID);
 	}
 
 	void OpenGLShader::Bind() const
 	{
-		glUseProgram(m_RendererID);
+		OpenGLState::UseProgram(m_RendererID);
 	}
 
 	void OpenGLShader::Unbind() const
 	{
-		glUseProgram(0);
+		OpenGLState::UseProgram(0);
 	}
 
 	void OpenGLShader::SetInt(const std::string& name, int value)
@@ -273,60 +276,70 @@ namespace Fracture
 
 	void OpenGLShader::UploadUniformInt(const std::string& name, int value)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform1iv(uniformLocation, 1, &value);
 	}
 
 	void OpenGLShader::UploadUniformInt2(const std::string& name, const glm::ivec2& values)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform2iv(uniformLocation, 1, glm::value_ptr(values));
 	}
 
 	void OpenGLShader::UploadUniformInt3(const std::string& name, const glm::ivec3& values)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform3iv(uniformLocation, 1, glm::value_ptr(values));
 	}
 
 	void OpenGLShader::UploadUniformInt4(const std::string& name, const glm::ivec4& values)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform4iv(uniformLocation, 1, glm::value_ptr(values));
 	}
 
 	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform1fv(uniformLocation, 1, &value);
 	}
 
 	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& values)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform2fv(uniformLocation, 1, glm::value_ptr(values));
 	}
 
 	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& values)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform3fv(uniformLocation, 1, glm::value_ptr(values));
 	}
 
 	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& values)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform4fv(uniformLocation, 1, glm::value_ptr(values));
 	}
 
 	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniformMatrix3fv(uniformLocation, 1, GL_FALSE, glm::value_ptr(matrix)); // Upload the matrix
 	}
 
 	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniformMatrix4fv(uniformLocation, 1, GL_FALSE, glm::value_ptr(matrix)); // Upload the matrix
 		// TODO: Cache locations
@@ -338,6 +351,7 @@ namespace Fracture
 
 	void OpenGLShader::UploadUniformBool(const std::string& name, bool value)
 	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::UniformUploads);
 		int32_t uniformLocation = GetUniformLocation(name);
 		glUniform1i(uniformLocation, value);
 	}
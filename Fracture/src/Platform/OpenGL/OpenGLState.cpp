@@ -0,0 +1,270 @@
+#include "frpch.h"
+#include "OpenGLState.h"
+
+#include "Fracture/Utils/FrameStats.h"
+
+#include <glad/glad.h>
+
+#include <cmath>
+
+namespace Fracture {
+
+	namespace {
+
+		constexpr uint32_t Unknown = 0xFFFFFFFF; /// The value of a cached binding before it is first set. Never a valid OpenGL name.
+
+		/// The cached buffer targets.
+		enum BufferTarget : uint32_t { ArrayBuffer = 0, ElementArrayBuffer, DrawIndirectBuffer, ShaderStorageBuffer, BufferTargetCount };
+
+		/// The cached capabilities.
+		enum Capability : uint32_t { Blend = 0, DepthTest, ScissorTest, CullFace, CapabilityCount };
+
+		/// The shadow copy of the context state.
+		struct OpenGLStateData
+		{
+			uint32_t Program = Unknown;
+			uint32_t VertexArray = Unknown;
+			uint32_t Buffers[BufferTargetCount];
+			uint32_t StorageBindings[OpenGLState::MaxStorageBindings];
+			uint32_t Textures[OpenGLState::MaxTextureUnits];
+			uint32_t Framebuffer = Unknown;
+			int8_t Capabilities[CapabilityCount]; /// -1 unknown, 0 disabled, 1 enabled.
+			glm::uvec2 BlendFactors; /// The source and destination factors.
+			uint32_t DepthFunction = Unknown;
+			glm::ivec4 ScissorBox;
+			glm::ivec4 ViewportBox;
+			glm::vec4 ClearColour; /// NaN when unknown, which compares unequal to every colour.
+
+			OpenGLStateData() { Reset(); }
+
+			void Reset()
+			{
+				Program = Unknown;
+				VertexArray = Unknown;
+				std::fill(std::begin(Buffers), std::end(Buffers), Unknown);
+				std::fill(std::begin(StorageBindings), std::end(StorageBindings), Unknown);
+				std::fill(std::begin(Textures), std::end(Textures), Unknown);
+				Framebuffer = Unknown;
+				std::fill(std::begin(Capabilities), std::end(Capabilities), (int8_t)-1);
+				BlendFactors = glm::uvec2(Unknown);
+				DepthFunction = Unknown;
+				ScissorBox = ViewportBox = glm::ivec4(-1);
+				ClearColour = glm::vec4(NAN);
+			}
+		};
+
+		OpenGLStateData& GetState()
+		{
+			static OpenGLStateData state;
+			return state;
+		}
+
+		/// Counts the call and returns true when the cached value differs and the call has to be issued.
+		template<typename T>
+		bool Update(T& cached, const T& value)
+		{
+			if (cached == value)
+			{
+				Utils::FrameStats::AddCount(Utils::FrameStats::Metric::GLStateCallsElided);
+				return false;
+			}
+			cached = value;
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::GLStateCalls);
+			return true;
+		}
+
+		uint32_t ToBufferTarget(uint32_t target)
+		{
+			switch (target)
+			{
+			case GL_ARRAY_BUFFER: return ArrayBuffer;
+			case GL_ELEMENT_ARRAY_BUFFER: return ElementArrayBuffer;
+			case GL_DRAW_INDIRECT_BUFFER: return DrawIndirectBuffer;
+			case GL_SHADER_STORAGE_BUFFER: return ShaderStorageBuffer;
+			}
+			return Unknown;
+		}
+
+		uint32_t ToCapability(uint32_t capability)
+		{
+			switch (capability)
+			{
+			case GL_BLEND: return Blend;
+			case GL_DEPTH_TEST: return DepthTest;
+			case GL_SCISSOR_TEST: return ScissorTest;
+			case GL_CULL_FACE: return CullFace;
+			}
+			return Unknown;
+		}
+
+	}
+
+	void OpenGLState::UseProgram(uint32_t program)
+	{
+		if (Update(GetState().Program, program))
+			glUseProgram(program);
+	}
+
+	void OpenGLState::BindVertexArray(uint32_t vertexArray)
+	{
+		OpenGLStateData& state = GetState();
+		if (Update(state.VertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+			state.Buffers[ElementArrayBuffer] = Unknown; // The element array buffer binding is part of the vertex array
+		}
+	}
+
+	void OpenGLState::BindBuffer(uint32_t target, uint32_t buffer)
+	{
+		uint32_t index = ToBufferTarget(target);
+		if (index == Unknown)
+		{
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::GLStateCalls);
+			glBindBuffer(target, buffer);
+			return;
+		}
+		if (Update(GetState().Buffers[index], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void OpenGLState::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer)
+	{
+		OpenGLStateData& state = GetState();
+		if (target != GL_SHADER_STORAGE_BUFFER || index >= MaxStorageBindings)
+		{
+			// Uncached binding points. The generic binding of the target changes too, so forget it
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::GLStateCalls);
+			glBindBufferBase(target, index, buffer);
+			uint32_t generic = ToBufferTarget(target);
+			if (generic != Unknown)
+				state.Buffers[generic] = Unknown;
+			return;
+		}
+		if (Update(state.StorageBindings[index], buffer))
+		{
+			glBindBufferBase(target, index, buffer);
+			state.Buffers[ShaderStorageBuffer] = buffer;
+		}
+	}
+
+	void OpenGLState::BindTextureUnit(uint32_t unit, uint32_t texture)
+	{
+		FR_CORE_ASSERT(unit < MaxTextureUnits, "Texture unit {0} is out of range!", unit);
+		if (Update(GetState().Textures[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void OpenGLState::BindFramebuffer(uint32_t framebuffer)
+	{
+		if (Update(GetState().Framebuffer, framebuffer))
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	}
+
+	void OpenGLState::SetCapability(uint32_t capability, bool enabled)
+	{
+		uint32_t index = ToCapability(capability);
+		if (index == Unknown)
+			Utils::FrameStats::AddCount(Utils::FrameStats::Metric::GLStateCalls);
+		else if (!Update(GetState().Capabilities[index], (int8_t)enabled))
+			return;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	void OpenGLState::BlendFunc(uint32_t source, uint32_t destination)
+	{
+		if (Update(GetState().BlendFactors, glm::uvec2(source, destination)))
+			glBlendFunc(source, destination);
+	}
+
+	void OpenGLState::DepthFunc(uint32_t function)
+	{
+		if (Update(GetState().DepthFunction, function))
+			glDepthFunc(function);
+	}
+
+	void OpenGLState::Scissor(int32_t x, int32_t y, int32_t width, int32_t height)
+	{
+		if (Update(GetState().ScissorBox, glm::ivec4(x, y, width, height)))
+			glScissor(x, y, width, height);
+	}
+
+	void OpenGLState::Viewport(int32_t x, int32_t y, int32_t width, int32_t height)
+	{
+		if (Update(GetState().ViewportBox, glm::ivec4(x, y, width, height)))
+			glViewport(x, y, width, height);
+	}
+
+	glm::ivec4 OpenGLState::GetViewport()
+	{
+		OpenGLStateData& state = GetState();
+		if (state.ViewportBox == glm::ivec4(-1))
+			glGetIntegerv(GL_VIEWPORT, &state.ViewportBox.x); // Forgotten by Invalidate, ImGui sets it behind the cache
+		return state.ViewportBox;
+	}
+
+	void OpenGLState::ClearColor(const glm::vec4& colour)
+	{
+		if (Update(GetState().ClearColour, colour))
+			glClearColor(colour.r, colour.g, colour.b, colour.a);
+	}
+
+	void OpenGLState::OnProgramDeleted(uint32_t program)
+	{
+		OpenGLStateData& state = GetState();
+		if (state.Program == program)
+			state.Program = Unknown;
+	}
+
+	void OpenGLState::OnVertexArrayDeleted(uint32_t vertexArray)
+	{
+		OpenGLStateData& state = GetState();
+		if (state.VertexArray == vertexArray)
+		{
+			state.VertexArray = Unknown;
+			state.Buffers[ElementArrayBuffer] = Unknown;
+		}
+	}
+
+	void OpenGLState::OnBufferDeleted(uint32_t buffer)
+	{
+		OpenGLStateData& state = GetState();
+		for (uint32_t& binding : state.Buffers)
+		{
+			if (binding == buffer)
+				binding = Unknown;
+		}
+		for (uint32_t& binding : state.StorageBindings)
+		{
+			if (binding == buffer)
+				binding = Unknown;
+		}
+	}
+
+	void OpenGLState::OnTextureDeleted(uint32_t texture)
+	{
+		OpenGLStateData& state = GetState();
+		for (uint32_t& binding : state.Textures)
+		{
+			if (binding == texture)
+				binding = Unknown;
+		}
+	}
+
+	void OpenGLState::OnFramebufferDeleted(uint32_t framebuffer)
+	{
+		OpenGLStateData& state = GetState();
+		if (state.Framebuffer == framebuffer)
+			state.Framebuffer = Unknown;
+	}
+
+	void OpenGLState::Invalidate()
+	{
+		GetState().Reset();
+	}
+
+}
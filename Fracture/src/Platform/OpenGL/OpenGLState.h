@@ -0,0 +1,86 @@
+#pragma once
+/*!
+* @file OpenGLState.h
+*
+* @brief Contains the OpenGLState class that caches the OpenGL context state and skips calls that would not change it.
+*
+* @see OpenGLRendererAPI
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Core/Core.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace Fracture {
+
+	/*!
+	* @brief Shadow copy of the OpenGL state the engine changes. Every class in Platform/OpenGL changes state through it instead of calling OpenGL directly.
+	*
+	* @details Each setter compares against the cached value and only calls OpenGL when the value differs. Issued and elided calls are counted in the
+	* GLStateCalls and GLStateCallsElided metrics of FrameStats, so the PerformanceLayer shows both per frame.
+	*
+	* The cache starts out unknown, so the first call of every setter is always issued. Code that changes OpenGL state behind the cache (ImGui, a third party
+	* library) must call Invalidate afterwards. Objects that are deleted must be reported with the OnXDeleted functions, because OpenGL unbinds deleted objects
+	* and may hand their names out again.
+	*
+	* The element array buffer binding belongs to the vertex array, so it is forgotten whenever the vertex array changes. Only used from the thread that owns the context.
+	*/
+	class OpenGLState
+	{
+	public:
+		static constexpr uint32_t MaxTextureUnits = 32; /// The number of texture units cached, the minimum OpenGL 4.5 guarantees.
+		static constexpr uint32_t MaxStorageBindings = 8; /// The number of shader storage binding points cached, the minimum OpenGL 4.5 guarantees.
+
+		static void UseProgram(uint32_t program);
+		static void BindVertexArray(uint32_t vertexArray);
+
+		/*!
+		* @brief Binds a buffer to GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_DRAW_INDIRECT_BUFFER or GL_SHADER_STORAGE_BUFFER. Other targets are not cached.
+		*/
+		static void BindBuffer(uint32_t target, uint32_t buffer);
+
+		/*!
+		* @brief Binds a buffer to an indexed GL_SHADER_STORAGE_BUFFER binding point. Like OpenGL, this also binds it to the generic target.
+		*/
+		static void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+
+		static void BindTextureUnit(uint32_t unit, uint32_t texture);
+
+		/*!
+		* @brief Binds a framebuffer to GL_FRAMEBUFFER, for drawing and reading. 0 is the window.
+		*/
+		static void BindFramebuffer(uint32_t framebuffer);
+
+		/*!
+		* @brief Enables or disables GL_BLEND, GL_DEPTH_TEST, GL_SCISSOR_TEST or GL_CULL_FACE. Other capabilities are not cached.
+		*/
+		static void SetCapability(uint32_t capability, bool enabled);
+
+		static void BlendFunc(uint32_t source, uint32_t destination);
+		static void DepthFunc(uint32_t function);
+		static void Scissor(int32_t x, int32_t y, int32_t width, int32_t height);
+		static void Viewport(int32_t x, int32_t y, int32_t width, int32_t height);
+
+		/*!
+		* @brief Returns the viewport as x, y, width and height. Reads it from OpenGL when the cache does not know it.
+		*/
+		static glm::ivec4 GetViewport();
+		static void ClearColor(const glm::vec4& colour);
+
+		static void OnProgramDeleted(uint32_t program);
+		static void OnVertexArrayDeleted(uint32_t vertexArray);
+		static void OnBufferDeleted(uint32_t buffer);
+		static void OnTextureDeleted(uint32_t texture);
+		static void OnFramebufferDeleted(uint32_t framebuffer);
+
+		/*!
+		* @brief Forgets the cached state. The next call of every setter is issued.
+		*/
+		static void Invalidate();
+	};
+
+}
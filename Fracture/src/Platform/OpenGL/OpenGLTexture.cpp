@@ -1,6 +1,8 @@
 #include "frpch.h"
 #include "OpenGLTexture.h"
 
+#include "Platform/OpenGL/OpenGLState.h"
+
 #include <glad/glad.h>
 #include <stb_image.h>
 
@@ -76,6 +78,7 @@ namespace Fracture {
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
+		OpenGLState::OnTextureDeleted(m_RendererID);
 		glDeleteTextures(1, &m_RendererID);
 	}
 
@@ -83,7 +86,7 @@ namespace Fracture {
 	{
 		// First paramter is the slot we want to bind the texture to
 		// Second paramter is the texture we want to bind
-		glBindTextureUnit(slot, m_RendererID);
+		OpenGLState::BindTextureUnit(slot, m_RendererID);
 	}
 
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "frpch.h"
 #include "OpenGLVertexArray.h"
 
+#include "Platform/OpenGL/OpenGLState.h"
+
 #include <glad/glad.h>
 
 namespace Fracture {
@@ -30,11 +32,12 @@ namespace Fracture {
 		m_RendererID(0)
 	{
 		glCreateVertexArrays(1, &m_RendererID);
-		glBindVertexArray(m_RendererID);
+		OpenGLState::BindVertexArray(m_RendererID);
 	}
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
+		OpenGLState::OnVertexArrayDeleted(m_RendererID);
 		glDeleteVertexArrays(1, &m_RendererID);
 	}
 
@@ -43,7 +46,7 @@ namespace Fracture {
 		const auto& layout = vertexBuffer->GetLayout();
 		FR_CORE_ASSERT(layout.GetElements().size(), "Vertex Buffer has no layout!");
 
-		glBindVertexArray(m_RendererID);
+		OpenGLState::BindVertexArray(m_RendererID);
 		vertexBuffer->Bind();
 		//glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr); // This says how the data is layed out in the buffer
 																					// 0 is the index of the attribute we want to configure. In the previous line we enabled this index with glEnableVertexAttribArray.
@@ -72,18 +75,18 @@ namespace Fracture {
 
 	void OpenGLVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
 	{
-		glBindVertexArray(m_RendererID);
+		OpenGLState::BindVertexArray(m_RendererID);
 		indexBuffer->Bind();
 		m_IndexBuffer = indexBuffer;
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
-		glBindVertexArray(m_RendererID);
+		OpenGLState::BindVertexArray(m_RendererID);
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		OpenGLState::BindVertexArray(0);
 	}
 }
\ No newline at end of file
@@ -63,6 +63,16 @@ namespace Fracture {
 		*/
 		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
 
+		/*!
+		* @brief Sets the model space bounds of the vertices used for culling.
+		*/
+		virtual void SetBounds(const AABB& bounds) override { m_Bounds = bounds; }
+
+		/*!
+		* @brief Returns the model space bounds of the vertices.
+		*/
+		virtual const AABB& GetBounds() const override { return m_Bounds; }
+
 		/*!
 		* @brief Binds the vertex array.
 		*/
@@ -77,6 +87,7 @@ namespace Fracture {
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers; /// A vector of vertex buffers.
 		Ref<IndexBuffer> m_IndexBuffer; /// The index buffer of the vertex array.
 		uint32_t m_VertexBufferIndex = 0; /// The index the current attribute is at this is so we can bind multiple vertex buffers to the vertex array.
+		AABB m_Bounds; /// The model space bounds of the vertices.
 	};
 
 }
@@ -0,0 +1,79 @@
+#include "frpch.h"
+#include "SoftwareBuffer.h"
+
+#include "Fracture/Utils/FrameStats.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
+
+namespace Fracture {
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// VertexBuffer ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SoftwareVertexBuffer::SoftwareVertexBuffer(float* vertices, uint32_t size)
+	{
+		SetData(vertices, size);
+	}
+
+	void SoftwareVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		m_Data.resize(size);
+		if (data)
+			memcpy(m_Data.data(), data, size);
+	}
+
+	void SoftwareVertexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset)
+	{
+		FR_CORE_ASSERT(offset + size <= m_Data.size(), "Vertex buffer sub data is out of range");
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		memcpy(m_Data.data() + offset, data, size);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// IndexBuffer ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SoftwareIndexBuffer::SoftwareIndexBuffer(uint32_t* indices, uint32_t count)
+	{
+		SetData(indices, count * sizeof(uint32_t));
+	}
+
+	void SoftwareIndexBuffer::SetData(const void* data, uint32_t size)
+	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		m_Indices.resize(size / sizeof(uint32_t));
+		if (data)
+			memcpy(m_Indices.data(), data, m_Indices.size() * sizeof(uint32_t));
+	}
+
+	void SoftwareIndexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset)
+	{
+		FR_CORE_ASSERT(offset + size <= m_Indices.size() * sizeof(uint32_t), "Index buffer sub data is out of range");
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		memcpy((uint8_t*)m_Indices.data() + offset, data, size);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// StorageBuffer //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SoftwareStorageBuffer::SoftwareStorageBuffer(uint32_t size)
+		: m_Data(CreateRef<std::vector<uint8_t>>(size))
+	{
+	}
+
+	void SoftwareStorageBuffer::SetData(const void* data, uint32_t size)
+	{
+		Utils::FrameStats::AddCount(Utils::FrameStats::Metric::BufferBytes, size);
+		if (size > m_Data->size())
+			m_Data->resize(size);
+		memcpy(m_Data->data(), data, size);
+	}
+
+	void SoftwareStorageBuffer::Bind(uint32_t binding) const
+	{
+		SoftwareRendererAPI::BindStorageBuffer(binding, m_Data);
+	}
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+/*!
+* @file SoftwareBuffer.h
+* @brief Contains the software renderer implementations of the VertexBuffer and IndexBuffer classes.
+* 
+* @see VertexBuffer
+* @see IndexBuffer
+* @see SoftwareRendererAPI
+* 
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Renderer/Buffer.h"
+
+namespace Fracture {
+
+	/*!
+	* @brief Implementation of the VertexBuffer class for the software renderer. The vertex data is kept in system memory.
+	* 
+	* @see VertexBuffer
+	*/
+	class SoftwareVertexBuffer : public VertexBuffer
+	{
+	public:
+		/*!
+		* @brief Constructor for the SoftwareVertexBuffer class. Copies the vertex data.
+		* 
+		* @param[in] float* vertices: The vertices of the vertex buffer. Can be nullptr to create an empty buffer of the given size.
+		* @param[in] uint32_t size: The size of the vertex data in bytes.
+		*/
+		SoftwareVertexBuffer(float* vertices, uint32_t size);
+
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) override;
+
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+
+		/// Binding a buffer has no effect in the software renderer. Buffers are read through the bound vertex array.
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		/*!
+		* @brief Returns the vertex data of the buffer.
+		* 
+		* @return const std::vector<uint8_t>&: The raw bytes of the buffer.
+		*/
+		inline const std::vector<uint8_t>& GetData() const { return m_Data; }
+	private:
+		std::vector<uint8_t> m_Data; /// The vertex data.
+		BufferLayout m_Layout; /// The layout of the vertex buffer.
+	};
+
+	/*!
+	* @brief Implementation of the IndexBuffer class for the software renderer. The indices are kept in system memory.
+	* 
+	* @see IndexBuffer
+	*/
+	class SoftwareIndexBuffer : public IndexBuffer
+	{
+	public:
+		/*!
+		* @brief Constructor for the SoftwareIndexBuffer class. Copies the indices.
+		* 
+		* @param[in] uint32_t* indices: The indices.
+		* @param[in] uint32_t count: The number of indices.
+		*/
+		SoftwareIndexBuffer(uint32_t* indices, uint32_t count);
+
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) override;
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual uint32_t GetCount() const override { return (uint32_t)m_Indices.size(); }
+
+		/*!
+		* @brief Returns the indices of the buffer.
+		* 
+		* @return const std::vector<uint32_t>&: The indices.
+		*/
+		inline const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+	private:
+		std::vector<uint32_t> m_Indices; /// The indices.
+	};
+
+	/*!
+	* @brief Implementation of the StorageBuffer class for the software renderer. The data is kept in system memory and read by MultiDrawIndexedIndirect.
+	* 
+	* @see StorageBuffer
+	*/
+	class SoftwareStorageBuffer : public StorageBuffer
+	{
+	public:
+		SoftwareStorageBuffer(uint32_t size);
+
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		/// Makes the data visible to the software renderer at the binding point.
+		virtual void Bind(uint32_t binding) const override;
+
+		virtual uint32_t GetSize() const override { return (uint32_t)m_Data->size(); }
+	private:
+		Ref<std::vector<uint8_t>> m_Data; /// The data, shared with the renderer while bound.
+	};
+
+}
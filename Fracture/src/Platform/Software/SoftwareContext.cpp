@@ -0,0 +1,74 @@
+#include "frpch.h"
+#include "SoftwareContext.h"
+
+#include "Fracture/Core/JobSystem.h"
+#include "Platform/Software/SoftwareRasterizer.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
+
+#define GLFW_EXPOSE_NATIVE_WIN32
+#include <GLFW/glfw3.h>
+#include <GLFW/glfw3native.h>
+
+namespace Fracture {
+
+	SoftwareContext::SoftwareContext(GLFWwindow* windowHandle) :
+		m_WindowHandle(windowHandle)
+	{
+		FR_CORE_ASSERT(windowHandle, "Window handle is null!")
+	}
+
+	SoftwareContext::~SoftwareContext()
+	{
+		if (SoftwareRendererAPI::GetRenderTarget() == &m_BackBuffer)
+			SoftwareRendererAPI::SetRenderTarget(nullptr);
+	}
+
+	void SoftwareContext::Init()
+	{
+		int width, height;
+		glfwGetFramebufferSize(m_WindowHandle, &width, &height);
+		m_BackBuffer.Resize(width, height);
+		SoftwareRendererAPI::SetRenderTarget(&m_BackBuffer);
+
+		FR_CORE_INFO("Software renderer: {0} worker threads, {1}x{1} tiles", JobSystem::GetThreadCount(), SoftwareRasterizer::TileSize);
+	}
+
+	void SoftwareContext::SwapBuffers()
+	{
+		FR_PROFILE_SCOPE("SoftwareContext::SwapBuffers");
+		SoftwareRendererAPI::Flush();
+
+		uint32_t width = m_BackBuffer.GetWidth();
+		uint32_t height = m_BackBuffer.GetHeight();
+		if (width > 0 && height > 0)
+		{
+			// The back buffer stores R in the lowest byte, 32 bit DIBs store B in the lowest byte
+			const uint32_t* pixels = m_BackBuffer.GetPixels();
+			m_PresentBuffer.resize((size_t)width * height);
+			for (size_t i = 0; i < m_PresentBuffer.size(); i++)
+			{
+				uint32_t pixel = pixels[i];
+				m_PresentBuffer[i] = (pixel & 0xFF00FF00) | ((pixel & 0xFF) << 16) | ((pixel >> 16) & 0xFF);
+			}
+
+			BITMAPINFO info = {};
+			info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+			info.bmiHeader.biWidth = (LONG)width;
+			info.bmiHeader.biHeight = (LONG)height; // positive height means bottom up rows, the same as the back buffer
+			info.bmiHeader.biPlanes = 1;
+			info.bmiHeader.biBitCount = 32;
+			info.bmiHeader.biCompression = BI_RGB;
+
+			HWND window = glfwGetWin32Window(m_WindowHandle);
+			HDC deviceContext = GetDC(window);
+			StretchDIBits(deviceContext, 0, 0, width, height, 0, 0, width, height, m_PresentBuffer.data(), &info, DIB_RGB_COLORS, SRCCOPY);
+			ReleaseDC(window, deviceContext);
+		}
+
+		// Pick up window resizes for the next frame. The contents are cleared at the start of every frame anyway.
+		int framebufferWidth, framebufferHeight;
+		glfwGetFramebufferSize(m_WindowHandle, &framebufferWidth, &framebufferHeight);
+		m_BackBuffer.Resize(framebufferWidth, framebufferHeight);
+	}
+
+}
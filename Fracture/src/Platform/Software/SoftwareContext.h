@@ -0,0 +1,55 @@
+#pragma once
+/*!
+* @file SoftwareContext.h
+* @brief Contains the SoftwareContext class that presents the frames of the software renderer in a window.
+* 
+* @see GraphicsContext
+* @see SoftwareRendererAPI
+* 
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Renderer\GraphicsContext.h"
+#include "Platform\Software\SoftwareFramebuffer.h"
+
+struct GLFWwindow; // Forward declaration
+
+namespace Fracture {
+
+	/*!
+	* @brief Implementation of the GraphicsContext class for the software renderer.
+	* 
+	* @details The context owns the back buffer the software renderer draws into. SwapBuffers flushes the queued draws and copies the back buffer to the window with GDI.
+	* The window has to be created with GLFW_CLIENT_API set to GLFW_NO_API.
+	*/
+	class SoftwareContext : public GraphicsContext
+	{
+	public:
+		/*!
+		* @brief Constructor for the SoftwareContext class.
+		* 
+		* @param[in] GLFWwindow* windowHandle: The window the frames are presented in.
+		*/
+		SoftwareContext(GLFWwindow* windowHandle);
+
+		/*!
+		* @brief Destructor. Switches the renderer back to its offscreen target so it does not draw into a destroyed back buffer.
+		*/
+		~SoftwareContext();
+
+		/*!
+		* @brief Sizes the back buffer to the window and makes it the render target of the software renderer.
+		*/
+		virtual void Init() override;
+
+		/*!
+		* @brief Flushes the software renderer and presents the back buffer.
+		*/
+		virtual void SwapBuffers() override;
+	private:
+		GLFWwindow* m_WindowHandle; /// The window handle of the application window.
+		SoftwareFramebuffer m_BackBuffer; /// The framebuffer the renderer draws into.
+		std::vector<uint32_t> m_PresentBuffer; /// The back buffer converted to the BGRA layout GDI expects.
+	};
+
+}
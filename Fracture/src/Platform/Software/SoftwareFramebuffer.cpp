@@ -0,0 +1,159 @@
+#include "frpch.h"
+#include "SoftwareFramebuffer.h"
+
+#include <array>
+
+namespace Fracture {
+
+	namespace {
+
+		// CRC and Adler checksums required by the PNG and zlib containers.
+		uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+		{
+			static const std::array<uint32_t, 256> table = []()
+			{
+				std::array<uint32_t, 256> result = {};
+				for (uint32_t i = 0; i < 256; i++)
+				{
+					uint32_t c = i;
+					for (int k = 0; k < 8; k++)
+						c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+					result[i] = c;
+				}
+				return result;
+			}();
+
+			crc = ~crc;
+			for (size_t i = 0; i < size; i++)
+				crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+			return ~crc;
+		}
+
+		void WriteU32BE(std::vector<uint8_t>& out, uint32_t value)
+		{
+			out.push_back((uint8_t)(value >> 24));
+			out.push_back((uint8_t)(value >> 16));
+			out.push_back((uint8_t)(value >> 8));
+			out.push_back((uint8_t)(value));
+		}
+
+		void WriteChunk(std::ofstream& stream, const char* type, const std::vector<uint8_t>& data)
+		{
+			std::vector<uint8_t> chunk;
+			chunk.reserve(data.size() + 12);
+			WriteU32BE(chunk, (uint32_t)data.size());
+			chunk.insert(chunk.end(), type, type + 4);
+			chunk.insert(chunk.end(), data.begin(), data.end());
+			uint32_t crc = Crc32(chunk.data() + 4, data.size() + 4); // the crc covers the type and the data
+			WriteU32BE(chunk, crc);
+			stream.write((const char*)chunk.data(), chunk.size());
+		}
+
+	}
+
+	SoftwareFramebuffer::SoftwareFramebuffer(uint32_t width, uint32_t height)
+	{
+		Resize(width, height);
+	}
+
+	void SoftwareFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == m_Width && height == m_Height)
+			return;
+
+		m_Width = width;
+		m_Height = height;
+		m_Pixels.assign((size_t)width * height, 0);
+	}
+
+	void SoftwareFramebuffer::Clear(const glm::vec4& colour)
+	{
+		std::fill(m_Pixels.begin(), m_Pixels.end(), PackColour(colour));
+	}
+
+	uint32_t SoftwareFramebuffer::PackColour(const glm::vec4& colour)
+	{
+		auto toByte = [](float value) { return (uint32_t)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f); };
+		return toByte(colour.r) | (toByte(colour.g) << 8) | (toByte(colour.b) << 16) | (toByte(colour.a) << 24);
+	}
+
+	glm::vec4 SoftwareFramebuffer::UnpackColour(uint32_t packed)
+	{
+		constexpr float scale = 1.0f / 255.0f;
+		return glm::vec4((packed & 0xFF) * scale, ((packed >> 8) & 0xFF) * scale, ((packed >> 16) & 0xFF) * scale, (packed >> 24) * scale);
+	}
+
+	bool SoftwareFramebuffer::WritePNG(const std::string& path) const
+	{
+		std::ofstream stream(path, std::ios::out | std::ios::binary);
+		if (!stream)
+		{
+			FR_CORE_ERROR("Could not open file {0} for writing", path);
+			return false;
+		}
+
+		static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		stream.write((const char*)signature, sizeof(signature));
+
+		std::vector<uint8_t> header;
+		WriteU32BE(header, m_Width);
+		WriteU32BE(header, m_Height);
+		header.push_back(8); // bit depth
+		header.push_back(6); // colour type RGBA
+		header.push_back(0); // compression
+		header.push_back(0); // filter
+		header.push_back(0); // interlace
+		WriteChunk(stream, "IHDR", header);
+
+		// Raw scanlines: a filter byte (0 = none) followed by the row pixels, top row first
+		size_t rowSize = (size_t)m_Width * 4 + 1;
+		std::vector<uint8_t> raw(rowSize * m_Height);
+		for (uint32_t y = 0; y < m_Height; y++)
+		{
+			uint8_t* row = raw.data() + rowSize * y;
+			row[0] = 0;
+			const uint32_t* source = m_Pixels.data() + (size_t)(m_Height - 1 - y) * m_Width;
+			for (uint32_t x = 0; x < m_Width; x++)
+			{
+				uint32_t pixel = source[x];
+				row[1 + x * 4 + 0] = (uint8_t)(pixel);
+				row[1 + x * 4 + 1] = (uint8_t)(pixel >> 8);
+				row[1 + x * 4 + 2] = (uint8_t)(pixel >> 16);
+				row[1 + x * 4 + 3] = (uint8_t)(pixel >> 24);
+			}
+		}
+
+		// zlib stream made of stored deflate blocks (at most 65535 bytes each)
+		std::vector<uint8_t> zlib;
+		zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+		zlib.push_back(0x78);
+		zlib.push_back(0x01);
+		size_t offset = 0;
+		do
+		{
+			size_t blockSize = std::min<size_t>(raw.size() - offset, 65535);
+			bool last = offset + blockSize == raw.size();
+			zlib.push_back(last ? 1 : 0);
+			zlib.push_back((uint8_t)(blockSize & 0xFF));
+			zlib.push_back((uint8_t)(blockSize >> 8));
+			zlib.push_back((uint8_t)(~blockSize & 0xFF));
+			zlib.push_back((uint8_t)((~blockSize >> 8) & 0xFF));
+			zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+			offset += blockSize;
+		} while (offset < raw.size());
+
+		uint32_t a = 1, b = 0;
+		for (uint8_t value : raw)
+		{
+			a = (a + value) % 65521;
+			b = (b + a) % 65521;
+		}
+		WriteU32BE(zlib, (b << 16) | a);
+
+		WriteChunk(stream, "IDAT", zlib);
+		WriteChunk(stream, "IEND", {});
+
+		return stream.good();
+	}
+
+}
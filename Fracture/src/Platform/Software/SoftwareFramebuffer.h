@@ -0,0 +1,93 @@
+#pragma once
+/*!
+* @file SoftwareFramebuffer.h
+* @brief Contains the SoftwareFramebuffer class that stores the pixels the software renderer draws into.
+*
+* @see SoftwareRendererAPI
+* @see SoftwareRasterizer
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Core/Core.h"
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Fracture {
+
+	/*!
+	* @brief In-memory RGBA8 colour buffer used as a render target by the software renderer.
+	*
+	* @details Pixels are stored as packed 32 bit RGBA values (R in the lowest byte). Like the OpenGL default framebuffer, row 0 is the bottom row of the image.
+	*/
+	class SoftwareFramebuffer
+	{
+	public:
+		SoftwareFramebuffer() = default;
+
+		/*!
+		* @brief Constructor that allocates a framebuffer of the given size cleared to transparent black.
+		*
+		* @param[in] uint32_t width: The width of the framebuffer in pixels.
+		* @param[in] uint32_t height: The height of the framebuffer in pixels.
+		*/
+		SoftwareFramebuffer(uint32_t width, uint32_t height);
+
+		/*!
+		* @brief Resizes the framebuffer. The contents are discarded when the size changes.
+		*
+		* @param[in] uint32_t width: The new width in pixels.
+		* @param[in] uint32_t height: The new height in pixels.
+		*/
+		void Resize(uint32_t width, uint32_t height);
+
+		/*!
+		* @brief Fills every pixel with the given colour.
+		*
+		* @param[in] const glm::vec4& colour: The colour in the [0, 1] range.
+		*/
+		void Clear(const glm::vec4& colour);
+
+		/*!
+		* @brief Writes the framebuffer to a PNG file. The image is flipped so that the top row of the file is the top of the frame.
+		*
+		* @details The image data is stored with uncompressed deflate blocks so the encoder has no dependencies. The files are larger than a compressed PNG but any image viewer can read them.
+		*
+		* @param[in] const std::string& path: The path of the file to write.
+		*
+		* @return bool: True if the file was written successfully.
+		*/
+		bool WritePNG(const std::string& path) const;
+
+		inline uint32_t GetWidth() const { return m_Width; }
+		inline uint32_t GetHeight() const { return m_Height; }
+
+		inline uint32_t* GetPixels() { return m_Pixels.data(); }
+		inline const uint32_t* GetPixels() const { return m_Pixels.data(); }
+
+		/*!
+		* @brief Returns the pixel at the given coordinates. Row 0 is the bottom row.
+		*
+		* @return uint32_t: The packed RGBA8 value of the pixel.
+		*/
+		inline uint32_t GetPixel(uint32_t x, uint32_t y) const { return m_Pixels[(size_t)y * m_Width + x]; }
+
+		/*!
+		* @brief Packs a [0, 1] colour into the RGBA8 format used by the framebuffer.
+		*/
+		static uint32_t PackColour(const glm::vec4& colour);
+
+		/*!
+		* @brief Unpacks an RGBA8 value into a [0, 1] colour.
+		*/
+		static glm::vec4 UnpackColour(uint32_t packed);
+	private:
+		uint32_t m_Width = 0; /// The width of the framebuffer in pixels.
+		uint32_t m_Height = 0; /// The height of the framebuffer in pixels.
+		std::vector<uint32_t> m_Pixels; /// The pixels of the framebuffer. Bottom row first.
+	};
+
+}
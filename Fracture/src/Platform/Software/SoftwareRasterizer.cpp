@@ -0,0 +1,385 @@
+#include "frpch.h"
+#include "SoftwareRasterizer.h"
+
+#include "Fracture/Core/JobSystem.h"
+#include "Fracture/Core/Simd.h"
+
+namespace Fracture {
+
+	namespace {
+
+		constexpr float SubpixelSteps = 16.0f; // vertices are snapped to 1/16th of a pixel so edges on shared vertices evaluate identically
+
+		inline int32_t Wrap(int32_t value, int32_t size)
+		{
+			value %= size;
+			return value < 0 ? value + size : value;
+		}
+
+		// GL_REPEAT sampling with either nearest or bilinear filtering
+		glm::vec4 SampleTexture(const SoftwareTextureData& texture, float u, float v, bool linear)
+		{
+			int32_t width = (int32_t)texture.Width;
+			int32_t height = (int32_t)texture.Height;
+			const uint32_t* texels = texture.Texels.data();
+
+			if (!linear)
+			{
+				int32_t x = Wrap((int32_t)std::floor(u * width), width);
+				int32_t y = Wrap((int32_t)std::floor(v * height), height);
+				return SoftwareFramebuffer::UnpackColour(texels[y * width + x]);
+			}
+
+			float fx = u * width - 0.5f;
+			float fy = v * height - 0.5f;
+			float floorX = std::floor(fx);
+			float floorY = std::floor(fy);
+			float tx = fx - floorX;
+			float ty = fy - floorY;
+
+			int32_t x0 = Wrap((int32_t)floorX, width);
+			int32_t y0 = Wrap((int32_t)floorY, height);
+			int32_t x1 = x0 + 1 == width ? 0 : x0 + 1;
+			int32_t y1 = y0 + 1 == height ? 0 : y0 + 1;
+
+			glm::vec4 c00 = SoftwareFramebuffer::UnpackColour(texels[y0 * width + x0]);
+			glm::vec4 c10 = SoftwareFramebuffer::UnpackColour(texels[y0 * width + x1]);
+			glm::vec4 c01 = SoftwareFramebuffer::UnpackColour(texels[y1 * width + x0]);
+			glm::vec4 c11 = SoftwareFramebuffer::UnpackColour(texels[y1 * width + x1]);
+
+			glm::vec4 bottom = c00 + (c10 - c00) * tx;
+			glm::vec4 top = c01 + (c11 - c01) * tx;
+			return bottom + (top - bottom) * ty;
+		}
+
+		SoftwareRasterizer::Vertex Lerp(const SoftwareRasterizer::Vertex& a, const SoftwareRasterizer::Vertex& b, float t)
+		{
+			SoftwareRasterizer::Vertex result;
+			result.Position = a.Position + (b.Position - a.Position) * t;
+			result.TexCoord = a.TexCoord + (b.TexCoord - a.TexCoord) * t;
+			result.Colour = a.Colour + (b.Colour - a.Colour) * t;
+			return result;
+		}
+
+	}
+
+	void SoftwareRasterizer::SetTarget(SoftwareFramebuffer* target)
+	{
+		if (target == m_Target)
+			return;
+
+		Flush();
+		m_Target = target;
+	}
+
+	void SoftwareRasterizer::SetViewport(int32_t x, int32_t y, uint32_t width, uint32_t height)
+	{
+		m_ViewportX = x;
+		m_ViewportY = y;
+		m_ViewportWidth = width;
+		m_ViewportHeight = height;
+	}
+
+	void SoftwareRasterizer::Clear(const glm::vec4& colour)
+	{
+		m_Triangles.clear();
+		m_States.clear();
+		for (auto& bin : m_Bins)
+			bin.clear();
+
+		if (m_Target)
+			m_Target->Clear(colour);
+	}
+
+	void SoftwareRasterizer::UpdateBins()
+	{
+		if (m_Target->GetWidth() == m_BinnedWidth && m_Target->GetHeight() == m_BinnedHeight)
+			return;
+
+		FR_CORE_ASSERT(m_Triangles.empty(), "The render target was resized while triangles were pending!");
+		m_BinnedWidth = m_Target->GetWidth();
+		m_BinnedHeight = m_Target->GetHeight();
+		m_TilesX = (m_BinnedWidth + TileSize - 1) / TileSize;
+		m_TilesY = (m_BinnedHeight + TileSize - 1) / TileSize;
+		m_Bins.clear();
+		m_Bins.resize((size_t)m_TilesX * m_TilesY);
+	}
+
+	void SoftwareRasterizer::Submit(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount, const DrawState& state)
+	{
+		if (m_Target == nullptr || m_ViewportWidth == 0 || m_ViewportHeight == 0)
+			return;
+
+		UpdateBins();
+
+		uint32_t stateIndex = (uint32_t)m_States.size();
+		m_States.push_back(state);
+
+		for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+		{
+			FR_CORE_ASSERT(indices[i] < vertices.size() && indices[i + 1] < vertices.size() && indices[i + 2] < vertices.size(), "Index out of range!");
+			ClipAndSetup(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]], stateIndex);
+		}
+	}
+
+	void SoftwareRasterizer::ClipAndSetup(const Vertex& v0, const Vertex& v1, const Vertex& v2, uint32_t stateIndex)
+	{
+		const Vertex* input[3] = { &v0, &v1, &v2 };
+
+		// Trivially reject triangles that are completely outside one of the side planes
+		for (int axis = 0; axis < 2; axis++)
+		{
+			if (v0.Position[axis] > v0.Position.w && v1.Position[axis] > v1.Position.w && v2.Position[axis] > v2.Position.w)
+				return;
+			if (v0.Position[axis] < -v0.Position.w && v1.Position[axis] < -v1.Position.w && v2.Position[axis] < -v2.Position.w)
+				return;
+		}
+
+		auto nearDistance = [](const Vertex& v) { return v.Position.z + v.Position.w; };
+		auto farDistance = [](const Vertex& v) { return v.Position.w - v.Position.z; };
+
+		bool inside = true;
+		for (const Vertex* v : input)
+			inside &= nearDistance(*v) >= 0.0f && farDistance(*v) >= 0.0f;
+
+		if (inside)
+		{
+			SetupTriangle(v0, v1, v2, stateIndex);
+			return;
+		}
+
+		// Sutherland-Hodgman against the near and far planes. The side planes are handled by clamping the bounding box to the viewport.
+		Vertex polygon[5] = { v0, v1, v2 };
+		uint32_t count = 3;
+		for (int plane = 0; plane < 2; plane++)
+		{
+			Vertex clipped[5];
+			uint32_t clippedCount = 0;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const Vertex& current = polygon[i];
+				const Vertex& next = polygon[(i + 1) % count];
+				float currentDistance = plane == 0 ? nearDistance(current) : farDistance(current);
+				float nextDistance = plane == 0 ? nearDistance(next) : farDistance(next);
+
+				if (currentDistance >= 0.0f)
+					clipped[clippedCount++] = current;
+				if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+					clipped[clippedCount++] = Lerp(current, next, currentDistance / (currentDistance - nextDistance));
+			}
+
+			count = clippedCount;
+			for (uint32_t i = 0; i < count; i++)
+				polygon[i] = clipped[i];
+		}
+
+		for (uint32_t i = 1; i + 1 < count; i++)
+			SetupTriangle(polygon[0], polygon[i], polygon[i + 1], stateIndex);
+	}
+
+	void SoftwareRasterizer::SetupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, uint32_t stateIndex)
+	{
+		const Vertex* vertices[3] = { &v0, &v1, &v2 };
+
+		Triangle triangle;
+		double x[3], y[3];
+		for (int i = 0; i < 3; i++)
+		{
+			const glm::vec4& position = vertices[i]->Position;
+			if (position.w <= 1e-6f)
+				return;
+
+			float invW = 1.0f / position.w;
+			float ndcX = position.x * invW;
+			float ndcY = position.y * invW;
+			float screenX = (ndcX * 0.5f + 0.5f) * m_ViewportWidth + m_ViewportX;
+			float screenY = (ndcY * 0.5f + 0.5f) * m_ViewportHeight + m_ViewportY;
+			x[i] = std::round(screenX * SubpixelSteps) / SubpixelSteps;
+			y[i] = std::round(screenY * SubpixelSteps) / SubpixelSteps;
+
+			triangle.InvW[i] = invW;
+			triangle.TexCoordOverW[i] = vertices[i]->TexCoord * invW;
+			triangle.ColourOverW[i] = vertices[i]->Colour * invW;
+		}
+
+		double doubleArea = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if (doubleArea == 0.0)
+			return;
+
+		// Face culling is disabled in OpenGLRendererAPI so both windings are drawn. Flip clockwise triangles so the inside is always positive.
+		double sign = doubleArea > 0.0 ? 1.0 : -1.0;
+		for (int i = 0; i < 3; i++)
+		{
+			int a = (i + 1) % 3;
+			int b = (i + 2) % 3;
+			triangle.EdgeA[i] = (y[a] - y[b]) * sign;
+			triangle.EdgeB[i] = (x[b] - x[a]) * sign;
+			triangle.EdgeC[i] = (x[a] * y[b] - y[a] * x[b]) * sign;
+			// With y pointing up a left edge has the inside to its right and a top edge is horizontal with the inside below it
+			triangle.TopLeft[i] = triangle.EdgeA[i] > 0.0 || (triangle.EdgeA[i] == 0.0 && triangle.EdgeB[i] < 0.0);
+		}
+		triangle.InvDoubleArea = (float)(1.0 / std::abs(doubleArea));
+
+		int32_t clipMinX = std::max(m_ViewportX, 0);
+		int32_t clipMinY = std::max(m_ViewportY, 0);
+		int32_t clipMaxX = std::min(m_ViewportX + (int32_t)m_ViewportWidth, (int32_t)m_Target->GetWidth()) - 1;
+		int32_t clipMaxY = std::min(m_ViewportY + (int32_t)m_ViewportHeight, (int32_t)m_Target->GetHeight()) - 1;
+
+		// Pixel centres are at +0.5 so a pixel can only be covered if its centre is inside the bounds of the vertices
+		triangle.MinX = std::max((int32_t)std::floor(std::min({ x[0], x[1], x[2] }) - 0.5), clipMinX);
+		triangle.MinY = std::max((int32_t)std::floor(std::min({ y[0], y[1], y[2] }) - 0.5), clipMinY);
+		triangle.MaxX = std::min((int32_t)std::ceil(std::max({ x[0], x[1], x[2] }) - 0.5), clipMaxX);
+		triangle.MaxY = std::min((int32_t)std::ceil(std::max({ y[0], y[1], y[2] }) - 0.5), clipMaxY);
+		if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+			return;
+
+		triangle.State = stateIndex;
+		triangle.Linear = false;
+		const DrawState& state = m_States[stateIndex];
+		if (state.Texture)
+		{
+			// Pick the minification or magnification filter by comparing the texel area of the triangle with its area on screen
+			glm::vec2 uv0 = v0.TexCoord, uv1 = v1.TexCoord, uv2 = v2.TexCoord;
+			float uvArea = std::abs((uv1.x - uv0.x) * (uv2.y - uv0.y) - (uv2.x - uv0.x) * (uv1.y - uv0.y));
+			float texelArea = uvArea * state.Texture->Width * state.Texture->Height;
+			triangle.Linear = texelArea > std::abs(doubleArea) ? state.Texture->LinearMin : state.Texture->LinearMag;
+		}
+
+		uint32_t triangleIndex = (uint32_t)m_Triangles.size();
+		m_Triangles.push_back(triangle);
+
+		uint32_t tileMinX = triangle.MinX / TileSize, tileMaxX = triangle.MaxX / TileSize;
+		uint32_t tileMinY = triangle.MinY / TileSize, tileMaxY = triangle.MaxY / TileSize;
+		for (uint32_t ty = tileMinY; ty <= tileMaxY; ty++)
+		{
+			for (uint32_t tx = tileMinX; tx <= tileMaxX; tx++)
+			{
+				m_Bins[ty * m_TilesX + tx].push_back(triangleIndex);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::Flush()
+	{
+		FR_PROFILE_FUNCTION();
+		if (m_Triangles.empty())
+			return;
+
+		JobSystem::ParallelFor((uint32_t)m_Bins.size(), 1, [this](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t tile = begin; tile < end; tile++)
+					RasterizeTile(tile);
+			});
+
+		m_Triangles.clear();
+		m_States.clear();
+		for (auto& bin : m_Bins)
+			bin.clear();
+	}
+
+	void SoftwareRasterizer::RasterizeTile(uint32_t tileIndex)
+	{
+		const std::vector<uint32_t>& bin = m_Bins[tileIndex];
+		if (bin.empty())
+			return;
+
+		int32_t tileMinX = (int32_t)((tileIndex % m_TilesX) * TileSize);
+		int32_t tileMinY = (int32_t)((tileIndex / m_TilesX) * TileSize);
+		int32_t tileMaxX = std::min(tileMinX + (int32_t)TileSize, (int32_t)m_Target->GetWidth()) - 1;
+		int32_t tileMaxY = std::min(tileMinY + (int32_t)TileSize, (int32_t)m_Target->GetHeight()) - 1;
+
+		uint32_t* pixels = m_Target->GetPixels();
+		uint32_t targetWidth = m_Target->GetWidth();
+
+		const SimdFloat laneOffsets = SimdLaneOffsets();
+		const SimdFloat zero = SimdSet(0.0f);
+		alignas(32) float lambda1[SimdLanes];
+		alignas(32) float lambda2[SimdLanes];
+
+		for (uint32_t triangleIndex : bin)
+		{
+			const Triangle& triangle = m_Triangles[triangleIndex];
+			const DrawState& state = m_States[triangle.State];
+
+			int32_t minX = std::max(triangle.MinX, tileMinX);
+			int32_t minY = std::max(triangle.MinY, tileMinY);
+			int32_t maxX = std::min(triangle.MaxX, tileMaxX);
+			int32_t maxY = std::min(triangle.MaxY, tileMaxY);
+			if (minX > maxX || minY > maxY)
+				continue;
+
+			SimdFloat stepX[3], topLeft[3];
+			for (int i = 0; i < 3; i++)
+			{
+				stepX[i] = SimdSet((float)triangle.EdgeA[i] * SimdLanes);
+				// All bits set for top-left edges so that E == 0 counts as covered
+				topLeft[i] = triangle.TopLeft[i] ? SimdGreaterEqual(zero, zero) : zero;
+			}
+			const SimdFloat invDoubleArea = SimdSet(triangle.InvDoubleArea);
+
+			for (int32_t y = minY; y <= maxY; y++)
+			{
+				// The edge values of the first pixel of the row are computed in double precision, the steps along the row are small enough for floats
+				SimdFloat edge[3];
+				double centreX = minX + 0.5, centreY = y + 0.5;
+				for (int i = 0; i < 3; i++)
+				{
+					float rowStart = (float)(triangle.EdgeA[i] * centreX + triangle.EdgeB[i] * centreY + triangle.EdgeC[i]);
+					edge[i] = SimdAdd(SimdSet(rowStart), SimdMul(SimdSet((float)triangle.EdgeA[i]), laneOffsets));
+				}
+
+				uint32_t* row = pixels + (size_t)y * targetWidth;
+				for (int32_t x = minX; x <= maxX; x += SimdLanes)
+				{
+					SimdFloat covered = SimdOr(SimdGreater(edge[0], zero), SimdAnd(SimdGreaterEqual(edge[0], zero), topLeft[0]));
+					covered = SimdAnd(covered, SimdOr(SimdGreater(edge[1], zero), SimdAnd(SimdGreaterEqual(edge[1], zero), topLeft[1])));
+					covered = SimdAnd(covered, SimdOr(SimdGreater(edge[2], zero), SimdAnd(SimdGreaterEqual(edge[2], zero), topLeft[2])));
+
+					uint32_t mask = SimdMask(covered);
+					int32_t remaining = maxX - x + 1;
+					if (remaining < (int32_t)SimdLanes)
+						mask &= (1u << remaining) - 1;
+
+					if (mask)
+					{
+						SimdStore(lambda1, SimdMul(edge[1], invDoubleArea));
+						SimdStore(lambda2, SimdMul(edge[2], invDoubleArea));
+
+						for (uint32_t lane = 0; lane < SimdLanes; lane++)
+						{
+							if (!(mask & (1u << lane)))
+								continue;
+
+							float l1 = lambda1[lane];
+							float l2 = lambda2[lane];
+							float l0 = 1.0f - l1 - l2;
+							float w = 1.0f / (l0 * triangle.InvW[0] + l1 * triangle.InvW[1] + l2 * triangle.InvW[2]);
+
+							glm::vec4 colour = state.Colour;
+							if (state.HasVertexColour)
+								colour *= (triangle.ColourOverW[0] * l0 + triangle.ColourOverW[1] * l1 + triangle.ColourOverW[2] * l2) * w;
+							if (state.Texture)
+							{
+								glm::vec2 uv = (triangle.TexCoordOverW[0] * l0 + triangle.TexCoordOverW[1] * l1 + triangle.TexCoordOverW[2] * l2) * w;
+								colour *= SampleTexture(*state.Texture, uv.x, uv.y, triangle.Linear);
+							}
+
+							uint32_t& pixel = row[x + lane];
+							if (colour.a < 1.0f)
+							{
+								// SRC_ALPHA, ONE_MINUS_SRC_ALPHA on all four channels like glBlendFunc
+								glm::vec4 destination = SoftwareFramebuffer::UnpackColour(pixel);
+								colour = colour * colour.a + destination * (1.0f - colour.a);
+							}
+							pixel = SoftwareFramebuffer::PackColour(colour);
+						}
+					}
+
+					for (int i = 0; i < 3; i++)
+						edge[i] = SimdAdd(edge[i], stepX[i]);
+				}
+			}
+		}
+	}
+
+}
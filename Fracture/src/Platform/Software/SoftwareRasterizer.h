@@ -0,0 +1,136 @@
+#pragma once
+/*!
+* @file SoftwareRasterizer.h
+* @brief Contains the SoftwareRasterizer class that turns triangles into pixels on the CPU.
+*
+* @see SoftwareRendererAPI
+* @see SoftwareFramebuffer
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Core/Core.h"
+#include "Platform/Software/SoftwareFramebuffer.h"
+#include "Platform/Software/SoftwareTexture.h"
+
+#include <glm/glm.hpp>
+
+namespace Fracture {
+
+	/*!
+	* @brief Tile based triangle rasterizer.
+	*
+	* @details Triangles are not drawn when they are submitted. Submit transforms and sets up the triangles and bins them into 64x64 pixel tiles of the render target.
+	* Flush then rasterizes every tile on the JobSystem. Each tile is owned by a single thread and walks its triangles in submission order, so blending gives the same result as drawing in order.
+	* Coverage is tested with edge functions on 8 pixels at a time with AVX (4 with SSE in builds without it, see Simd.h) and follows the top-left fill rule.
+	* Attributes are interpolated with perspective correct barycentrics. Blending is fixed to SRC_ALPHA, ONE_MINUS_SRC_ALPHA to match OpenGLRendererAPI.
+	*
+	* @see JobSystem
+	*/
+	class SoftwareRasterizer
+	{
+	public:
+		static constexpr uint32_t TileSize = 64; /// The width and height of a tile in pixels.
+
+		/// A vertex in clip space together with the attributes of the fixed pipeline.
+		struct Vertex
+		{
+			glm::vec4 Position; /// The clip space position (the output of the vertex transform).
+			glm::vec2 TexCoord; /// The texture coordinates.
+			glm::vec4 Colour; /// The vertex colour.
+		};
+
+		/// The state the triangles of a draw are shaded with.
+		struct DrawState
+		{
+			Ref<SoftwareTextureData> Texture; /// The texture to sample. nullptr for untextured draws.
+			glm::vec4 Colour = glm::vec4(1.0f); /// The colour every fragment is multiplied by.
+			bool HasVertexColour = false; /// Whether the vertex colours need to be interpolated.
+		};
+
+		/*!
+		* @brief Sets the framebuffer that is drawn to. Pending triangles are flushed to the previous target first.
+		*
+		* @param[in] SoftwareFramebuffer* target: The new render target.
+		*/
+		void SetTarget(SoftwareFramebuffer* target);
+
+		inline SoftwareFramebuffer* GetTarget() const { return m_Target; }
+
+		/*!
+		* @brief Sets the viewport that normalized device coordinates are mapped to. Only affects triangles submitted afterwards.
+		*/
+		void SetViewport(int32_t x, int32_t y, uint32_t width, uint32_t height);
+
+		/*!
+		* @brief Clears the render target. Pending triangles would be overwritten by the clear so they are dropped instead of drawn.
+		*
+		* @param[in] const glm::vec4& colour: The clear colour.
+		*/
+		void Clear(const glm::vec4& colour);
+
+		/*!
+		* @brief Sets up and bins a list of indexed triangles.
+		*
+		* @param[in] const std::vector<Vertex>& vertices: The transformed vertices.
+		* @param[in] const uint32_t* indices: The indices of the triangles, 3 per triangle.
+		* @param[in] uint32_t indexCount: The number of indices.
+		* @param[in] const DrawState& state: The state the triangles are shaded with.
+		*/
+		void Submit(const std::vector<Vertex>& vertices, const uint32_t* indices, uint32_t indexCount, const DrawState& state);
+
+		/*!
+		* @brief Rasterizes all the pending triangles into the render target.
+		*/
+		void Flush();
+
+		inline uint32_t GetPendingTriangleCount() const { return (uint32_t)m_Triangles.size(); }
+	private:
+		/// A triangle after setup. The edge functions are E(x, y) = A * x + B * y + C and are positive inside the triangle.
+		struct Triangle
+		{
+			double EdgeA[3]; /// The x coefficient of the edge opposite each vertex.
+			double EdgeB[3]; /// The y coefficient of the edge opposite each vertex.
+			double EdgeC[3]; /// The constant of the edge opposite each vertex.
+			bool TopLeft[3]; /// Whether pixels exactly on the edge are covered.
+			float InvDoubleArea; /// 1 / (2 * area) to turn edge values into barycentrics.
+			float InvW[3]; /// 1 / w of each vertex.
+			glm::vec2 TexCoordOverW[3]; /// The texture coordinates of each vertex divided by w.
+			glm::vec4 ColourOverW[3]; /// The colours of each vertex divided by w.
+			int32_t MinX, MinY, MaxX, MaxY; /// The bounding box in pixels, inclusive and clamped to the viewport.
+			uint32_t State; /// The index of the draw state.
+			bool Linear; /// Whether the texture is sampled with bilinear filtering.
+		};
+
+		/*!
+		* @brief Clips a triangle against the near and far planes and sets up the pieces.
+		*/
+		void ClipAndSetup(const Vertex& v0, const Vertex& v1, const Vertex& v2, uint32_t stateIndex);
+
+		/*!
+		* @brief Computes the edge functions of a clipped triangle and adds it to the bins of the tiles it overlaps.
+		*/
+		void SetupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, uint32_t stateIndex);
+
+		/*!
+		* @brief Draws the triangles binned into a tile.
+		*/
+		void RasterizeTile(uint32_t tileIndex);
+
+		/*!
+		* @brief Resizes the bins to match the size of the render target.
+		*/
+		void UpdateBins();
+	private:
+		SoftwareFramebuffer* m_Target = nullptr; /// The framebuffer the triangles are drawn to.
+		int32_t m_ViewportX = 0, m_ViewportY = 0; /// The origin of the viewport.
+		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0; /// The size of the viewport.
+
+		std::vector<DrawState> m_States; /// The states of the pending draws.
+		std::vector<Triangle> m_Triangles; /// The pending triangles.
+		std::vector<std::vector<uint32_t>> m_Bins; /// The indices of the triangles overlapping each tile, in submission order.
+		uint32_t m_TilesX = 0, m_TilesY = 0; /// The number of tiles in each direction.
+		uint32_t m_BinnedWidth = 0, m_BinnedHeight = 0; /// The target size the bins were created for.
+	};
+
+}
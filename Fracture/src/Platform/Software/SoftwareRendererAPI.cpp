@@ -0,0 +1,277 @@
+#include "frpch.h"
+#include "SoftwareRendererAPI.h"
+
+#include "Fracture/Core/JobSystem.h"
+#include "Platform/Software/SoftwareBuffer.h"
+#include "Platform/Software/SoftwareRasterizer.h"
+#include "Platform/Software/SoftwareShader.h"
+#include "Platform/Software/SoftwareVertexArray.h"
+
+namespace Fracture {
+
+	static constexpr uint32_t s_MaxTextureSlots = 32; /// The number of texture slots, the minimum OpenGL 4.5 guarantees.
+	static constexpr uint32_t s_MaxStorageBindings = 8; /// The number of storage buffer binding points, the minimum OpenGL 4.5 guarantees.
+
+	/// The bound state of the software renderer. Kept in a function local static so it exists before any resource is bound.
+	struct SoftwareRendererState
+	{
+		SoftwareRasterizer Rasterizer; /// The rasterizer the draws are queued in.
+		SoftwareFramebuffer Offscreen; /// The render target used when no other target is set.
+		SoftwareFramebuffer* Target = nullptr; /// The render target set with SetRenderTarget.
+		glm::vec4 ClearColour = glm::vec4(0.0f); /// The colour used by Clear.
+
+		const SoftwareVertexArray* VertexArray = nullptr; /// The bound vertex array.
+		const SoftwareShader* Shader = nullptr; /// The bound shader.
+		Ref<SoftwareTextureData> Textures[s_MaxTextureSlots]; /// The bound textures.
+		Ref<std::vector<uint8_t>> StorageBuffers[s_MaxStorageBindings]; /// The data of the bound storage buffers.
+
+		std::vector<SoftwareRasterizer::Vertex> Vertices; /// Scratch storage for the transformed vertices of a draw.
+		std::vector<uint32_t> Indices; /// Scratch storage for the rebased indices of a range draw.
+	};
+
+	static SoftwareRendererState& GetState()
+	{
+		static SoftwareRendererState state;
+		return state;
+	}
+
+	/// The location of an attribute inside a vertex buffer.
+	struct AttributeSource
+	{
+		const uint8_t* Data = nullptr; /// The start of the buffer. nullptr if the attribute is missing.
+		uint32_t Stride = 0; /// The stride of the buffer.
+		uint32_t Offset = 0; /// The offset of the attribute inside a vertex.
+		uint32_t Components = 0; /// The number of floats in the attribute.
+		uint32_t VertexCount = 0; /// The number of vertices in the buffer.
+
+		inline const float* Get(uint32_t vertex) const { return (const float*)(Data + (size_t)vertex * Stride + Offset); }
+	};
+
+	static AttributeSource FindAttribute(const SoftwareVertexArray& vertexArray, std::initializer_list<const char*> names)
+	{
+		for (const auto& vertexBuffer : vertexArray.GetVertexBuffers())
+		{
+			const auto& layout = vertexBuffer->GetLayout();
+			for (const auto& element : layout)
+			{
+				if (std::find_if(names.begin(), names.end(), [&element](const char* name) { return element.Name == name; }) == names.end())
+					continue;
+
+				const auto& data = static_cast<const SoftwareVertexBuffer&>(*vertexBuffer).GetData();
+				AttributeSource source;
+				source.Data = data.data();
+				source.Stride = layout.GetStride();
+				source.Offset = element.Offset;
+				source.Components = element.GetElementCount();
+				source.VertexCount = layout.GetStride() ? (uint32_t)(data.size() / layout.GetStride()) : 0;
+				return source;
+			}
+		}
+		return AttributeSource();
+	}
+
+	/// Transforms the vertices in [firstVertex, endVertex) of the bound vertex array and queues the triangles of the indices, which are relative to firstVertex.
+	static void DrawRange(SoftwareRendererState& state, const glm::mat4& transform, uint32_t firstVertex, uint32_t endVertex, const uint32_t* indices, uint32_t count)
+	{
+		AttributeSource positions = FindAttribute(*state.VertexArray, { "a_Position" });
+		AttributeSource texCoords = FindAttribute(*state.VertexArray, { "a_TexCoord" });
+		AttributeSource colours = FindAttribute(*state.VertexArray, { "a_Color", "a_Colour" });
+		FR_CORE_ASSERT(positions.Data, "The vertex array has no a_Position attribute!");
+		endVertex = std::min(endVertex, positions.VertexCount);
+
+		state.Vertices.resize(endVertex > firstVertex ? endVertex - firstVertex : 0);
+		for (uint32_t i = firstVertex; i < endVertex; i++)
+		{
+			SoftwareRasterizer::Vertex& vertex = state.Vertices[i - firstVertex];
+
+			const float* position = positions.Get(i);
+			glm::vec4 local(position[0], positions.Components > 1 ? position[1] : 0.0f, positions.Components > 2 ? position[2] : 0.0f, 1.0f);
+			vertex.Position = transform * local;
+
+			vertex.TexCoord = glm::vec2(0.0f);
+			if (texCoords.Data && i < texCoords.VertexCount)
+				vertex.TexCoord = glm::vec2(texCoords.Get(i)[0], texCoords.Get(i)[1]);
+
+			vertex.Colour = glm::vec4(1.0f);
+			if (colours.Data && i < colours.VertexCount)
+			{
+				const float* colour = colours.Get(i);
+				vertex.Colour = glm::vec4(colour[0], colour[1], colour[2], colours.Components > 3 ? colour[3] : 1.0f);
+			}
+		}
+
+		const SoftwareShader& shader = *state.Shader;
+		SoftwareRasterizer::DrawState drawState;
+		drawState.Colour = shader.GetColour();
+		drawState.HasVertexColour = colours.Data != nullptr;
+		if (shader.IsTextured())
+		{
+			uint32_t slot = shader.GetTextureSlot();
+			FR_CORE_ASSERT(slot < s_MaxTextureSlots, "Texture slot {0} is out of range!", slot);
+			drawState.Texture = state.Textures[slot];
+		}
+
+		state.Rasterizer.Submit(state.Vertices, indices, count, drawState);
+	}
+
+	/// Draws count indices from firstIndex of the bound index buffer, offset by baseVertex. The indices are rebased on the lowest vertex they reference so only the vertices of the range are transformed.
+	static void DrawIndexRange(SoftwareRendererState& state, const glm::mat4& transform, const std::vector<uint32_t>& indices, uint32_t firstIndex, uint32_t count, int32_t baseVertex)
+	{
+		FR_CORE_ASSERT(firstIndex + count <= indices.size(), "The index range is out of the index buffer!");
+		const uint32_t* first = indices.data() + firstIndex;
+		auto [lowest, highest] = std::minmax_element(first, first + count);
+		state.Indices.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			state.Indices[i] = first[i] - *lowest;
+
+		DrawRange(state, transform, *lowest + baseVertex, *highest + baseVertex + 1, state.Indices.data(), count);
+	}
+
+	SoftwareRendererAPI::SoftwareRendererAPI()
+	{
+		Init();
+	}
+
+	void SoftwareRendererAPI::Init()
+	{
+		JobSystem::Init();
+		m_IsInitialized = true;
+	}
+
+	void SoftwareRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		GetState().ClearColour = color;
+	}
+
+	void SoftwareRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		SoftwareRendererState& state = GetState();
+		if (state.Target == nullptr)
+		{
+			// Resizing discards the pixels so draw what is pending first
+			if (state.Offscreen.GetWidth() != x + width || state.Offscreen.GetHeight() != y + height)
+			{
+				state.Rasterizer.Flush();
+				state.Offscreen.Resize(x + width, y + height);
+			}
+			state.Rasterizer.SetTarget(&state.Offscreen);
+		}
+		state.Rasterizer.SetViewport(x, y, width, height);
+	}
+
+	void SoftwareRendererAPI::Clear()
+	{
+		SoftwareRendererState& state = GetState();
+		state.Rasterizer.Clear(state.ClearColour);
+	}
+
+	void SoftwareRendererAPI::DrawIndexed(uint32_t indexCount)
+	{
+		FR_MEMORY_TAG(Renderer);
+		SoftwareRendererState& state = GetState();
+		FR_CORE_ASSERT(state.VertexArray, "No vertex array is bound!");
+		FR_CORE_ASSERT(state.Shader, "No shader is bound!");
+
+		const Ref<IndexBuffer>& indexBuffer = state.VertexArray->GetIndexBuffer();
+		FR_CORE_ASSERT(indexBuffer, "The vertex array has no index buffer!");
+		const auto& indices = static_cast<const SoftwareIndexBuffer&>(*indexBuffer).GetIndices();
+		uint32_t count = indexCount == 0 ? (uint32_t)indices.size() : std::min(indexCount, (uint32_t)indices.size());
+
+		const SoftwareShader& shader = *state.Shader;
+		glm::mat4 transform = shader.GetMatrix("u_ViewProjection") * shader.GetMatrix("u_Transform");
+		DrawRange(state, transform, 0, 0xFFFFFFFF, indices.data(), count);
+	}
+
+	void SoftwareRendererAPI::DrawIndexedRange(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex)
+	{
+		FR_MEMORY_TAG(Renderer);
+		SoftwareRendererState& state = GetState();
+		FR_CORE_ASSERT(state.VertexArray, "No vertex array is bound!");
+		FR_CORE_ASSERT(state.Shader, "No shader is bound!");
+		if (indexCount == 0)
+			return;
+
+		const Ref<IndexBuffer>& indexBuffer = state.VertexArray->GetIndexBuffer();
+		FR_CORE_ASSERT(indexBuffer, "The vertex array has no index buffer!");
+		const auto& indices = static_cast<const SoftwareIndexBuffer&>(*indexBuffer).GetIndices();
+
+		const SoftwareShader& shader = *state.Shader;
+		glm::mat4 transform = shader.GetMatrix("u_ViewProjection") * shader.GetMatrix("u_Transform");
+		DrawIndexRange(state, transform, indices, firstIndex, indexCount, baseVertex);
+	}
+
+	void SoftwareRendererAPI::DrawIndexedIndirect(const DrawIndexedIndirectCommand& command)
+	{
+		MultiDrawIndexedIndirect(&command, 1);
+	}
+
+	void SoftwareRendererAPI::MultiDrawIndexedIndirect(const DrawIndexedIndirectCommand* commands, uint32_t drawCount)
+	{
+		FR_MEMORY_TAG(Renderer);
+		SoftwareRendererState& state = GetState();
+		FR_CORE_ASSERT(state.VertexArray, "No vertex array is bound!");
+		FR_CORE_ASSERT(state.Shader, "No shader is bound!");
+
+		const Ref<IndexBuffer>& indexBuffer = state.VertexArray->GetIndexBuffer();
+		FR_CORE_ASSERT(indexBuffer, "The vertex array has no index buffer!");
+		const auto& indices = static_cast<const SoftwareIndexBuffer&>(*indexBuffer).GetIndices();
+
+		const SoftwareShader& shader = *state.Shader;
+		glm::mat4 viewProjection = shader.GetMatrix("u_ViewProjection");
+		glm::mat4 defaultTransform = shader.GetMatrix("u_Transform");
+		const Ref<std::vector<uint8_t>>& drawData = state.StorageBuffers[IndirectDrawData::Binding];
+		// A storage buffer stays bound after the multi draw that used it, so only shaders that index it read it
+		uint32_t drawDataCount = drawData && shader.ReadsDrawData() ? (uint32_t)(drawData->size() / sizeof(IndirectDrawData)) : 0;
+
+		for (uint32_t draw = 0; draw < drawCount; draw++)
+		{
+			const DrawIndexedIndirectCommand& command = commands[draw];
+			if (command.Count == 0 || command.InstanceCount == 0)
+				continue;
+
+			glm::mat4 model = draw < drawDataCount ? ((const IndirectDrawData*)drawData->data())[draw].Transform : defaultTransform;
+			DrawIndexRange(state, viewProjection * model, indices, command.FirstIndex, command.Count, command.BaseVertex);
+		}
+	}
+
+	void SoftwareRendererAPI::SetRenderTarget(SoftwareFramebuffer* target)
+	{
+		SoftwareRendererState& state = GetState();
+		state.Target = target;
+		state.Rasterizer.SetTarget(target ? target : &state.Offscreen);
+	}
+
+	SoftwareFramebuffer* SoftwareRendererAPI::GetRenderTarget()
+	{
+		return GetState().Rasterizer.GetTarget();
+	}
+
+	void SoftwareRendererAPI::Flush()
+	{
+		FR_MEMORY_TAG(Renderer);
+		GetState().Rasterizer.Flush();
+	}
+
+	void SoftwareRendererAPI::BindVertexArray(const SoftwareVertexArray* vertexArray)
+	{
+		GetState().VertexArray = vertexArray;
+	}
+
+	void SoftwareRendererAPI::BindShader(const SoftwareShader* shader)
+	{
+		GetState().Shader = shader;
+	}
+
+	void SoftwareRendererAPI::BindTexture(uint32_t slot, const Ref<SoftwareTextureData>& texture)
+	{
+		FR_CORE_ASSERT(slot < s_MaxTextureSlots, "Texture slot {0} is out of range!", slot);
+		GetState().Textures[slot] = texture;
+	}
+
+	void SoftwareRendererAPI::BindStorageBuffer(uint32_t binding, const Ref<std::vector<uint8_t>>& data)
+	{
+		FR_CORE_ASSERT(binding < s_MaxStorageBindings, "Storage buffer binding {0} is out of range!", binding);
+		GetState().StorageBuffers[binding] = data;
+	}
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+/*!
+* @file SoftwareRendererAPI.h
+* @brief Contains the software implementation of the RendererAPI class.
+* 
+* @see RendererAPI
+* @see SoftwareRasterizer
+* 
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Renderer/RendererAPI.h"
+#include "Platform/Software/SoftwareFramebuffer.h"
+#include "Platform/Software/SoftwareTexture.h"
+
+namespace Fracture {
+
+	class SoftwareVertexArray;
+	class SoftwareShader;
+
+	/*!
+	* @brief Implementation of the RendererAPI class that renders on the CPU with the SoftwareRasterizer. Selected with RendererAPI::SetAPI(RendererAPI::API::Software).
+	* 
+	* @details The software resources (vertex arrays, shaders and textures) register themselves here when they are bound, the same way binding works in OpenGL.
+	* Draws are queued in the rasterizer and only written to the render target when it is flushed, which happens on Clear, when the target changes and when the SoftwareContext swaps buffers.
+	* Without a SoftwareContext (for example in a headless run) the renderer draws into an offscreen framebuffer the size of the viewport.
+	* 
+	* @see SoftwareRasterizer
+	* @see SoftwareContext
+	*/
+	class SoftwareRendererAPI : public RendererAPI
+	{
+	public:
+		SoftwareRendererAPI();
+
+		virtual void Init() override;
+
+		virtual void SetClearColor(const glm::vec4& color) override;
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		virtual void Clear() override;
+
+		/*!
+		* @brief Draws indexCount indices of the bound vertex array with the bound shader. If indexCount is 0 the whole index buffer is drawn.
+		* 
+		* @details The vertex buffers are searched for the a_Position, a_TexCoord and a_Color attributes by name. Missing texture coordinates default to 0 and missing colours to white.
+		* 
+		* @param[in] uint32_t indexCount: The number of indices to draw.
+		*/
+		virtual void DrawIndexed(uint32_t indexCount = 0) override;
+
+		/*!
+		* @brief Draws indexCount indices from firstIndex of the bound vertex array with the bound shader. Only the vertices the range references are transformed.
+		* 
+		* @param[in] uint32_t indexCount: The number of indices to draw.
+		* @param[in] uint32_t firstIndex: The first index to draw.
+		* @param[in] int32_t baseVertex: The value added to every index before fetching the vertex.
+		*/
+		virtual void DrawIndexedRange(uint32_t indexCount, uint32_t firstIndex, int32_t baseVertex) override;
+
+		/*!
+		* @brief Draws the command like a multi draw of one command, with the IndirectDrawData at index 0.
+		* 
+		* @param[in] const DrawIndexedIndirectCommand& command: The draw.
+		*/
+		virtual void DrawIndexedIndirect(const DrawIndexedIndirectCommand& command) override;
+
+		/*!
+		* @brief Draws every command as a separate draw of the bound vertex array with the bound shader.
+		* 
+		* @details The model matrix of draw i is the Transform of the IndirectDrawData at index i of the storage buffer bound to IndirectDrawData::Binding,
+		* or u_Transform when none is bound or the shader does not use gl_DrawID. Only the vertices a command references are transformed. The material index is ignored; every draw uses the colour of the shader.
+		* 
+		* @param[in] const DrawIndexedIndirectCommand* commands: The draws.
+		* @param[in] uint32_t drawCount: The number of draws.
+		*/
+		virtual void MultiDrawIndexedIndirect(const DrawIndexedIndirectCommand* commands, uint32_t drawCount) override;
+
+		virtual bool IsInitialized() const override { return m_IsInitialized; }
+
+		/*!
+		* @brief Sets the framebuffer the renderer draws into. Passing nullptr switches back to the offscreen framebuffer.
+		* 
+		* @param[in] SoftwareFramebuffer* target: The render target.
+		*/
+		static void SetRenderTarget(SoftwareFramebuffer* target);
+
+		/*!
+		* @brief Returns the framebuffer the renderer currently draws into. Call Flush before reading the pixels.
+		*/
+		static SoftwareFramebuffer* GetRenderTarget();
+
+		/*!
+		* @brief Rasterizes all the queued draws into the render target.
+		*/
+		static void Flush();
+
+		// Called by the software resources when they are bound
+		static void BindVertexArray(const SoftwareVertexArray* vertexArray);
+		static void BindShader(const SoftwareShader* shader);
+		static void BindTexture(uint32_t slot, const Ref<SoftwareTextureData>& texture);
+		static void BindStorageBuffer(uint32_t binding, const Ref<std::vector<uint8_t>>& data);
+	private:
+		bool m_IsInitialized = false; /// Flag to check if the SoftwareRendererAPI is initialized.
+	};
+
+}
@@ -0,0 +1,84 @@
+#include "frpch.h"
+#include "SoftwareShader.h"
+
+#include "Fracture\Utils\Helpers.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
+
+#include <regex>
+
+namespace Fracture
+{
+
+	static uint32_t NextShaderHandle()
+	{
+		static std::atomic<uint32_t> s_NextHandle = 1;
+		return s_NextHandle++;
+	}
+
+	SoftwareShader::SoftwareShader(const std::string& name, const std::string& vertex_source, const std::string fragment_source) :
+		m_Handle(NextShaderHandle()), m_Name(name)
+	{
+		m_ReadsDrawData = vertex_source.find("gl_DrawID") != std::string::npos;
+		Reflect(fragment_source);
+	}
+
+	SoftwareShader::SoftwareShader(const std::string& name, const std::string& shaderFilePath) :
+		m_Handle(NextShaderHandle()), m_Name(name)
+	{
+		std::string source = Utils::ReadFile(shaderFilePath);
+		m_ReadsDrawData = source.find("gl_DrawID") != std::string::npos;
+
+		// Only the fragment part of the file declares the uniforms the fixed pipeline cares about
+		const std::string fragmentToken = "_TYPE_FRAGMENT_SHADER";
+		size_t pos = source.find(fragmentToken);
+		if (pos == std::string::npos)
+			pos = source.find("_TYPE_PIXEL_SHADER");
+		FR_CORE_ASSERT(pos != std::string::npos, "Shader {0} has no fragment shader", shaderFilePath);
+
+		Reflect(source.substr(pos));
+	}
+
+	void SoftwareShader::Reflect(const std::string& fragmentSource)
+	{
+		std::smatch match;
+		static const std::regex samplerRegex(R"(uniform\s+sampler2D\s+(\w+)\s*;)");
+		if (std::regex_search(fragmentSource, match, samplerRegex))
+			m_SamplerName = match[1];
+
+		static const std::regex colourRegex(R"(uniform\s+vec4\s+(\w+)\s*;)");
+		if (std::regex_search(fragmentSource, match, colourRegex))
+			m_ColourName = match[1];
+	}
+
+	void SoftwareShader::Bind() const
+	{
+		SoftwareRendererAPI::BindShader(this);
+	}
+
+	void SoftwareShader::Unbind() const
+	{
+		SoftwareRendererAPI::BindShader(nullptr);
+	}
+
+	glm::mat4 SoftwareShader::GetMatrix(const std::string& name) const
+	{
+		auto it = m_Matrices.find(name);
+		return it != m_Matrices.end() ? it->second : glm::mat4(1.0f);
+	}
+
+	glm::vec4 SoftwareShader::GetColour() const
+	{
+		if (m_ColourName.empty())
+			return glm::vec4(1.0f);
+
+		auto it = m_Floats.find(m_ColourName);
+		return it != m_Floats.end() ? it->second : glm::vec4(1.0f);
+	}
+
+	uint32_t SoftwareShader::GetTextureSlot() const
+	{
+		auto it = m_Ints.find(m_SamplerName);
+		return it != m_Ints.end() ? (uint32_t)it->second : 0;
+	}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+/*!
+* @file SoftwareShader.h
+* @brief Contains the software renderer implementation of the Shader class.
+* 
+* @see Shader
+* @see SoftwareRendererAPI
+* 
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Core/Core.h"
+#include "Fracture/Renderer/Shader.h"
+
+namespace Fracture
+{
+	/*!
+	* @brief Implementation of the Shader class for the software renderer.
+	* 
+	* @details The GLSL source is not executed. The software renderer runs a fixed pipeline: the position is transformed by u_ViewProjection * u_Transform and the
+	* output colour is the vertex colour (a_Color, if the layout has one) multiplied by the first vec4 uniform of the fragment shader and the texture bound to the first sampler2D uniform.
+	* The source is only scanned for those uniform declarations so the shaders in the assets folder work with both renderers.
+	*/
+	class SoftwareShader : public Shader
+	{
+	public:
+		/*!
+		* @brief Constructor that takes the vertex and fragment sources.
+		* 
+		* @param[in] const std::string& name: The name of the shader.
+		* @param[in] const std::string& vertex_source: The vertex shader source.
+		* @param[in] const std::string fragment_source: The fragment shader source.
+		*/
+		SoftwareShader(const std::string& name, const std::string& vertex_source, const std::string fragment_source);
+
+		/*!
+		* @brief Constructor that loads a combined shader file.
+		* 
+		* @param[in] const std::string& name: The name of the shader.
+		* @param[in] const std::string& shaderFilePath: The path to the shader file.
+		*/
+		SoftwareShader(const std::string& name, const std::string& shaderFilePath);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void SetInt(const std::string& name, int value) override { m_Ints[name] = value; }
+		virtual void SetInt2(const std::string& name, const glm::ivec2& values) override { m_Ints[name] = values.x; }
+		virtual void SetInt3(const std::string& name, const glm::ivec3& values) override { m_Ints[name] = values.x; }
+		virtual void SetInt4(const std::string& name, const glm::ivec4& values) override { m_Ints[name] = values.x; }
+
+		virtual void SetFloat(const std::string& name, float value) override { m_Floats[name] = glm::vec4(value, 0.0f, 0.0f, 1.0f); }
+		virtual void SetFloat2(const std::string& name, const glm::vec2& values) override { m_Floats[name] = glm::vec4(values.x, values.y, 0.0f, 1.0f); }
+		virtual void SetFloat3(const std::string& name, const glm::vec3& values) override { m_Floats[name] = glm::vec4(values.x, values.y, values.z, 1.0f); }
+		virtual void SetFloat4(const std::string& name, const glm::vec4& values) override { m_Floats[name] = values; }
+
+		virtual void SetMat3(const std::string& name, const glm::mat3& matrix) override { m_Matrices[name] = glm::mat4(matrix); }
+		virtual void SetMat4(const std::string& name, const glm::mat4& matrix) override { m_Matrices[name] = matrix; }
+
+		virtual void SetBool(const std::string& name, bool value) override { m_Ints[name] = value; }
+
+		virtual const std::string& GetName() const override { return m_Name; }
+		virtual const uint32_t& GetHandle() const override { return m_Handle; }
+
+		/*!
+		* @brief Returns the matrix uniform with the given name or the identity if it was never set.
+		*/
+		glm::mat4 GetMatrix(const std::string& name) const;
+
+		/*!
+		* @brief Returns the colour the fragments are multiplied by. White if the shader has no vec4 uniform or it was never set.
+		*/
+		glm::vec4 GetColour() const;
+
+		/*!
+		* @brief Returns whether the fragment shader samples a texture.
+		*/
+		inline bool IsTextured() const { return !m_SamplerName.empty(); }
+
+		/*!
+		* @brief Returns whether the vertex shader reads its model matrix from the indirect draw data with gl_DrawID instead of u_Transform.
+		*/
+		inline bool ReadsDrawData() const { return m_ReadsDrawData; }
+
+		/*!
+		* @brief Returns the texture slot the sampler reads from. Defaults to 0 like an unset sampler in OpenGL.
+		*/
+		uint32_t GetTextureSlot() const;
+	private:
+		/*!
+		* @brief Finds the sampler2D and vec4 uniforms used by the fixed pipeline in the fragment shader source.
+		*/
+		void Reflect(const std::string& fragmentSource);
+	private:
+		uint32_t m_Handle; /// A unique id so the renderer can skip rebinding the same shader.
+		std::string m_Name; /// The name of the shader mostly used for debugging and identification
+		std::string m_SamplerName; /// The name of the sampler2D uniform. Empty if the shader is not textured.
+		std::string m_ColourName; /// The name of the vec4 uniform used as the colour. Empty if there is none.
+		bool m_ReadsDrawData = false; /// Whether the source uses gl_DrawID, so multi draws take their model matrices from the draw data.
+		std::unordered_map<std::string, int> m_Ints; /// The int and bool uniforms.
+		std::unordered_map<std::string, glm::vec4> m_Floats; /// The float and vector uniforms padded to vec4.
+		std::unordered_map<std::string, glm::mat4> m_Matrices; /// The matrix uniforms.
+	};
+
+}
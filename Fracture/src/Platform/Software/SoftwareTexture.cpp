@@ -0,0 +1,56 @@
+#include "frpch.h"
+#include "SoftwareTexture.h"
+
+#include "Platform/Software/SoftwareFramebuffer.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
+
+#include <stb_image.h>
+
+namespace Fracture {
+
+	static uint32_t NextTextureHandle()
+	{
+		static std::atomic<uint32_t> s_NextHandle = 1;
+		return s_NextHandle++;
+	}
+
+	SoftwareTexture2D::SoftwareTexture2D(const std::string& path) :
+		m_Path(path), m_Data(CreateRef<SoftwareTextureData>()), m_Handle(NextTextureHandle())
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(1);
+		stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+		FR_CORE_ASSERT(data, "Failed to load image: {}", path);
+		FR_CORE_ASSERT(channels == 3 || channels == 4, "Format not supported");
+
+		m_Data->Width = width;
+		m_Data->Height = height;
+		m_Data->Texels.resize((size_t)width * height);
+		for (size_t i = 0; i < m_Data->Texels.size(); i++)
+		{
+			const stbi_uc* texel = data + i * channels;
+			uint32_t alpha = channels == 4 ? texel[3] : 255;
+			m_Data->Texels[i] = texel[0] | (texel[1] << 8) | (texel[2] << 16) | (alpha << 24);
+		}
+
+		// Same filtering as OpenGLTexture2D
+		m_Data->LinearMin = true;
+		m_Data->LinearMag = false;
+
+		stbi_image_free(data);
+	}
+
+	SoftwareTexture2D::SoftwareTexture2D(uint32_t width, uint32_t height, glm::vec4 color) :
+		m_Path("None"), m_Data(CreateRef<SoftwareTextureData>()), m_Handle(NextTextureHandle())
+	{
+		m_Data->Width = width;
+		m_Data->Height = height;
+		m_Data->Texels.assign((size_t)width * height, SoftwareFramebuffer::PackColour(color));
+	}
+
+	void SoftwareTexture2D::Bind(uint32_t slot) const
+	{
+		SoftwareRendererAPI::BindTexture(slot, m_Data);
+	}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+/*!
+* @file SoftwareTexture.h
+* @brief Contains the software renderer implementation of the Texture2D class.
+* 
+* @see Texture2D
+* @see SoftwareRasterizer
+* 
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Renderer\Texture.h"
+
+namespace Fracture {
+
+	/*!
+	* @brief The texels and sampling state of a software texture. Held through a shared pointer so queued draws keep the texture alive until they are rasterized.
+	*/
+	struct SoftwareTextureData
+	{
+		uint32_t Width = 0; /// The width of the texture in texels.
+		uint32_t Height = 0; /// The height of the texture in texels.
+		std::vector<uint32_t> Texels; /// Packed RGBA8 texels. Row 0 is the bottom row, the same as the OpenGL textures.
+		bool LinearMin = true; /// Whether minification uses bilinear filtering (GL_LINEAR) or nearest.
+		bool LinearMag = true; /// Whether magnification uses bilinear filtering (GL_LINEAR) or nearest.
+	};
+
+	/*!
+	* @brief Implementation of the Texture2D class for the software renderer. Uses the same filtering as OpenGLTexture2D.
+	* 
+	* @see Texture2D
+	*/
+	class SoftwareTexture2D : public Texture2D
+	{
+	public:
+		/*!
+		* @brief Constructor that loads the texture from a file using stb_image. 3 channel images are expanded to RGBA.
+		* 
+		* @param[in] const std::string& path: The path to the image.
+		*/
+		SoftwareTexture2D(const std::string& path);
+
+		/*!
+		* @brief Constructor that creates a texture of a single colour.
+		* 
+		* @param[in] uint32_t width: The width of the texture.
+		* @param[in] uint32_t height: The height of the texture.
+		* @param[in] glm::vec4 color: The colour of every texel.
+		*/
+		SoftwareTexture2D(uint32_t width, uint32_t height, glm::vec4 color);
+
+		virtual uint32_t GetWidth() const override { return m_Data->Width; }
+		virtual uint32_t GetHeight() const override { return m_Data->Height; }
+		virtual uint32_t GetHandle() const override { return m_Handle; }
+
+		/*!
+		* @brief Binds the texture to a slot of the software renderer.
+		* 
+		* @param[in] uint32_t slot: The slot to bind the texture to.
+		*/
+		virtual void Bind(uint32_t slot = 0) const override;
+
+		inline const Ref<SoftwareTextureData>& GetData() const { return m_Data; }
+	private:
+		std::string m_Path; /// The path of the image or "None" for colour textures.
+		Ref<SoftwareTextureData> m_Data; /// The texels of the texture.
+		uint32_t m_Handle; /// A unique id so the texture can be identified like an OpenGL handle.
+	};
+
+}
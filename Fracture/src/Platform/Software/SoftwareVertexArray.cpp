@@ -0,0 +1,24 @@
+#include "frpch.h"
+#include "SoftwareVertexArray.h"
+
+#include "Platform/Software/SoftwareRendererAPI.h"
+
+namespace Fracture {
+
+	void SoftwareVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		FR_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex buffer has no layout!");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void SoftwareVertexArray::Bind() const
+	{
+		SoftwareRendererAPI::BindVertexArray(this);
+	}
+
+	void SoftwareVertexArray::Unbind() const
+	{
+		SoftwareRendererAPI::BindVertexArray(nullptr);
+	}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+/*!
+* @file SoftwareVertexArray.h
+* @brief Contains the software renderer implementation of the VertexArray class.
+* 
+* @see VertexArray
+* 
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture\Renderer\VertexArray.h"
+
+namespace Fracture {
+
+	/*!
+	* @brief Implementation of the VertexArray class for the software renderer. Only keeps references to the buffers; binding makes it the array read by DrawIndexed.
+	* 
+	* @see VertexArray
+	*/
+	class SoftwareVertexArray : public VertexArray
+	{
+	public:
+		SoftwareVertexArray() = default;
+
+		/*!
+		* @brief Adds a vertex buffer to the vertex array. The buffer must have a layout.
+		* 
+		* @param[in] const Ref<VertexBuffer>& vertexBuffer: The vertex buffer to add.
+		*/
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+
+		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override { m_IndexBuffer = indexBuffer; }
+
+		virtual const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
+
+		virtual void SetBounds(const AABB& bounds) override { m_Bounds = bounds; }
+		virtual const AABB& GetBounds() const override { return m_Bounds; }
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+	private:
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers; /// A vector of vertex buffers.
+		Ref<IndexBuffer> m_IndexBuffer; /// The index buffer of the vertex array.
+		AABB m_Bounds; /// The model space bounds of the vertices.
+	};
+
+}
@@ -1,47 +0,0 @@
-#include "frpch.h"
-
-#include "WindowsInput.h"
-#include "Fracture\Core\Application.h"
-
-#include <GLFW\glfw3.h>
-
-namespace Fracture {
-
-	// We create the static instance of the Input class here because we want different implementations of the Input class for different platforms.
-	Scope<Input> Input::s_Instance = CreateScope<WindowsInput>();
-
-	bool WindowsInput::IsKeyPressedImpl(int keyCode)
-	{
-		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		auto state = glfwGetKey(window, keyCode);
-		return state == GLFW_PRESS || state == GLFW_REPEAT;
-	}
-
-	bool WindowsInput::IsMouseButtonPressedImpl(int button)
-	{
-		GLFWwindow* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		auto  state = glfwGetMouseButton(window, button);
-		return state == GLFW_PRESS || state == GLFW_REPEAT;
-	}
-
-	float WindowsInput::GetMouseXImpl()
-	{
-		auto[x, y] = GetMousePositionImpl();
-		return x;
-	}
-
-	float WindowsInput::GetMouseYImpl()
-	{
-		auto[x, y] = GetMousePositionImpl();
-		return y;
-	}
-
-	std::pair<float, float> WindowsInput::GetMousePositionImpl()
-	{
-		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		double xpos, ypos;
-		glfwGetCursorPos(window, &xpos, &ypos);
-		return std::pair<float, float>((float)xpos, (float)ypos);
-	}
-
-}
@@ -1,11 +1,11 @@
 #include "frpch.h"
 #include "WindowsWindow.h"
 
-#include "Fracture\Events\ApplicationEvent.h"
-#include "Fracture\Events\KeyEvent.h"
-#include "Fracture\Events\MouseEvent.h"
+#include "Fracture\Events\EventQueue.h"
 
+#include "Fracture\Renderer\RendererAPI.h"
 #include "Platform\OpenGL\OpenGLContext.h"
+#include "Platform\Software\SoftwareContext.h"
 
 
 namespace Fracture {
@@ -40,7 +40,8 @@ namespace Fracture {
 		m_Data.Width = props.Width;
 		m_Data.Height = props.Height;
 
-		FR_CORE_INFO("Creating window OpenGL: {0} ({1}, {2})", m_Data.Title, m_Data.Width, m_Data.Height);
+		bool software = RendererAPI::GetAPI() == RendererAPI::API::Software;
+		FR_CORE_INFO("Creating window {0}: {1} ({2}, {3})", software ? "Software" : "OpenGL", m_Data.Title, m_Data.Width, m_Data.Height);
 
 
 		if (s_GLFWWindowCount == 0) // initialize GLFW on first window creation
@@ -50,10 +51,16 @@ namespace Fracture {
 			glfwSetErrorCallback(GLFWErrorCallback);
 		}
 
+		// The software renderer presents through GDI so the window must not own an OpenGL context
+		glfwWindowHint(GLFW_CLIENT_API, software ? GLFW_NO_API : GLFW_OPENGL_API);
+		glfwWindowHint(GLFW_VISIBLE, props.Visible ? GLFW_TRUE : GLFW_FALSE);
 		m_Window = glfwCreateWindow((int)m_Data.Width, (int)m_Data.Height, m_Data.Title.c_str(), nullptr, nullptr);
 		++s_GLFWWindowCount; // increment window count
 
-		m_Context = CreateScope<OpenGLContext>(m_Window);
+		if (software)
+			m_Context = CreateScope<SoftwareContext>(m_Window);
+		else
+			m_Context = CreateScope<OpenGLContext>(m_Window);
 		m_Context->Init(); // initialize the graphics context. This will load all OpenGL function pointers via GLAD. We pass glfwGetProcAddress to gladLoadGLLoader to load the OpenGL function pointers that are unique to the current context (in this case the GLFW window we just created).
 
 		// in glfw we can provide a pointer to some user-defined data with glfwSetWindowUserPointer. We can use this to store a pointer to our WindowData struct.
@@ -69,16 +76,14 @@ namespace Fracture {
 				data.Width = width;
 				data.Height = height;
 
-				WindowResizeEvent event(width, height);
-				data.EventCallback(event);
+				data.Queue->Push(QueuedEvent::WindowResize(width, height));
 			});
 
 		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
 			{
 				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window); // get window data from user pointer
 
-				WindowCloseEvent event;
-				data.EventCallback(event);
+				data.Queue->Push(QueuedEvent::WindowClose());
 			});
 
 		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
@@ -89,20 +94,17 @@ namespace Fracture {
 				{
 					case GLFW_PRESS:
 					{
-						KeyPressedEvent event(key, false, mods);
-						data.EventCallback(event);
+						data.Queue->Push(QueuedEvent::KeyPressed(key, false, mods));
 						break;
 					}
 					case GLFW_RELEASE:
 					{
-						KeyReleasedEvent event(key, mods);
-						data.EventCallback(event);
+						data.Queue->Push(QueuedEvent::KeyReleased(key, mods));
 						break;
 					}
 					case GLFW_REPEAT:
 					{
-						KeyPressedEvent event(key, true, mods);
-						data.EventCallback(event);
+						data.Queue->Push(QueuedEvent::KeyPressed(key, true, mods));
 						break;
 					}
 				}
@@ -112,8 +114,7 @@ namespace Fracture {
 			{
 				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-				KeyTypedEvent event(keycode);
-				data.EventCallback(event);
+				data.Queue->Push(QueuedEvent::KeyTyped((int32_t)keycode));
 			});
 
 		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods)
@@ -124,14 +125,12 @@ namespace Fracture {
 				{
 					case GLFW_PRESS:
 					{
-						MouseButtonPressedEvent event(button, mods);
-						data.EventCallback(event);
+						data.Queue->Push(QueuedEvent::MouseButtonPressed(button, mods));
 						break;
 					}
 					case GLFW_RELEASE:
 					{
-						MouseButtonReleasedEvent event(button, mods);
-						data.EventCallback(event);
+						data.Queue->Push(QueuedEvent::MouseButtonReleased(button, mods));
 						break;
 					}
 				}
@@ -141,16 +140,14 @@ namespace Fracture {
 			{
 				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window); // get window data from user pointer
 
-				MouseMovedEvent event((float)xpos, (float)ypos);
-				data.EventCallback(event);
+				data.Queue->Push(QueuedEvent::MouseMoved((float)xpos, (float)ypos));
 			});
 
 		glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double xoffset, double yoffset)
 			{
 				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window); // get window data from user pointer
 
-				MouseScrolledEvent event((float)xoffset, (float)yoffset);
-				data.EventCallback(event);
+				data.Queue->Push(QueuedEvent::MouseScrolled((float)xoffset, (float)yoffset));
 			});
 	}
 
@@ -163,17 +160,36 @@ namespace Fracture {
 	{
 		{
 			FR_PROFILE_SCOPE("WindowsWindow::OnUpdate::glfwPollEvents");
-			glfwPollEvents(); // checks if any events are triggered (like keyboard input or mouse movement events), updates the window state, and calls the corresponding functions (which we can set via callback methods)
+			FR_MEMORY_TAG(Events);
+			glfwPollEvents(); // checks if any events are triggered (like keyboard input or mouse movement events), updates the window state, and calls the callbacks, which push the events to the queue
 		}
 		m_Context->SwapBuffers(); // swap the color buffer (a large buffer that contains color values for each pixel in GLFW's window) that is used to render to during this render iteration and show it as output to the screen.
 	}
 
+	void WindowsWindow::SetEventQueue(EventQueue* queue)
+	{
+		m_Data.Queue = queue;
+
+		double xpos, ypos;
+		glfwGetCursorPos(m_Window, &xpos, &ypos);
+		m_Data.Queue->Push(QueuedEvent::MouseMoved((float)xpos, (float)ypos));
+	}
+
+	void WindowsWindow::SetSize(uint32_t width, uint32_t height)
+	{
+		glfwSetWindowSize(m_Window, (int)width, (int)height);
+	}
+
 	void WindowsWindow::SetVSync(bool enabled)
 	{
-		if (enabled)
-			glfwSwapInterval(1);
-		else
-			glfwSwapInterval(0);
+		// The software renderer presents with GDI and has no swap interval to set
+		if (RendererAPI::GetAPI() != RendererAPI::API::Software)
+		{
+			if (enabled)
+				glfwSwapInterval(1);
+			else
+				glfwSwapInterval(0);
+		}
 
 		m_Data.VSync = enabled;
 	}
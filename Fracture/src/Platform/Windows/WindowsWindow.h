@@ -65,13 +65,23 @@ namespace Fracture {
 		inline uint32_t GetHeight() const override { return m_Data.Height; }
 
 		/*!
-		* @brief Function that sets the event callback function for the window.
+		* @brief Function that sets the queue the window events are pushed to.
 		* 
-		* @param[in] const EventCallbackFn& callback: The callback function to set.
+		* @details Pushes the current cursor position first, so the input state knows it before the mouse moves.
 		* 
-		* @see EventCallbackFn
+		* @param[in] EventQueue* queue: The queue to push to.
+		* 
+		* @see EventQueue
+		*/
+		void SetEventQueue(EventQueue* queue) override;
+
+		/*!
+		* @brief Function that resizes the window with glfwSetWindowSize. The size callback updates the window data and pushes the event.
+		* 
+		* @param[in] uint32_t width: The new width of the window.
+		* @param[in] uint32_t height: The new height of the window.
 		*/
-		inline void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
+		void SetSize(uint32_t width, uint32_t height) override;
 
 		/*!
 		* @brief Function that sets the VSync for the window.
@@ -128,7 +138,7 @@ namespace Fracture {
 		{
 			std::string Title; /// The title of the window.
 			uint32_t Width, Height; /// The width and height of the window.
-			EventCallbackFn EventCallback; /// The event callback function for the window.
+			EventQueue* Queue = nullptr; /// The queue the glfw callbacks push the window events to.
 			bool VSync; /// Whether VSync is enabled or not.
 
 			WindowData() = default;
@@ -0,0 +1,49 @@
+#ifdef _TYPE_VERTEX_SHADER
+
+	#extension GL_ARB_shader_draw_parameters : require
+
+	layout(location = 0) in vec3 a_Position;
+
+	// One entry per draw of the multi draw, see IndirectDrawData
+	struct DrawData
+	{
+		mat4 Transform;
+		uint MaterialIndex;
+	};
+
+	layout(std430, binding = 0) readonly buffer DrawDataBuffer
+	{
+		DrawData u_Draws[];
+	};
+
+	uniform mat4 u_ViewProjection;
+
+	flat out uint v_MaterialIndex;
+
+	void main()
+	{
+		DrawData draw = u_Draws[gl_DrawIDARB];
+		gl_Position = u_ViewProjection * draw.Transform * vec4(a_Position, 1.0);
+		v_MaterialIndex = draw.MaterialIndex;
+	}
+#endif
+
+#ifdef _TYPE_FRAGMENT_SHADER
+
+	layout(location = 0) out vec4 color;
+
+	layout(std430, binding = 1) readonly buffer MaterialBuffer
+	{
+		vec4 u_MaterialColours[];
+	};
+
+	uniform vec4 u_Colour; // Only used by the software renderer, which ignores the material index
+
+	flat in uint v_MaterialIndex;
+
+	void main()
+	{
+		color = u_MaterialColours[v_MaterialIndex];
+	}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "AnimationLayers.h"
+#include "Shapes.h"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+
+namespace Sandbox {
+
+	GridAnimationLayer::GridAnimationLayer(Fracture::World& world, Fracture::TransformSystem& transforms, SceneAnimation& animation) :
+		Layer("GridAnimation"), m_World(world), m_Transforms(transforms), m_Animation(animation)
+	{
+		m_UpdateDesc.Phase = Fracture::LayerUpdatePhase::PreUpdate;
+		m_UpdateDesc.Parallel = true;
+		m_UpdateDesc.Writes = { "GridTransforms" };
+	}
+
+	void GridAnimationLayer::OnUpdate(Fracture::Utils::Timestep deltaTime)
+	{
+		if (!m_Animation.AnimateSquares)
+			return;
+
+		glm::vec3 rotation(0.0f, 0.0f, m_Animation.SquareSpeed * deltaTime);
+		m_World.GetQuery<const Fracture::TransformHandle, const GridCellComponent>().Each([this, &rotation](Fracture::Entity, const Fracture::TransformHandle& transform, const GridCellComponent&)
+		{
+			m_Transforms.Rotate(transform, rotation);
+		});
+		m_Animation.GridMoved = true;
+	}
+
+	PolygonAnimationLayer::PolygonAnimationLayer(SceneAnimation& animation) :
+		Layer("PolygonAnimation"), m_Animation(animation)
+	{
+		m_UpdateDesc.Phase = Fracture::LayerUpdatePhase::PreUpdate;
+		m_UpdateDesc.Parallel = true;
+		m_UpdateDesc.Writes = { "PolygonTransforms" };
+		UpdateTransforms();
+	}
+
+	void PolygonAnimationLayer::OnUpdate(Fracture::Utils::Timestep deltaTime)
+	{
+		m_Animation.PolygonAngle = std::fmod(m_Animation.PolygonAngle + m_Animation.PolygonSpeed * deltaTime, glm::two_pi<float>());
+		UpdateTransforms();
+	}
+
+	void PolygonAnimationLayer::UpdateTransforms()
+	{
+		m_Animation.PolygonTransforms.resize(SceneAnimation::PolygonCount);
+		for (uint32_t i = 0; i < SceneAnimation::PolygonCount; i++)
+		{
+			float angle = m_Animation.PolygonAngle + glm::two_pi<float>() * i / SceneAnimation::PolygonCount;
+			m_Animation.PolygonTransforms[i] = glm::translate(glm::mat4(1.0f), glm::vec3(1.5f * std::cos(angle), 1.5f * std::sin(angle), 0.0f)) * glm::scale(glm::mat4(1.0f), glm::vec3(0.12f));
+		}
+	}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Fracture.h"
+
+#include <vector>
+
+
+namespace Sandbox
+{
+
+	/// The settings and the results of the scene animations. Edited and drawn by Sandbox2D, advanced by the animation layers.
+	struct SceneAnimation
+	{
+		static constexpr uint32_t PolygonCount = 64; /// The number of polygons in the ring.
+
+		bool AnimateSquares = false; /// Whether GridAnimationLayer rotates the grid squares.
+		float SquareSpeed = 0.5f; /// The rotation speed of every grid square in radians per second.
+		bool GridMoved = false; /// Set by GridAnimationLayer when it rotated the squares, cleared by Sandbox2D when it refits the grid.
+
+		float PolygonSpeed = 0.25f; /// The rotation speed of the polygon ring in radians per second.
+		float PolygonAngle = 0.0f; /// The current rotation of the polygon ring.
+		std::vector<glm::mat4> PolygonTransforms; /// The model matrices of the polygons of the ring, written by PolygonAnimationLayer.
+	};
+
+	/*!
+	* @brief Rotates every grid square of the scene. Updates on a worker thread in the PreUpdate phase, next to PolygonAnimationLayer.
+	*
+	* @details Only the transforms of the grid are written, so the layer declares them as its one resource. Sandbox2D updates on the main thread in
+	* the Update phase and reads them after both animation layers finished.
+	*/
+	class GridAnimationLayer : public Fracture::Layer
+	{
+	public:
+		/*!
+		* @brief Constructor for the GridAnimationLayer class.
+		*
+		* @param[in] Fracture::World& world: The world with the grid squares. Must outlive the layer.
+		* @param[in] Fracture::TransformSystem& transforms: The transforms of the grid squares. Must outlive the layer.
+		* @param[in] SceneAnimation& animation: The settings of the animation. Must outlive the layer.
+		*/
+		GridAnimationLayer(Fracture::World& world, Fracture::TransformSystem& transforms, SceneAnimation& animation);
+		virtual ~GridAnimationLayer() = default;
+
+		virtual void OnUpdate(Fracture::Utils::Timestep deltaTime) override;
+	private:
+		Fracture::World& m_World;
+		Fracture::TransformSystem& m_Transforms;
+		SceneAnimation& m_Animation;
+	};
+
+	/*!
+	* @brief Turns the ring of polygons. Updates on a worker thread in the PreUpdate phase, next to GridAnimationLayer.
+	*/
+	class PolygonAnimationLayer : public Fracture::Layer
+	{
+	public:
+		/*!
+		* @brief Constructor for the PolygonAnimationLayer class. Fills the transforms of the ring so they are valid before the first update.
+		*
+		* @param[in] SceneAnimation& animation: The settings of the animation. Must outlive the layer.
+		*/
+		PolygonAnimationLayer(SceneAnimation& animation);
+		virtual ~PolygonAnimationLayer() = default;
+
+		virtual void OnUpdate(Fracture::Utils::Timestep deltaTime) override;
+	private:
+		/*!
+		* @brief Writes the model matrices of the ring at the current angle.
+		*/
+		void UpdateTransforms();
+	private:
+		SceneAnimation& m_Animation;
+	};
+
+}
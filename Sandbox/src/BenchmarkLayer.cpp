@@ -0,0 +1,92 @@
+#include "BenchmarkLayer.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+
+namespace Sandbox {
+
+	std::string FormatBenchmarkLine(const char* format, ...)
+	{
+		char line[256];
+		va_list args;
+		va_start(args, format);
+		vsnprintf(line, sizeof(line), format, args);
+		va_end(args);
+		return line;
+	}
+
+	BenchmarkLayer::BenchmarkLayer() :
+		Layer("BenchmarkLayer")
+	{
+		m_EventHandlers.Subscribe<&BenchmarkLayer::OnBenchmarkStart>(this);
+		m_EventHandlers.Subscribe<&BenchmarkLayer::OnBenchmarkFinished>(this);
+	}
+
+	void BenchmarkLayer::OnDetach()
+	{
+		if (m_Thread.joinable())
+			m_Thread.join();
+	}
+
+	void BenchmarkLayer::Add(const std::string& name, BenchmarkFn benchmark)
+	{
+		m_Benchmarks.push_back({ name, std::move(benchmark), {} });
+	}
+
+	void BenchmarkLayer::OnImGuiRender()
+	{
+		ImGui::Begin("Benchmarks");
+		if (m_Running)
+			ImGui::Text("Benchmark running, the other layers are paused...");
+		for (uint32_t i = 0; i < (uint32_t)m_Benchmarks.size(); i++)
+		{
+			Benchmark& benchmark = m_Benchmarks[i];
+			if (!m_Running && ImGui::Button(benchmark.Name.c_str()))
+			{
+				// Suspended from the next frame on, the benchmark starts when that frame dispatches the posted event
+				for (Fracture::Layer* layer : Fracture::Application::Get().GetLayerStack())
+				{
+					if (layer != this && !layer->IsSuspended())
+					{
+						layer->SetSuspended(true);
+						m_SuspendedLayers.push_back(layer);
+					}
+				}
+				m_Running = true;
+				Fracture::Application::Get().PostEvent<BenchmarkStartEvent>(i);
+			}
+			for (const std::string& line : benchmark.Report)
+				ImGui::Text("%s", line.c_str());
+		}
+		ImGui::End();
+	}
+
+	bool BenchmarkLayer::OnBenchmarkStart(BenchmarkStartEvent& e)
+	{
+		if (m_Thread.joinable())
+			m_Thread.join();
+		uint32_t index = e.GetIndex();
+		BenchmarkFn run = m_Benchmarks[index].Run;
+		m_Thread = std::thread([index, run]() { Fracture::Application::Get().PostEvent<BenchmarkFinishedEvent>(index, run()); });
+		return true;
+	}
+
+	bool BenchmarkLayer::OnBenchmarkFinished(BenchmarkFinishedEvent& e)
+	{
+		m_Thread.join();
+		m_Benchmarks[e.GetIndex()].Report = std::move(e.GetReport());
+
+		// Only the layers that are still in the stack, one could have been popped meanwhile
+		for (Fracture::Layer* layer : Fracture::Application::Get().GetLayerStack())
+		{
+			if (std::find(m_SuspendedLayers.begin(), m_SuspendedLayers.end(), layer) != m_SuspendedLayers.end())
+				layer->SetSuspended(false);
+		}
+		m_SuspendedLayers.clear();
+		m_Running = false;
+		return true;
+	}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "Fracture.h"
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace Sandbox
+{
+
+	/// The lines a benchmark reports, drawn under its button.
+	using BenchmarkReport = std::vector<std::string>;
+
+	/// A benchmark run by BenchmarkLayer. Runs on the benchmark thread and returns its report.
+	using BenchmarkFn = std::function<BenchmarkReport()>;
+
+	/*!
+	* @brief Formats one line of a BenchmarkReport like printf.
+	*/
+	std::string FormatBenchmarkLine(const char* format, ...);
+
+	/// Posted by BenchmarkLayer when a button is pressed. Starts the benchmark one frame later, once the other layers are suspended.
+	class BenchmarkStartEvent : public Fracture::Event
+	{
+	public:
+		BenchmarkStartEvent(uint32_t index) : m_Index(index) {}
+
+		inline uint32_t GetIndex() const { return m_Index; }
+
+		EVENT_CLASS_CUSTOM_TYPE(BenchmarkStart)
+		EVENT_CLASS_CATEGORY(Fracture::EventCategoryCustom)
+	private:
+		uint32_t m_Index;
+	};
+
+	/// Posted by the benchmark thread when the benchmark finishes.
+	class BenchmarkFinishedEvent : public Fracture::Event
+	{
+	public:
+		BenchmarkFinishedEvent(uint32_t index, BenchmarkReport report) : m_Index(index), m_Report(std::move(report)) {}
+
+		inline uint32_t GetIndex() const { return m_Index; }
+		inline BenchmarkReport& GetReport() { return m_Report; }
+
+		EVENT_CLASS_CUSTOM_TYPE(BenchmarkFinished)
+		EVENT_CLASS_CATEGORY(Fracture::EventCategoryCustom)
+	private:
+		uint32_t m_Index;
+		BenchmarkReport m_Report;
+	};
+
+	/*!
+	* @brief Draws a button for every added benchmark and runs the pressed one on a thread of its own, one at a time.
+	*
+	* @details The benchmarks use the JobSystem, like the layer updates, and both would contend for its submit mutex. So the frame loop is paused
+	* while a benchmark runs: every other layer is suspended, the benchmark starts on the next frame once the suspension took effect, and the
+	* layers are resumed when it finishes. The window, the events and the ImGui windows keep running, so the frame times recorded meanwhile are
+	* those of an idle frame.
+	*/
+	class BenchmarkLayer : public Fracture::Layer
+	{
+	public:
+		BenchmarkLayer();
+		virtual ~BenchmarkLayer() = default;
+
+		virtual void OnDetach() override;
+		virtual void OnImGuiRender() override;
+
+		/*!
+		* @brief Adds a benchmark with a button in the Benchmarks window.
+		*
+		* @param[in] const std::string& name: The label of the button.
+		* @param[in] BenchmarkFn benchmark: Runs the benchmark and returns its report. Called on the benchmark thread, so it must not touch the renderer or ImGui.
+		*/
+		void Add(const std::string& name, BenchmarkFn benchmark);
+	private:
+		bool OnBenchmarkStart(BenchmarkStartEvent& e);
+		bool OnBenchmarkFinished(BenchmarkFinishedEvent& e);
+
+		struct Benchmark
+		{
+			std::string Name;
+			BenchmarkFn Run;
+			BenchmarkReport Report; /// The report of the last run. Empty until it ran once.
+		};
+
+		std::vector<Benchmark> m_Benchmarks;
+		std::vector<Fracture::Layer*> m_SuspendedLayers; /// The layers suspended while the benchmark runs, resumed when it finishes.
+		std::thread m_Thread; /// Runs the benchmarks, one at a time.
+		bool m_Running = false; /// Set from the button press until the benchmark thread posts its report.
+	};
+
+}
@@ -0,0 +1,99 @@
+#include "EcsBenchmark.h"
+
+#include <chrono>
+
+
+namespace Sandbox {
+
+	namespace {
+
+		struct BenchmarkPosition { glm::vec3 Value = glm::vec3(0.0f); };
+		struct BenchmarkVelocity { glm::vec3 Value = glm::vec3(1.0f, 0.0f, 0.0f); };
+		struct BenchmarkAcceleration { glm::vec3 Value = glm::vec3(0.0f, -9.8f, 0.0f); };
+		struct BenchmarkMass { float InverseMass = 1.0f; };
+
+		constexpr float BenchmarkStep = 1.0f / 60.0f; /// The time step of the integration the queries do.
+
+		/// Returns the average nanoseconds per entity of passes calls to fn, after one untimed call that warms the caches.
+		template<typename Fn>
+		float NanosecondsPerEntity(uint32_t entityCount, uint32_t passes, Fn&& fn)
+		{
+			fn();
+			auto start = std::chrono::high_resolution_clock::now();
+			for (uint32_t pass = 0; pass < passes; pass++)
+				fn();
+			return std::chrono::duration<float, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / ((float)entityCount * passes);
+		}
+
+		/// Times the query of Ts with the three iteration methods and stores the results at index sizeof...(Ts) - 1.
+		template<typename... Ts, typename Kernel>
+		void TimeQuery(Fracture::World& world, uint32_t passes, Kernel kernel, EcsBenchmarkResult& result)
+		{
+			FR_PROFILE_FUNCTION();
+			constexpr size_t index = sizeof...(Ts) - 1;
+			Fracture::Query<Ts...> query = world.GetQuery<Ts...>();
+
+			result.EachNanoseconds[index] = NanosecondsPerEntity(result.EntityCount, passes, [&]()
+				{
+					query.Each([&](Fracture::Entity, Ts&... components) { kernel(components...); });
+				});
+			result.EachChunkNanoseconds[index] = NanosecondsPerEntity(result.EntityCount, passes, [&]()
+				{
+					query.EachChunk([&](uint32_t count, const Fracture::Entity*, Ts*... components)
+						{
+							for (uint32_t i = 0; i < count; i++)
+								kernel(components[i]...);
+						});
+				});
+			result.ParallelEachNanoseconds[index] = NanosecondsPerEntity(result.EntityCount, passes, [&]()
+				{
+					query.ParallelEach([&](Fracture::Entity, Ts&... components) { kernel(components...); });
+				});
+		}
+
+	}
+
+	EcsBenchmarkResult RunEcsBenchmark(uint32_t entityCount, uint32_t passes)
+	{
+		FR_PROFILE_FUNCTION();
+		EcsBenchmarkResult result;
+		result.EntityCount = entityCount;
+		result.ThreadCount = Fracture::JobSystem::GetThreadCount();
+		if (entityCount == 0 || passes == 0)
+			return result;
+
+		Fracture::World world;
+		{
+			FR_PROFILE_SCOPE("RunEcsBenchmark::CreateEntities");
+			for (uint32_t i = 0; i < entityCount; i++)
+				world.CreateEntity(BenchmarkPosition(), BenchmarkVelocity(), BenchmarkAcceleration(), BenchmarkMass());
+		}
+
+		TimeQuery<BenchmarkPosition>(world, passes, [](BenchmarkPosition& position)
+			{
+				position.Value.x += BenchmarkStep;
+			}, result);
+		TimeQuery<BenchmarkPosition, const BenchmarkVelocity>(world, passes, [](BenchmarkPosition& position, const BenchmarkVelocity& velocity)
+			{
+				position.Value += velocity.Value * BenchmarkStep;
+			}, result);
+		TimeQuery<BenchmarkPosition, BenchmarkVelocity, const BenchmarkAcceleration>(world, passes, [](BenchmarkPosition& position, BenchmarkVelocity& velocity, const BenchmarkAcceleration& acceleration)
+			{
+				velocity.Value += acceleration.Value * BenchmarkStep;
+				position.Value += velocity.Value * BenchmarkStep;
+			}, result);
+		TimeQuery<BenchmarkPosition, BenchmarkVelocity, const BenchmarkAcceleration, const BenchmarkMass>(world, passes, [](BenchmarkPosition& position, BenchmarkVelocity& velocity, const BenchmarkAcceleration& acceleration, const BenchmarkMass& mass)
+			{
+				velocity.Value += acceleration.Value * (mass.InverseMass * BenchmarkStep);
+				position.Value += velocity.Value * BenchmarkStep;
+			}, result);
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			FR_INFO("ECS iteration of {0} entities with {1} components: Each {2:.2f}ns, EachChunk {3:.2f}ns, ParallelEach {4:.2f}ns/entity on {5} threads",
+				entityCount, i + 1, result.EachNanoseconds[i], result.EachChunkNanoseconds[i], result.ParallelEachNanoseconds[i], result.ThreadCount);
+		}
+		return result;
+	}
+
+}
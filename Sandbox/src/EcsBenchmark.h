@@ -0,0 +1,29 @@
+#pragma once
+#include "Fracture.h"
+
+
+namespace Sandbox
+{
+
+	/// The cost per entity of the three ways to iterate a query, for queries of 1 to 4 components. Index 0 is the 1 component query.
+	struct EcsBenchmarkResult
+	{
+		uint32_t EntityCount = 0; /// The number of entities every query visited.
+		uint32_t ThreadCount = 0; /// The number of threads ParallelEach ran on.
+		float EachNanoseconds[4] = {}; /// Per entity, with Query::Each.
+		float EachChunkNanoseconds[4] = {}; /// Per entity, with Query::EachChunk and the loop over the arrays written in the caller.
+		float ParallelEachNanoseconds[4] = {}; /// Per entity, with Query::ParallelEach.
+	};
+
+	/*!
+	* @brief Creates a World of entities with a position, a velocity, an acceleration and a mass and times Each, EachChunk and ParallelEach over them.
+	*
+	* @details The queries read and write 1 to 4 of the components with a small integration step, so the cost is mostly the iteration and the memory traffic.
+	* Every entity has all four components, so each query walks one archetype.
+	*
+	* @param[in] uint32_t entityCount: The number of entities.
+	* @param[in] uint32_t passes: The number of timed passes of every query and method. The result is their average.
+	*/
+	EcsBenchmarkResult RunEcsBenchmark(uint32_t entityCount = 1000000, uint32_t passes = 5);
+
+}
@@ -0,0 +1,115 @@
+#include "EventBenchmark.h"
+
+#include <chrono>
+
+
+namespace Sandbox {
+
+	namespace {
+
+		/// The handlers every benchmark layer has. They only count, so the dispatch itself is what is measured.
+		struct HandlerCounts
+		{
+			uint64_t Handled = 0;
+
+			bool OnMouseScrolled(Fracture::MouseScrolledEvent& e) { Handled++; return false; }
+			bool OnWindowResize(Fracture::WindowResizeEvent& e) { Handled++; return false; }
+			bool OnMouseButtonPressed(Fracture::MouseButtonPressedEvent& e) { Handled++; return false; }
+			bool OnMouseButtonReleased(Fracture::MouseButtonReleasedEvent& e) { Handled++; return false; }
+		};
+
+		/// A layer as it was written for EventDispatcher: a virtual OnEvent trying every handler.
+		class DispatcherLayer
+		{
+		public:
+			virtual ~DispatcherLayer() = default;
+
+			virtual void OnEvent(Fracture::Event& e)
+			{
+				Fracture::EventDispatcher dispatcher(e);
+				dispatcher.Dispatch<Fracture::MouseScrolledEvent>(FRACTURE_BIND_EVENT_FN(DispatcherLayer::OnMouseScrolled));
+				dispatcher.Dispatch<Fracture::WindowResizeEvent>(FRACTURE_BIND_EVENT_FN(DispatcherLayer::OnWindowResize));
+				dispatcher.Dispatch<Fracture::MouseButtonPressedEvent>(FRACTURE_BIND_EVENT_FN(DispatcherLayer::OnMouseButtonPressed));
+				dispatcher.Dispatch<Fracture::MouseButtonReleasedEvent>(FRACTURE_BIND_EVENT_FN(DispatcherLayer::OnMouseButtonReleased));
+			}
+
+			HandlerCounts Counts;
+		private:
+			bool OnMouseScrolled(Fracture::MouseScrolledEvent& e) { return Counts.OnMouseScrolled(e); }
+			bool OnWindowResize(Fracture::WindowResizeEvent& e) { return Counts.OnWindowResize(e); }
+			bool OnMouseButtonPressed(Fracture::MouseButtonPressedEvent& e) { return Counts.OnMouseButtonPressed(e); }
+			bool OnMouseButtonReleased(Fracture::MouseButtonReleasedEvent& e) { return Counts.OnMouseButtonReleased(e); }
+		};
+
+		/// Returns the nanoseconds elapsed since start, per event.
+		inline float NanosecondsPerEvent(std::chrono::high_resolution_clock::time_point start, uint32_t eventCount)
+		{
+			return std::chrono::duration<float, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / (float)eventCount;
+		}
+
+	}
+
+	EventBenchmarkResult RunEventBenchmark(uint32_t eventCount, uint32_t layerCount)
+	{
+		FR_PROFILE_FUNCTION();
+		EventBenchmarkResult result;
+		result.EventCount = eventCount;
+		result.LayerCount = layerCount;
+		if (eventCount == 0)
+			return result;
+
+		// Mostly mouse moves, with a scroll and a click every 16 events and a resize every 64
+		std::vector<Fracture::QueuedEvent> events(eventCount);
+		for (uint32_t i = 0; i < eventCount; i++)
+		{
+			switch (i % 64)
+			{
+			case 0: events[i] = Fracture::QueuedEvent::WindowResize(1280, 720); break;
+			case 5: case 21: case 37: case 53: events[i] = Fracture::QueuedEvent::MouseScrolled(0.0f, 1.0f); break;
+			case 9: case 25: case 41: case 57: events[i] = Fracture::QueuedEvent::MouseButtonPressed(0, 0); break;
+			case 10: case 26: case 42: case 58: events[i] = Fracture::QueuedEvent::MouseButtonReleased(0, 0); break;
+			default: events[i] = Fracture::QueuedEvent::MouseMoved((float)(i % 1280), (float)(i % 720)); break;
+			}
+		}
+
+		std::vector<Fracture::Scope<DispatcherLayer>> dispatcherLayers;
+		for (uint32_t i = 0; i < layerCount; i++)
+			dispatcherLayers.push_back(Fracture::CreateScope<DispatcherLayer>());
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (const Fracture::QueuedEvent& queued : events)
+		{
+			Fracture::EventQueue::Visit(queued, [&](Fracture::Event& e)
+				{
+					for (auto it = dispatcherLayers.rbegin(); it != dispatcherLayers.rend() && !e.Handled; ++it)
+						(*it)->OnEvent(e);
+				});
+		}
+		result.EventDispatcherNanoseconds = NanosecondsPerEvent(start, eventCount);
+
+		std::vector<HandlerCounts> tableLayers(layerCount);
+		Fracture::EventHandlerTable table;
+		for (auto it = tableLayers.rbegin(); it != tableLayers.rend(); ++it)
+		{
+			Fracture::EventHandlers handlers;
+			handlers.Subscribe<&HandlerCounts::OnMouseScrolled>(&*it);
+			handlers.Subscribe<&HandlerCounts::OnWindowResize>(&*it);
+			handlers.Subscribe<&HandlerCounts::OnMouseButtonPressed>(&*it);
+			handlers.Subscribe<&HandlerCounts::OnMouseButtonReleased>(&*it);
+			table.Add(handlers);
+		}
+
+		start = std::chrono::high_resolution_clock::now();
+		for (const Fracture::QueuedEvent& queued : events)
+			Fracture::EventQueue::Visit(queued, [&](auto& e) { table.Dispatch(e); });
+		result.HandlerTableNanoseconds = NanosecondsPerEvent(start, eventCount);
+
+		for (uint32_t i = 0; i < layerCount; i++)
+			FR_ASSERT(dispatcherLayers[i]->Counts.Handled == tableLayers[i].Handled, "The dispatch paths handled different events");
+
+		FR_INFO("Event dispatch of {0} events to {1} layers: EventDispatcher {2:.1f}ns/event, EventHandlerTable {3:.1f}ns/event",
+			eventCount, layerCount, result.EventDispatcherNanoseconds, result.HandlerTableNanoseconds);
+		return result;
+	}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "Fracture.h"
+
+
+namespace Sandbox
+{
+
+	/// The cost per event of the two dispatch paths, measured on the same events and handlers.
+	struct EventBenchmarkResult
+	{
+		uint32_t EventCount = 0; /// The number of events dispatched through each path.
+		uint32_t LayerCount = 0; /// The number of layers the events were dispatched to.
+		float EventDispatcherNanoseconds = 0.0f; /// Per event, with a virtual OnEvent per layer, EventDispatcher and std::bind handlers.
+		float HandlerTableNanoseconds = 0.0f; /// Per event, with an EventHandlerTable and the event type known at compile time.
+	};
+
+	/*!
+	* @brief Dispatches the same mix of events through the EventDispatcher path and an EventHandlerTable and times both.
+	*
+	* @details Every layer handles scrolls, resizes and mouse button presses and releases, like a layer with an OrthographicCameraController.
+	* Most of the events are mouse moves that no layer handles, which is the common case the table skips entirely.
+	*
+	* @param[in] uint32_t eventCount: The number of events to dispatch through each path.
+	* @param[in] uint32_t layerCount: The number of layers.
+	*/
+	EventBenchmarkResult RunEventBenchmark(uint32_t eventCount = 1000000, uint32_t layerCount = 4);
+
+}
@@ -0,0 +1,56 @@
+#include "ProfilerBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+
+namespace Sandbox {
+
+	ProfilerBenchmarkResult RunProfilerBenchmark(uint32_t scopeCount)
+	{
+		ProfilerBenchmarkResult result;
+		result.ScopeCount = scopeCount;
+		if (scopeCount == 0)
+			return result;
+
+		// Half a buffer per batch, and more than one drain interval between batches, keeps the ring from filling up
+		constexpr uint32_t batchSize = Fracture::Utils::ProfileEventBuffer::Capacity / 2;
+		double scopeTime = 0.0, loopTime = 0.0;
+		volatile uint32_t sink = 0;
+		for (uint32_t first = 0; first < scopeCount; first += batchSize)
+		{
+			uint32_t count = std::min(batchSize, scopeCount - first);
+			auto start = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < count; i++)
+			{
+				FR_PROFILE_SCOPE("ProfilerBenchmark::Scope");
+				sink = i;
+			}
+			auto middle = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < count; i++)
+				sink = i;
+			auto end = std::chrono::high_resolution_clock::now();
+
+			scopeTime += std::chrono::duration<double, std::nano>(middle - start).count();
+			loopTime += std::chrono::duration<double, std::nano>(end - middle).count();
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+		result.ScopeNanoseconds = (float)std::max(0.0, (scopeTime - loopTime) / scopeCount);
+
+		uint64_t ticks = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < scopeCount; i++)
+			ticks += Fracture::Utils::Instrumentor::Now();
+		result.TimestampNanoseconds = std::chrono::duration<float, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / (float)scopeCount;
+		sink = (uint32_t)ticks;
+
+#ifndef FR_DIST
+		result.SessionActive = Fracture::Utils::Instrumentor::Get().IsActive(); // The scopes above compile to nothing in Dist
+#endif
+		FR_INFO("Profile scope overhead over {0} scopes: {1:.1f}ns/scope, {2:.1f}ns per timestamp read{3}",
+			scopeCount, result.ScopeNanoseconds, result.TimestampNanoseconds, result.SessionActive ? "" : " (no session was active)");
+		return result;
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Fracture.h"
+
+
+namespace Sandbox
+{
+
+	/// The cost of a profile scope on the thread that recorded it.
+	struct ProfilerBenchmarkResult
+	{
+		uint32_t ScopeCount = 0; /// The number of scopes recorded.
+		float ScopeNanoseconds = 0.0f; /// Per empty FR_PROFILE_SCOPE, with the loop around it subtracted.
+		float TimestampNanoseconds = 0.0f; /// Per read of the timestamp counter. A scope reads it twice.
+		bool SessionActive = false; /// Whether the scopes were recorded. In Dist builds they compile to nothing.
+	};
+
+	/*!
+	* @brief Records empty profile scopes into the running session and times them.
+	*
+	* @details The scopes are recorded in batches of half a ring buffer with a pause between them, so the writer thread drains the buffer and no scope
+	* takes the cheaper dropped path. The scopes end up in the trace of the session, named ProfilerBenchmark::Scope.
+	*
+	* @param[in] uint32_t scopeCount: The number of scopes to record.
+	*/
+	ProfilerBenchmarkResult RunProfilerBenchmark(uint32_t scopeCount = 100000);
+
+}
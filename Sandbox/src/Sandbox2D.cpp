@@ -1,5 +1,6 @@
 #include "Sandbox2D.h"
 
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 
@@ -7,17 +8,15 @@ namespace Sandbox {
 	Sandbox2D::Sandbox2D() :
 		Layer("Sandbox2D"), m_CameraController(1280.0f / 720.0f, true)
 	{
+		m_CameraController.SubscribeEvents(m_EventHandlers);
+		m_EventHandlers.Subscribe<&Sandbox2D::OnMouseButtonPressed>(this);
 	}
 
 	void Sandbox2D::OnAttach()
 	{
 		FR_PROFILE_SCOPE("Application::Sandbox2D::OnAttach");
 
-		m_BigSquare = Fracture::CreateRef<Sandbox::Object>("Texture Square");
-		m_Square = Fracture::CreateRef<Sandbox::Object>("Ground Shape");
-		m_Logo = Fracture::CreateRef<Sandbox::Object>("Logo Square");
-
-		m_Square->VertexArray = Fracture::VertexArray::Create(); // create a vertex array object for a square
+		m_SquareVA = Fracture::VertexArray::Create(); // create a vertex array object for a square. Every square of the scene shares it
 
 		float squareVertices[4 * 5] = { -0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
 										0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
@@ -33,39 +32,79 @@ namespace Sandbox {
 			};
 			m_SquareVertexBuffer->SetLayout(layout);
 		}
-		m_Square->VertexArray->AddVertexBuffer(m_SquareVertexBuffer);
+		m_SquareVA->AddVertexBuffer(m_SquareVertexBuffer);
 
 		uint32_t squareIndices[6] = { 0, 1, 2, 2, 3, 0 }; // the indices of the vertices that make up the square. As mentioned above we draw the square by drawing 6 vertices in counter-clockwise order. The indices are used to specify the order in which the vertices should be drawn.
 
-		m_Square->VertexArray->SetIndexBuffer(Fracture::IndexBuffer::Create(squareIndices, 6));
+		m_SquareVA->SetIndexBuffer(Fracture::IndexBuffer::Create(squareIndices, 6));
+		m_SquareVA->SetBounds(Fracture::AABB({ -0.5f, -0.5f }, { 0.5f, 0.5f })); // so squares outside the camera view are culled
 
-		m_Square->Transform.SetScale(glm::vec3(0.1f));
+		m_FlatColorShader = Fracture::ShaderLibrary::Load("square_shader", "assets/shaders/FlatColourShader.glsl");
+		Fracture::Ref<Fracture::Shader> bigSquareShader = Fracture::ShaderLibrary::Load("big_square", "assets/shaders/TextureShader.glsl");
+		Fracture::Ref<Fracture::Shader> logoShader = Fracture::ShaderLibrary::Load("logo", "assets/shaders/TextureShader.glsl");
 
-		m_BigSquare->VertexArray = Fracture::VertexArray::Create(); // create a vertex array object for a square
+		// The grid squares are created in one archetype so drawing and animating them walks contiguous arrays
+		m_GridRoot = m_Transforms.Create();
+		for (int x = -10; x < 10; x++)
+		{
+			for (int y = -10; y < 10; y++)
+			{
+				Fracture::TransformHandle transform = m_Transforms.Create(glm::vec3(x * 0.1f, y * 0.1f, 0.0f), glm::vec3(0.0f), glm::vec3(0.1f));
+				m_Transforms.SetParent(transform, m_GridRoot);
+				Fracture::Entity entity = m_World.CreateEntity(transform, Fracture::RenderableComponent(m_SquareVA, m_FlatColorShader), GridCellComponent());
+				m_GridCells.push_back({ entity, transform });
+			}
+		}
 
-		m_BigSquare->VertexArray->AddVertexBuffer(m_SquareVertexBuffer);
-		m_BigSquare->VertexArray->SetIndexBuffer(Fracture::IndexBuffer::Create(squareIndices, 6));
-		m_BigSquare->Transform.SetScale(glm::vec3(1.5f));
+		// The grid is baked into one vertex buffer and drawn with a single call. Only squares that move are uploaded again
+		m_Transforms.Update();
+		m_GridBatch = Fracture::CreateScope<Fracture::StaticBatch>(m_SquareVertexBuffer->GetLayout());
+		for (uint32_t index = 0; index < (uint32_t)m_GridCells.size(); index++)
+		{
+			GridCell& cell = m_GridCells[index];
+			const glm::mat4& transform = m_Transforms.GetTransform(cell.Transform);
+			cell.Proxy = m_GridIndex.Insert(m_SquareVA->GetBounds().Transform(transform), index);
+			cell.Member = m_GridBatch->Add(squareVertices, 4, squareIndices, 6, transform);
+		}
 
-		m_Logo->VertexArray = Fracture::VertexArray::Create(); // create a vertex array object for a square
+		// The square and a ring of regular polygons with 3 to 10 sides share one vertex and index buffer. The polygons are drawn with a single multi draw
+		m_IndirectShader = Fracture::ShaderLibrary::Load("indirect_flat_colour", "assets/shaders/IndirectFlatColourShader.glsl");
+		m_Geometry = Fracture::CreateScope<Fracture::GeometryPool>(m_SquareVertexBuffer->GetLayout());
+		m_SquareMesh = m_Geometry->Add(squareVertices, 4, squareIndices, 6);
+		for (uint32_t sides = 3; sides <= 10; sides++)
+		{
+			std::vector<float> vertices = { 0.0f, 0.0f, 0.0f, 0.5f, 0.5f };
+			std::vector<uint32_t> indices;
+			for (uint32_t side = 0; side < sides; side++)
+			{
+				float angle = glm::two_pi<float>() * side / sides;
+				float x = 0.5f * std::cos(angle), y = 0.5f * std::sin(angle);
+				vertices.insert(vertices.end(), { x, y, 0.0f, x + 0.5f, y + 0.5f });
+				indices.insert(indices.end(), { 0, side + 1, (side + 1) % sides + 1 });
+			}
+			m_PolygonMeshes.push_back(m_Geometry->Add(vertices.data(), sides + 1, indices.data(), (uint32_t)indices.size()));
+		}
+		const glm::vec4 polygonColours[4] = { { 0.9f, 0.3f, 0.3f, 1.0f }, { 0.3f, 0.9f, 0.3f, 1.0f }, { 0.3f, 0.5f, 0.9f, 1.0f }, { 0.9f, 0.8f, 0.2f, 1.0f } };
+		m_PolygonMaterials = Fracture::StorageBuffer::Create(sizeof(polygonColours));
+		m_PolygonMaterials->SetData(polygonColours, sizeof(polygonColours));
 
-		m_Logo->VertexArray->AddVertexBuffer(m_SquareVertexBuffer);
-		m_Logo->VertexArray->SetIndexBuffer(Fracture::IndexBuffer::Create(squareIndices, 6));
-		m_Logo->Transform.SetScale(glm::vec3(0.5f));
+		Fracture::TransformComponent bigSquareTransform;
+		bigSquareTransform.SetScale(glm::vec3(1.5f));
+		m_BigSquare = m_World.CreateEntity(Fracture::TagComponent("Texture Square"), std::move(bigSquareTransform), Fracture::RenderableComponent(m_SquareVA, bigSquareShader));
 
-		m_Square->Shader = Fracture::ShaderLibrary::Load("square_shader", "assets/shaders/FlatColourShader.glsl");
-		m_BigSquare->Shader = Fracture::ShaderLibrary::Load("big_square", "assets/shaders/TextureShader.glsl");
-		m_Logo->Shader = Fracture::ShaderLibrary::Load("logo", "assets/shaders/TextureShader.glsl");
+		Fracture::TransformComponent logoTransform;
+		logoTransform.SetScale(glm::vec3(0.5f));
+		m_Logo = m_World.CreateEntity(Fracture::TagComponent("Logo Square"), std::move(logoTransform), Fracture::RenderableComponent(m_SquareVA, logoShader));
 
 		m_Texture = Fracture::Texture2D::Create("assets/textures/base-map.png"); // does not return a raw pointer.
 		m_TextureLogo = Fracture::Texture2D::Create("assets/textures/FractureLogo.png"); // does not return a raw pointer.
 		m_Texture->Bind(0);
 		m_TextureLogo->Bind(1);
 
-		m_BigSquare->Shader->Bind();
-		m_BigSquare->Shader->SetInt("u_Texture", 0);
-		m_Logo->Shader->Bind();
-		m_Logo->Shader->SetInt("u_Texture", 1);
+		bigSquareShader->Bind();
+		bigSquareShader->SetInt("u_Texture", 0);
+		logoShader->Bind();
+		logoShader->SetInt("u_Texture", 1);
 
 	}
 
@@ -77,63 +116,170 @@ namespace Sandbox {
 	{
 		FR_PROFILE_SCOPE("Application::Sandbox2D::OnUpdate");
 		//FR_TRACE("Delta time: {0}s ({1}ms)", delta_time.GetSeconds(), delta_time.GetMilliseconds());
-		m_LastFrameTime = delta_time;
 		{
 			FR_PROFILE_SCOPE("CameraController::OnUpdate");
 			m_CameraController.OnUpdate(delta_time);
 		}
 
+		const Fracture::Window& window = Fracture::Application::Get().GetWindow();
+		Fracture::Framebuffer* sceneTarget = PrepareSceneFramebuffer(window.GetWidth(), window.GetHeight());
+		if (sceneTarget)
+			sceneTarget->Bind();
+
 		Fracture::Renderer::BeginScene(m_CameraController.GetCamera());
 		Fracture::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.2f, 1.0f });
 		Fracture::RenderCommand::Clear();
 
-		if (m_AnimateSquares)
-			m_Square->Transform.Rotate(glm::vec3(0.0f, 0.0f, m_SqaureAnimationSpeed * delta_time));
+		if (m_Animation.GridMoved)
+		{
+			m_GridMoved = true; // GridAnimationLayer rotated the squares in the PreUpdate phase
+			m_Animation.GridMoved = false;
+		}
+		m_Transforms.Update();
+		if (m_GridMoved)
+			RefitGrid();
 
-		
-		m_Square->Shader->Bind();
-		m_Square->Shader->SetFloat4("u_Colour", m_SquareColor);
+		m_FlatColorShader->Bind();
+		m_FlatColorShader->SetFloat4("u_Colour", m_SquareColor);
 
-		for (int x = -10; x < 10; x++)
 		{
-			for (int y = -10; y < 10; y++)
-			{
-				FR_PROFILE_SCOPE("Renderer::Submit");
-				Fracture::TransformComponent local_transform = m_Square->Transform;
-				local_transform.Translate(glm::vec3(x * 0.1f, y * 0.1f, 0.0f));
-				Fracture::Renderer::Submit(m_Square->VertexArray, m_Square->Shader, local_transform.GetTransform());
-			}
+			FR_PROFILE_SCOPE("Renderer::Submit");
+			Fracture::Renderer::Cull(m_GridIndex, m_VisibleGridCells);
+			m_VisibleGridMembers.clear();
+			for (uint32_t index : m_VisibleGridCells)
+				m_VisibleGridMembers.push_back(m_GridCells[index].Member);
+			m_GridBatch->Draw(m_FlatColorShader, m_VisibleGridMembers);
+
+			// Draw the picked squares again on top in the inverted colour
+			m_FlatColorShader->SetFloat4("u_Colour", glm::vec4(glm::vec3(1.0f) - glm::vec3(m_SquareColor), 1.0f));
+			for (uint32_t index : m_PickedGridCells)
+				Fracture::Renderer::Submit(*m_Geometry, m_SquareMesh, m_FlatColorShader, m_Transforms.GetTransform(m_GridCells[index].Transform));
+		}
+
+		if (m_ShowPolygons)
+		{
+			m_PolygonMaterials->Bind(1); // The material colours the shader indexes with the material index of each draw
+			m_IndirectShader->Bind();
+			m_IndirectShader->SetFloat4("u_Colour", m_SquareColor);
+			FillPolygonDraws(); // The ring turns every frame, and the ranges move when the pool is defragmented
+			Fracture::Renderer::SubmitIndirect(*m_Geometry, m_PolygonDraws, m_IndirectShader);
 		}
 
-		Fracture::Renderer::Submit(m_BigSquare->VertexArray, m_BigSquare->Shader, m_BigSquare->Transform.GetTransform());
+		// Drawn explicitly after the grid so they blend on top of it
+		const Fracture::RenderableComponent& bigSquare = m_World.GetComponent<Fracture::RenderableComponent>(m_BigSquare);
+		Fracture::Renderer::Submit(bigSquare.Mesh, bigSquare.Material, m_World.GetComponent<Fracture::TransformComponent>(m_BigSquare).GetTransform());
 
-		m_Logo->Transform.SetPosition(m_LogoPosition);
-		Fracture::Renderer::Submit(m_Logo->VertexArray, m_Logo->Shader, m_Logo->Transform.GetTransform());
+		Fracture::TransformComponent& logoTransform = m_World.GetComponent<Fracture::TransformComponent>(m_Logo);
+		logoTransform.SetPosition(m_LogoPosition);
+		const Fracture::RenderableComponent& logo = m_World.GetComponent<Fracture::RenderableComponent>(m_Logo);
+		Fracture::Renderer::Submit(logo.Mesh, logo.Material, logoTransform.GetTransform());
 
 		Fracture::Renderer::EndScene();
+
+		if (sceneTarget)
+		{
+			FR_PROFILE_SCOPE("Sandbox2D::UpscaleScene");
+			sceneTarget->Unbind();
+			sceneTarget->BlitToScreen(0, 0, window.GetWidth(), window.GetHeight(), Fracture::FramebufferFilter::Linear);
+		}
+	}
+
+	Fracture::Framebuffer* Sandbox2D::PrepareSceneFramebuffer(uint32_t windowWidth, uint32_t windowHeight)
+	{
+		if (Fracture::Renderer::GetAPI() != Fracture::RendererAPI::API::OpenGL || (m_RenderScale >= 1.0f && m_SceneSamples <= 1))
+			return nullptr;
+
+		uint32_t width = std::max(1u, (uint32_t)(windowWidth * m_RenderScale));
+		uint32_t height = std::max(1u, (uint32_t)(windowHeight * m_RenderScale));
+		if (!m_SceneFramebuffer || m_SceneFramebufferSamples != m_SceneSamples)
+		{
+			Fracture::FramebufferSpecification spec;
+			spec.Width = width;
+			spec.Height = height;
+			spec.Samples = m_SceneSamples;
+			m_SceneFramebuffer = Fracture::Framebuffer::Create(spec);
+			m_SceneFramebufferSamples = m_SceneSamples;
+		}
+		m_SceneFramebuffer->Resize(width, height);
+		return m_SceneFramebuffer.get();
 	}
 
 	void Sandbox2D::OnImGuiRender()
 	{
 		FR_PROFILE_SCOPE("Application::Sandbox2D::ImGuiLayer::OnImGuiRender");
-		ImGui::Begin("Performance Overview");
-		ImGui::Text("Performance");
-		ImGui::Text("Frame Rate: %f", 1.0f / m_LastFrameTime);
-		ImGui::End();
-
 		ImGui::Begin("Scene Controls");
 		ImGui::Text("Small Squares Controls");
 		ImGui::ColorEdit4("Square Color", glm::value_ptr(m_SquareColor));
-		ImGui::SliderFloat("Square Animation Speed", &m_SqaureAnimationSpeed, 0.0f, 10.0f);
-		ImGui::Checkbox("Animate Squares", &m_AnimateSquares);
+		ImGui::SliderFloat("Square Animation Speed", &m_Animation.SquareSpeed, 0.0f, 10.0f);
+		ImGui::Checkbox("Animate Squares", &m_Animation.AnimateSquares);
+		if (ImGui::SliderAngle("Grid Rotation", &m_GridRotation))
+		{
+			m_Transforms.SetRotation(m_GridRoot, glm::vec3(0.0f, 0.0f, m_GridRotation)); // Only the grid is recomposed, and only on the frames the slider moves
+			m_GridMoved = true;
+		}
+		ImGui::Text("Grid: %u of %u squares in view, in one draw call", (uint32_t)m_VisibleGridCells.size(), m_GridBatch->GetMemberCount());
+		ImGui::Checkbox("Show Polygons", &m_ShowPolygons);
+		ImGui::SliderFloat("Polygon Ring Speed", &m_Animation.PolygonSpeed, -2.0f, 2.0f);
+		ImGui::Text("Polygons: %u draws of %u meshes in one multi draw", m_PolygonDraws.GetDrawCount(), (uint32_t)m_PolygonMeshes.size());
+		Fracture::GeometryPoolStats geometry = m_Geometry->GetStats();
+		ImGui::Text("Geometry: %u meshes, %u/%u vertices, %u/%u indices", geometry.MeshCount, geometry.UsedVertices, geometry.VertexCapacity, geometry.UsedIndices, geometry.IndexCapacity);
+		ImGui::Text("Geometry: %u shared ranges, %u free blocks", geometry.DeduplicatedUploads, geometry.FreeBlocks);
+		if (ImGui::Button("Defragment Geometry"))
+			m_Geometry->Defragment();
+		Fracture::EventQueue& events = Fracture::Application::Get().GetEventQueue();
+		Fracture::EventCoalescing coalescing = events.GetCoalescing();
+		bool changed = ImGui::Checkbox("Coalesce Mouse Moves", &coalescing.MouseMoves);
+		changed |= ImGui::Checkbox("Coalesce Scrolls", &coalescing.Scrolls);
+		changed |= ImGui::Checkbox("Coalesce Resizes", &coalescing.Resizes);
+		if (changed)
+			events.SetCoalescing(coalescing);
+		if (Fracture::Renderer::GetAPI() == Fracture::RendererAPI::API::OpenGL)
+		{
+			ImGui::SliderFloat("Render Scale", &m_RenderScale, 0.25f, 1.0f);
+			const char* sampleNames[] = { "Off", "2x", "4x", "8x" };
+			int sampleIndex = m_SceneSamples >= 8 ? 3 : m_SceneSamples >= 4 ? 2 : m_SceneSamples >= 2 ? 1 : 0;
+			if (ImGui::Combo("MSAA", &sampleIndex, sampleNames, IM_ARRAYSIZE(sampleNames)))
+				m_SceneSamples = 1u << sampleIndex;
+			if (m_SceneFramebuffer && (m_RenderScale < 1.0f || m_SceneSamples > 1))
+				ImGui::Text("Scene: %ux%u", m_SceneFramebuffer->GetSpecification().Width, m_SceneFramebuffer->GetSpecification().Height);
+		}
 		ImGui::Text("Control logo position");
 		ImGui::SliderFloat3("Logo Position", glm::value_ptr(m_LogoPosition), -1.0f, 1.0f);
 		ImGui::End();
 	}
 
-	void Sandbox2D::OnEvent(Fracture::Event& e)
+	bool Sandbox2D::OnMouseButtonPressed(Fracture::MouseButtonPressedEvent& e)
+	{
+		if (e.GetMouseButton() != FR_MOUSE_BUTTON_LEFT)
+			return false;
+
+		auto [x, y] = Fracture::Input::GetMousePosition();
+		const Fracture::Window& window = Fracture::Application::Get().GetWindow();
+		glm::vec2 worldPosition = m_CameraController.GetCamera().ScreenToWorld({ x, y }, { (float)window.GetWidth(), (float)window.GetHeight() });
+		m_GridIndex.QueryPoint(worldPosition, m_PickedGridCells);
+		return false;
+	}
+
+	void Sandbox2D::RefitGrid()
+	{
+		FR_PROFILE_FUNCTION();
+		m_MovedProxies.clear();
+		m_MovedBounds.clear();
+		for (const GridCell& cell : m_GridCells)
+		{
+			const glm::mat4& transform = m_Transforms.GetTransform(cell.Transform);
+			m_MovedProxies.push_back(cell.Proxy);
+			m_MovedBounds.push_back(m_SquareVA->GetBounds().Transform(transform));
+			m_GridBatch->SetTransform(cell.Member, transform);
+		}
+		m_GridIndex.MoveBatch(m_MovedProxies.data(), m_MovedBounds.data(), (uint32_t)m_MovedProxies.size());
+		m_GridMoved = false;
+	}
+
+	void Sandbox2D::FillPolygonDraws()
 	{
-		FR_PROFILE_SCOPE("Application::Sandbox2D::OnEvent");
-		m_CameraController.OnEvent(e);
+		m_PolygonDraws.Clear();
+		for (uint32_t i = 0; i < (uint32_t)m_Animation.PolygonTransforms.size(); i++)
+			m_PolygonDraws.Add(m_Geometry->GetRange(m_PolygonMeshes[i % m_PolygonMeshes.size()]), m_Animation.PolygonTransforms[i], i % 4);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "Fracture.h"
 #include "Shapes.h"
+#include "AnimationLayers.h"
 
 
 namespace Sandbox
@@ -16,11 +17,65 @@ namespace Sandbox
 
 		void OnUpdate(Fracture::Utils::Timestep ts) override;
 		virtual void OnImGuiRender() override;
-		void OnEvent(Fracture::Event& e) override;
+
+		/*!
+		* @brief Functions that return the state the animation layers update before Sandbox2D draws it.
+		*/
+		inline Fracture::World& GetWorld() { return m_World; }
+		inline Fracture::TransformSystem& GetTransforms() { return m_Transforms; }
+		inline SceneAnimation& GetAnimation() { return m_Animation; }
+	private:
+		/*!
+		* @brief Picks the grid square under the mouse through the spatial index.
+		*/
+		bool OnMouseButtonPressed(Fracture::MouseButtonPressedEvent& e);
+
+		/*!
+		* @brief Moves the grid squares in the spatial index and in the static batch after the transforms were updated.
+		*/
+		void RefitGrid();
+
+		/*!
+		* @brief Refills the polygon draw list with the transforms PolygonAnimationLayer wrote and the current ranges of the polygon meshes in the geometry pool.
+		*/
+		void FillPolygonDraws();
+
+		/*!
+		* @brief Returns the framebuffer to draw the scene into at the render scale and sample count, resized to the window. nullptr to draw straight into the window.
+		*/
+		Fracture::Framebuffer* PrepareSceneFramebuffer(uint32_t windowWidth, uint32_t windowHeight);
 	private:
-		Fracture::Ref<Sandbox::Object> m_BigSquare;
-		Fracture::Ref<Sandbox::Object> m_Logo;
-		Fracture::Ref<Sandbox::Object> m_Square;
+		Fracture::World m_World;
+		Fracture::TransformSystem m_Transforms; /// The transforms of the grid squares, composed in SIMD batches.
+		Fracture::TransformHandle m_GridRoot; /// The parent of every grid square, so the grid can be rotated as a whole.
+		Fracture::Entity m_BigSquare;
+		Fracture::Entity m_Logo;
+
+		/// A grid square and its proxy in the spatial index.
+		struct GridCell
+		{
+			Fracture::Entity Entity;
+			Fracture::TransformHandle Transform;
+			uint32_t Proxy = Fracture::SpatialGrid::InvalidProxy;
+			uint32_t Member = 0; /// The member of the square in m_GridBatch.
+		};
+		std::vector<GridCell> m_GridCells; /// The grid squares. The spatial index reports indices into this array.
+		Fracture::SpatialGrid m_GridIndex { 0.25f }; /// The world space bounds of the grid squares. Culled against the view to pick the batch members to draw, and queried under the mouse to pick squares.
+		std::vector<uint32_t> m_VisibleGridCells; /// The grid squares in view this frame, found through m_GridIndex.
+		std::vector<uint32_t> m_VisibleGridMembers; /// The members of m_GridBatch of the squares in view.
+		std::vector<uint32_t> m_MovedProxies; /// Scratch arrays for the batch update of the spatial index.
+		std::vector<Fracture::AABB> m_MovedBounds;
+		Fracture::Scope<Fracture::StaticBatch> m_GridBatch; /// The grid squares baked into one vertex buffer.
+
+		Fracture::Scope<Fracture::GeometryPool> m_Geometry; /// The square and the polygon meshes in one shared vertex and index buffer.
+		Fracture::GeometryHandle m_SquareMesh; /// The square in m_Geometry, used to draw the picked grid squares.
+		std::vector<Fracture::GeometryHandle> m_PolygonMeshes; /// The polygons with 3 to 10 sides in m_Geometry.
+		Fracture::IndirectDrawList m_PolygonDraws; /// The ring of polygons, drawn with one multi draw.
+		Fracture::Ref<Fracture::StorageBuffer> m_PolygonMaterials; /// The colours the polygon materials index.
+		Fracture::Ref<Fracture::Shader> m_IndirectShader; /// Reads the transform and material of each polygon with gl_DrawID.
+		bool m_ShowPolygons = true;
+		std::vector<uint32_t> m_PickedGridCells; /// The indices of the grid squares under the mouse on the last click.
+		bool m_GridMoved = false; /// Set when the grid squares moved and the spatial index has to be refitted.
 
 		Fracture::Ref<Fracture::Texture2D> m_Texture;
 		Fracture::Ref<Fracture::Texture2D> m_TextureBlue;
@@ -34,12 +89,14 @@ namespace Sandbox
 		Fracture::Ref<Fracture::Texture2D> m_CheckerboardTexture;
 
 		glm::vec4 m_SquareColor = { 0.2f, 0.3f, 0.8f, 1.0f };
-		bool m_AnimateSquares = false;
+		SceneAnimation m_Animation; /// The animation settings and the transforms the animation layers write.
 
 		glm::vec3 m_LogoPosition = { -1.0f, 0.0f, 0.0f };
 
-		Fracture::Utils::Timestep m_LastFrameTime;
-
-		float m_SqaureAnimationSpeed = 0.5f;
+		Fracture::Ref<Fracture::Framebuffer> m_SceneFramebuffer; /// The scene is drawn into it and scaled to the window when the render scale or the sample count are changed.
+		uint32_t m_SceneFramebufferSamples = 0; /// The sample count m_SceneFramebuffer was created with.
+		float m_RenderScale = 1.0f; /// The resolution of the scene relative to the window.
+		uint32_t m_SceneSamples = 1; /// The MSAA sample count of the scene.
+		float m_GridRotation = 0.0f;
 	};
 }
\ No newline at end of file
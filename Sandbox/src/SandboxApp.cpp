@@ -3,6 +3,11 @@
 
 #include "Sandbox2D.h"
 #include "Shapes.h"
+#include "BenchmarkLayer.h"
+#include "EcsBenchmark.h"
+#include "EventBenchmark.h"
+#include "ProfilerBenchmark.h"
+#include "SpatialGridBenchmark.h"
 
 #include <memory>
 #include <glm/gtc/type_ptr.hpp>
@@ -12,7 +17,47 @@ class SandboxApp : public Fracture::Application
 public:
 	SandboxApp()
 	{
-		PushLayer(new Sandbox::Sandbox2D());
+		Sandbox::Sandbox2D* scene = new Sandbox::Sandbox2D();
+		PushLayer(scene);
+		// Both animations update in the PreUpdate phase and write different resources, so they run on the job system at the same time
+		PushLayer(new Sandbox::GridAnimationLayer(scene->GetWorld(), scene->GetTransforms(), scene->GetAnimation()));
+		PushLayer(new Sandbox::PolygonAnimationLayer(scene->GetAnimation()));
+
+		Sandbox::BenchmarkLayer* benchmarks = new Sandbox::BenchmarkLayer();
+		benchmarks->Add("Benchmark Event Dispatch", []()
+			{
+				Sandbox::EventBenchmarkResult result = Sandbox::RunEventBenchmark();
+				return Sandbox::BenchmarkReport{ Sandbox::FormatBenchmarkLine("EventDispatcher %.1fns, EventHandlerTable %.1fns per event", result.EventDispatcherNanoseconds, result.HandlerTableNanoseconds) };
+			});
+		benchmarks->Add("Benchmark Profile Scopes", []()
+			{
+				Sandbox::ProfilerBenchmarkResult result = Sandbox::RunProfilerBenchmark();
+				return Sandbox::BenchmarkReport{ Sandbox::FormatBenchmarkLine("Profile scope %.1fns, timestamp read %.1fns%s", result.ScopeNanoseconds, result.TimestampNanoseconds, result.SessionActive ? "" : " (no session)") };
+			});
+		benchmarks->Add("Benchmark ECS Iteration", []()
+			{
+				Sandbox::EcsBenchmarkResult result = Sandbox::RunEcsBenchmark();
+				Sandbox::BenchmarkReport report;
+				for (uint32_t i = 0; i < 4; i++)
+				{
+					report.push_back(Sandbox::FormatBenchmarkLine("%u components: Each %.2fns, EachChunk %.2fns, ParallelEach %.2fns per entity", i + 1,
+						result.EachNanoseconds[i], result.EachChunkNanoseconds[i], result.ParallelEachNanoseconds[i]));
+				}
+				return report;
+			});
+		benchmarks->Add("Benchmark Spatial Grid", []()
+			{
+				Sandbox::SpatialGridBenchmarkResult result = Sandbox::RunSpatialGridBenchmark();
+				Sandbox::BenchmarkReport report;
+				for (const Sandbox::SpatialGridBenchmarkRow& row : result.Rows)
+				{
+					report.push_back(Sandbox::FormatBenchmarkLine("%u objects: Insert %.0fns, MoveBatch %.0fns/%.0fns per object", row.ObjectCount, row.InsertNanoseconds, row.MoveFewNanoseconds, row.MoveAllNanoseconds));
+					report.push_back(Sandbox::FormatBenchmarkLine("%u objects: Rect %.0fns, Point %.0fns, Radius %.0fns, brute force %.0fns per query, %u mismatches", row.ObjectCount,
+						row.QueryRectNanoseconds, row.QueryPointNanoseconds, row.QueryRadiusNanoseconds, row.BruteForceNanoseconds, row.Mismatches));
+				}
+				return report;
+			});
+		PushLayer(benchmarks);
 	}
 
 	~SandboxApp()
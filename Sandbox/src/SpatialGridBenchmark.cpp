@@ -0,0 +1,159 @@
+#include "SpatialGridBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+
+namespace Sandbox {
+
+	namespace {
+
+		constexpr float QueryHalfSize = 2.0f; /// Half the width of the rectangles searched by QueryRect.
+		constexpr float QueryRadius = 2.0f; /// The radius searched by QueryRadius.
+
+		/// Returns the nanoseconds elapsed since start, per item.
+		inline float NanosecondsPer(std::chrono::high_resolution_clock::time_point start, uint32_t count)
+		{
+			return std::chrono::duration<float, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / (float)std::max(count, 1u);
+		}
+
+		/// Returns whether the grid found the same objects as the brute force scan. Sorts both.
+		bool SameResults(std::vector<uint32_t>& found, std::vector<uint32_t>& expected)
+		{
+			std::sort(found.begin(), found.end());
+			std::sort(expected.begin(), expected.end());
+			return found == expected;
+		}
+
+		/// Collects the indices of the boxes that pass the test, the way the grid queries would report them.
+		template<typename Test>
+		void BruteForce(const std::vector<Fracture::AABB>& bounds, const Test& test, std::vector<uint32_t>& results)
+		{
+			results.clear();
+			for (uint32_t i = 0; i < (uint32_t)bounds.size(); i++)
+			{
+				if (test(bounds[i]))
+					results.push_back(i);
+			}
+		}
+
+		SpatialGridBenchmarkRow RunRow(uint32_t objectCount, uint32_t queryCount, uint32_t checkedQueryCount)
+		{
+			FR_PROFILE_FUNCTION();
+			SpatialGridBenchmarkRow row;
+			row.ObjectCount = objectCount;
+
+			std::mt19937 random(objectCount);
+			float worldSize = std::sqrt((float)objectCount) * 2.0f; // About a quarter of the cells are covered at every count
+			std::uniform_real_distribution<float> position(0.0f, worldSize);
+			std::uniform_real_distribution<float> size(0.2f, 1.5f);
+			std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+
+			std::vector<Fracture::AABB> bounds(objectCount);
+			for (Fracture::AABB& box : bounds)
+			{
+				glm::vec2 min(position(random), position(random));
+				box = Fracture::AABB(min, min + glm::vec2(size(random), size(random)));
+			}
+
+			Fracture::SpatialGrid grid(1.0f);
+			std::vector<uint32_t> proxies(objectCount);
+			auto start = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < objectCount; i++)
+				proxies[i] = grid.Insert(bounds[i], i);
+			row.InsertNanoseconds = NanosecondsPer(start, objectCount);
+
+			// A tenth of the objects stays below the rebuild threshold of MoveBatch, all of them goes above it
+			auto moveObjects = [&](uint32_t count)
+			{
+				for (uint32_t i = 0; i < count; i++)
+				{
+					glm::vec2 delta(offset(random), offset(random));
+					bounds[i] = Fracture::AABB(bounds[i].Min + delta, bounds[i].Max + delta);
+				}
+				auto moveStart = std::chrono::high_resolution_clock::now();
+				grid.MoveBatch(proxies.data(), bounds.data(), count);
+				return NanosecondsPer(moveStart, count);
+			};
+			row.MoveFewNanoseconds = moveObjects(objectCount / 10);
+			row.MoveAllNanoseconds = moveObjects(objectCount);
+
+			std::vector<glm::vec2> points(queryCount);
+			for (glm::vec2& point : points)
+				point = glm::vec2(position(random), position(random));
+
+			std::vector<uint32_t> results;
+			uint64_t rectResults = 0;
+			start = std::chrono::high_resolution_clock::now();
+			for (const glm::vec2& point : points)
+				rectResults += grid.QueryRect(Fracture::AABB(point - QueryHalfSize, point + QueryHalfSize), results);
+			row.QueryRectNanoseconds = NanosecondsPer(start, queryCount);
+			row.AverageRectResults = (float)rectResults / (float)std::max(queryCount, 1u);
+
+			start = std::chrono::high_resolution_clock::now();
+			for (const glm::vec2& point : points)
+				grid.QueryPoint(point, results);
+			row.QueryPointNanoseconds = NanosecondsPer(start, queryCount);
+
+			start = std::chrono::high_resolution_clock::now();
+			for (const glm::vec2& point : points)
+				grid.QueryRadius(point, QueryRadius, results);
+			row.QueryRadiusNanoseconds = NanosecondsPer(start, queryCount);
+
+			// The same tests the grid does, on every object
+			std::vector<uint32_t> expected;
+			uint32_t checkedCount = std::min(checkedQueryCount, queryCount);
+			start = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < checkedCount; i++)
+			{
+				Fracture::AABB area(points[i] - QueryHalfSize, points[i] + QueryHalfSize);
+				BruteForce(bounds, [&area](const Fracture::AABB& box) { return box.Intersects(area); }, expected);
+				grid.QueryRect(area, results);
+				row.Mismatches += SameResults(results, expected) ? 0 : 1;
+			}
+			row.BruteForceNanoseconds = NanosecondsPer(start, checkedCount);
+
+			for (uint32_t i = 0; i < checkedCount; i++)
+			{
+				const glm::vec2& point = points[i];
+				BruteForce(bounds, [&point](const Fracture::AABB& box) { return box.Contains(point); }, expected);
+				grid.QueryPoint(point, results);
+				row.Mismatches += SameResults(results, expected) ? 0 : 1;
+
+				BruteForce(bounds, [&point](const Fracture::AABB& box)
+					{
+						glm::vec2 offset = glm::clamp(point, box.Min, box.Max) - point;
+						return offset.x * offset.x + offset.y * offset.y <= QueryRadius * QueryRadius;
+					}, expected);
+				grid.QueryRadius(point, QueryRadius, results);
+				row.Mismatches += SameResults(results, expected) ? 0 : 1;
+			}
+			return row;
+		}
+
+	}
+
+	SpatialGridBenchmarkResult RunSpatialGridBenchmark(uint32_t queryCount, uint32_t checkedQueryCount)
+	{
+		FR_PROFILE_FUNCTION();
+		const uint32_t objectCounts[SpatialGridBenchmarkResult::RowCount] = { 10000, 100000, 1000000 };
+
+		SpatialGridBenchmarkResult result;
+		for (uint32_t i = 0; i < SpatialGridBenchmarkResult::RowCount; i++)
+		{
+			SpatialGridBenchmarkRow& row = result.Rows[i];
+			row = RunRow(objectCounts[i], queryCount, checkedQueryCount);
+			FR_INFO("SpatialGrid with {0} objects: Insert {1:.1f}ns, MoveBatch {2:.1f}ns (a tenth) {3:.1f}ns (all) per object",
+				row.ObjectCount, row.InsertNanoseconds, row.MoveFewNanoseconds, row.MoveAllNanoseconds);
+			FR_INFO("SpatialGrid with {0} objects: QueryRect {1:.0f}ns ({2:.1f} results), QueryPoint {3:.0f}ns, QueryRadius {4:.0f}ns, brute force rect {5:.0f}ns per query",
+				row.ObjectCount, row.QueryRectNanoseconds, row.AverageRectResults, row.QueryPointNanoseconds, row.QueryRadiusNanoseconds, row.BruteForceNanoseconds);
+			if (row.Mismatches > 0)
+				FR_ERROR("SpatialGrid with {0} objects: {1} queries differ from the brute force scan", row.ObjectCount, row.Mismatches);
+			FR_ASSERT(row.Mismatches == 0, "The SpatialGrid queries differ from the brute force scan");
+		}
+		return result;
+	}
+
+}
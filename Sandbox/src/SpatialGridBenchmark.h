@@ -0,0 +1,42 @@
+#pragma once
+#include "Fracture.h"
+
+
+namespace Sandbox
+{
+
+	/// The cost of the SpatialGrid operations at one object count.
+	struct SpatialGridBenchmarkRow
+	{
+		uint32_t ObjectCount = 0; /// The number of objects in the grid.
+		float InsertNanoseconds = 0.0f; /// Per object inserted into the empty grid.
+		float MoveFewNanoseconds = 0.0f; /// Per object, for a MoveBatch of a tenth of the objects, which moves them one at a time.
+		float MoveAllNanoseconds = 0.0f; /// Per object, for a MoveBatch of every object, which rebuilds the cells.
+		float QueryRectNanoseconds = 0.0f; /// Per QueryRect call.
+		float QueryPointNanoseconds = 0.0f; /// Per QueryPoint call.
+		float QueryRadiusNanoseconds = 0.0f; /// Per QueryRadius call.
+		float BruteForceNanoseconds = 0.0f; /// Per rectangle query answered by testing every object, for comparison.
+		float AverageRectResults = 0.0f; /// The average number of objects a QueryRect call found.
+		uint32_t Mismatches = 0; /// The number of queries whose results differed from the brute force scan. Always 0 unless the grid is broken.
+	};
+
+	/// The SpatialGrid benchmark at 10k, 100k and 1M objects.
+	struct SpatialGridBenchmarkResult
+	{
+		static constexpr uint32_t RowCount = 3;
+		SpatialGridBenchmarkRow Rows[RowCount];
+	};
+
+	/*!
+	* @brief Times Insert, MoveBatch, QueryRect, QueryPoint and QueryRadius of a SpatialGrid with 10k, 100k and 1M objects and checks the queries against a brute force scan.
+	*
+	* @details The objects are boxes of 0.2 to 1.5 units scattered at random, with the area growing with the count so the density stays the same.
+	* The cells are 1 unit wide, so the cost of a query should stay flat as the count grows while the brute force scan grows linearly.
+	* The first queries of every kind are repeated by testing every object after the moves and the results are compared.
+	*
+	* @param[in] uint32_t queryCount: The number of queries of each kind that are timed.
+	* @param[in] uint32_t checkedQueryCount: The number of queries of each kind that are compared with the brute force scan.
+	*/
+	SpatialGridBenchmarkResult RunSpatialGridBenchmark(uint32_t queryCount = 1000, uint32_t checkedQueryCount = 100);
+
+}
@@ -0,0 +1,401 @@
+/*!
+* @file FractureTrace.cpp
+* @brief Command line tool that reads the binary .frtrace files written by the Instrumentor.
+*
+* @details Usage:
+*
+* FractureTrace <trace.frtrace> [--json <output.json>] [--stats] [--top <count>] [--frames <first>:<last>]
+*
+* --json converts the trace to Chrome trace JSON that can be opened in chrome://tracing or https://ui.perfetto.dev.
+* --stats prints the frame time percentiles and the count, total, mean, percentiles and max time of every scope, sorted by total time. This is the default when no other option is given.
+* --frames only keeps the events that start between the FrameBegin marker of frame first and the FrameEnd marker of frame last, both included.
+*
+* @see TraceFormat.h
+*
+* @author Aditya Rajagopal
+*/
+
+#include "Fracture/Utils/TraceFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Fracture::Utils;
+
+/// An event of the trace with its times converted to microseconds.
+struct DecodedEvent
+{
+	uint64_t NameID; /// The id of the name.
+	uint64_t ThreadID; /// The thread that recorded the event.
+	double Start; /// The start relative to the session start.
+	double Duration; /// The duration, 0 for markers.
+	TraceFormat::EventType Type; /// Whether the event is a scope or a frame marker.
+	bool HasArgument; /// Whether the event carries an argument.
+	uint64_t ArgumentNameID; /// The id of the argument name.
+	int64_t Argument; /// The value of the argument.
+};
+
+/// The markers of a frame.
+struct FrameRange
+{
+	double Begin = -1.0; /// The time of the FrameBegin marker, -1 if it is missing.
+	double End = -1.0; /// The time of the FrameEnd marker, -1 if it is missing.
+};
+
+/// The durations of every occurrence of a scope.
+struct ScopeStats
+{
+	std::string Name; /// The name of the scope.
+	std::vector<double> Durations; /// The durations in microseconds.
+	double Total = 0.0; /// The sum of the durations.
+};
+
+/*!
+* @brief Returns the value at the given percentile of a sorted list.
+*/
+static double Percentile(const std::vector<double>& sorted, double percentile)
+{
+	if (sorted.empty())
+		return 0.0;
+	size_t index = (size_t)(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/*!
+* @brief Writes a string as a JSON string literal.
+*/
+static void AppendJsonString(std::string& out, const std::string& value)
+{
+	out += '"';
+	for (char c : value)
+	{
+		if (c == '"' || c == '\\')
+			out += '\\';
+		out += c;
+	}
+	out += '"';
+}
+
+static void PrintUsage()
+{
+	std::cerr << "Usage: FractureTrace <trace.frtrace> [--json <output.json>] [--stats] [--top <count>] [--frames <first>:<last>]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::string inputPath = argv[1];
+	std::string jsonPath;
+	bool printStats = false;
+	size_t top = 50;
+	bool sliceFrames = false;
+	int64_t firstFrame = 0, lastFrame = 0;
+	for (int i = 2; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		if (argument == "--json" && i + 1 < argc)
+			jsonPath = argv[++i];
+		else if (argument == "--stats")
+			printStats = true;
+		else if (argument == "--top" && i + 1 < argc)
+			top = (size_t)std::stoul(argv[++i]);
+		else if (argument == "--frames" && i + 1 < argc)
+		{
+			std::string range = argv[++i];
+			size_t separator = range.find(':');
+			firstFrame = std::stoll(range.substr(0, separator));
+			lastFrame = separator == std::string::npos ? firstFrame : std::stoll(range.substr(separator + 1));
+			sliceFrames = true;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (jsonPath.empty())
+		printStats = true;
+
+	std::ifstream input(inputPath, std::ios::in | std::ios::binary);
+	if (!input)
+	{
+		std::cerr << "Could not open " << inputPath << std::endl;
+		return 1;
+	}
+
+	TraceFormat::FileHeader header = {};
+	input.read((char*)&header, sizeof(header));
+	if (!input || memcmp(header.Magic, TraceFormat::Magic, sizeof(header.Magic)) != 0)
+	{
+		std::cerr << inputPath << " is not a Fracture trace" << std::endl;
+		return 1;
+	}
+	if (header.Version > TraceFormat::Version)
+	{
+		std::cerr << inputPath << " was written with a newer version of the format (" << header.Version << ")" << std::endl;
+		return 1;
+	}
+
+	std::unordered_map<uint64_t, std::string> names; // name id -> name
+	std::vector<DecodedEvent> events;
+	bool hasInfo = false;
+	bool hasEnd = false;
+	TraceFormat::InfoChunk info = {};
+	std::string sessionName;
+	uint64_t droppedCount = 0;
+
+	// First pass: decode the whole file. The frame markers are needed before the events can be sliced and they are spread over the chunks of the main thread.
+	std::vector<uint8_t> payload;
+	TraceFormat::ChunkHeader chunk;
+	while (input.read((char*)&chunk, sizeof(chunk)))
+	{
+		payload.resize(chunk.Size);
+		if (!input.read((char*)payload.data(), chunk.Size))
+		{
+			std::cerr << "Warning: the trace ends in the middle of a chunk, it was probably not closed" << std::endl;
+			break;
+		}
+
+		TraceFormat::Reader reader(payload.data(), payload.size());
+		switch (chunk.Type)
+		{
+			case TraceFormat::ChunkType::Info:
+			{
+				info = reader.ReadRaw<TraceFormat::InfoChunk>();
+				sessionName = reader.ReadString();
+				hasInfo = true;
+				break;
+			}
+			case TraceFormat::ChunkType::Strings:
+			{
+				while (!reader.AtEnd() && !reader.HasError())
+				{
+					uint64_t id = reader.ReadVarint();
+					names[id] = reader.ReadString();
+				}
+				break;
+			}
+			case TraceFormat::ChunkType::Events:
+			{
+				if (!hasInfo)
+				{
+					std::cerr << "Events chunk before the Info chunk" << std::endl;
+					return 1;
+				}
+
+				uint64_t threadID = reader.ReadVarint();
+				uint64_t count = reader.ReadVarint();
+				int64_t start = 0; // relative to the session start in ticks
+				for (uint64_t i = 0; i < count && !reader.HasError(); i++)
+				{
+					DecodedEvent event = {};
+					event.ThreadID = threadID;
+					event.Type = TraceFormat::EventType::Scope;
+
+					uint64_t eventHeader = reader.ReadVarint();
+					if (header.Version >= 2)
+					{
+						event.NameID = TraceFormat::GetEventHeaderName(eventHeader);
+						event.Type = TraceFormat::GetEventHeaderType(eventHeader);
+						event.HasArgument = TraceFormat::GetEventHeaderHasArgument(eventHeader);
+					}
+					else
+					{
+						event.NameID = eventHeader;
+					}
+
+					start += TraceFormat::ZigZagDecode(reader.ReadVarint());
+					event.Start = start * info.MicrosecondsPerTick;
+					if (event.Type == TraceFormat::EventType::Scope)
+						event.Duration = reader.ReadVarint() * info.MicrosecondsPerTick;
+					if (event.HasArgument)
+					{
+						event.ArgumentNameID = reader.ReadVarint();
+						event.Argument = TraceFormat::ZigZagDecode(reader.ReadVarint());
+					}
+					events.push_back(event);
+				}
+				break;
+			}
+			case TraceFormat::ChunkType::End:
+			{
+				reader.ReadVarint(); // event count, recomputed while reading
+				droppedCount = reader.ReadVarint();
+				hasEnd = true;
+				break;
+			}
+			default:
+				break; // unknown chunks from newer writers are skipped
+		}
+
+		if (reader.HasError())
+		{
+			std::cerr << "Corrupt chunk of type " << (uint32_t)chunk.Type << std::endl;
+			return 1;
+		}
+	}
+
+	std::map<int64_t, FrameRange> frames; // frame index -> markers
+	for (const DecodedEvent& event : events)
+	{
+		if (event.Type == TraceFormat::EventType::FrameBegin)
+			frames[event.Argument].Begin = event.Start;
+		else if (event.Type == TraceFormat::EventType::FrameEnd)
+			frames[event.Argument].End = event.Start;
+	}
+
+	double sliceBegin = 0.0;
+	double sliceEnd = std::numeric_limits<double>::max();
+	if (sliceFrames)
+	{
+		auto first = frames.find(firstFrame);
+		auto last = frames.find(lastFrame);
+		if (first == frames.end() || first->second.Begin < 0.0 || last == frames.end() || last->second.End < 0.0)
+		{
+			std::cerr << "The trace has no markers for frames " << firstFrame << " to " << lastFrame << std::endl;
+			return 1;
+		}
+		sliceBegin = first->second.Begin;
+		sliceEnd = last->second.End;
+	}
+
+	// Second pass: convert and gather statistics for the events in the slice
+	std::ofstream json;
+	std::string jsonBuffer;
+	if (!jsonPath.empty())
+	{
+		json.open(jsonPath, std::ios::out | std::ios::binary);
+		if (!json)
+		{
+			std::cerr << "Could not open " << jsonPath << " for writing" << std::endl;
+			return 1;
+		}
+		jsonBuffer = "{\"otherData\": {},\"traceEvents\":[";
+	}
+
+	std::unordered_map<std::string, ScopeStats> stats; // merged by name, the same literal can have several ids
+	uint64_t eventCount = 0;
+	double firstTimestamp = std::numeric_limits<double>::max();
+	double lastTimestamp = 0.0;
+	char number[128];
+	for (const DecodedEvent& event : events)
+	{
+		if (event.Start < sliceBegin || event.Start > sliceEnd)
+			continue;
+
+		const std::string& name = names[event.NameID];
+		firstTimestamp = std::min(firstTimestamp, event.Start);
+		lastTimestamp = std::max(lastTimestamp, event.Start + event.Duration);
+
+		if (printStats && event.Type == TraceFormat::EventType::Scope)
+		{
+			ScopeStats& scope = stats[name];
+			scope.Durations.push_back(event.Duration);
+			scope.Total += event.Duration;
+		}
+
+		if (json.is_open())
+		{
+			if (eventCount > 0)
+				jsonBuffer += ',';
+			int length;
+			if (event.Type == TraceFormat::EventType::Scope)
+			{
+				jsonBuffer += "{\"cat\":\"function\",\"name\":";
+				AppendJsonString(jsonBuffer, name);
+				length = snprintf(number, sizeof(number), ",\"ph\":\"X\",\"pid\":0,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f", (unsigned long long)event.ThreadID, event.Start, event.Duration);
+			}
+			else if (event.Type == TraceFormat::EventType::Counter)
+			{
+				jsonBuffer += "{\"cat\":\"counter\",\"name\":";
+				AppendJsonString(jsonBuffer, name);
+				length = snprintf(number, sizeof(number), ",\"ph\":\"C\",\"pid\":0,\"tid\":%llu,\"ts\":%.3f", (unsigned long long)event.ThreadID, event.Start);
+			}
+			else
+			{
+				jsonBuffer += event.Type == TraceFormat::EventType::FrameBegin ? "{\"cat\":\"frame\",\"name\":\"FrameBegin\"" : "{\"cat\":\"frame\",\"name\":\"FrameEnd\"";
+				length = snprintf(number, sizeof(number), ",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":%llu,\"ts\":%.3f", (unsigned long long)event.ThreadID, event.Start);
+			}
+			jsonBuffer.append(number, length);
+			if (event.HasArgument)
+			{
+				jsonBuffer += ",\"args\":{";
+				AppendJsonString(jsonBuffer, names[event.ArgumentNameID]);
+				length = snprintf(number, sizeof(number), ":%lld}", (long long)event.Argument);
+				jsonBuffer.append(number, length);
+			}
+			jsonBuffer += '}';
+
+			if (jsonBuffer.size() > 1 << 20)
+			{
+				json.write(jsonBuffer.data(), jsonBuffer.size());
+				jsonBuffer.clear();
+			}
+		}
+		eventCount++;
+	}
+
+	if (json.is_open())
+	{
+		jsonBuffer += "]}";
+		json.write(jsonBuffer.data(), jsonBuffer.size());
+		json.close();
+		std::cout << "Wrote " << eventCount << " events to " << jsonPath << std::endl;
+	}
+
+	if (!hasEnd)
+		std::cerr << "Warning: the trace has no End chunk, the session was not ended cleanly" << std::endl;
+
+	if (printStats)
+	{
+		std::cout << "Session: " << sessionName << ", " << eventCount << " events over " << (eventCount ? (lastTimestamp - firstTimestamp) / 1000.0 : 0.0) << " ms";
+		if (droppedCount)
+			std::cout << ", " << droppedCount << " dropped";
+		std::cout << std::endl << std::endl;
+
+		std::vector<double> frameTimes;
+		for (const auto& [index, frame] : frames)
+		{
+			if (frame.Begin >= 0.0 && frame.End >= frame.Begin && frame.Begin >= sliceBegin && frame.End <= sliceEnd)
+				frameTimes.push_back(frame.End - frame.Begin);
+		}
+		if (!frameTimes.empty())
+		{
+			std::sort(frameTimes.begin(), frameTimes.end());
+			printf("%zu frames: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms\n\n", frameTimes.size(), Percentile(frameTimes, 50.0) / 1000.0,
+				Percentile(frameTimes, 95.0) / 1000.0, Percentile(frameTimes, 99.0) / 1000.0, frameTimes.back() / 1000.0);
+		}
+
+		std::vector<ScopeStats*> sorted;
+		sorted.reserve(stats.size());
+		for (auto& [name, scope] : stats)
+		{
+			scope.Name = name;
+			std::sort(scope.Durations.begin(), scope.Durations.end());
+			sorted.push_back(&scope);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](const ScopeStats* a, const ScopeStats* b) { return a->Total > b->Total; });
+
+		printf("%12s %12s %10s %10s %10s %10s %10s  %s\n", "count", "total ms", "mean us", "p50 us", "p95 us", "p99 us", "max us", "name");
+		for (size_t i = 0; i < std::min(top, sorted.size()); i++)
+		{
+			const ScopeStats& scope = *sorted[i];
+			printf("%12zu %12.3f %10.3f %10.3f %10.3f %10.3f %10.3f  %s\n", scope.Durations.size(), scope.Total / 1000.0, scope.Total / scope.Durations.size(),
+				Percentile(scope.Durations, 50.0), Percentile(scope.Durations, 95.0), Percentile(scope.Durations, 99.0), scope.Durations.back(), scope.Name.c_str());
+		}
+	}
+
+	return 0;
+}
@@ -1,3 +1,9 @@
+newoption
+{
+    trigger = "track-allocations",
+    description = "Replace the global operator new and delete to track heap allocations (FR_TRACK_ALLOCATIONS)"
+}
+
 workspace "SoulCat"
     architecture "x64"
 
@@ -12,6 +18,13 @@ workspace "SoulCat"
 	{
 		"MultiProcessorCompile"
 	}
+
+    -- The SIMD loops of the engine (Fracture/src/Fracture/Core/Simd.h) process 8 floats at a time with AVX, 4 with SSE
+    vectorextensions "AVX2"
+    filter "options:track-allocations"
+        defines "FR_TRACK_ALLOCATIONS"
+    filter {}
+
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
 -- Include directories relative to root folder
@@ -153,4 +166,44 @@ project "Sandbox"
     filter "configurations:Dist"
         defines "FR_DIST"
         runtime "Release"
-        optimize "on"
\ No newline at end of file
+        optimize "on"
+group "Tools"
+project "FractureTrace"
+    location "Tools/FractureTrace"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+    staticruntime "on"
+
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+    files
+    {
+        "Tools/%{prj.name}/src/**.h",
+        "Tools/%{prj.name}/src/**.cpp",
+    }
+
+    includedirs
+    {
+        "Fracture/src"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "configurations:Debug"
+        defines "FR_DEBUG"
+        runtime "Debug"
+        symbols "on"
+
+    filter "configurations:Release"
+        defines "FR_RELEASE"
+        runtime "Release"
+        optimize "on"
+
+    filter "configurations:Dist"
+        defines "FR_DIST"
+        runtime "Release"
+        optimize "on"
+group ""